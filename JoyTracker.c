@@ -2,11 +2,34 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "pico/bootrom.h"
+#include "pico/flash.h"
 #include "lib/rgb.h"
+#include "lib/led_wave.h"
+#include "lib/led_seq.h"
+#include "lib/rgb_dither.h"
 #include "lib/joystick.h"
 #include "lib/oledgfx.h"
 #include "lib/push_button.h"
-#include "hardware/pwm.h"
+#include "lib/usb_device.h"
+#include "lib/usb_hid.h"
+#include "lib/telemetry.h"
+#include "lib/telemetry_usb.h"
+#include "lib/spsc_ring.h"
+#include "lib/display_pipeline.h"
+#include "lib/sched.h"
+#include "lib/profile.h"
+#include "lib/i2c_trace.h"
+#include "lib/i2c_bus.h"
+#include "lib/clock_gov.h"
+#include "lib/latency.h"
+#include "lib/ram_func.h"
+#include "lib/recorder.h"
+#include "lib/heatmap.h"
+#include "lib/fb_mirror.h"
+#include "lib/event_trace.h"
+#include "lib/predict.h"
+#include "lib/pixaddr.h"
+#include "lib/menu.h"
 
 /// @brief Define a porta I2C utilizada pelo OLED.
 #define I2C_PORT i2c1
@@ -22,12 +45,41 @@
 #define JOYSTICK_VRY 26  ///< Pino do eixo Y do joystick.
 #define JOYSTICK_PB  22  ///< Pino do botão do joystick.
 
+/// @brief Período de amostragem do joystick (1 kHz, igual ao intervalo de consulta HID).
+#define SAMPLE_PERIOD_US 1000
+
+/// @brief Períodos das tarefas do núcleo 0, independentes da taxa de quadros (núcleo 1).
+#define INPUT_PERIOD_US   5000   ///< Eventos de botão e estado do display (200 Hz).
+#define LED_PERIOD_US     10000  ///< Cor dos LEDs (100 Hz, mesmo passo do sequenciador).
+#define CONSOLE_PERIOD_US 50000  ///< Comandos do console (20 Hz).
+
+/// @brief Identificadores dos fluxos de telemetria, um por contexto produtor.
+#define TELEMETRY_STREAM_SAMPLER 0  ///< Interrupção de amostragem do joystick.
+#define TELEMETRY_STREAM_BUTTONS 1  ///< Eventos de botão gerados pelo debounce.
+#define TELEMETRY_STREAM_MAIN    2  ///< Pipeline do display no núcleo 1 (tempos de quadro).
+#define TELEMETRY_STREAM_MIRROR  3  ///< Espelho do framebuffer (núcleo 1 codifica, USB envia).
+
+/// @brief Capacidade da fila de eventos de botão (potência de dois).
+#define BUTTON_EVENT_QUEUE_SIZE 16
+
 /// @brief Definições dos pinos do LED RGB.
 #define RED_PIN   13  ///< Pino do LED vermelho.
 #define BLUE_PIN  12  ///< Pino do LED azul.
 #define GREEN_PIN 11  ///< Pino do LED verde.
 
-/// @brief Macros para verificar se um botão foi pressionado.
+/// @brief Divisor do PWM dos LEDs: 120 MHz / 2,5 / 2048 ≈ 23,4 kHz. No nível de 48 MHz
+/// do governador de clock, o divisor preservado chega a 1,0.
+#define LED_PWM_CLKDIV 2.5f
+#define LED_PWM_WRAP   2048
+
+/// @brief Nível perceptual (0-65535) do LED verde com a borda grossa (cerca de 50% do ciclo, como antes).
+#define LED_GREEN_LEVEL (194 * 257)
+
+/// @brief Efeito de "respiração" do LED azul enquanto o controle pelo joystick está sobreposto.
+#define LED_BREATHE_STEPS 200  ///< Duração do ciclo, em passos do sequenciador (2 s a 100 Hz).
+#define LED_BREATHE_PEAK  96   ///< Nível perceptual máximo.
+
+/// @brief Macros para identificar o botão que gerou um evento.
 #define JOYSTICK_SW_PRESSED gpio == 22
 #define BUTTON_A_PRESSED gpio == BUTTON_A
 #define BUTTON_B_PRESSED gpio == BUTTON_B
@@ -35,17 +87,117 @@
 /// @brief Ativa o modo de boot USB para atualizar o firmware.
 #define set_bootsel_mode() reset_usb_boot(0, 0)
 
-/// @brief Variável global para controlar o tipo de borda no OLED.
-static volatile uint8_t border_type = BORDER_LIGHT;
+/// @brief Variável global para controlar o tipo de borda no OLED (alterada só pelo tarefas do núcleo 0).
+static uint8_t border_type = BORDER_LIGHT;
+
+/// @brief Visão exibida no OLED (alterada pelo console, publicada pela tarefa de entrada).
+static uint8_t display_view = DISPLAY_VIEW_CURSOR;
+
+/// @brief Visão restaurada ao fechar o menu.
+static uint8_t display_view_before_menu = DISPLAY_VIEW_CURSOR;
+
+/// @brief Variáveis globais para controlar o estado dos LEDs (alteradas só pelo tarefas do núcleo 0).
+static bool led_green_active = false;
+static bool led_control_override = false; ///< Se ativo, sobrepõe os estados individuais dos LEDs.
+
+/// @brief LED RGB e a cor (perceptual) aplicada a ele uma vez por período pela tarefa dos LEDs.
+static rgb_t rgb;
+static rgb_color16_t led_color = {0, 0, 0};
+
+/// @brief Modo com dithering (16 bits efetivos); desativado pelo console volta ao PWM direto.
+static rgb_dither_t dither;
+static bool led_dither_ready = false;
+static bool led_dither_enabled = false;
+
+/// @brief Sequenciador por DMA do slice do LED azul e o efeito tocado por ele.
+static led_seq_t led_seq;
+static bool led_seq_ready = false;
+static uint8_t led_seq_free_mask = RGB_MASK_ALL; ///< Canais fora do slice do sequenciador.
+static led_wave_t override_wave;
+static uint32_t override_wave_storage[LED_BREATHE_STEPS];
+
+/// @brief Fila de eventos de botão: produzida no contexto do debounce, consumida pelo tarefa de entrada.
+static spsc_ring_t button_events;
+static pb_event_t button_events_storage[BUTTON_EVENT_QUEUE_SIZE];
+
+/// @brief Eventos de botão descartados por fila cheia.
+static volatile uint32_t button_events_dropped = 0;
+
+/// @brief Display OLED: inicializado pelo núcleo 0 e, depois, usado só pelo núcleo 1.
+static ssd1306_t ssd;
+
+/// @brief Joystick lido pela interrupção de amostragem; a zona morta é ajustada pelo menu.
+static joystick_t joy;
+
+/// @brief Amostra mais recente do joystick, publicada pela interrupção de amostragem.
+static joystick_latest_t latest_sample;
+
+/// @brief Preditor da posição no fim do envio do quadro (tarefa de entrada) e se ele é aplicado ao cursor.
+static predict_t predictor;
+static bool predict_enabled = false;
+
+/// @brief Mapa de cobertura das posições, alimentado pela interrupção de amostragem.
+static heatmap_t coverage;
+
+/// @brief Atraso da interrupção de amostragem em relação ao instante programado.
+static latency_stats_t sampling_isr_latency;
+
+/// @brief Instante programado da próxima amostragem (válido com `sampling_isr_synced`).
+static uint32_t sampling_expected_us;
+static bool sampling_isr_synced = false;
+
+/// @brief Pedido de zerar o atraso da amostragem, atendido pela própria interrupção.
+static volatile bool sampling_isr_reset_requested = true;
+
+/// @brief Escalonador do núcleo 0.
+static sched_t sched_core0;
+
+/// @brief Níveis do governador de clock. Múltiplos de 24 MHz: os divisores do PWM dos LEDs
+/// (1,0; 2,0; 2,5) e do marcapasso do sequenciador continuam exatos em todos os níveis, e o
+/// nível mais alto fica abaixo dos 125 MHz padrão.
+static const uint32_t clock_levels_khz[] = {48000, 96000, 120000};
+
+/// @brief Governador de clock: decidido pelo núcleo 1, entre quadros.
+static clock_gov_t clock_gov;
+
+/// @brief Intervalo de atualização dos rótulos do menu (quadros, clock e latência).
+#define MENU_LABEL_PERIOD_US 500000
+
+static void menu_apply_deadzone(menu_widget_t *widget);
+static void menu_apply_border(menu_widget_t *widget);
+static void menu_apply_dither(menu_widget_t *widget);
+static void menu_apply_override(menu_widget_t *widget);
+static void menu_apply_predict(menu_widget_t *widget);
+static void menu_apply_clock_gov(menu_widget_t *widget);
+static void menu_apply_hid_mouse(menu_widget_t *widget);
 
-/// @brief Variáveis globais para controlar o estado dos LEDs.
-static volatile bool led_red_active = false;
-static volatile bool led_green_active = false;
-static volatile bool led_blue_active = false;
-static volatile bool led_control_override = false; ///< Se ativo, sobrepõe os estados individuais dos LEDs.
+/// @brief Menu de configuração (botão B ou comando `M`): os widgets espelham as variáveis acima,
+/// sincronizados pela tarefa de entrada, e aplicam as mudanças feitas no menu.
+static menu_widget_t menu_deadzone = MENU_SLIDER_INIT("ZONA MORTA", 120, 0, 250, 10, menu_apply_deadzone);
+static menu_widget_t menu_border = MENU_TOGGLE_INIT("BORDA GROSSA", 0, menu_apply_border);
+static menu_widget_t menu_dither = MENU_TOGGLE_INIT("DITHERING", 0, menu_apply_dither);
+static menu_widget_t menu_override = MENU_TOGGLE_INIT("RESPIRAR", 0, menu_apply_override);
+static menu_widget_t *const menu_led_items[] = {&menu_dither, &menu_override};
+static menu_widget_t menu_leds = MENU_LIST_INIT("LEDS", menu_led_items);
+static menu_widget_t menu_predict = MENU_TOGGLE_INIT("PREDICAO", 0, menu_apply_predict);
+static menu_widget_t menu_clock_gov = MENU_TOGGLE_INIT("GOVERNADOR", 0, menu_apply_clock_gov);
+static menu_widget_t menu_hid_mouse = MENU_TOGGLE_INIT("HID MOUSE", 0, menu_apply_hid_mouse);
+static menu_widget_t menu_frames = MENU_LABEL_INIT("QUADROS");
+static menu_widget_t menu_clock_mhz = MENU_LABEL_INIT("CLOCK MHZ");
+static menu_widget_t menu_latency = MENU_LABEL_INIT("LATENCIA US");
+static menu_widget_t *const menu_status_items[] = {&menu_frames, &menu_clock_mhz, &menu_latency};
+static menu_widget_t menu_status = MENU_LIST_INIT("ESTADO", menu_status_items);
+static menu_widget_t *const menu_root_items[] = {&menu_deadzone, &menu_border,    &menu_leds,  &menu_predict,
+                                                 &menu_clock_gov, &menu_hid_mouse, &menu_status};
+static menu_widget_t menu_root = MENU_LIST_INIT("CONFIGURACAO", menu_root_items);
+static menu_t menu;
+static menu_nav_t menu_nav;
 
-/// @brief Ponteiro global para o objeto OLED.
-static ssd1306_t *ssd_global = NULL;
+/// @brief Fluxos de telemetria e suas filas (capacidades em potência de dois).
+static telemetry_stream_t telemetry_sampler, telemetry_buttons, telemetry_main;
+static telemetry_record_t telemetry_sampler_storage[256];
+static telemetry_record_t telemetry_buttons_storage[16];
+static telemetry_record_t telemetry_main_storage[32];
 
 /**
  * @brief Normaliza um valor do joystick para a escala do display.
@@ -57,151 +209,744 @@ static ssd1306_t *ssd_global = NULL;
 static uint16_t normalize_joystick_to_display(uint16_t joystick_vr, uint8_t new_max);
 
 /**
- * @brief Ajusta a intensidade do LED com base no valor do PWM.
+ * @brief Converte a deflexão de um eixo do joystick em nível perceptual do LED.
+ *
+ * @param joystick_vr Valor do joystick (0-4095).
+ * @return Nível perceptual do LED (0-65535).
+ */
+static uint16_t joystick_to_led_level(uint16_t joystick_vr);
+
+/**
+ * @brief Prepara o sequenciador por DMA e o efeito exibido durante a sobreposição.
+ */
+static void led_effects_init(void);
+
+/**
+ * @brief Callback para os eventos de botão já filtrados pelo debounce.
+ *
+ * @param event Evento de botão (pino, tipo e instante).
+ */
+static void button_event_callback(const pb_event_t *event);
+
+/**
+ * @brief Aplica um evento de botão ao estado do programa, entre iterações.
+ *
+ * @param event Evento de botão retirado da fila.
+ */
+static void apply_button_event(const pb_event_t *event);
+
+/**
+ * @brief Alterna entre bordas finas e grossas, com o LED verde aceso na grossa.
+ *
+ * @param thick Borda grossa.
+ */
+static void set_border_thick(bool thick);
+
+/**
+ * @brief Liga ou desliga a sobreposição do controle dos LEDs (LED azul "respirando").
+ *
+ * @param enabled Sobreposição ativa.
+ */
+static void set_led_override(bool enabled);
+
+/**
+ * @brief Liga ou desliga o dithering dos LEDs.
+ *
+ * @param enabled Dithering ativo (ignorado se não houver canal DMA para ele).
+ */
+static void set_led_dither(bool enabled);
+
+/**
+ * @brief Abre ou fecha o menu de configuração.
+ *
+ * @param open Menu na tela; ao fechar, volta à visão anterior.
+ */
+static void set_menu_open(bool open);
+
+/**
+ * @brief Copia para os widgets do menu as configurações alteradas fora dele e atualiza os rótulos.
+ *
+ * @param now_us Instante atual (os rótulos mudam a cada MENU_LABEL_PERIOD_US).
+ */
+static void menu_sync(uint32_t now_us);
+
+/**
+ * @brief Atende comandos de um caractere recebidos pelo USB stdio, sem bloquear.
+ */
+static void console_poll(void);
+
+/**
+ * @brief Tarefa de entrada: aplica os eventos de botão e publica o estado do display.
+ *
+ * @param ctx Não utilizado.
+ * @param release_us Instante de liberação.
+ */
+static void input_task(void *ctx, uint32_t release_us);
+
+/**
+ * @brief Tarefa dos LEDs: aplica a cor derivada do joystick.
  *
- * @param pwm_led_value Valor PWM do LED.
- * @return Valor ajustado para o PWM.
+ * @param ctx Não utilizado.
+ * @param release_us Instante de liberação.
  */
-static uint16_t adjust_pwm_led_value(uint16_t pwm_value);
+static void led_task(void *ctx, uint32_t release_us);
 
 /**
- * @brief Callback para interrupções de GPIO (botões).
+ * @brief Tarefa do console: atende um comando pendente.
  *
- * @param gpio Pino que acionou a interrupção.
- * @param event Tipo de evento da interrupção.
+ * @param ctx Não utilizado.
+ * @param release_us Instante de liberação.
  */
-static void gpio_irq_callback(uint gpio, uint32_t event);
+static void console_task(void *ctx, uint32_t release_us);
+
+/**
+ * @brief Callback do temporizador de amostragem: lê o joystick e publica a amostra.
+ *
+ * @param rt Temporizador repetitivo; `user_data` aponta para o joystick.
+ * @return `true` para manter o temporizador ativo.
+ */
+static bool sampling_timer_callback(repeating_timer_t *rt);
+
+/**
+ * @brief Fornece à interface HID a amostra mais recente e o estado dos botões.
+ *
+ * @param input Leitura preenchida para o relatório HID.
+ */
+static void read_hid_input(hid_report_input_t *input);
 
 /// @brief Função principal do programa.
 int main()
 {
+    // Antes de qualquer periférico derivado de clk_sys (PWM, I2C, marcapasso dos LEDs)
+    clock_gov_init(&clock_gov, clock_levels_khz, sizeof(clock_levels_khz) / sizeof(clock_levels_khz[0]));
+
+    usb_device_init(); ///< Inicializa o USB composto (CDC + HID) antes do stdio.
     stdio_init_all();  ///< Inicializa a comunicação serial.
+    profile_init_core();
 
-    rgb_t rgb;
-    uint16_t adj_led_red_pwm_value, adj_led_blue_pwm_value;
-    uint8_t joystick_vrx_norm, joystick_vry_norm;
-    uint16_t joystick_vrx, joystick_vry;
-    joystick_t joy;
-    ssd1306_t ssd;
+    joystick_sample_t sample;
+    repeating_timer_t sampling_timer;
+
+    // Fluxos de telemetria, drenados a cada quadro USB pela interface CDC de telemetria
+    telemetry_stream_init(&telemetry_sampler, TELEMETRY_STREAM_SAMPLER, telemetry_sampler_storage, 256);
+    telemetry_stream_init(&telemetry_buttons, TELEMETRY_STREAM_BUTTONS, telemetry_buttons_storage, 16);
+    telemetry_stream_init(&telemetry_main, TELEMETRY_STREAM_MAIN, telemetry_main_storage, 32);
+    telemetry_usb_init();
+    fb_mirror_init(TELEMETRY_STREAM_MIRROR);
 
     // Inicializa o LED RGB, Joystick e Display OLED
-    rgb_init_all(&rgb, RED_PIN, GREEN_PIN, BLUE_PIN, 1.0, 2048);
+    rgb_init_all(&rgb, RED_PIN, GREEN_PIN, BLUE_PIN, LED_PWM_CLKDIV, LED_PWM_WRAP);
+    led_effects_init();
     joystick_init_all(&joy, JOYSTICK_VRX, JOYSTICK_VRY, JOYSTICK_PB);
     oledgfx_init_all(&ssd, I2C_PORT, OLED_BAUDRATE, OLED_SDA, OLED_SCL, OLED_ADDR);
-    ssd_global = &ssd;  ///< Guarda a referência global do OLED.
 
     // Configuração dos botões e interrupções
     pb_config(JOYSTICK_PB, true);
     pb_config_btn_a();
     pb_config_btn_b();
-    pb_set_irq_callback(&gpio_irq_callback);
-    pb_enable_irq(BUTTON_A);
-    pb_enable_irq(JOYSTICK_PB);
-    pb_enable_irq(BUTTON_B);
+    spsc_ring_init(&button_events, button_events_storage, sizeof(pb_event_t), BUTTON_EVENT_QUEUE_SIZE);
+    pb_set_event_callback(&button_event_callback);
+    pb_debounce_add(BUTTON_A, NULL);
+    pb_debounce_add(JOYSTICK_PB, NULL);
+    pb_debounce_add(BUTTON_B, NULL);
 
-    // Desenha a borda inicial no OLED
-    oledgfx_draw_border(&ssd, 1);
+    // Amostragem do joystick a 1 kHz, compartilhada pelo núcleo 0 e pelo HID
+    heatmap_init(&coverage);
+    predict_init(&predictor);
+    joystick_read_sample(&joy, &sample);
+    joystick_publish_sample(&latest_sample, &sample);
+    joystick_capture_start(&joy, SAMPLE_PERIOD_US); // Conversões por DMA: seguem com este núcleo pausado
+    add_repeating_timer_us(-SAMPLE_PERIOD_US, sampling_timer_callback, &joy, &sampling_timer);
+    usb_hid_init(read_hid_input, joy.deadzone);
 
-    // Loop principal
-    while(true)
+    // Frequências a preservar nas trocas de nível: PWM dos LEDs, marcapasso e I2C do display
+    for(uint i = 0; i < RGB_CHANNELS; i++)
     {
-        // Lê os valores do joystick
-        joystick_vrx = joystick_get_x(&joy);
-        joystick_vry = joystick_get_y(&joy);
+        clock_gov_track_pwm(&clock_gov, rgb.slice[i]);
+    }
+    clock_gov_track_pwm(&clock_gov, LED_SEQ_PACER_SLICE);
+    clock_gov_track_i2c(&clock_gov, I2C_PORT, OLED_BAUDRATE);
 
-        // Normaliza os valores do joystick para o display
-        joystick_vrx_norm = normalize_joystick_to_display(joystick_vrx, 127 - CURSOR_SIDE - border_type);
-        joystick_vry_norm = (63 - CURSOR_SIDE) - normalize_joystick_to_display(joystick_vry, 63 - CURSOR_SIDE - border_type);
+    // Fim do log de gravação na flash, antes que o núcleo 1 passe a gravá-la
+    recorder_init(SAMPLE_PERIOD_US);
 
-        // Atualiza o cursor e redesenha a borda no OLED
-        oledgfx_update_cursor(&ssd, joystick_vrx_norm, joystick_vry_norm);
-        oledgfx_draw_border(&ssd, border_type);
-        oledgfx_render(&ssd);
+    // A partir daqui o display e a gravação da flash pertencem ao núcleo 1; o I2C, ao gerenciador do barramento
+    display_pipeline_set_clock_gov(&clock_gov);
+    display_pipeline_set_heatmap(&coverage);
+    menu_init(&menu, &menu_root);
+    menu_sync(time_us_32());
+    display_pipeline_set_menu(&menu);
+    display_pipeline_set_background(recorder_service);
+    display_pipeline_start(&ssd, &telemetry_main);
+    flash_safe_execute_core_init(); // O núcleo 1 pausa este nas operações na flash; a captura do joystick segue por DMA
 
-        // Se o controle do LED não estiver sobreposto, ajusta as intensidades do LED com base no joystick
-        if(!led_control_override)
-        {
-            adj_led_red_pwm_value = adjust_pwm_led_value(joystick_vrx);
-            adj_led_blue_pwm_value = adjust_pwm_led_value(joystick_vry);
-            pwm_set_gpio_level(BLUE_PIN, adj_led_blue_pwm_value);
-            pwm_set_gpio_level(RED_PIN, adj_led_red_pwm_value);
-        }
+    // Núcleo 0: tarefas de taxa fixa, sem esperar pelo display. A amostragem a 1 kHz
+    // continua na interrupção do temporizador, que a HID também consome.
+    sched_init(&sched_core0);
+    sched_add(&sched_core0, "input", input_task, NULL, INPUT_PERIOD_US, 0, 0);
+    sched_add(&sched_core0, "led", led_task, NULL, LED_PERIOD_US, 0, INPUT_PERIOD_US / 2);
+    sched_add(&sched_core0, "console", console_task, NULL, CONSOLE_PERIOD_US, 0, INPUT_PERIOD_US / 4);
+    sched_run(&sched_core0);
 
-        sleep_ms(100);  ///< Pequeno atraso para suavizar as leituras.
-    }
-    
     return EXIT_SUCCESS;
 }
 
 /**
  * @brief Normaliza um valor do joystick para a escala do display.
  *
+ * Sem divisão: cada posição recebe a mesma fatia da faixa do ADC (pixaddr_map),
+ * pelo interpolador com JOYTRACKER_INTERP.
+ *
  * @param joystick_vr Valor lido do joystick (0-4095).
  * @param new_max Valor máximo desejado para normalização.
  * @return Valor normalizado dentro da nova faixa.
  */
 static uint16_t normalize_joystick_to_display(uint16_t joystick_vr, uint8_t new_max)
 {
-    return (joystick_vr * new_max) / 4095;
+    return pixaddr_map(joystick_vr, new_max, PIXADDR_USE_INTERP);
+}
+
+/**
+ * @brief Prepara o sequenciador por DMA e o efeito exibido durante a sobreposição.
+ *
+ * O sequenciador controla o slice do LED azul (compartilhado com o vermelho no
+ * BitDogLab); os canais de outros slices continuam com o tarefa dos LEDs.
+ */
+static void led_effects_init(void)
+{
+    uint slice = rgb.slice[BLUE];
+    uint8_t peak[2] = {0, 0};
+
+    led_seq_pacer_init(LED_SEQ_PACER_SLICE, LED_SEQ_STEP_HZ);
+    led_seq_ready = led_seq_init(&led_seq, slice, LED_SEQ_PACER_SLICE);
+
+    for(uint i = 0; i < RGB_CHANNELS; i++)
+    {
+        if(rgb.slice[i] == slice) led_seq_free_mask &= (uint8_t) ~(1u << i);
+    }
+
+    peak[rgb.channel[BLUE]] = LED_BREATHE_PEAK;
+    led_wave_init(&override_wave, override_wave_storage, LED_BREATHE_STEPS, rgb.gamma);
+    led_wave_breathe(&override_wave, peak[0], peak[1], LED_BREATHE_STEPS);
+
+    led_dither_ready = rgb_dither_init(&dither, &rgb);
+    led_dither_enabled = led_dither_ready;
+}
+
+/**
+ * @brief Callback para os eventos de botão já filtrados pelo debounce.
+ *
+ * Roda em interrupção: apenas registra o evento na telemetria e o enfileira
+ * para a tarefa de entrada, sem tocar no framebuffer nem nos LEDs.
+ *
+ * @param event Evento de botão (pino, tipo e instante).
+ */
+static void button_event_callback(const pb_event_t *event)
+{
+    EVENT_TRACE_MARK(EVENT_TRACE_BUTTON, (uint16_t) (event->gpio << 8 | event->type));
+    telemetry_emit_button(&telemetry_buttons, event->timestamp_us, event->gpio, event->type);
+    recorder_event(event->timestamp_us, event->gpio, (uint8_t) event->type);
+    if(!spsc_ring_push(&button_events, event)) button_events_dropped++;
 }
 
 /**
- * @brief Callback para interrupções de botões e joystick.
+ * @brief Aplica um evento de botão ao estado do programa, entre quadros.
  *
- * Se o botão B for pressionado, entra no modo de boot USB.
- * Se o botão A for pressionado, desliga os LEDs e alterna `led_control_override`.
- * Se o botão do joystick for pressionado, alterna entre bordas finas e grossas no OLED.
+ * Se o botão B for mantido pressionado (pressionar longo), entra no modo de boot USB;
+ * o toque curto (ao soltar) abre o menu de configuração. Com o menu aberto, B volta
+ * à lista anterior (na raiz, fecha o menu) e A e o botão do joystick selecionam.
+ * Fora do menu:
+ * se o botão A for pressionado, desliga os LEDs e alterna `led_control_override`; durante a
+ * sobreposição, o LED azul "respira" por DMA, sem uso da CPU.
+ * Se o botão do joystick for pressionado, alterna entre bordas finas e grossas no OLED
+ * (o quadro é refeito pelo núcleo 1).
  *
- * @param gpio Pino que acionou a interrupção.
- * @param event Tipo de evento da interrupção.
+ * @param event Evento de botão retirado da fila.
  */
-static void gpio_irq_callback(uint gpio, uint32_t event)
+static void apply_button_event(const pb_event_t *event)
 {
-    if(pb_is_debounce_delay_over())
+    uint gpio = event->gpio;
+    bool menu_open = display_view == DISPLAY_VIEW_MENU;
+
+    if(BUTTON_B_PRESSED && event->type == PB_EVENT_LONG_PRESS)
     {
-        if(BUTTON_B_PRESSED) 
+        set_bootsel_mode();
+    }
+    else if(BUTTON_B_PRESSED && event->type == PB_EVENT_RELEASE)
+    {
+        // O pressionar longo não chega a soltar: o boot USB reinicia a placa antes
+        if(!menu_open)
+            set_menu_open(true);
+        else if(!menu_handle_key(&menu, MENU_KEY_BACK))
+            set_menu_open(false);
+    }
+    else if(event->type == PB_EVENT_PRESS)
+    {
+        if(menu_open)
         {
-            set_bootsel_mode();
+            if(BUTTON_A_PRESSED || JOYSTICK_SW_PRESSED) menu_handle_key(&menu, MENU_KEY_SELECT);
         }
         else if(BUTTON_A_PRESSED) 
         {
-            pwm_set_gpio_level(RED_PIN, 0);
-            pwm_set_gpio_level(BLUE_PIN, 0);
-            led_control_override = !led_control_override;
+            set_led_override(!led_control_override);
         }
         else if(JOYSTICK_SW_PRESSED)
         {
-            oledgfx_clear_screen(ssd_global);
-            if(led_green_active)
-            {
-                border_type = BORDER_LIGHT;
-                oledgfx_draw_border(ssd_global, BORDER_LIGHT);
-                pwm_set_gpio_level(GREEN_PIN, 0);
-            }
-            else
-            {
-                border_type = BORDER_THICK;
-                oledgfx_draw_border(ssd_global, BORDER_THICK);
-                pwm_set_gpio_level(GREEN_PIN, 1024);
-            }
-            led_green_active = !led_green_active;
+            // A troca de borda chega ao núcleo 1 no próximo estado publicado, que limpa a tela
+            set_border_thick(!led_green_active);
         }
     }
 }
 
+static void set_border_thick(bool thick)
+{
+    border_type = thick ? BORDER_THICK : BORDER_LIGHT;
+    led_color.green = thick ? LED_GREEN_LEVEL : 0;
+    led_green_active = thick;
+}
+
+static void set_led_override(bool enabled)
+{
+    if(enabled == led_control_override) return;
+    led_color.red = 0;
+    led_color.blue = 0;
+    led_control_override = enabled;
+
+    if(led_seq_ready)
+    {
+        if(led_control_override)
+        {
+            // O slice do efeito deixa de receber o padrão de dithering antes de ser assumido
+            if(led_dither_ready) rgb_dither_release(&dither, (uint8_t) ~led_seq_free_mask);
+            led_seq_play(&led_seq, NULL, &override_wave);
+        }
+        else
+        {
+            led_seq_stop(&led_seq);
+        }
+    }
+}
+
+static void set_led_dither(bool enabled)
+{
+    if(!led_dither_ready) return;
+    led_dither_enabled = enabled;
+    if(!led_dither_enabled) rgb_dither_release(&dither, RGB_MASK_ALL);
+}
+
+static void set_menu_open(bool open)
+{
+    if(open == (display_view == DISPLAY_VIEW_MENU)) return;
+    if(open)
+    {
+        display_view_before_menu = display_view;
+        display_view = DISPLAY_VIEW_MENU;
+    }
+    else
+    {
+        display_view = display_view_before_menu;
+    }
+}
+
+static void menu_apply_deadzone(menu_widget_t *widget)
+{
+    joystick_set_deadzone(&joy, (uint8_t) widget->value);
+}
+
+static void menu_apply_border(menu_widget_t *widget)
+{
+    set_border_thick(widget->value != 0);
+}
+
+static void menu_apply_dither(menu_widget_t *widget)
+{
+    set_led_dither(widget->value != 0);
+}
+
+static void menu_apply_override(menu_widget_t *widget)
+{
+    set_led_override(widget->value != 0);
+}
+
+static void menu_apply_predict(menu_widget_t *widget)
+{
+    predict_enabled = widget->value != 0;
+}
+
+static void menu_apply_clock_gov(menu_widget_t *widget)
+{
+    clock_gov_set_enabled(&clock_gov, widget->value != 0);
+}
+
+static void menu_apply_hid_mouse(menu_widget_t *widget)
+{
+    usb_hid_set_mode(widget->value != 0 ? HID_MODE_MOUSE : HID_MODE_GAMEPAD);
+}
+
+static void menu_sync(uint32_t now_us)
+{
+    static uint32_t labels_due_us = 0;
+
+    // Só as mudanças incrementam a revisão: o núcleo 1 redesenha apenas esses valores
+    menu_set_value(&menu_deadzone, joy.deadzone);
+    menu_set_value(&menu_border, border_type == BORDER_THICK);
+    menu_set_value(&menu_dither, led_dither_enabled);
+    menu_set_value(&menu_override, led_control_override);
+    menu_set_value(&menu_predict, predict_enabled);
+    menu_set_value(&menu_clock_gov, clock_gov.enabled);
+    menu_set_value(&menu_hid_mouse, usb_hid_get_mode() == HID_MODE_MOUSE);
+
+    // Os rótulos mudariam a cada quadro (e o contador de quadros, por causa deles): atualizados a 2 Hz
+    if((int32_t) (now_us - labels_due_us) < 0) return;
+    labels_due_us = now_us + MENU_LABEL_PERIOD_US;
+    menu_set_value(&menu_frames, (int32_t) display_pipeline_get_frame_count());
+    menu_set_value(&menu_clock_mhz, (int32_t) (clock_gov.levels_khz[clock_gov.level] / 1000u));
+    menu_set_value(&menu_latency, (int32_t) display_pipeline_get_latency_estimate());
+}
+
+/**
+ * @brief Converte a deflexão de um eixo do joystick em nível perceptual do LED.
+ *
+ * O brilho cresce com o afastamento do centro, em qualquer direção. Como o nível
+ * é perceptual, o brilho aparente cresce de forma linear com a deflexão.
+ *
+ * @param joystick_vr Valor do joystick (0-4095).
+ * @return Nível perceptual do LED (0-65535).
+ */
+static uint16_t joystick_to_led_level(uint16_t joystick_vr)
+{
+    uint32_t deflection = (joystick_vr >= 2048) ? joystick_vr - 2048u : 2048u - joystick_vr;
+    deflection <<= 5;
+    return (uint16_t) ((deflection > 65535u) ? 65535u : deflection);
+}
+
+/**
+ * @brief Tarefa de entrada: aplica os eventos de botão e publica o estado do display.
+ *
+ * Os eventos são aplicados antes da publicação, para que o próximo quadro já
+ * reflita a troca de borda. O núcleo 1 compõe o quadro quando o barramento estiver livre.
+ * Com o menu aberto, o joystick navega por ele (com repetição enquanto mantido).
+ * Com a predição ligada, o cursor é extrapolado pela latência input-to-photon
+ * estimada pelo núcleo 1; o instante publicado continua o da amostra.
+ *
+ * @param ctx Não utilizado.
+ * @param release_us Instante de liberação.
+ */
+static void input_task(void *ctx, uint32_t release_us)
+{
+    (void) ctx;
+    PROFILE_SCOPE(PROFILE_TASK_INPUT);
+    EVENT_TRACE_SCOPE(EVENT_TRACE_TASK_INPUT, 0);
+    pb_event_t event;
+    while(spsc_ring_pop(&button_events, &event))
+    {
+        apply_button_event(&event);
+    }
+
+    // Amostra mais recente do joystick, marcada com o instante da leitura
+    joystick_sample_t sample;
+    joystick_get_latest_sample(&latest_sample, &sample);
+    uint16_t x = sample.x, y = sample.y;
+    uint8_t limit_x = 127 - CURSOR_SIDE - border_type, limit_y = 63 - CURSOR_SIDE - border_type;
+    predict_add(&predictor, sample.x, sample.y, sample.timestamp_us);
+
+    if(display_view == DISPLAY_VIEW_MENU)
+    {
+        menu_key_t key = menu_nav_poll(&menu_nav, sample.x, sample.y, release_us);
+        if(key != MENU_KEY_NONE && !menu_handle_key(&menu, key)) set_menu_open(false);
+    }
+    menu_sync(release_us);
+    if(predict_enabled) predict_position(&predictor, display_pipeline_get_latency_estimate(), &x, &y);
+
+    display_state_t display_state;
+    display_state.cursor_x = normalize_joystick_to_display(x, limit_x);
+    display_state.cursor_y = (63 - CURSOR_SIDE) - normalize_joystick_to_display(y, limit_y);
+    // Com a predição, o marcador mostra a posição medida, centrado onde o cursor estaria sem ela
+    display_state.marker_x = normalize_joystick_to_display(sample.x, limit_x) + (CURSOR_SIDE - MARKER_SIDE) / 2;
+    display_state.marker_y = (63 - CURSOR_SIDE) - normalize_joystick_to_display(sample.y, limit_y) +
+                             (CURSOR_SIDE - MARKER_SIDE) / 2;
+    display_state.marker_visible = predict_enabled;
+    display_state.border = border_type;
+    display_state.view = display_view;
+    display_state.sample_timestamp_us = sample.timestamp_us;
+    display_pipeline_publish(&display_state);
+
+    // Transações I2C submetidas de interrupções (sensores), se o display não estiver enviando
+    if(ssd.bus != NULL) i2c_bus_service(ssd.bus);
+}
+
+/**
+ * @brief Tarefa dos LEDs: aplica a cor derivada do joystick.
+ *
+ * @param ctx Não utilizado.
+ * @param release_us Instante de liberação.
+ */
+static void led_task(void *ctx, uint32_t release_us)
+{
+    (void) ctx;
+    (void) release_us;
+    PROFILE_SCOPE(PROFILE_TASK_LED);
+    EVENT_TRACE_SCOPE(EVENT_TRACE_TASK_LED, 0);
+    // Se o controle do LED não estiver sobreposto, ajusta as intensidades do LED com base no joystick
+    if(!led_control_override)
+    {
+        joystick_sample_t sample;
+        joystick_get_latest_sample(&latest_sample, &sample);
+        led_color.red = joystick_to_led_level(sample.x);
+        led_color.blue = joystick_to_led_level(sample.y);
+    }
+
+    // Uma única atualização por período: vermelho e azul dividem o slice 6 e mudam juntos.
+    // Durante a sobreposição, esse slice pertence ao sequenciador.
+    uint8_t led_mask = (led_control_override && led_seq_ready) ? led_seq_free_mask : RGB_MASK_ALL;
+    if(led_dither_enabled)
+        rgb_dither_apply(&dither, led_color, led_mask);
+    else
+        rgb_set_color_masked(&rgb, rgb_color_from16(led_color), led_mask);
+}
+
+/**
+ * @brief Tarefa do console: atende um comando pendente.
+ *
+ * @param ctx Não utilizado.
+ * @param release_us Instante de liberação.
+ */
+static void console_task(void *ctx, uint32_t release_us)
+{
+    (void) ctx;
+    (void) release_us;
+    EVENT_TRACE_SCOPE(EVENT_TRACE_TASK_CONSOLE, 0);
+    console_poll();
+}
+
+/**
+ * @brief Atende comandos de um caractere recebidos pelo USB stdio, sem bloquear.
+ *
+ * Comandos disponíveis:
+ * - `l`: imprime a latência input-to-photon, a duração dos quadros, o atraso da interrupção de amostragem (mín/média/p99/máx)
+ *   e os contadores da camada de sprites.
+ * - `r`: zera os acumuladores de latência (incluindo o atraso de fila do barramento I2C).
+ * - `g`: interface HID em modo gamepad.
+ * - `m`: interface HID em modo mouse relativo.
+ * - `h`: imprime o modo HID e a quantidade de relatórios enviados.
+ * - `t`: imprime os contadores dos fluxos de telemetria.
+ * - `b`: imprime os eventos de botão pendentes e descartados.
+ * - `d`: liga/desliga o dithering dos LEDs e imprime a resolução e o custo medido.
+ * - `s`: imprime as estatísticas dos escalonadores dos dois núcleos.
+ * - `z`: zera as estatísticas dos escalonadores.
+ * - `p`: imprime o profiler por etapa (chamadas, ciclos médio/máximo e histograma).
+ * - `c`: zera o profiler.
+ * - `i`: imprime o custo dos últimos quadros no barramento I2C.
+ * - `x`: imprime o registro de transações I2C (formato de host/i2c_replay.c) e recomeça a captura.
+ * - `I`: imprime, por dispositivo do barramento I2C, a utilização, o atraso de fila e os prazos perdidos.
+ * - `f`: imprime o nível de clock, o tempo em cada nível e a verificação dos periféricos.
+ * - `e`: liga/desliga o governador de clock (desligado, fixa o nível mais alto).
+ * - `k`: inicia/encerra a gravação da sessão na flash.
+ * - `v`: imprime os contadores da gravação (bytes por segundo, páginas, operações na flash).
+ * - `u`: imprime as páginas gravadas na flash (formato de tools/recorder_decode.py).
+ * - `a`: alterna o OLED entre o cursor e o mapa de cobertura das posições.
+ * - `o`: imprime a cobertura: amostras, células alcançadas e células por nível.
+ * - `q`: zera o mapa de cobertura.
+ * - `w`: liga/desliga o espelhamento do framebuffer pela interface CDC de telemetria e imprime seus contadores.
+ * - `y`: registra 1 s de eventos na linha do tempo (requer `-DJOYTRACKER_EVENT_TRACE=ON`).
+ * - `j`: imprime a linha do tempo registrada (formato de tools/trace_to_chrome.py).
+ * - `n`: liga/desliga a predição da posição do cursor e imprime seus contadores.
+ * - `M`: abre/fecha o menu de configuração no OLED e imprime seus contadores.
+ *
+ * As impressões leem, sem trava, contadores atualizados pelo outro núcleo, por
+ * interrupções ou por quem conduz o barramento: os campos de uma mesma linha
+ * podem pertencer a quadros ou amostras vizinhos. Os que precisam de um
+ * instante coerente (os quadros do I2C) são copiados com o contador de
+ * sequência de i2c_trace.c.
+ */
+static void console_poll(void)
+{
+    int command = getchar_timeout_us(0);
+    switch(command)
+    {
+        case 'l':
+            display_pipeline_print_latency();
+            display_pipeline_print_sprites();
+            latency_print(&sampling_isr_latency, "sampling-isr");
+            printf("display: frames=%lu latencia_estimada=%luus\n", (unsigned long) display_pipeline_get_frame_count(),
+                   (unsigned long) display_pipeline_get_latency_estimate());
+            break;
+        case 'r':
+            display_pipeline_reset_latency();
+            sampling_isr_reset_requested = true;
+            if(i2c_bus_get(I2C_PORT) != NULL) i2c_bus_reset_stats(i2c_bus_get(I2C_PORT));
+            break;
+        case 'g':
+            usb_hid_set_mode(HID_MODE_GAMEPAD);
+            break;
+        case 'm':
+            usb_hid_set_mode(HID_MODE_MOUSE);
+            break;
+        case 'h':
+            printf("hid: mode=%s reports=%lu\n", usb_hid_get_mode() == HID_MODE_MOUSE ? "mouse" : "gamepad",
+                   (unsigned long) usb_hid_get_report_count());
+            break;
+        case 't':
+            telemetry_print_stats();
+            break;
+        case 'b':
+            printf("buttons: queued=%lu dropped=%lu\n", (unsigned long) spsc_ring_count(&button_events),
+                   (unsigned long) button_events_dropped);
+            break;
+        case 'd':
+            if(!led_dither_ready) break;
+            set_led_dither(!led_dither_enabled);
+            printf("dither: %s\n", led_dither_enabled ? "on" : "off");
+            rgb_dither_print_stats(&dither);
+            break;
+        case 's':
+            sched_print_stats(&sched_core0, "sched core0");
+            sched_print_stats(display_pipeline_get_sched(), "sched core1");
+            break;
+        case 'z':
+            sched_request_reset(&sched_core0);
+            sched_request_reset(display_pipeline_get_sched());
+            break;
+        case 'p':
+            profile_print();
+            break;
+        case 'c':
+            profile_reset();
+            break;
+        case 'i':
+            i2c_trace_print_summary();
+            break;
+        case 'x':
+            i2c_trace_dump();
+            i2c_trace_reset();
+            break;
+        case 'I':
+            if(i2c_bus_get(I2C_PORT) != NULL) i2c_bus_print_stats(i2c_bus_get(I2C_PORT));
+            break;
+        case 'f':
+            clock_gov_print(&clock_gov);
+            break;
+        case 'e':
+            clock_gov_set_enabled(&clock_gov, !clock_gov.enabled);
+            printf("clock: governador %s\n", clock_gov.enabled ? "on" : "off");
+            break;
+        case 'k':
+            if(recorder_is_recording())
+                recorder_stop();
+            else
+                recorder_start();
+            printf("rec: %s\n", recorder_is_recording() ? "gravando" : "parado");
+            break;
+        case 'v':
+            recorder_print_stats();
+            break;
+        case 'u':
+            recorder_dump();
+            break;
+        case 'a':
+            display_view = display_view == DISPLAY_VIEW_HEATMAP ? DISPLAY_VIEW_CURSOR : DISPLAY_VIEW_HEATMAP;
+            printf("display: %s\n", display_view == DISPLAY_VIEW_HEATMAP ? "heatmap" : "cursor");
+            break;
+        case 'o':
+            heatmap_print(&coverage);
+            break;
+        case 'q':
+            heatmap_request_reset(&coverage);
+            break;
+        case 'y':
+            event_trace_start(EVENT_TRACE_WINDOW_US);
+            printf("event_trace: %s\n", event_trace_is_active() ? "registrando" : "desativado");
+            break;
+        case 'j':
+            event_trace_dump();
+            break;
+        case 'w':
+            fb_mirror_set_enabled(!fb_mirror_is_enabled());
+            fb_mirror_print_stats();
+            break;
+        case 'n':
+            predict_enabled = !predict_enabled;
+            predict_print(&predictor, predict_enabled, display_pipeline_get_latency_estimate());
+            break;
+        case 'M':
+            set_menu_open(display_view != DISPLAY_VIEW_MENU);
+            menu_print_stats(&menu, display_view == DISPLAY_VIEW_MENU);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Callback do temporizador de amostragem: lê o joystick e publica a amostra.
+ *
+ * Roda a cada SAMPLE_PERIOD_US em interrupção, sendo o único ponto do programa
+ * que lê o joystick; os demais consumidores leem a amostra publicada. Entrega
+ * todas as amostras capturadas pelo DMA desde o disparo anterior: depois de uma
+ * operação na flash, que pausa este núcleo, são várias, cada uma com o instante
+ * da sua conversão. Também avança o debounce dos botões, que gera os eventos
+ * neste mesmo contexto.
+ *
+ * Na entrada, registra o atraso em relação ao instante programado (latência
+ * da interrupção, em us), impresso pelo comando `l`.
+ *
+ * @param rt Temporizador repetitivo; `user_data` aponta para o joystick.
+ * @return `true` para manter o temporizador ativo.
+ */
+static bool RAM_FUNC(sampling_timer_callback)(repeating_timer_t *rt)
+{
+    // Período negativo: cada disparo é programado a partir do anterior, sem acumular atraso
+    uint32_t now_us = time_us_32();
+    EVENT_TRACE_SCOPE(EVENT_TRACE_SAMPLING_ISR, 0);
+    if(sampling_isr_reset_requested)
+    {
+        latency_reset(&sampling_isr_latency);
+        sampling_isr_synced = false;
+        sampling_isr_reset_requested = false;
+    }
+    if(sampling_isr_synced)
+    {
+        int32_t late_us = (int32_t) (now_us - sampling_expected_us);
+        latency_record(&sampling_isr_latency, late_us > 0 ? (uint32_t) late_us : 0u);
+        sampling_expected_us += SAMPLE_PERIOD_US;
+    }
+    else
+    {
+        sampling_expected_us = now_us + SAMPLE_PERIOD_US;
+        sampling_isr_synced = true;
+    }
+
+    uint32_t pending = joystick_samples_pending();
+    for(uint32_t i = 0; i < pending; i++)
+    {
+        joystick_sample_t sample;
+        joystick_read_sample((const joystick_t *) rt->user_data, &sample);
+        joystick_publish_sample(&latest_sample, &sample);
+        recorder_sample(sample.timestamp_us, sample.x, sample.y);
+        heatmap_add(&coverage, sample.x, sample.y);
+        telemetry_emit_sample(&telemetry_sampler, TELEMETRY_RAW_SAMPLE, sample.timestamp_us, sample.raw_x,
+                              sample.raw_y);
+        telemetry_emit_sample(&telemetry_sampler, TELEMETRY_FILTERED_SAMPLE, sample.timestamp_us, sample.x, sample.y);
+    }
+    pb_debounce_poll(time_us_32());
+    return true;
+}
+
 /**
- * @brief Ajusta o valor do PWM do LED com base no movimento do joystick.
+ * @brief Fornece à interface HID a amostra mais recente e o estado dos botões.
  *
- * Se o joystick for movido para a direita, o brilho do LED diminui.
- * Se o joystick for movido para a esquerda, o brilho do LED aumenta gradualmente.
+ * Os botões usam o estado filtrado pelo debounce, atualizado a cada 1 ms.
  *
- * @param pwm_value Valor do joystick (0-4095).
- * @return Valor ajustado para o PWM (0-2048).
+ * @param input Leitura preenchida para o relatório HID.
  */
-static uint16_t adjust_pwm_led_value(uint16_t pwm_value)
+static void read_hid_input(hid_report_input_t *input)
 {
-    if(pwm_value >= 2048) 
-        return pwm_value - 2048;
-    else 
-        return 2048 - pwm_value;  ///< Ajusta o brilho gradualmente para a esquerda.
+    joystick_sample_t sample;
+    joystick_get_latest_sample(&latest_sample, &sample);
+    input->x = sample.x;
+    input->y = sample.y;
+    input->buttons = 0;
+    if(pb_debounce_is_pressed(BUTTON_A)) input->buttons |= HID_BUTTON_A;
+    if(pb_debounce_is_pressed(BUTTON_B)) input->buttons |= HID_BUTTON_B;
+    if(pb_debounce_is_pressed(JOYSTICK_PB)) input->buttons |= HID_BUTTON_JOYSTICK;
 }
@@ -0,0 +1,322 @@
+#include "bench.h"
+#include "bench_platform.h"
+#include "oledgfx.h"
+#include "pixaddr.h"
+#include "sprite.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file bench.c
+ * @brief Tabela de casos e medição das primitivas de desenho e do envio.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Limite de iterações de uma rodada, para primitivas vazias. */
+#define BENCH_MAX_ITERATIONS (1u << 24)
+
+typedef struct bench_case bench_case_t;
+
+/**
+ * @brief Executa uma vez a primitiva de um caso.
+ */
+typedef void (*bench_fn_t)(ssd1306_t *ssd, const bench_case_t *c);
+
+/**
+ * @brief Caso de benchmark: primitiva, argumentos e bytes tocados por chamada.
+ */
+struct bench_case
+{
+    const char *name;      /**< Identificador estável, usado na comparação entre execuções. */
+    bench_fn_t fn;         /**< Primitiva. */
+    uint8_t a, b, c, d;    /**< Argumentos (posição, tamanho ou extremos). */
+    uint32_t bytes_per_op; /**< Bytes do framebuffer (ou do barramento) por chamada. */
+    bool cold;             /**< Invalida a cache XIP antes de cada chamada. */
+};
+
+/** @brief Bytes de um retângulo de contorno: as quatro arestas, cantos repetidos. */
+#define BENCH_RECT_OUTLINE(w, h) (2u * (w) + 2u * (h))
+
+/** @brief Bytes de um retângulo preenchido: contorno mais o interior. */
+#define BENCH_RECT_FILLED(w, h) (BENCH_RECT_OUTLINE(w, h) + ((w) - 2u) * ((h) - 2u))
+
+/** @brief Trechos de um envio: o buffer dividido pelo gerenciador do barramento (i2c_bus.h). */
+#define BENCH_FLUSH_CHUNKS ((WIDTH * HEIGHT / 8u + OLED_BUS_CHUNK_BYTES - 2u) / (OLED_BUS_CHUNK_BYTES - 1u))
+
+/** @brief Bytes de um envio: 6 comandos de endereçamento (3 bytes cada) e o buffer, com endereço e byte de controle por trecho. */
+#define BENCH_FLUSH_BYTES (6u * 3u + WIDTH * HEIGHT / 8u + 2u * BENCH_FLUSH_CHUNKS)
+
+/** @brief Bitmap de 16x16 (duas páginas), para o blit. */
+static const uint8_t bench_sprite[2 * 16] =
+{
+    0x3C, 0x42, 0x81, 0xA5, 0x81, 0x99, 0x42, 0x3C, 0x3C, 0x42, 0x81, 0xA5, 0x81, 0x99, 0x42, 0x3C,
+    0x3C, 0x42, 0x81, 0xA5, 0x81, 0x99, 0x42, 0x3C, 0x3C, 0x42, 0x81, 0xA5, 0x81, 0x99, 0x42, 0x3C,
+};
+
+/** @brief Destino das leituras mapeadas, para que o compilador não descarte as chamadas. */
+static volatile uint16_t bench_sink;
+
+static void bench_fill(ssd1306_t *ssd, const bench_case_t *c)
+{
+    ssd1306_fill(ssd, c->a != 0);
+}
+
+static void bench_rect(ssd1306_t *ssd, const bench_case_t *c)
+{
+    ssd1306_rect(ssd, c->b, c->a, c->c, c->d, true, false);
+}
+
+static void bench_rect_filled(ssd1306_t *ssd, const bench_case_t *c)
+{
+    ssd1306_rect(ssd, c->b, c->a, c->c, c->d, true, true);
+}
+
+static void bench_line(ssd1306_t *ssd, const bench_case_t *c)
+{
+    ssd1306_line(ssd, c->a, c->b, c->c, c->d, true);
+}
+
+static void bench_cursor_draw(ssd1306_t *ssd, const bench_case_t *c)
+{
+    oledgfx_draw_cursor(ssd, c->a, c->b);
+}
+
+static void bench_cursor_update(ssd1306_t *ssd, const bench_case_t *c)
+{
+    oledgfx_update_cursor(ssd, c->a, c->b);
+}
+
+static void bench_border(ssd1306_t *ssd, const bench_case_t *c)
+{
+    oledgfx_draw_border(ssd, c->a);
+}
+
+/*
+ * Casos do endereçamento de pixels: `d` escolhe a versão (0, software; 1,
+ * interpolador). Os casos do interpolador só existem no build do RP2040.
+ */
+static void bench_span_h(ssd1306_t *ssd, const bench_case_t *c)
+{
+    pixaddr_span(ssd->ram_buffer, PIXADDR_PACK(c->a, c->b), PIXADDR_STEP_X, c->c, true, c->d != 0);
+}
+
+static void bench_span_v(ssd1306_t *ssd, const bench_case_t *c)
+{
+    pixaddr_span(ssd->ram_buffer, PIXADDR_PACK(c->a, c->b), PIXADDR_STEP_Y, c->c, true, c->d != 0);
+}
+
+static void bench_blit(ssd1306_t *ssd, const bench_case_t *c)
+{
+    pixaddr_blit(ssd->ram_buffer, c->a, c->b, bench_sprite, 16, c->c, true, c->d != 0);
+}
+
+static void bench_map(ssd1306_t *ssd, const bench_case_t *c)
+{
+    static uint16_t value;
+    (void) ssd;
+    value = (value + 257u) & 0xFFFu;
+    bench_sink = pixaddr_map(value, 127 - CURSOR_SIDE - c->a, c->d != 0);
+    bench_sink = pixaddr_map(4095u - value, 63 - CURSOR_SIDE - c->a, c->d != 0);
+}
+
+/*
+ * Casos da camada de sprites: `a` sprites 8x8 numa grade (cruzando fronteiras
+ * de página), dos quais `b`, espalhados pela grade, andam uma coluna por
+ * chamada, seguidos da composição. O tempo deve acompanhar `b`, não `a`; os
+ * bytes das áreas sujas dependem das sobreposições e são contados pela camada.
+ */
+static void bench_sprites(ssd1306_t *ssd, const bench_case_t *c)
+{
+    static sprite_layer_t layer;
+    static uint8_t layer_sprites;
+    static uint8_t phase;
+    ssd1306_window_t rects[4];
+
+    if(layer_sprites != c->a)
+    {
+        sprite_layer_init(&layer);
+        for(uint8_t i = 0; i < c->a; i++)
+        {
+            int id = sprite_add(&layer, oledgfx_cursor_bitmap, CURSOR_SIDE, 1, (int8_t) (i & 3u));
+            sprite_move(&layer, id, (uint8_t) ((i & 7u) * 16u), (uint8_t) ((i >> 3) * 16u + 4u));
+            sprite_set_visible(&layer, id, true);
+        }
+        ssd1306_fill(ssd, false);
+        sprite_layer_render(&layer, ssd, rects, 4);
+        layer_sprites = c->a;
+    }
+
+    phase ^= 1u;
+    for(uint8_t j = 0; j < c->b; j++)
+    {
+        uint8_t id = (uint8_t) (j * c->a / c->b);
+        sprite_move(&layer, id, (uint8_t) ((id & 7u) * 16u + phase), layer.sprites[id].y);
+    }
+    sprite_layer_render(&layer, ssd, rects, 4);
+}
+
+static void bench_nop(ssd1306_t *ssd, const bench_case_t *c)
+{
+    (void) ssd;
+    (void) c;
+}
+
+static void bench_flush(ssd1306_t *ssd, const bench_case_t *c)
+{
+    (void) c;
+    ssd1306_send_data(ssd);
+}
+
+/**
+ * @brief Casos medidos. Posições com y múltiplo de 8 ficam alinhadas às páginas
+ * do framebuffer; as demais cruzam uma fronteira de página.
+ *
+ * Os casos `_cold` invalidam a cache XIP antes de cada chamada, como acontece
+ * quando outro código ocupou a cache entre dois quadros: o tempo inclui o da
+ * invalidação, medido sozinho em `xip_flush`. A diferença para o caso quente
+ * é o custo das faltas na cache, que desaparece com JOYTRACKER_RAM_HOT_PATH.
+ */
+static const bench_case_t bench_cases[] =
+{
+    {"fill",                bench_fill,          1, 0, 0, 0,     WIDTH * HEIGHT, false},
+    {"rect_8x8",            bench_rect,          8, 8, 8, 8,     BENCH_RECT_OUTLINE(8, 8), false},
+    {"rect_32x16",          bench_rect,          40, 20, 32, 16, BENCH_RECT_OUTLINE(32, 16), false},
+    {"rect_128x64",         bench_rect,          0, 0, 128, 64,  BENCH_RECT_OUTLINE(128, 64), false},
+    {"rect_filled_8x8",     bench_rect_filled,   8, 8, 8, 8,     BENCH_RECT_FILLED(8, 8), false},
+    {"rect_filled_32x16",   bench_rect_filled,   40, 20, 32, 16, BENCH_RECT_FILLED(32, 16), false},
+    {"rect_filled_128x64",  bench_rect_filled,   0, 0, 128, 64,  BENCH_RECT_FILLED(128, 64), false},
+    {"line_h128",           bench_line,          0, 31, 127, 31, 128, false},
+    {"line_v64",            bench_line,          63, 0, 63, 63,  64, false},
+    {"line_diag",           bench_line,          0, 0, 127, 63,  128, false},
+    {"line_short8",         bench_line,          60, 28, 67, 31, 8, false},
+    {"cursor_draw_aligned", bench_cursor_draw,   60, 0, 0, 0,    64, false},
+    {"cursor_draw_offset",  bench_cursor_draw,   60, 4, 0, 0,    64, false},
+    {"cursor_update_aligned", bench_cursor_update, 60, 0, 0, 0,  128, false},
+    {"cursor_update_offset",  bench_cursor_update, 60, 4, 0, 0,  128, false},
+    {"border_1",            bench_border,        1, 0, 0, 0,     384, false},
+    {"border_3",            bench_border,        3, 0, 0, 0,     3 * 384, false},
+    {"flush",               bench_flush,         0, 0, 0, 0,     BENCH_FLUSH_BYTES, false},
+    {"span_h128_soft",      bench_span_h,        0, 31, 128, 0,  128, false},
+    {"span_v64_soft",       bench_span_v,        63, 0, 64, 0,   64, false},
+    {"blit_16x16_offset_soft", bench_blit,       60, 20, 2, 0,   48, false},
+    {"map_xy_soft",         bench_map,           BORDER_THICK, 0, 0, 0, 0, false},
+#if PIXADDR_HAVE_INTERP
+    {"span_h128_interp",    bench_span_h,        0, 31, 128, 1,  128, false},
+    {"span_v64_interp",     bench_span_v,        63, 0, 64, 1,   64, false},
+    {"blit_16x16_offset_interp", bench_blit,     60, 20, 2, 1,   48, false},
+    {"map_xy_interp",       bench_map,           BORDER_THICK, 0, 0, 1, 0, false},
+#endif
+    {"sprites_8_move1",     bench_sprites,       8, 1, 0, 0,     0, false},
+    {"sprites_32_move1",    bench_sprites,       32, 1, 0, 0,    0, false},
+    {"sprites_32_move8",    bench_sprites,       32, 8, 0, 0,    0, false},
+    {"sprites_32_move32",   bench_sprites,       32, 32, 0, 0,   0, false},
+    {"xip_flush",           bench_nop,           0, 0, 0, 0,     0, true},
+    {"line_diag_cold",      bench_line,          0, 0, 127, 63,  128, true},
+    {"rect_filled_32x16_cold", bench_rect_filled, 40, 20, 32, 16, BENCH_RECT_FILLED(32, 16), true},
+    {"cursor_update_offset_cold", bench_cursor_update, 60, 4, 0, 0, 128, true},
+    {"border_3_cold",       bench_border,        3, 0, 0, 0,     3 * 384, true},
+    {"flush_cold",          bench_flush,         0, 0, 0, 0,     BENCH_FLUSH_BYTES, true},
+};
+
+/**
+ * @brief Executa `iterations` chamadas e devolve o tempo gasto.
+ *
+ * @param ssd Display.
+ * @param c Caso.
+ * @param iterations Quantidade de chamadas.
+ * @return Duração em nanossegundos.
+ */
+static uint64_t bench_time(ssd1306_t *ssd, const bench_case_t *c, uint32_t iterations)
+{
+    uint64_t start_ns = bench_clock_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        if(c->cold) bench_platform_flush_cache();
+        c->fn(ssd, c);
+    }
+    return bench_clock_ns() - start_ns;
+}
+
+/**
+ * @brief Mede um caso e imprime sua linha CSV.
+ *
+ * Dobra as iterações até a rodada durar BENCH_MIN_TIME_NS e repete a rodada
+ * BENCH_REPEATS vezes com essa contagem, ficando com a mais rápida: as
+ * interrupções (USB, temporizadores) só podem aumentar o tempo medido.
+ *
+ * @param ssd Display.
+ * @param c Caso.
+ */
+static void bench_run_case(ssd1306_t *ssd, const bench_case_t *c)
+{
+    uint32_t iterations = 1;
+    uint64_t elapsed_ns = bench_time(ssd, c, iterations);
+    while(elapsed_ns < BENCH_MIN_TIME_NS && iterations < BENCH_MAX_ITERATIONS)
+    {
+        iterations *= 2u;
+        elapsed_ns = bench_time(ssd, c, iterations);
+    }
+
+    uint64_t best_ns = elapsed_ns;
+    for(uint r = 1; r < BENCH_REPEATS; r++)
+    {
+        elapsed_ns = bench_time(ssd, c, iterations);
+        if(elapsed_ns < best_ns) best_ns = elapsed_ns;
+    }
+
+    printf("%s,%s,%lu,%.1f,%lu\n", c->name, bench_platform_name(), (unsigned long) iterations,
+           (double) best_ns / iterations, (unsigned long) c->bytes_per_op);
+}
+
+#if PIXADDR_HAVE_INTERP
+/**
+ * @brief Confere as versões do interpolador com as em software.
+ *
+ * @return Resultados divergentes (mapeamentos e blits em todas as linhas).
+ */
+static uint32_t bench_check_interp(void)
+{
+    static uint8_t buffers[2][WIDTH * HEIGHT / 8u + 1u];
+    uint32_t mismatches = 0;
+
+    for(uint32_t value = 0; value < 4096u; value++)
+    {
+        if(pixaddr_map(value, 127 - CURSOR_SIDE, false) != pixaddr_map(value, 127 - CURSOR_SIDE, true)) mismatches++;
+        if(pixaddr_map(value, 63 - CURSOR_SIDE, false) != pixaddr_map(value, 63 - CURSOR_SIDE, true)) mismatches++;
+    }
+    for(uint8_t y = 0; y < HEIGHT; y++)
+    {
+        memset(buffers, 0, sizeof(buffers));
+        pixaddr_blit(buffers[0], WIDTH - 10, y, bench_sprite, 16, 2, true, false);
+        pixaddr_blit(buffers[1], WIDTH - 10, y, bench_sprite, 16, 2, true, true);
+        pixaddr_span(buffers[0], PIXADDR_PACK(0, y), PIXADDR_STEP_X + PIXADDR_STEP_Y, HEIGHT - y, true, false);
+        pixaddr_span(buffers[1], PIXADDR_PACK(0, y), PIXADDR_STEP_X + PIXADDR_STEP_Y, HEIGHT - y, true, true);
+        if(memcmp(buffers[0], buffers[1], sizeof(buffers[0])) != 0) mismatches++;
+    }
+    return mismatches;
+}
+#endif
+
+void bench_run_all(ssd1306_t *ssd)
+{
+    printf("# JoyTracker micro-benchmarks\n");
+    printf("# min_time_ms=%llu repeats=%u\n", (unsigned long long) (BENCH_MIN_TIME_NS / 1000000u),
+           (unsigned) BENCH_REPEATS);
+#if PIXADDR_HAVE_INTERP
+    printf("# pixaddr interp x software: divergencias=%lu\n", (unsigned long) bench_check_interp());
+#endif
+    printf("benchmark,platform,iterations,ns_per_op,bytes_per_op\n");
+
+    for(uint i = 0; i < sizeof(bench_cases) / sizeof(bench_cases[0]); i++)
+    {
+        ssd1306_fill(ssd, false);
+        bench_run_case(ssd, &bench_cases[i]);
+    }
+    printf("# fim\n");
+    fflush(stdout);
+}
@@ -0,0 +1,51 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "ssd1306.h"
+
+/**
+ * @file bench.h
+ * @brief Micro-benchmarks das primitivas de desenho e do envio do framebuffer.
+ *
+ * Cada caso chama uma primitiva com tamanho e posição fixos. O número de
+ * iterações dobra até que uma rodada dure ao menos BENCH_MIN_TIME_NS, e o
+ * resultado é o melhor de BENCH_REPEATS rodadas. A saída é CSV, uma linha por
+ * caso (linhas iniciadas por `#` são comentários):
+ *
+ *     benchmark,platform,iterations,ns_per_op,bytes_per_op
+ *
+ * `bytes_per_op` conta, nas primitivas de desenho, os bytes do framebuffer
+ * lidos e escritos (um por pixel, pois `ssd1306_pixel` altera um byte); no
+ * envio, os bytes que passam pelo barramento, incluindo os de endereço.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Bench Micro-benchmarks
+ * @brief Casos, medição e saída CSV.
+ * @{
+ */
+
+/** @brief Duração mínima de uma rodada. */
+#define BENCH_MIN_TIME_NS 20000000ull
+
+/** @brief Rodadas por caso; vale a mais rápida. */
+#define BENCH_REPEATS 5
+
+/**
+ * @brief Executa todos os casos e imprime os resultados em CSV pelo stdio.
+ *
+ * @param[in,out] ssd Display já inicializado; o framebuffer é sobrescrito.
+ */
+void bench_run_all(ssd1306_t *ssd);
+
+/** @} */ // Fim do grupo "Bench"
+
+#endif // BENCH_H
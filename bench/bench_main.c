@@ -0,0 +1,37 @@
+#include "bench.h"
+#include "bench_platform.h"
+#include "oledgfx.h"
+
+/**
+ * @file bench_main.c
+ * @brief Ponto de entrada dos micro-benchmarks (RP2040 ou build nativo).
+ *
+ * Inicializa o display como o firmware (i2c1, 400 kHz, SDA 14, SCL 15,
+ * endereço 0x3C) e executa os casos enquanto a plataforma pedir.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#define I2C_PORT i2c1
+#define OLED_SDA 14
+#define OLED_SCL 15
+#define OLED_ADDR 0x3C
+#define OLED_BAUDRATE 400000
+
+int main(void)
+{
+    ssd1306_t ssd;
+
+    bench_platform_init();
+    oledgfx_init_all(&ssd, I2C_PORT, OLED_BAUDRATE, OLED_SDA, OLED_SCL, OLED_ADDR);
+
+    do
+    {
+        bench_run_all(&ssd);
+    } while(bench_platform_repeat());
+    return 0;
+}
@@ -0,0 +1,48 @@
+#ifndef BENCH_PLATFORM_H
+#define BENCH_PLATFORM_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @file bench_platform.h
+ * @brief Pontos que diferem entre o benchmark no RP2040 e no build nativo.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @brief Prepara o stdio e o barramento do display.
+ */
+void bench_platform_init(void);
+
+/**
+ * @brief Relógio monotônico do benchmark, em nanossegundos.
+ */
+uint64_t bench_clock_ns(void);
+
+/**
+ * @brief Invalida a cache de instruções (XIP), para os casos medidos a frio.
+ *
+ * Sem cache de flash (build nativo), não faz nada.
+ */
+void bench_platform_flush_cache(void);
+
+/**
+ * @brief Nome da plataforma, gravado na coluna `platform`.
+ */
+const char *bench_platform_name(void);
+
+/**
+ * @brief Decide se os casos devem ser executados de novo.
+ *
+ * @return `true` para repetir.
+ */
+bool bench_platform_repeat(void);
+
+#endif // BENCH_PLATFORM_H
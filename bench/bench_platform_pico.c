@@ -0,0 +1,53 @@
+#include "bench_platform.h"
+#include "pico/stdio_usb.h"
+#include "hardware/structs/xip_ctrl.h"
+#include <stdio.h>
+
+/**
+ * @file bench_platform_pico.c
+ * @brief Plataforma do benchmark no RP2040: resultados pela CDC do USB.
+ *
+ * Espera o terminal abrir a porta antes da primeira rodada e, ao fim de cada
+ * rodada, aguarda a tecla `r` para repetir.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+void bench_platform_init(void)
+{
+    stdio_init_all();
+    while(!stdio_usb_connected())
+        sleep_ms(100);
+    sleep_ms(500); // Tempo para o terminal começar a ler
+}
+
+uint64_t bench_clock_ns(void)
+{
+    return time_us_64() * 1000u;
+}
+
+void bench_platform_flush_cache(void)
+{
+    xip_ctrl_hw->flush = 1;
+    (void) xip_ctrl_hw->flush; // A leitura só retorna ao fim da invalidação
+}
+
+const char *bench_platform_name(void)
+{
+    return "rp2040";
+}
+
+bool bench_platform_repeat(void)
+{
+    printf("# pressione 'r' para repetir\n");
+    int c;
+    do
+    {
+        c = getchar();
+    } while(c != 'r');
+    return true;
+}
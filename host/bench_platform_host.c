@@ -0,0 +1,51 @@
+#include "bench_platform.h"
+#include "sim.h"
+#include "sim_ssd1306.h"
+#include <time.h>
+
+/**
+ * @file bench_platform_host.c
+ * @brief Plataforma do benchmark no build nativo.
+ *
+ * O relógio soma o tempo real do processo ao tempo virtual da simulação: as
+ * primitivas de desenho custam só tempo real, e o envio custa o tempo do
+ * barramento simulado (a 400 kHz), que é o que limita a taxa de quadros no
+ * hardware. Os números de desenho refletem a CPU do computador, não a do RP2040;
+ * sirvem para comparar execuções na mesma máquina.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+static sim_ssd1306_t bench_oled;
+
+void bench_platform_init(void)
+{
+    sim_init(UINT64_MAX, NULL);
+    sim_ssd1306_init(&bench_oled);
+    sim_i2c_attach(i2c1, 0x3C, sim_ssd1306_write, &bench_oled);
+}
+
+uint64_t bench_clock_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec + time_us_64() * 1000u;
+}
+
+void bench_platform_flush_cache(void)
+{
+}
+
+const char *bench_platform_name(void)
+{
+    return "host";
+}
+
+bool bench_platform_repeat(void)
+{
+    return false;
+}
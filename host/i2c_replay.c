@@ -0,0 +1,238 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sim.h"
+#include "sim_ssd1306.h"
+#include "ssd1306.h"
+#include "i2c_trace.h"
+
+/**
+ * @file i2c_replay.c
+ * @brief Reproduz um registro de transações I2C (i2c_trace.h) em um SSD1306 simulado.
+ *
+ * Lê o registro gravado pelo build nativo (`joytracker_sim -I`) ou impresso
+ * pela placa (comando `x` do console), alimenta o controlador simulado com as
+ * transações do endereço do display e, a cada quadro, imprime em CSV o custo
+ * no barramento e um hash da imagem visível:
+ *
+ *     frame,t_us,transactions,control_bytes,command_bytes,data_bytes,bus_us,image_hash
+ *
+ * Dois registros de estratégias de envio diferentes produzem as mesmas
+ * imagens se a sequência de hashes for igual (descontando quadros repetidos);
+ * o custo por quadro mostra o ganho. Linhas que não seguem o formato (eco do
+ * terminal, outras saídas do console) são ignoradas.
+ *
+ * Uso:
+ *
+ *     i2c_replay [-a endereço] [-b taxa] [-r] [-f dir_quadros] [-o ultimo.pbm] registro.txt
+ *
+ * `-b` recalcula o tempo de barramento em outra taxa; por padrão vale a do registro.
+ *
+ * O registro da placa guarda só as últimas transações, sem a configuração
+ * inicial do painel; por isso o controlador simulado parte do estado deixado
+ * por `ssd1306_config` (o próprio driver é executado sobre o barramento
+ * simulado). `-r` parte do estado de reset.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Endereço padrão do OLED. */
+#define REPLAY_DEFAULT_ADDR 0x3C
+
+/** @brief Taxa assumida se o registro não informar nenhuma. */
+#define REPLAY_DEFAULT_BAUD 400000
+
+/**
+ * @brief Hash FNV-1a da imagem visível, pixel a pixel.
+ *
+ * @param display Controlador.
+ * @return Hash de 32 bits.
+ */
+static uint32_t replay_image_hash(const sim_ssd1306_t *display)
+{
+    uint32_t hash = 2166136261u;
+    for(uint y = 0; y < SIM_SSD1306_HEIGHT; y++)
+    {
+        for(uint x = 0; x < SIM_SSD1306_WIDTH; x += 8)
+        {
+            uint8_t bits = 0;
+            for(uint k = 0; k < 8; k++)
+                bits |= (uint8_t) (sim_ssd1306_get_pixel(display, x + k, y) << k);
+            hash = (hash ^ bits) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+/**
+ * @brief Converte os bytes em hexadecimal de uma linha do registro.
+ *
+ * @param hex Texto (termina no primeiro caractere que não é hexadecimal).
+ * @param[out] out Bytes.
+ * @param capacity Capacidade de `out`.
+ * @return Quantidade de bytes, ou -1 se o texto for inválido.
+ */
+static long replay_parse_hex(const char *hex, uint8_t *out, size_t capacity)
+{
+    size_t count = 0;
+    while(isxdigit((unsigned char) hex[0]))
+    {
+        if(count >= capacity || !isxdigit((unsigned char) hex[1])) return -1;
+        char digits[3] = {hex[0], hex[1], '\0'};
+        out[count++] = (uint8_t) strtoul(digits, NULL, 16);
+        hex += 2;
+    }
+    return (long) count;
+}
+
+/**
+ * @brief Configura o controlador como o firmware, executando o driver sobre o barramento simulado.
+ *
+ * @param oled Controlador.
+ * @param address Endereço do display.
+ */
+static void replay_configure(sim_ssd1306_t *oled, uint8_t address)
+{
+    ssd1306_t ssd;
+    sim_init(UINT64_MAX, NULL);
+    sim_i2c_attach(i2c1, address, sim_ssd1306_write, oled);
+    i2c_init(i2c1, REPLAY_DEFAULT_BAUD);
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, address, i2c1);
+    ssd1306_config(&ssd);
+    free(ssd.ram_buffer);
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t address = REPLAY_DEFAULT_ADDR;
+    uint baud_override = 0;
+    const char *frames_dir = NULL;
+    const char *last_frame_path = NULL;
+    bool from_reset = false;
+    int opt;
+
+    while((opt = getopt(argc, argv, "a:b:rf:o:h")) != -1)
+    {
+        switch(opt)
+        {
+            case 'a':
+                address = (uint8_t) strtoul(optarg, NULL, 0);
+                break;
+            case 'b':
+                baud_override = (uint) strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                from_reset = true;
+                break;
+            case 'f':
+                frames_dir = optarg;
+                break;
+            case 'o':
+                last_frame_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "uso: %s [-a endereco] [-b taxa] [-r] [-f dir_quadros] [-o ultimo.pbm] registro.txt\n",
+                        argv[0]);
+                return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if(optind >= argc)
+    {
+        fprintf(stderr, "%s: informe o registro\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *file = strcmp(argv[optind], "-") == 0 ? stdin : fopen(argv[optind], "r");
+    if(file == NULL)
+    {
+        perror(argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    static sim_ssd1306_t oled;
+    static uint8_t payload[I2C_TRACE_BUFFER_SIZE];
+    sim_ssd1306_init(&oled);
+    if(!from_reset) replay_configure(&oled, address);
+
+    uint baud = REPLAY_DEFAULT_BAUD;
+    i2c_trace_frame_t frame = {0}, total = {0};
+    i2c_trace_window_t window = {0};
+    uint32_t frames = 0, transactions = 0, skipped = 0, worst_us = 0;
+    char *line = NULL;
+    size_t line_capacity = 0;
+
+    printf("frame,t_us,transactions,control_bytes,command_bytes,data_bytes,bus_us,image_hash\n");
+    while(getline(&line, &line_capacity, file) != -1)
+    {
+        unsigned recorded_baud;
+        if(sscanf(line, "# i2c_trace baud=%u", &recorded_baud) == 1)
+        {
+            if(recorded_baud != 0) baud = recorded_baud;
+            continue;
+        }
+
+        unsigned long t_us;
+        unsigned addr;
+        char flags[4];
+        int offset;
+        if(sscanf(line, "%lu %2x %3s %n", &t_us, &addr, flags, &offset) != 3) continue;
+        if((flags[0] != 'S' && flags[0] != 'N') || flags[1] == '+')
+        {
+            skipped++; // Transação truncada: não dá para reproduzir
+            continue;
+        }
+        long len = replay_parse_hex(line + offset, payload, sizeof(payload));
+        if(len < 0 || addr != address)
+        {
+            skipped++;
+            continue;
+        }
+
+        transactions++;
+        sim_ssd1306_write(&oled, payload, (size_t) len, flags[0] == 'N');
+        if(!i2c_trace_account(&frame, &window, payload, (size_t) len)) continue;
+
+        uint bus_baud = baud_override ? baud_override : baud;
+        uint32_t bus_us = i2c_trace_bits_to_us(frame.bus_bits, bus_baud);
+        printf("%lu,%lu,%lu,%lu,%lu,%lu,%lu,%08lx\n", (unsigned long) frames, t_us,
+               (unsigned long) frame.transactions, (unsigned long) frame.control_bytes,
+               (unsigned long) frame.command_bytes, (unsigned long) frame.data_bytes, (unsigned long) bus_us,
+               (unsigned long) replay_image_hash(&oled));
+
+        if(frames_dir != NULL)
+        {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/frame_%05lu.pbm", frames_dir, (unsigned long) frames);
+            if(!sim_ssd1306_write_pbm(&oled, path)) perror(path);
+        }
+
+        total.transactions += frame.transactions;
+        total.command_bytes += frame.command_bytes;
+        total.data_bytes += frame.data_bytes;
+        total.bus_bits += frame.bus_bits;
+        if(bus_us > worst_us) worst_us = bus_us;
+        memset(&frame, 0, sizeof(frame));
+        frames++;
+    }
+    free(line);
+    if(file != stdin) fclose(file);
+
+    uint bus_baud = baud_override ? baud_override : baud;
+    fprintf(stderr, "replay: transacoes=%lu ignoradas=%lu quadros=%lu baud=%u\n", (unsigned long) transactions,
+            (unsigned long) skipped, (unsigned long) frames, bus_baud);
+    if(frames > 0)
+    {
+        fprintf(stderr, "replay: por quadro: transacoes=%lu comando=%lu dados=%lu barramento=%luus (pior %luus)\n",
+                (unsigned long) (total.transactions / frames), (unsigned long) (total.command_bytes / frames),
+                (unsigned long) (total.data_bytes / frames),
+                (unsigned long) (i2c_trace_bits_to_us(total.bus_bits, bus_baud) / frames), (unsigned long) worst_us);
+    }
+    if(last_frame_path != NULL && !sim_ssd1306_write_pbm(&oled, last_frame_path)) perror(last_frame_path);
+    return EXIT_SUCCESS;
+}
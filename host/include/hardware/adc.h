@@ -0,0 +1,41 @@
+#ifndef SIM_HARDWARE_ADC_H
+#define SIM_HARDWARE_ADC_H
+
+/**
+ * @file adc.h
+ * @brief ADC simulado: cada canal devolve o valor injetado pelo simulador (sim.h).
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include "pico/types.h"
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint adc_get_selected_input(void);
+uint16_t adc_read(void);
+
+/** @brief DREQ do FIFO do ADC. */
+#define DREQ_ADC 36u
+
+typedef struct
+{
+    volatile uint32_t fifo;
+} adc_hw_t;
+
+extern adc_hw_t *const adc_hw;
+
+/** @brief Conversão contínua para o DMA: sem canais livres no simulador, a captura nunca a liga. */
+void adc_set_round_robin(uint input_mask);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_set_clkdiv(float clkdiv);
+void adc_run(bool run);
+
+#endif // SIM_HARDWARE_ADC_H
@@ -0,0 +1,49 @@
+#ifndef SIM_HARDWARE_CLOCKS_H
+#define SIM_HARDWARE_CLOCKS_H
+
+/**
+ * @file clocks.h
+ * @brief Clocks simulados: `clk_sys` e `clk_peri` seguem `set_sys_clock_khz`; os demais são fixos.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include "pico/types.h"
+
+enum clock_index
+{
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+    clk_rtc,
+    CLK_COUNT
+};
+
+/** @brief Fonte do contador de frequência para `clk_sys`. */
+#define CLOCKS_FC0_SRC_VALUE_CLK_SYS 0x09u
+
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+/**
+ * @brief Contador de frequência: devolve a frequência registrada de `clk_sys`, em kHz.
+ */
+uint32_t frequency_count_khz(uint src);
+
+/**
+ * @brief Registra a nova frequência do sistema (não altera a velocidade da simulação).
+ */
+bool set_sys_clock_khz(uint32_t freq_khz, bool required);
+
+#endif // SIM_HARDWARE_CLOCKS_H
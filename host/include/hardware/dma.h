@@ -0,0 +1,81 @@
+#ifndef SIM_HARDWARE_DMA_H
+#define SIM_HARDWARE_DMA_H
+
+/**
+ * @file dma.h
+ * @brief DMA simulado: sem canais livres, os módulos que dependem de DMA caem no caminho por CPU.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include "pico/types.h"
+
+#define NUM_DMA_CHANNELS 12
+
+typedef struct
+{
+    uint32_t ctrl;
+} dma_channel_config;
+
+enum dma_channel_transfer_size
+{
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2
+};
+
+typedef struct
+{
+    volatile uint32_t read_addr;
+    volatile uint32_t write_addr;
+    volatile uint32_t transfer_count;
+    volatile uint32_t ctrl_trig;
+    volatile uint32_t al1_ctrl;
+    volatile uint32_t al1_read_addr;
+    volatile uint32_t al1_write_addr;
+    volatile uint32_t al1_transfer_count_trig;
+    volatile uint32_t al2_ctrl;
+    volatile uint32_t al2_transfer_count;
+    volatile uint32_t al2_read_addr;
+    volatile uint32_t al2_write_addr_trig;
+    volatile uint32_t al3_ctrl;
+    volatile uint32_t al3_write_addr;
+    volatile uint32_t al3_transfer_count;
+    volatile uint32_t al3_read_addr_trig;
+} dma_channel_hw_t;
+
+typedef struct
+{
+    dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+} dma_hw_t;
+
+extern dma_hw_t *const dma_hw;
+
+/** @return Sempre -1 (nenhum canal livre); com `required`, encerra a simulação. */
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(uint channel);
+
+dma_channel_config dma_channel_get_default_config(uint channel);
+dma_channel_config dma_get_channel_config(uint channel);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size);
+void channel_config_set_read_increment(dma_channel_config *c, bool incr);
+void channel_config_set_write_increment(dma_channel_config *c, bool incr);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to);
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits);
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger);
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger);
+void dma_channel_abort(uint channel);
+bool dma_channel_is_busy(uint channel);
+
+#endif // SIM_HARDWARE_DMA_H
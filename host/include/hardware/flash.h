@@ -0,0 +1,39 @@
+#ifndef SIM_HARDWARE_FLASH_H
+#define SIM_HARDWARE_FLASH_H
+
+/**
+ * @file flash.h
+ * @brief Flash simulada: memória de 2 MB mapeada no lugar do XIP.
+ *
+ * Apagar leva um setor a 0xFF e gravar só zera bits, como na flash real; as
+ * duas operações custam o tempo típico do W25Q16 da placa (sim_flash.c).
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include "pico/types.h"
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+
+#ifndef PICO_FLASH_SIZE_BYTES
+#define PICO_FLASH_SIZE_BYTES (2u * 1024u * 1024u)
+#endif
+
+/** @brief Conteúdo da flash simulada. */
+extern uint8_t sim_flash_memory[PICO_FLASH_SIZE_BYTES];
+
+/** @brief Janelas do XIP: no simulador, todas apontam para a mesma memória. */
+#define XIP_BASE ((uintptr_t) sim_flash_memory)
+#define XIP_NOCACHE_NOALLOC_BASE ((uintptr_t) sim_flash_memory)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#endif // SIM_HARDWARE_FLASH_H
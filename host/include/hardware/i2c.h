@@ -0,0 +1,45 @@
+#ifndef SIM_HARDWARE_I2C_H
+#define SIM_HARDWARE_I2C_H
+
+/**
+ * @file i2c.h
+ * @brief I2C simulado: transações entregues a dispositivos virtuais e cobradas em tempo de barramento.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include "pico/types.h"
+
+typedef struct i2c_inst i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+/** @brief Índice da instância (0 ou 1), como no SDK. */
+static inline uint i2c_hw_index(i2c_inst_t *i2c)
+{
+    return i2c == i2c1 ? 1u : 0u;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+void i2c_deinit(i2c_inst_t *i2c);
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate);
+
+/**
+ * @brief Escreve `len` bytes no dispositivo `addr`, bloqueando o núcleo pelo tempo do envio.
+ *
+ * @return Bytes escritos, ou `PICO_ERROR_GENERIC` se nenhum dispositivo responder.
+ */
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+
+#endif // SIM_HARDWARE_I2C_H
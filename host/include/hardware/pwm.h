@@ -0,0 +1,91 @@
+#ifndef SIM_HARDWARE_PWM_H
+#define SIM_HARDWARE_PWM_H
+
+/**
+ * @file pwm.h
+ * @brief PWM simulado: registradores em memória e registro das mudanças de nível por pino.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include "pico/types.h"
+
+#define NUM_PWM_SLICES 8
+
+#define PWM_CH0_CSR_EN_BITS 0x00000001u
+#define PWM_CH0_CC_A_LSB 0u
+#define PWM_CH0_CC_A_BITS 0x0000ffffu
+#define PWM_CH0_CC_B_LSB 16u
+#define PWM_CH0_CC_B_BITS 0xffff0000u
+#define PWM_CH0_DIV_INT_LSB 4u
+
+#define DREQ_PWM_WRAP0 24u
+
+enum pwm_chan
+{
+    PWM_CHAN_A = 0,
+    PWM_CHAN_B = 1
+};
+
+typedef struct
+{
+    volatile uint32_t csr;
+    volatile uint32_t div;
+    volatile uint32_t ctr;
+    volatile uint32_t cc;
+    volatile uint32_t top;
+} pwm_slice_hw_t;
+
+typedef struct
+{
+    pwm_slice_hw_t slice[NUM_PWM_SLICES];
+} pwm_hw_t;
+
+extern pwm_hw_t *const pwm_hw;
+
+typedef struct
+{
+    uint32_t csr;
+    uint32_t div;
+    uint32_t top;
+} pwm_config;
+
+/**
+ * @brief Escrita mascarada em um registrador; nos registradores do PWM, registra a mudança.
+ */
+void hw_write_masked(volatile uint32_t *addr, uint32_t values, uint32_t write_mask);
+
+static inline uint pwm_gpio_to_slice_num(uint gpio)
+{
+    return (gpio >> 1u) & 7u;
+}
+
+static inline uint pwm_gpio_to_channel(uint gpio)
+{
+    return gpio & 1u;
+}
+
+static inline uint pwm_get_dreq(uint slice_num)
+{
+    return DREQ_PWM_WRAP0 + slice_num;
+}
+
+pwm_config pwm_get_default_config(void);
+void pwm_config_set_clkdiv(pwm_config *c, float div);
+void pwm_config_set_clkdiv_int(pwm_config *c, uint div);
+void pwm_config_set_wrap(pwm_config *c, uint16_t wrap);
+void pwm_init(uint slice_num, pwm_config *c, bool start);
+void pwm_set_clkdiv(uint slice_num, float divider);
+void pwm_set_wrap(uint slice_num, uint16_t wrap);
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level);
+void pwm_set_both_levels(uint slice_num, uint16_t level_a, uint16_t level_b);
+void pwm_set_gpio_level(uint gpio, uint16_t level);
+void pwm_set_enabled(uint slice_num, bool enabled);
+
+#endif // SIM_HARDWARE_PWM_H
@@ -0,0 +1,71 @@
+#ifndef SIM_HARDWARE_SYNC_H
+#define SIM_HARDWARE_SYNC_H
+
+/**
+ * @file sync.h
+ * @brief Primitivas de sincronização: no simulador apenas um núcleo executa por vez.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include "pico/types.h"
+
+/** @brief Dorme até um evento; no simulador, cede o núcleo por 1 us. */
+void __wfe(void);
+void __wfi(void);
+
+static inline void __sev(void)
+{
+}
+
+static inline void __dmb(void)
+{
+    __sync_synchronize();
+}
+
+static inline uint32_t save_and_disable_interrupts(void)
+{
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t status)
+{
+    (void) status;
+}
+
+uint get_core_num(void);
+
+/**
+ * @brief Spin lock de hardware.
+ *
+ * Só um núcleo simulado executa por vez e as seções críticas não chamam nada
+ * que ceda o núcleo: a trava apenas registra a posse.
+ */
+typedef volatile uint32_t spin_lock_t;
+
+/** @brief Trava de número `lock_num` (0 - 31). */
+spin_lock_t *spin_lock_instance(uint lock_num);
+
+/** @brief Reserva uma trava livre; devolve o número ou -1. */
+int spin_lock_claim_unused(bool required);
+
+static inline uint32_t spin_lock_blocking(spin_lock_t *lock)
+{
+    uint32_t status = save_and_disable_interrupts();
+    *lock = 1;
+    return status;
+}
+
+static inline void spin_unlock(spin_lock_t *lock, uint32_t status)
+{
+    *lock = 0;
+    restore_interrupts(status);
+}
+
+#endif // SIM_HARDWARE_SYNC_H
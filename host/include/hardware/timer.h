@@ -0,0 +1,34 @@
+#ifndef SIM_HARDWARE_TIMER_H
+#define SIM_HARDWARE_TIMER_H
+
+/**
+ * @file timer.h
+ * @brief Contador de microssegundos do relógio virtual.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include "pico/types.h"
+
+uint64_t time_us_64(void);
+
+static inline uint32_t time_us_32(void)
+{
+    return (uint32_t) time_us_64();
+}
+
+/** @brief Espera ativa: no simulador, o núcleo cede o tempo aos demais. */
+void busy_wait_us(uint64_t us);
+
+static inline void busy_wait_us_32(uint32_t us)
+{
+    busy_wait_us(us);
+}
+
+#endif // SIM_HARDWARE_TIMER_H
@@ -0,0 +1,21 @@
+#ifndef SIM_PICO_MULTICORE_H
+#define SIM_PICO_MULTICORE_H
+
+/**
+ * @file multicore.h
+ * @brief Núcleo 1 simulado por uma thread que executa alternadamente com o núcleo 0.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include "pico/types.h"
+
+void multicore_launch_core1(void (*entry)(void));
+
+#endif // SIM_PICO_MULTICORE_H
@@ -0,0 +1,49 @@
+#ifndef SIM_PICO_STDLIB_H
+#define SIM_PICO_STDLIB_H
+
+/**
+ * @file stdlib.h
+ * @brief Substituto do `pico/stdlib.h` para o build nativo (HAL simulada).
+ *
+ * Reúne os mesmos módulos do SDK (tipos, GPIO, tempo e stdio). O stdio de
+ * saída é o `stdout` do processo; a entrada vem das teclas injetadas pelo
+ * simulador (sim.h).
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include <stdio.h>
+#include "pico/types.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+#define PICO_OK 0
+#define PICO_ERROR_NONE 0
+#define PICO_ERROR_TIMEOUT (-1)
+#define PICO_ERROR_GENERIC (-2)
+
+#define __not_in_flash(group)
+#define __not_in_flash_func(func_name) func_name
+#define __time_critical_func(func_name) func_name
+#define __no_inline_not_in_flash_func(func_name) __attribute__((noinline)) func_name
+
+static inline void tight_loop_contents(void)
+{
+}
+
+bool stdio_init_all(void);
+
+/**
+ * @brief Lê um caractere injetado pelo simulador.
+ *
+ * @return O caractere, ou `PICO_ERROR_TIMEOUT` se não houver nenhum pendente.
+ */
+int getchar_timeout_us(uint32_t timeout_us);
+
+#endif // SIM_PICO_STDLIB_H
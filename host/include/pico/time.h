@@ -0,0 +1,83 @@
+#ifndef SIM_PICO_TIME_H
+#define SIM_PICO_TIME_H
+
+/**
+ * @file time.h
+ * @brief Relógio, esperas e temporizadores repetitivos sobre o relógio virtual.
+ *
+ * As esperas bloqueiam apenas o núcleo que chama: o tempo virtual avança quando
+ * todos os núcleos estão esperando, e os temporizadores disparam nesse avanço,
+ * como interrupções.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include "pico/types.h"
+#include "hardware/timer.h"
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+
+/** @brief Temporizador repetitivo (mesmos campos usados pelo pico-sdk). */
+struct repeating_timer
+{
+    int64_t delay_us;                    /**< Período; negativo = entre inícios de callback. */
+    int32_t alarm_id;                    /**< Identificador do agendamento ativo (0 = cancelado). */
+    repeating_timer_callback_t callback; /**< Callback. */
+    void *user_data;                     /**< Contexto do usuário. */
+};
+
+static inline absolute_time_t get_absolute_time(void)
+{
+    return time_us_64();
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t)
+{
+    return (uint32_t) (t / 1000u);
+}
+
+static inline uint64_t to_us_since_boot(absolute_time_t t)
+{
+    return t;
+}
+
+static inline absolute_time_t make_timeout_time_us(uint64_t us)
+{
+    return time_us_64() + us;
+}
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms)
+{
+    return time_us_64() + (uint64_t) ms * 1000u;
+}
+
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to)
+{
+    return (int64_t) (to - from);
+}
+
+void sleep_until(absolute_time_t target);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+
+/**
+ * @brief Dorme até `timeout` (o simulador não tem eventos que antecipem o WFE).
+ *
+ * @return `true`, pois a espera sempre termina pelo tempo.
+ */
+bool best_effort_wfe_or_timeout(absolute_time_t timeout);
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out);
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out);
+bool cancel_repeating_timer(repeating_timer_t *timer);
+
+#endif // SIM_PICO_TIME_H
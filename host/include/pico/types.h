@@ -0,0 +1,26 @@
+#ifndef SIM_PICO_TYPES_H
+#define SIM_PICO_TYPES_H
+
+/**
+ * @file types.h
+ * @brief Tipos básicos do pico-sdk para o build nativo (HAL simulada).
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+/** @brief Instante absoluto, em microssegundos desde o início da simulação. */
+typedef uint64_t absolute_time_t;
+
+#endif // SIM_PICO_TYPES_H
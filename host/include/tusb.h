@@ -0,0 +1,41 @@
+#ifndef SIM_TUSB_H
+#define SIM_TUSB_H
+
+/**
+ * @file tusb.h
+ * @brief Subconjunto do TinyUSB usado pelo JoyTracker, sobre um host USB simulado.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#include "pico/types.h"
+
+typedef enum
+{
+    HID_REPORT_TYPE_INVALID = 0,
+    HID_REPORT_TYPE_INPUT,
+    HID_REPORT_TYPE_OUTPUT,
+    HID_REPORT_TYPE_FEATURE
+} hid_report_type_t;
+
+bool tusb_init(void);
+
+/** @brief Ativa o início de quadro a cada 1 ms, que chama `tud_sof_cb`. */
+void tud_sof_cb_enable(bool en);
+void tud_sof_cb(uint32_t frame_count);
+
+bool tud_hid_n_ready(uint8_t instance);
+bool tud_hid_n_report(uint8_t instance, uint8_t report_id, void const *report, uint16_t len);
+
+bool tud_cdc_n_connected(uint8_t itf);
+uint32_t tud_cdc_n_write_available(uint8_t itf);
+uint32_t tud_cdc_n_write(uint8_t itf, void const *buffer, uint32_t bufsize);
+uint32_t tud_cdc_n_write_flush(uint8_t itf);
+
+#endif // SIM_TUSB_H
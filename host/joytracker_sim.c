@@ -0,0 +1,403 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sim.h"
+#include "sim_ssd1306.h"
+#include "i2c_trace.h"
+#include "i2c_bus.h"
+
+/**
+ * @file joytracker_sim.c
+ * @brief Executa o firmware do JoyTracker (JoyTracker.c e lib/) sobre a HAL simulada.
+ *
+ * O `main` do firmware é compilado como `joytracker_main` e roda no núcleo 0
+ * simulado. Um roteiro de texto injeta entradas ao longo do tempo virtual; ao
+ * final, são impressas as estatísticas do display, do I2C, da HID e dos LEDs.
+ *
+ * Roteiro: uma entrada por linha, `#` inicia comentário.
+ *
+ *     <t_ms> joy <x> <y>         eixos do joystick (0-4095; centro 2048)
+ *     <t_ms> adc <canal> <valor> canal do ADC
+ *     <t_ms> gpio <pino> <0|1>   nível de um pino (botões: 0 = pressionado)
+ *     <t_ms> key <caractere>     comando do console
+ *
+ * Uso:
+ *
+ *     joytracker_sim [-s roteiro] [-t duração_ms] [-f dir_quadros] [-o ultimo.pbm]
+ *                    [-p log_pwm.txt] [-T telemetria.bin] [-I registro_i2c.txt] [-F flash.bin]
+ *                    [-S taxa_hz]
+ *
+ * `-I` grava as transações do display no formato de i2c_trace.h, para o
+ * reprodutor (i2c_replay). `-F` carrega a flash simulada da imagem, se ela
+ * existir, e a grava de volta ao fim: as sessões do gravador (recorder.h)
+ * persistem entre execuções e podem ser lidas por tools/recorder_decode.py.
+ * `-S` conecta um sensor simulado ao barramento do OLED e o lê na taxa dada,
+ * de uma interrupção do núcleo 0, pelo gerenciador do barramento (i2c_bus.h);
+ * o comando `I` do console mostra a disputa com o display.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Endereço e barramento do OLED no firmware. */
+#define SIM_OLED_ADDR 0x3C
+#define SIM_OLED_I2C i2c1
+
+/** @brief Sensor simulado (-S): endereço e registrador lido (o prazo de cada leitura é o período). */
+#define SIM_SENSOR_ADDR 0x48
+#define SIM_SENSOR_REGISTER 0x00
+
+/** @brief Canais do ADC dos eixos (X no GPIO27, Y no GPIO26). */
+#define SIM_JOY_X_CHANNEL 1
+#define SIM_JOY_Y_CHANNEL 0
+
+/** @brief Pinos PWM do LED RGB, para o resumo final. */
+static const uint sim_led_pins[3] = {13, 11, 12};
+static const char *const sim_led_names[3] = {"vermelho", "verde", "azul"};
+
+/** @brief Ponto de entrada do firmware (JoyTracker.c compilado com main=joytracker_main). */
+int joytracker_main(void);
+
+/**
+ * @brief Entrada do roteiro.
+ */
+typedef struct
+{
+    uint64_t t_us;  /**< Instante. */
+    char kind;      /**< 'j' (joy), 'a' (adc), 'g' (gpio) ou 'k' (key). */
+    uint32_t a;     /**< Primeiro argumento. */
+    uint32_t b;     /**< Segundo argumento. */
+} sim_script_entry_t;
+
+static sim_script_entry_t *script = NULL;
+static size_t script_length = 0;
+static size_t script_next = 0;
+
+static sim_ssd1306_t oled;
+static const char *frames_dir = NULL;
+static const char *last_frame_path = NULL;
+static uint32_t frames_written = 0;
+static FILE *i2c_trace_file = NULL;
+static const char *flash_image_path = NULL;
+
+/** @brief Sensor simulado: período de leitura, dispositivo no gerenciador e contadores. */
+static uint32_t sensor_period_us = 0;
+static i2c_bus_device_t *sensor_device = NULL;
+static const uint8_t sensor_register = SIM_SENSOR_REGISTER;
+static uint8_t sensor_value[2];
+static uint16_t sensor_sample = 0;
+static uint32_t sensor_submitted = 0;
+static uint32_t sensor_overruns = 0;
+
+/**
+ * @brief Carrega o roteiro de entradas.
+ *
+ * @param path Caminho do roteiro.
+ * @return `true` se o roteiro foi lido sem erros.
+ */
+static bool script_load(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if(file == NULL)
+    {
+        perror(path);
+        return false;
+    }
+
+    char line[256];
+    size_t capacity = 0;
+    uint line_number = 0;
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        line_number++;
+        char *comment = strchr(line, '#');
+        if(comment != NULL) *comment = '\0';
+
+        double t_ms;
+        char kind[16], arg_a[16];
+        uint32_t arg_b = 0;
+        int fields = sscanf(line, "%lf %15s %15s %u", &t_ms, kind, arg_a, &arg_b);
+        if(fields <= 0) continue;
+
+        sim_script_entry_t entry = {(uint64_t) (t_ms * 1000.0), kind[0], 0, arg_b};
+        bool valid = fields >= 3;
+        if(valid && strcmp(kind, "key") == 0)
+            entry.a = (unsigned char) arg_a[0];
+        else if(valid && fields == 4 && (!strcmp(kind, "joy") || !strcmp(kind, "adc") || !strcmp(kind, "gpio")))
+            entry.a = (uint32_t) strtoul(arg_a, NULL, 0);
+        else
+            valid = false;
+
+        if(!valid)
+        {
+            fprintf(stderr, "%s:%u: entrada invalida\n", path, line_number);
+            fclose(file);
+            return false;
+        }
+
+        if(script_length == capacity)
+        {
+            capacity = capacity ? capacity * 2u : 64u;
+            script = realloc(script, capacity * sizeof(*script));
+        }
+        script[script_length++] = entry;
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief Evento do roteiro: aplica as entradas que vencem agora e agenda a seguinte.
+ *
+ * @param ctx Não utilizado.
+ */
+static void script_step(void *ctx)
+{
+    (void) ctx;
+    uint64_t now_us = time_us_64();
+
+    while(script_next < script_length && script[script_next].t_us <= now_us)
+    {
+        const sim_script_entry_t *entry = &script[script_next++];
+        switch(entry->kind)
+        {
+            case 'j':
+                sim_adc_set(SIM_JOY_X_CHANNEL, (uint16_t) entry->a);
+                sim_adc_set(SIM_JOY_Y_CHANNEL, (uint16_t) entry->b);
+                break;
+            case 'a':
+                sim_adc_set(entry->a, (uint16_t) entry->b);
+                break;
+            case 'g':
+                sim_gpio_set_level(entry->a, entry->b != 0);
+                break;
+            case 'k':
+                sim_stdin_push((char) entry->a);
+                break;
+            default:
+                break;
+        }
+    }
+    if(script_next < script_length) sim_schedule(script[script_next].t_us, script_step, NULL);
+}
+
+/**
+ * @brief Ordena o roteiro por instante, preservando a ordem das entradas simultâneas.
+ */
+static void script_sort(void)
+{
+    for(size_t i = 1; i < script_length; i++)
+    {
+        sim_script_entry_t entry = script[i];
+        size_t j = i;
+        while(j > 0 && script[j - 1].t_us > entry.t_us)
+        {
+            script[j] = script[j - 1];
+            j--;
+        }
+        script[j] = entry;
+    }
+}
+
+/**
+ * @brief Quadro recebido pelo OLED simulado: grava-o, se solicitado.
+ */
+static void on_frame(void *ctx, const sim_ssd1306_t *display)
+{
+    (void) ctx;
+    if(frames_dir == NULL) return;
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/frame_%05lu.pbm", frames_dir, (unsigned long) display->data_writes);
+    if(sim_ssd1306_write_pbm(display, path)) frames_written++;
+}
+
+/**
+ * @brief Sensor simulado: aceita a escrita do registrador.
+ */
+static int sensor_write(void *ctx, const uint8_t *src, size_t len, bool nostop)
+{
+    (void) ctx;
+    (void) src;
+    (void) nostop;
+    return (int) len;
+}
+
+/**
+ * @brief Sensor simulado: devolve uma contagem crescente.
+ */
+static int sensor_read(void *ctx, uint8_t *dst, size_t len, bool nostop)
+{
+    (void) ctx;
+    (void) nostop;
+    sensor_sample++;
+    for(size_t i = 0; i < len; i++)
+        dst[i] = (uint8_t) (sensor_sample >> (8u * (i & 1u)));
+    return (int) len;
+}
+
+/**
+ * @brief Leitura periódica do sensor, como o driver de um sensor amostrado por temporizador.
+ *
+ * Roda no contexto de interrupção do núcleo 0: só submete a transação, que o
+ * gerenciador executa entre os trechos do display ou na tarefa de entrada.
+ */
+static void sensor_poll(void *ctx)
+{
+    (void) ctx;
+    i2c_bus_t *bus = i2c_bus_get(SIM_OLED_I2C);
+    if(bus != NULL && sensor_device == NULL)
+    {
+        sensor_device = i2c_bus_add_device(bus, "sensor", SIM_SENSOR_ADDR, I2C_BUS_PRIORITY_SENSOR, 0,
+                                           sensor_period_us, false);
+    }
+    if(sensor_device != NULL)
+    {
+        if(i2c_bus_submit(bus, sensor_device, &sensor_register, 1, sensor_value, sizeof(sensor_value)))
+            sensor_submitted++;
+        else
+            sensor_overruns++; // A leitura anterior ainda estava na fila
+    }
+    sim_schedule(time_us_64() + sensor_period_us, sensor_poll, NULL);
+}
+
+/**
+ * @brief Grava uma transação do display no registro de texto.
+ */
+static void on_i2c_transaction(void *ctx, uint32_t t_us, uint8_t addr, bool nostop, const uint8_t *src, size_t len)
+{
+    FILE *file = (FILE *) ctx;
+    if(ftell(file) == 0) fprintf(file, "# i2c_trace baud=%u\n", i2c_trace_get_baudrate());
+
+    fprintf(file, "%lu %02x %c ", (unsigned long) t_us, addr, nostop ? 'N' : 'S');
+    for(size_t i = 0; i < len; i++)
+        fprintf(file, "%02x", src[i]);
+    fputc('\n', file);
+}
+
+/**
+ * @brief Resumo impresso ao fim da simulação.
+ */
+static void on_end(void)
+{
+    uint64_t now_us = time_us_64();
+    uint32_t transactions;
+    uint64_t bytes, busy_us;
+    sim_i2c_get_stats(SIM_OLED_I2C, &transactions, &bytes, &busy_us);
+
+    printf("\nsim: t=%llums\n", (unsigned long long) (now_us / 1000u));
+    printf("sim: oled quadros=%lu comandos=%lu bytes_dados=%llu gravados=%lu\n",
+           (unsigned long) oled.data_writes, (unsigned long) oled.commands,
+           (unsigned long long) oled.data_bytes, (unsigned long) frames_written);
+    printf("sim: i2c transacoes=%lu bytes=%llu ocupado=%llums (%llu%%)\n", (unsigned long) transactions,
+           (unsigned long long) bytes, (unsigned long long) (busy_us / 1000u),
+           (unsigned long long) (now_us ? busy_us * 100u / now_us : 0u));
+    if(sensor_period_us != 0)
+    {
+        printf("sim: sensor leituras=%lu lidas=%u sobrepostas=%lu\n", (unsigned long) sensor_submitted,
+               sensor_sample, (unsigned long) sensor_overruns);
+    }
+    printf("sim: hid relatorios=%lu\n", (unsigned long) sim_usb_get_hid_report_count());
+    for(uint i = 0; i < 3; i++)
+    {
+        uint32_t period;
+        uint16_t level = sim_pwm_get_level(sim_led_pins[i], &period);
+        printf("sim: led %s nivel=%u/%lu\n", sim_led_names[i], level, (unsigned long) period);
+    }
+
+    if(last_frame_path != NULL && !sim_ssd1306_write_pbm(&oled, last_frame_path)) perror(last_frame_path);
+    if(i2c_trace_file != NULL) fclose(i2c_trace_file);
+    if(flash_image_path != NULL && !sim_flash_save(flash_image_path)) perror(flash_image_path);
+    fflush(stdout);
+}
+
+/**
+ * @brief Abre um arquivo de saída ou encerra com erro.
+ */
+static FILE *open_output(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if(file == NULL)
+    {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    return file;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t duration_ms = 1000;
+    const char *script_path = NULL;
+    int opt;
+
+    while((opt = getopt(argc, argv, "s:t:f:o:p:T:I:F:S:h")) != -1)
+    {
+        switch(opt)
+        {
+            case 's':
+                script_path = optarg;
+                break;
+            case 't':
+                duration_ms = strtoull(optarg, NULL, 0);
+                break;
+            case 'f':
+                frames_dir = optarg;
+                break;
+            case 'o':
+                last_frame_path = optarg;
+                break;
+            case 'p':
+                sim_pwm_set_log(open_output(optarg));
+                break;
+            case 'T':
+                sim_usb_set_cdc_output(1, open_output(optarg));
+                break;
+            case 'I':
+                i2c_trace_file = open_output(optarg);
+                i2c_trace_set_sink(on_i2c_transaction, i2c_trace_file);
+                break;
+            case 'F':
+                flash_image_path = optarg;
+                break;
+            case 'S':
+            {
+                unsigned long rate_hz = strtoul(optarg, NULL, 0);
+                sensor_period_us = rate_hz != 0 ? (uint32_t) (1000000u / rate_hz) : 0u;
+                break;
+            }
+            default:
+                fprintf(stderr, "uso: %s [-s roteiro] [-t duracao_ms] [-f dir_quadros] [-o ultimo.pbm] "
+                                "[-p log_pwm.txt] [-T telemetria.bin] [-I registro_i2c.txt] [-F flash.bin] "
+                                "[-S taxa_hz]\n", argv[0]);
+                return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if(script_path != NULL && !script_load(script_path)) return EXIT_FAILURE;
+    script_sort();
+
+    sim_init(duration_ms * 1000u, on_end);
+    if(flash_image_path != NULL && access(flash_image_path, F_OK) == 0 && !sim_flash_load(flash_image_path))
+    {
+        fprintf(stderr, "%s: imagem da flash invalida\n", flash_image_path);
+        return EXIT_FAILURE;
+    }
+    sim_ssd1306_init(&oled);
+    oled.on_data = on_frame;
+    sim_i2c_attach(SIM_OLED_I2C, SIM_OLED_ADDR, sim_ssd1306_write, &oled);
+    if(script_length > 0) sim_schedule(script[0].t_us, script_step, NULL);
+    if(sensor_period_us != 0)
+    {
+        sim_i2c_attach(SIM_OLED_I2C, SIM_SENSOR_ADDR, sensor_write, NULL);
+        sim_i2c_set_reader(SIM_OLED_I2C, SIM_SENSOR_ADDR, sensor_read);
+        sim_schedule(sensor_period_us, sensor_poll, NULL);
+    }
+
+    joytracker_main();
+    sim_finish();
+}
@@ -0,0 +1,369 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "predict.h"
+
+/**
+ * @file predict_replay.c
+ * @brief Avalia o preditor de posição (predict.h) sobre amostras gravadas do joystick.
+ *
+ * Lê um CSV de amostras, como o `filtered_sample.csv` de
+ * tools/telemetry_decode.py ou o `samples.csv` de tools/recorder_decode.py
+ * (as três últimas colunas de cada linha são instante em us, X e Y; as demais
+ * linhas são ignoradas), e reproduz a tarefa de entrada: a cada período, a
+ * amostra mais recente alimenta o preditor, que a extrapola pelo horizonte
+ * (a latência input-to-photon). A posição exibida é comparada com a posição
+ * real do joystick no instante em que a imagem aparece, interpolada entre as
+ * amostras, com e sem predição. Por passo, imprime em CSV:
+ *
+ *     t_us,x,y,shown_x,shown_y,actual_x,actual_y
+ *
+ * e, ao fim, o resumo em pixels do display:
+ *
+ * - erro: distância entre a posição exibida e a real (média, p99, máximo);
+ * - ultrapassagem: quanto a posição exibida passou da real no sentido do
+ *   avanço previsto (média, máximo e passos acima de 1 px);
+ * - latência percebida: o atraso τ para o qual a posição exibida mais se
+ *   aproxima da real em `instante da imagem - τ`, nos passos em movimento.
+ *   Sem predição ela é a própria latência; a redução mede o ganho.
+ *
+ * Uso:
+ *
+ *     predict_replay [-l latência_us] [-p período_us] [-n ruído] amostras.csv
+ *
+ * `-n` soma às amostras um ruído uniforme de ±n contagens (determinístico),
+ * para avaliar a robustez com gravações da simulação, que não têm ruído.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Horizonte padrão: a latência input-to-photon média na simulação. */
+#define REPLAY_DEFAULT_LATENCY_US 27000
+
+/** @brief Período padrão da tarefa de entrada. */
+#define REPLAY_DEFAULT_PERIOD_US 5000
+
+/** @brief Pixels por contagem do ADC em cada eixo (128x64). */
+#define REPLAY_PX_X (128.0 / 4096.0)
+#define REPLAY_PX_Y (64.0 / 4096.0)
+
+/** @brief Zona morta do firmware (joystick.c): o ruído é somado antes dela, como no ADC. */
+#define REPLAY_DEADZONE 120
+
+/** @brief Deslocamento mínimo, em pixels, para um passo contar como movimento. */
+#define REPLAY_MOVING_PX 1.0
+
+/** @brief Passo e limite da busca da latência percebida. */
+#define REPLAY_LAG_STEP_US 1000
+#define REPLAY_LAG_EXTRA_US 20000
+
+/**
+ * @brief Amostra lida, com o instante já sem a volta dos 32 bits.
+ */
+typedef struct
+{
+    int64_t t_us;
+    double x;
+    double y;
+} replay_sample_t;
+
+/**
+ * @brief Passo reproduzido.
+ */
+typedef struct
+{
+    int64_t photon_us; /**< Instante em que a imagem aparece. */
+    double sample_x, sample_y;
+    double shown_x, shown_y;
+} replay_step_t;
+
+static replay_sample_t *samples = NULL;
+static size_t sample_count = 0;
+
+/**
+ * @brief Soma o ruído a um eixo e reaplica a zona morta.
+ *
+ * Amostras no centro continuam nele: no firmware, o ruído já foi absorvido pela zona morta.
+ */
+static double replay_add_noise(double value, int noise, uint32_t *lcg)
+{
+    *lcg = *lcg * 1664525u + 1013904223u;
+    if(value == 2048) return value;
+    value += (double) ((int) (*lcg >> 16) % (2 * noise + 1) - noise);
+    if(value > 2048 - REPLAY_DEADZONE && value < 2048 + REPLAY_DEADZONE) return 2048;
+    return value < 0 ? 0 : value > 4095 ? 4095 : value;
+}
+
+/**
+ * @brief Lê as amostras do CSV.
+ *
+ * @param file Arquivo.
+ * @param noise Amplitude do ruído somado.
+ * @return `true` se ao menos duas amostras foram lidas.
+ */
+static bool replay_load(FILE *file, int noise)
+{
+    size_t capacity = 0;
+    uint32_t last_t = 0, lcg = 1;
+    int64_t offset = 0;
+    char *line = NULL;
+    size_t line_capacity = 0;
+
+    while(getline(&line, &line_capacity, file) != -1)
+    {
+        long values[3] = {0, 0, 0};
+        int found = 0;
+        char *cursor = line;
+        for(char *field = strtok(cursor, ", \t\r\n"); field != NULL; field = strtok(NULL, ", \t\r\n"))
+        {
+            char *end;
+            long value = strtol(field, &end, 10);
+            if(*end != '\0')
+            {
+                found = -1;
+                break;
+            }
+            values[0] = values[1];
+            values[1] = values[2];
+            values[2] = value;
+            found++;
+        }
+        if(found < 3) continue;
+
+        uint32_t t = (uint32_t) values[0];
+        if(sample_count > 0 && t < last_t && last_t - t > 0x80000000u) offset += 0x100000000ll;
+        last_t = t;
+        if(sample_count == capacity)
+        {
+            capacity = capacity ? capacity * 2 : 4096;
+            samples = realloc(samples, capacity * sizeof(*samples));
+        }
+        replay_sample_t *sample = &samples[sample_count++];
+        sample->t_us = (int64_t) t + offset;
+        sample->x = (double) values[1];
+        sample->y = (double) values[2];
+        if(noise > 0)
+        {
+            sample->x = replay_add_noise(sample->x, noise, &lcg);
+            sample->y = replay_add_noise(sample->y, noise, &lcg);
+        }
+    }
+    free(line);
+    return sample_count >= 2;
+}
+
+/**
+ * @brief Posição real do joystick em `t_us`, interpolada entre as amostras.
+ */
+static void replay_actual(int64_t t_us, double *x, double *y)
+{
+    size_t lo = 0, hi = sample_count - 1;
+    if(t_us <= samples[lo].t_us || t_us >= samples[hi].t_us)
+    {
+        const replay_sample_t *edge = t_us <= samples[lo].t_us ? &samples[lo] : &samples[hi];
+        *x = edge->x;
+        *y = edge->y;
+        return;
+    }
+    while(hi - lo > 1)
+    {
+        size_t mid = (lo + hi) / 2;
+        if(samples[mid].t_us <= t_us)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    double k = (double) (t_us - samples[lo].t_us) / (double) (samples[hi].t_us - samples[lo].t_us);
+    *x = samples[lo].x + (samples[hi].x - samples[lo].x) * k;
+    *y = samples[lo].y + (samples[hi].y - samples[lo].y) * k;
+}
+
+/**
+ * @brief Distância em pixels entre duas posições em contagens.
+ */
+static double replay_px(double dx, double dy)
+{
+    return hypot(dx * REPLAY_PX_X, dy * REPLAY_PX_Y);
+}
+
+static int replay_compare(const void *a, const void *b)
+{
+    double da = *(const double *) a, db = *(const double *) b;
+    return (da > db) - (da < db);
+}
+
+/**
+ * @brief Resumo de uma série de erros: média, p99 e máximo.
+ */
+static void replay_summary(double *values, size_t count, double *mean, double *p99, double *max)
+{
+    double sum = 0;
+    for(size_t i = 0; i < count; i++)
+        sum += values[i];
+    qsort(values, count, sizeof(*values), replay_compare);
+    *mean = count ? sum / (double) count : 0;
+    *p99 = count ? values[(count * 99) / 100 < count ? (count * 99) / 100 : count - 1] : 0;
+    *max = count ? values[count - 1] : 0;
+}
+
+/**
+ * @brief Latência percebida: o atraso que melhor explica a posição exibida, nos passos em movimento.
+ *
+ * @param steps Passos.
+ * @param count Quantidade de passos.
+ * @param predicted Usa a posição prevista (ou a amostra, sem predição).
+ * @param latency_us Horizonte, que limita a busca.
+ * @return Atraso em us.
+ */
+static int64_t replay_perceived_lag(const replay_step_t *steps, size_t count, bool predicted, int64_t latency_us)
+{
+    int64_t best_lag = 0;
+    double best_error = INFINITY;
+    for(int64_t lag = 0; lag <= latency_us + REPLAY_LAG_EXTRA_US; lag += REPLAY_LAG_STEP_US)
+    {
+        double sum = 0;
+        size_t used = 0;
+        for(size_t i = 0; i < count; i++)
+        {
+            double ax, ay, ox, oy;
+            replay_actual(steps[i].photon_us, &ax, &ay);
+            if(replay_px(ax - steps[i].sample_x, ay - steps[i].sample_y) < REPLAY_MOVING_PX) continue;
+            replay_actual(steps[i].photon_us - lag, &ox, &oy);
+            double sx = predicted ? steps[i].shown_x : steps[i].sample_x;
+            double sy = predicted ? steps[i].shown_y : steps[i].sample_y;
+            sum += replay_px(sx - ox, sy - oy);
+            used++;
+        }
+        if(used > 0 && sum / (double) used < best_error)
+        {
+            best_error = sum / (double) used;
+            best_lag = lag;
+        }
+    }
+    return best_lag;
+}
+
+/**
+ * @brief Ultrapassagem de um eixo: quanto o avanço previsto passou do real, no seu sentido.
+ */
+static double replay_overshoot(double predicted_lead, double actual_lead)
+{
+    if(predicted_lead > 0) return predicted_lead > actual_lead ? predicted_lead - actual_lead : 0;
+    if(predicted_lead < 0) return predicted_lead < actual_lead ? actual_lead - predicted_lead : 0;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t latency_us = REPLAY_DEFAULT_LATENCY_US;
+    uint32_t period_us = REPLAY_DEFAULT_PERIOD_US;
+    int noise = 0;
+    int opt;
+
+    while((opt = getopt(argc, argv, "l:p:n:h")) != -1)
+    {
+        switch(opt)
+        {
+            case 'l':
+                latency_us = (uint32_t) strtoul(optarg, NULL, 0);
+                break;
+            case 'p':
+                period_us = (uint32_t) strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                noise = atoi(optarg);
+                break;
+            default:
+                fprintf(stderr, "uso: %s [-l latencia_us] [-p periodo_us] [-n ruido] amostras.csv\n", argv[0]);
+                return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if(optind >= argc || period_us == 0)
+    {
+        fprintf(stderr, "%s: informe as amostras\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *file = strcmp(argv[optind], "-") == 0 ? stdin : fopen(argv[optind], "r");
+    if(file == NULL)
+    {
+        perror(argv[optind]);
+        return EXIT_FAILURE;
+    }
+    bool loaded = replay_load(file, noise);
+    if(file != stdin) fclose(file);
+    if(!loaded)
+    {
+        fprintf(stderr, "%s: menos de duas amostras\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    size_t step_capacity = (size_t) ((samples[sample_count - 1].t_us - samples[0].t_us) / period_us) + 1;
+    replay_step_t *steps = calloc(step_capacity, sizeof(*steps));
+    double *error_raw = calloc(step_capacity, sizeof(double));
+    double *error_pred = calloc(step_capacity, sizeof(double));
+    double *overshoot = calloc(step_capacity, sizeof(double));
+    size_t step_count = 0, over_px = 0, next = 0;
+    predict_t pred;
+    predict_init(&pred);
+
+    // Tarefa de entrada: a cada período, a amostra mais recente (a posição exibida vale no instante da imagem)
+    printf("t_us,x,y,shown_x,shown_y,actual_x,actual_y\n");
+    for(int64_t t = samples[0].t_us; t <= samples[sample_count - 1].t_us - (int64_t) latency_us; t += period_us)
+    {
+        while(next + 1 < sample_count && samples[next + 1].t_us <= t)
+            next++;
+        const replay_sample_t *sample = &samples[next];
+        uint16_t sx = (uint16_t) lround(sample->x), sy = (uint16_t) lround(sample->y), px, py;
+        predict_add(&pred, sx, sy, (uint32_t) sample->t_us);
+        predict_position(&pred, latency_us, &px, &py);
+
+        replay_step_t *step = &steps[step_count];
+        step->photon_us = sample->t_us + latency_us;
+        step->sample_x = sx;
+        step->sample_y = sy;
+        step->shown_x = px;
+        step->shown_y = py;
+        double ax, ay;
+        replay_actual(step->photon_us, &ax, &ay);
+        printf("%lld,%u,%u,%u,%u,%.0f,%.0f\n", (long long) sample->t_us, sx, sy, px, py, ax, ay);
+
+        error_raw[step_count] = replay_px(sx - ax, sy - ay);
+        error_pred[step_count] = replay_px(px - ax, py - ay);
+        overshoot[step_count] = hypot(replay_overshoot(px - sx, ax - sx) * REPLAY_PX_X,
+                                      replay_overshoot(py - sy, ay - sy) * REPLAY_PX_Y);
+        if(overshoot[step_count] > 1.0) over_px++;
+        step_count++;
+    }
+
+    int64_t lag_raw = replay_perceived_lag(steps, step_count, false, latency_us);
+    int64_t lag_pred = replay_perceived_lag(steps, step_count, true, latency_us);
+    double mean, p99, max;
+    fprintf(stderr, "replay: amostras=%zu passos=%zu latencia=%luus periodo=%luus ruido=%d\n", sample_count,
+            step_count, (unsigned long) latency_us, (unsigned long) period_us, noise);
+    replay_summary(error_raw, step_count, &mean, &p99, &max);
+    fprintf(stderr, "replay: sem predicao: erro media=%.2fpx p99=%.2fpx max=%.2fpx latencia_percebida=%lldus\n", mean,
+            p99, max, (long long) lag_raw);
+    replay_summary(error_pred, step_count, &mean, &p99, &max);
+    fprintf(stderr, "replay: com predicao: erro media=%.2fpx p99=%.2fpx max=%.2fpx latencia_percebida=%lldus\n", mean,
+            p99, max, (long long) lag_pred);
+    replay_summary(overshoot, step_count, &mean, &p99, &max);
+    fprintf(stderr, "replay: ultrapassagem media=%.2fpx p99=%.2fpx max=%.2fpx passos>1px=%zu (%.1f%%)\n", mean, p99,
+            max, over_px, step_count ? 100.0 * (double) over_px / (double) step_count : 0.0);
+    fprintf(stderr, "replay: preditor zona_morta=%lu parados=%lu inversoes=%lu paradas=%lu limitados=%lu avanco_max=%lu\n",
+            (unsigned long) pred.deadzone, (unsigned long) pred.still, (unsigned long) pred.reversals, (unsigned long) pred.stops,
+            (unsigned long) pred.clamped, (unsigned long) pred.lead_max);
+
+    free(steps);
+    free(error_raw);
+    free(error_pred);
+    free(overshoot);
+    free(samples);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,217 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+/**
+ * @file sim.h
+ * @brief Controle da HAL simulada: relógio virtual, núcleos, eventos e injeção de entradas.
+ *
+ * O tempo é virtual e discreto. Cada núcleo simulado é uma thread, mas apenas
+ * um executa por vez: o núcleo corrente roda até esperar (sleep, WFE, envio
+ * I2C), e então o relógio avança até o próximo instante relevante — o menor
+ * entre o despertar dos núcleos e os eventos agendados. Eventos (temporizadores,
+ * início de quadro USB, entradas roteirizadas) rodam nesse avanço, como
+ * interrupções. O código executa em tempo virtual zero; só as esperas e o
+ * barramento I2C custam tempo, o que torna as execuções determinísticas.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Sim HAL simulada
+ * @brief Relógio virtual, dispositivos simulados e injeção de entradas.
+ * @{
+ */
+
+/** @brief Quantidade máxima de eventos agendados simultaneamente. */
+#define SIM_MAX_EVENTS 64
+
+/** @brief Callback de um evento agendado (executado em contexto de interrupção). */
+typedef void (*sim_event_fn_t)(void *ctx);
+
+/** @brief Callback chamado ao fim da simulação, antes de encerrar o processo. */
+typedef void (*sim_end_fn_t)(void);
+
+/**
+ * @brief Dispositivo I2C: recebe cada transação de escrita (endereço já decodificado).
+ *
+ * @return Bytes aceitos, ou negativo para NACK.
+ */
+typedef int (*sim_i2c_write_fn_t)(void *ctx, const uint8_t *src, size_t len, bool nostop);
+
+/**
+ * @brief Dispositivo I2C: responde a uma transação de leitura.
+ *
+ * @return Bytes fornecidos, ou negativo para NACK.
+ */
+typedef int (*sim_i2c_read_fn_t)(void *ctx, uint8_t *dst, size_t len, bool nostop);
+
+/**
+ * @brief Inicializa a simulação; a thread que chama passa a ser o núcleo 0.
+ *
+ * @param[in] end_us Instante em que a simulação termina.
+ * @param[in] on_end Callback de encerramento (pode ser `NULL`).
+ */
+void sim_init(uint64_t end_us, sim_end_fn_t on_end);
+
+/**
+ * @brief Encerra a simulação: chama o callback de encerramento e sai do processo.
+ */
+void sim_finish(void) __attribute__((noreturn));
+
+/**
+ * @brief Bloqueia o núcleo corrente até `t_us`; os demais núcleos e os eventos executam.
+ *
+ * Em contexto de interrupção não há troca de núcleo: o relógio apenas avança.
+ *
+ * @param[in] t_us Instante de despertar.
+ */
+void sim_wait_until(uint64_t t_us);
+
+/**
+ * @brief Agenda um evento.
+ *
+ * @param[in] t_us Instante do evento (no passado, executa no próximo avanço).
+ * @param[in] fn Callback.
+ * @param[in] ctx Contexto.
+ * @return `true` se havia espaço na fila de eventos.
+ */
+bool sim_schedule(uint64_t t_us, sim_event_fn_t fn, void *ctx);
+
+/**
+ * @brief Indica se o chamador está em um evento (interrupção simulada).
+ */
+bool sim_in_irq(void);
+
+/**
+ * @brief Injeta um nível em um pino, gerando a interrupção de borda se habilitada.
+ *
+ * @param[in] gpio Pino.
+ * @param[in] level Nível.
+ */
+void sim_gpio_set_level(uint gpio, bool level);
+
+/**
+ * @brief Define o valor (12 bits) devolvido por um canal do ADC.
+ *
+ * @param[in] channel Canal (0-4).
+ * @param[in] value Valor.
+ */
+void sim_adc_set(uint channel, uint16_t value);
+
+/**
+ * @brief Registra em `log`, como texto, cada mudança de nível dos pinos em função PWM.
+ *
+ * Cada linha contém: instante (us), pino, nível e período do slice (TOP + 1).
+ *
+ * @param[in] log Arquivo de saída (`NULL` desativa).
+ */
+void sim_pwm_set_log(FILE *log);
+
+/**
+ * @brief Nível atual de um pino PWM.
+ *
+ * @param[in] gpio Pino.
+ * @param[out] period Período do slice (TOP + 1), se não for `NULL`.
+ * @return Nível de comparação do canal.
+ */
+uint16_t sim_pwm_get_level(uint gpio, uint32_t *period);
+
+/**
+ * @brief Indica se um pino foi configurado na função PWM.
+ */
+bool sim_pwm_is_output(uint gpio);
+
+/**
+ * @brief Conecta um dispositivo a um barramento I2C.
+ *
+ * @param[in] i2c Barramento.
+ * @param[in] addr Endereço de 7 bits.
+ * @param[in] write Callback de escrita.
+ * @param[in] ctx Contexto do dispositivo.
+ * @return `true` se havia espaço no barramento.
+ */
+bool sim_i2c_attach(i2c_inst_t *i2c, uint8_t addr, sim_i2c_write_fn_t write, void *ctx);
+
+/**
+ * @brief Permite leituras de um dispositivo conectado (sem leitor, a leitura recebe NACK).
+ *
+ * @param[in] i2c Barramento.
+ * @param[in] addr Endereço do dispositivo.
+ * @param[in] read Callback de leitura (recebe o contexto de `sim_i2c_attach`).
+ * @return `true` se o dispositivo está conectado.
+ */
+bool sim_i2c_set_reader(i2c_inst_t *i2c, uint8_t addr, sim_i2c_read_fn_t read);
+
+/**
+ * @brief Tempo de barramento de uma transação: START, endereço, `len` bytes e STOP.
+ *
+ * @param[in] baudrate Taxa do barramento.
+ * @param[in] len Bytes de dados.
+ * @return Duração em microssegundos.
+ */
+uint32_t sim_i2c_transfer_us(uint baudrate, size_t len);
+
+/**
+ * @brief Estatísticas acumuladas de um barramento.
+ *
+ * @param[in] i2c Barramento.
+ * @param[out] transactions Transações (pode ser `NULL`).
+ * @param[out] bytes Bytes de dados (pode ser `NULL`).
+ * @param[out] busy_us Tempo ocupado (pode ser `NULL`).
+ */
+void sim_i2c_get_stats(i2c_inst_t *i2c, uint32_t *transactions, uint64_t *bytes, uint64_t *busy_us);
+
+/**
+ * @brief Enfileira um caractere para `getchar_timeout_us`.
+ *
+ * @param[in] c Caractere.
+ */
+void sim_stdin_push(char c);
+
+/**
+ * @brief Grava em `out` os bytes enviados a uma interface CDC, que passa a constar como conectada.
+ *
+ * @param[in] itf Interface CDC.
+ * @param[in] out Arquivo de saída (`NULL` desconecta).
+ */
+void sim_usb_set_cdc_output(uint8_t itf, FILE *out);
+
+/**
+ * @brief Relatórios HID aceitos pelo host simulado.
+ */
+uint32_t sim_usb_get_hid_report_count(void);
+
+/**
+ * @brief Carrega a flash simulada de uma imagem de 2 MB (por exemplo, gravada por `sim_flash_save`).
+ *
+ * @param[in] path Caminho da imagem.
+ * @return `true` se a imagem foi lida por inteiro.
+ */
+bool sim_flash_load(const char *path);
+
+/**
+ * @brief Grava a flash simulada em uma imagem.
+ *
+ * @param[in] path Caminho da imagem.
+ * @return `true` se a imagem foi gravada.
+ */
+bool sim_flash_save(const char *path);
+
+/**
+ * @brief Apaga toda a flash simulada (chamada por `sim_init`).
+ */
+void sim_flash_init(void);
+
+/** @} */ // Fim do grupo "Sim"
+
+#endif // SIM_H
@@ -0,0 +1,75 @@
+#include "sim.h"
+#include "hardware/adc.h"
+
+/**
+ * @file sim_adc.c
+ * @brief ADC simulado: valores por canal definidos pelo simulador (centro por padrão).
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Canais do ADC (4 pinos e o sensor de temperatura). */
+#define SIM_ADC_CHANNELS 5
+
+static uint16_t sim_adc_value[SIM_ADC_CHANNELS] = {2048, 2048, 2048, 2048, 876};
+static uint sim_adc_selected = 0;
+
+static adc_hw_t sim_adc_regs;
+adc_hw_t *const adc_hw = &sim_adc_regs;
+
+void adc_init(void)
+{
+}
+
+void adc_gpio_init(uint gpio)
+{
+    gpio_set_function(gpio, GPIO_FUNC_NULL);
+}
+
+void adc_select_input(uint input)
+{
+    if(input < SIM_ADC_CHANNELS) sim_adc_selected = input;
+}
+
+uint adc_get_selected_input(void)
+{
+    return sim_adc_selected;
+}
+
+uint16_t adc_read(void)
+{
+    return sim_adc_value[sim_adc_selected];
+}
+
+void adc_set_round_robin(uint input_mask)
+{
+    (void) input_mask;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift)
+{
+    (void) en;
+    (void) dreq_en;
+    (void) dreq_thresh;
+    (void) err_in_fifo;
+    (void) byte_shift;
+}
+
+void adc_set_clkdiv(float clkdiv)
+{
+    (void) clkdiv;
+}
+
+void adc_run(bool run)
+{
+    (void) run;
+}
+
+void sim_adc_set(uint channel, uint16_t value)
+{
+    if(channel < SIM_ADC_CHANNELS) sim_adc_value[channel] = value & 0x0FFFu;
+}
@@ -0,0 +1,378 @@
+#include "sim.h"
+#include "pico/multicore.h"
+#include "pico/bootrom.h"
+#include "hardware/sync.h"
+#include "hardware/clocks.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+/**
+ * @file sim_core.c
+ * @brief Relógio virtual, alternância dos núcleos, eventos e temporizadores.
+ *
+ * A posse do processador é uma ficha: só o núcleo indicado por `sim_running`
+ * executa; os demais aguardam na variável de condição. Todo o estado da
+ * simulação é acessado apenas pelo dono da ficha, então dispensa travas; o
+ * mutex protege somente a passagem da ficha.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Núcleos simulados. */
+#define SIM_CORES 2
+
+/** @brief Frequência simulada do sistema (padrão do RP2040). */
+#define SIM_SYS_CLOCK_HZ 125000000u
+
+/**
+ * @brief Estado de um núcleo.
+ */
+typedef struct
+{
+    bool started;         /**< Núcleo em execução (thread criada). */
+    uint64_t wake_us;     /**< Instante em que volta a executar. */
+    void (*entry)(void);  /**< Ponto de entrada (núcleo 1). */
+    pthread_t thread;     /**< Thread do núcleo. */
+} sim_core_t;
+
+/**
+ * @brief Evento agendado.
+ */
+typedef struct
+{
+    uint64_t t_us;     /**< Instante. */
+    uint64_t order;    /**< Ordem de agendamento, para desempate estável. */
+    sim_event_fn_t fn; /**< Callback. */
+    void *ctx;         /**< Contexto. */
+} sim_event_t;
+
+static pthread_mutex_t sim_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sim_cond = PTHREAD_COND_INITIALIZER;
+static volatile int sim_running = 0;
+static __thread int sim_self = 0;
+
+static sim_core_t sim_cores[SIM_CORES];
+static uint64_t sim_now_us = 0;
+static uint64_t sim_end_us = UINT64_MAX;
+static sim_end_fn_t sim_on_end = NULL;
+static int sim_irq_depth = 0;
+
+static sim_event_t sim_events[SIM_MAX_EVENTS];
+static uint32_t sim_event_count = 0;
+static uint64_t sim_event_order = 0;
+
+static uint32_t sim_sys_clock_hz = SIM_SYS_CLOCK_HZ;
+static int32_t sim_next_alarm_id = 1;
+
+void sim_init(uint64_t end_us, sim_end_fn_t on_end)
+{
+    sim_now_us = 0;
+    sim_end_us = end_us;
+    sim_on_end = on_end;
+    sim_running = 0;
+    sim_self = 0;
+    sim_cores[0].started = true;
+    sim_cores[0].wake_us = 0;
+    sim_flash_init();
+}
+
+void sim_finish(void)
+{
+    if(sim_on_end != NULL) sim_on_end();
+    fflush(stdout);
+    exit(EXIT_SUCCESS);
+}
+
+bool sim_in_irq(void)
+{
+    return sim_irq_depth > 0;
+}
+
+bool sim_schedule(uint64_t t_us, sim_event_fn_t fn, void *ctx)
+{
+    if(sim_event_count >= SIM_MAX_EVENTS) return false;
+    sim_events[sim_event_count].t_us = t_us < sim_now_us ? sim_now_us : t_us;
+    sim_events[sim_event_count].order = sim_event_order++;
+    sim_events[sim_event_count].fn = fn;
+    sim_events[sim_event_count].ctx = ctx;
+    sim_event_count++;
+    return true;
+}
+
+/**
+ * @brief Retira o evento mais antigo que vence até `limit_us`, se houver.
+ *
+ * @param limit_us Limite.
+ * @param[out] event Evento retirado.
+ * @return `true` se um evento foi retirado.
+ */
+static bool sim_pop_event(uint64_t limit_us, sim_event_t *event)
+{
+    int best = -1;
+    for(uint32_t i = 0; i < sim_event_count; i++)
+    {
+        const sim_event_t *e = &sim_events[i];
+        if(e->t_us > limit_us) continue;
+        if(best < 0 || e->t_us < sim_events[best].t_us ||
+           (e->t_us == sim_events[best].t_us && e->order < sim_events[best].order))
+            best = (int) i;
+    }
+    if(best < 0) return false;
+
+    *event = sim_events[best];
+    sim_events[best] = sim_events[--sim_event_count];
+    return true;
+}
+
+/**
+ * @brief Executa os eventos que vencem até `t_us`, avançando o relógio até lá.
+ *
+ * @param t_us Instante alvo.
+ */
+static void sim_advance_to(uint64_t t_us)
+{
+    sim_event_t event;
+    while(sim_pop_event(t_us, &event))
+    {
+        if(event.t_us > sim_end_us) sim_finish();
+        if(event.t_us > sim_now_us) sim_now_us = event.t_us;
+        sim_irq_depth++;
+        event.fn(event.ctx);
+        sim_irq_depth--;
+    }
+    if(t_us > sim_end_us) sim_finish();
+    if(t_us > sim_now_us) sim_now_us = t_us;
+}
+
+/**
+ * @brief Passa a ficha ao núcleo de despertar mais próximo e espera recebê-la de volta.
+ */
+static void sim_dispatch(void)
+{
+    int next = -1;
+    for(int i = 0; i < SIM_CORES; i++)
+    {
+        if(!sim_cores[i].started) continue;
+        if(next < 0 || sim_cores[i].wake_us < sim_cores[next].wake_us) next = i;
+    }
+
+    sim_advance_to(sim_cores[next].wake_us);
+
+    pthread_mutex_lock(&sim_lock);
+    sim_running = next;
+    pthread_cond_broadcast(&sim_cond);
+    while(sim_running != sim_self) pthread_cond_wait(&sim_cond, &sim_lock);
+    pthread_mutex_unlock(&sim_lock);
+}
+
+void sim_wait_until(uint64_t t_us)
+{
+    if(sim_in_irq())
+    {
+        // Espera ativa dentro de uma interrupção: só o relógio avança
+        if(t_us > sim_now_us) sim_now_us = t_us;
+        return;
+    }
+    sim_cores[sim_self].wake_us = t_us < sim_now_us ? sim_now_us : t_us;
+    sim_dispatch();
+}
+
+uint64_t time_us_64(void)
+{
+    return sim_now_us;
+}
+
+void busy_wait_us(uint64_t us)
+{
+    sim_wait_until(sim_now_us + us);
+}
+
+void sleep_until(absolute_time_t target)
+{
+    sim_wait_until(target);
+}
+
+void sleep_us(uint64_t us)
+{
+    sim_wait_until(sim_now_us + us);
+}
+
+void sleep_ms(uint32_t ms)
+{
+    sim_wait_until(sim_now_us + (uint64_t) ms * 1000u);
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout)
+{
+    sim_wait_until(timeout);
+    return true;
+}
+
+void __wfe(void)
+{
+    sim_wait_until(sim_now_us + 1u);
+}
+
+void __wfi(void)
+{
+    sim_wait_until(sim_now_us + 1u);
+}
+
+uint get_core_num(void)
+{
+    // As interrupções simuladas são as do núcleo 0, mesmo quando o núcleo 1 avança o relógio
+    return sim_in_irq() ? 0u : (uint) sim_self;
+}
+
+/** @brief Spin locks de hardware e as travas já reservadas. */
+#define SIM_SPIN_LOCKS 32
+static spin_lock_t sim_spin_locks[SIM_SPIN_LOCKS];
+static uint32_t sim_spin_locks_claimed = 0;
+
+spin_lock_t *spin_lock_instance(uint lock_num)
+{
+    return &sim_spin_locks[lock_num % SIM_SPIN_LOCKS];
+}
+
+int spin_lock_claim_unused(bool required)
+{
+    // Como no SDK, as travas 24 - 31 são as reservadas dinamicamente
+    for(int i = 24; i < SIM_SPIN_LOCKS; i++)
+    {
+        if(sim_spin_locks_claimed & (1u << i)) continue;
+        sim_spin_locks_claimed |= 1u << i;
+        return i;
+    }
+    if(required)
+    {
+        fprintf(stderr, "sim: sem spin lock livre\n");
+        exit(EXIT_FAILURE);
+    }
+    return -1;
+}
+
+/**
+ * @brief Evento de um temporizador repetitivo: chama o callback e reagenda.
+ *
+ * @param ctx Temporizador.
+ */
+static void sim_repeating_timer_fire(void *ctx)
+{
+    repeating_timer_t *timer = (repeating_timer_t *) ctx;
+    int32_t id = timer->alarm_id;
+    if(id == 0) return;
+
+    uint64_t start_us = sim_now_us;
+    bool again = timer->callback(timer);
+    if(!again || timer->alarm_id != id)
+    {
+        timer->alarm_id = 0;
+        return;
+    }
+
+    // Negativo: período entre inícios; positivo: intervalo após o fim do callback
+    uint64_t base_us = timer->delay_us < 0 ? start_us : sim_now_us;
+    uint64_t period_us = (uint64_t) (timer->delay_us < 0 ? -timer->delay_us : timer->delay_us);
+    sim_schedule(base_us + period_us, sim_repeating_timer_fire, timer);
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out)
+{
+    if(delay_us == 0) delay_us = 1;
+    out->delay_us = delay_us;
+    out->callback = callback;
+    out->user_data = user_data;
+    out->alarm_id = sim_next_alarm_id++;
+    uint64_t period_us = (uint64_t) (delay_us < 0 ? -delay_us : delay_us);
+    return sim_schedule(sim_now_us + period_us, sim_repeating_timer_fire, out);
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out)
+{
+    return add_repeating_timer_us((int64_t) delay_ms * 1000, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer)
+{
+    bool active = timer->alarm_id != 0;
+    timer->alarm_id = 0;
+    return active;
+}
+
+/**
+ * @brief Thread do núcleo 1: espera a ficha e executa o ponto de entrada.
+ */
+static void *sim_core1_thread(void *arg)
+{
+    (void) arg;
+    sim_self = 1;
+
+    pthread_mutex_lock(&sim_lock);
+    while(sim_running != sim_self) pthread_cond_wait(&sim_cond, &sim_lock);
+    pthread_mutex_unlock(&sim_lock);
+
+    sim_cores[1].entry();
+
+    // Ponto de entrada retornou: o núcleo para e não volta a ser escolhido
+    sim_cores[1].started = false;
+    sim_cores[1].wake_us = UINT64_MAX;
+    sim_dispatch();
+    return NULL;
+}
+
+void multicore_launch_core1(void (*entry)(void))
+{
+    sim_cores[1].entry = entry;
+    sim_cores[1].wake_us = sim_now_us;
+    sim_cores[1].started = true;
+    if(pthread_create(&sim_cores[1].thread, NULL, sim_core1_thread, NULL) != 0)
+    {
+        fprintf(stderr, "sim: falha ao criar a thread do nucleo 1\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask)
+{
+    (void) usb_activity_gpio_pin_mask;
+    (void) disable_interface_mask;
+    printf("sim: reset_usb_boot em t=%lluus\n", (unsigned long long) sim_now_us);
+    sim_finish();
+}
+
+uint32_t clock_get_hz(enum clock_index clk_index)
+{
+    switch(clk_index)
+    {
+        case clk_sys:
+        case clk_peri:
+            return sim_sys_clock_hz;
+        case clk_usb:
+        case clk_adc:
+            return 48000000u;
+        case clk_ref:
+            return 12000000u;
+        case clk_rtc:
+            return 46875u;
+        default:
+            return 125000000u;
+    }
+}
+
+uint32_t frequency_count_khz(uint src)
+{
+    return src == CLOCKS_FC0_SRC_VALUE_CLK_SYS ? sim_sys_clock_hz / 1000u : 0u;
+}
+
+bool set_sys_clock_khz(uint32_t freq_khz, bool required)
+{
+    (void) required;
+    sim_sys_clock_hz = freq_khz * 1000u;
+    return true;
+}
@@ -0,0 +1,136 @@
+#include "sim.h"
+#include "hardware/dma.h"
+#include "hardware/structs/systick.h"
+#include <stdlib.h>
+
+/**
+ * @file sim_dma.c
+ * @brief DMA simulado: nenhum canal disponível, para que os módulos usem o caminho por CPU.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+static dma_hw_t sim_dma_regs;
+dma_hw_t *const dma_hw = &sim_dma_regs;
+
+/** @brief SysTick parado: as sondas do profiler medem zero no tempo virtual. */
+static systick_hw_t sim_systick_regs;
+systick_hw_t *const systick_hw = &sim_systick_regs;
+
+int dma_claim_unused_channel(bool required)
+{
+    if(required)
+    {
+        fprintf(stderr, "sim: DMA nao e simulado\n");
+        exit(EXIT_FAILURE);
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel)
+{
+    (void) channel;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel)
+{
+    (void) channel;
+    dma_channel_config c = {0};
+    return c;
+}
+
+dma_channel_config dma_get_channel_config(uint channel)
+{
+    return dma_channel_get_default_config(channel);
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size)
+{
+    (void) c;
+    (void) size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr)
+{
+    (void) c;
+    (void) incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr)
+{
+    (void) c;
+    (void) incr;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq)
+{
+    (void) c;
+    (void) dreq;
+}
+
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to)
+{
+    (void) c;
+    (void) chain_to;
+}
+
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits)
+{
+    (void) c;
+    (void) write;
+    (void) size_bits;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger)
+{
+    (void) channel;
+    (void) config;
+    (void) write_addr;
+    (void) read_addr;
+    (void) transfer_count;
+    (void) trigger;
+}
+
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger)
+{
+    (void) channel;
+    (void) config;
+    (void) trigger;
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger)
+{
+    (void) channel;
+    (void) trans_count;
+    (void) trigger;
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger)
+{
+    (void) channel;
+    (void) read_addr;
+    (void) trigger;
+}
+
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger)
+{
+    (void) channel;
+    (void) write_addr;
+    (void) trigger;
+}
+
+void dma_channel_abort(uint channel)
+{
+    (void) channel;
+}
+
+bool dma_channel_is_busy(uint channel)
+{
+    (void) channel;
+    return false;
+}
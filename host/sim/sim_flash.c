@@ -0,0 +1,84 @@
+#include <string.h>
+#include "sim.h"
+#include "hardware/flash.h"
+#include "pico/flash.h"
+
+/**
+ * @file sim_flash.c
+ * @brief Flash simulada: apagamento por setor, gravação por página e custo em tempo.
+ *
+ * O núcleo que executa a operação fica bloqueado pelo tempo típico do W25Q16
+ * (45 ms por setor, 0,4 ms por página). A pausa do outro núcleo feita por
+ * `flash_safe_execute` no hardware não é simulada: ele continua executando,
+ * assim como as interrupções.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Tempos típicos do W25Q16JV. */
+#define SIM_FLASH_SECTOR_ERASE_US 45000u
+#define SIM_FLASH_PAGE_PROGRAM_US 400u
+
+uint8_t sim_flash_memory[PICO_FLASH_SIZE_BYTES];
+
+void sim_flash_init(void)
+{
+    memset(sim_flash_memory, 0xFF, sizeof(sim_flash_memory));
+}
+
+bool sim_flash_load(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if(file == NULL) return false;
+    size_t read = fread(sim_flash_memory, 1, sizeof(sim_flash_memory), file);
+    fclose(file);
+    return read == sizeof(sim_flash_memory);
+}
+
+bool sim_flash_save(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if(file == NULL) return false;
+    size_t written = fwrite(sim_flash_memory, 1, sizeof(sim_flash_memory), file);
+    return fclose(file) == 0 && written == sizeof(sim_flash_memory);
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count)
+{
+    if(flash_offs % FLASH_SECTOR_SIZE || count % FLASH_SECTOR_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES)
+    {
+        fprintf(stderr, "sim: flash_range_erase desalinhado (%u, %zu)\n", flash_offs, count);
+        return;
+    }
+    memset(&sim_flash_memory[flash_offs], 0xFF, count);
+    sim_wait_until(time_us_64() + (uint64_t) (count / FLASH_SECTOR_SIZE) * SIM_FLASH_SECTOR_ERASE_US);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count)
+{
+    if(flash_offs % FLASH_PAGE_SIZE || count % FLASH_PAGE_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES)
+    {
+        fprintf(stderr, "sim: flash_range_program desalinhado (%u, %zu)\n", flash_offs, count);
+        return;
+    }
+    // A gravação só leva bits de 1 para 0
+    for(size_t i = 0; i < count; i++)
+        sim_flash_memory[flash_offs + i] &= data[i];
+    sim_wait_until(time_us_64() + (uint64_t) (count / FLASH_PAGE_SIZE) * SIM_FLASH_PAGE_PROGRAM_US);
+}
+
+bool flash_safe_execute_core_init(void)
+{
+    return true;
+}
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms)
+{
+    (void) enter_exit_timeout_ms;
+    func(param);
+    return PICO_OK;
+}
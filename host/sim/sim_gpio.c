@@ -0,0 +1,86 @@
+#include "sim.h"
+
+/**
+ * @file sim_gpio.c
+ * @brief GPIO simulado: níveis, pull-ups e interrupções de borda injetadas.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+static bool sim_gpio_level[NUM_BANK0_GPIOS];
+static enum gpio_function sim_gpio_function[NUM_BANK0_GPIOS];
+static uint32_t sim_gpio_irq_mask[NUM_BANK0_GPIOS];
+static gpio_irq_callback_t sim_gpio_callback = NULL;
+
+void gpio_init(uint gpio)
+{
+    sim_gpio_function[gpio] = GPIO_FUNC_SIO;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn)
+{
+    sim_gpio_function[gpio] = fn;
+}
+
+enum gpio_function gpio_get_function(uint gpio)
+{
+    return sim_gpio_function[gpio];
+}
+
+void gpio_set_dir(uint gpio, bool out)
+{
+    (void) gpio;
+    (void) out;
+}
+
+void gpio_pull_up(uint gpio)
+{
+    sim_gpio_level[gpio] = true;
+}
+
+void gpio_pull_down(uint gpio)
+{
+    sim_gpio_level[gpio] = false;
+}
+
+void gpio_disable_pulls(uint gpio)
+{
+    (void) gpio;
+}
+
+bool gpio_get(uint gpio)
+{
+    return sim_gpio_level[gpio];
+}
+
+void gpio_put(uint gpio, bool value)
+{
+    sim_gpio_level[gpio] = value;
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled)
+{
+    if(enabled)
+        sim_gpio_irq_mask[gpio] |= event_mask;
+    else
+        sim_gpio_irq_mask[gpio] &= ~event_mask;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback)
+{
+    sim_gpio_callback = callback;
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+}
+
+void sim_gpio_set_level(uint gpio, bool level)
+{
+    if(sim_gpio_level[gpio] == level) return;
+    sim_gpio_level[gpio] = level;
+
+    uint32_t events = sim_gpio_irq_mask[gpio] & (level ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL);
+    if(events && sim_gpio_callback != NULL) sim_gpio_callback(gpio, events);
+}
@@ -0,0 +1,148 @@
+#include "sim.h"
+
+/**
+ * @file sim_i2c.c
+ * @brief Barramentos I2C simulados: roteamento por endereço e custo em tempo de barramento.
+ *
+ * O núcleo que inicia a transação fica bloqueado pelo tempo que ela ocupa no
+ * barramento (como `i2c_write_blocking` no hardware); o outro núcleo continua
+ * executando nesse intervalo.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Dispositivos por barramento. */
+#define SIM_I2C_MAX_DEVICES 4
+
+/**
+ * @brief Dispositivo conectado.
+ */
+typedef struct
+{
+    uint8_t addr;             /**< Endereço de 7 bits. */
+    sim_i2c_write_fn_t write; /**< Recebe as escritas. */
+    sim_i2c_read_fn_t read;   /**< Responde às leituras (ou `NULL`). */
+    void *ctx;                /**< Contexto do dispositivo. */
+} sim_i2c_device_t;
+
+/**
+ * @brief Barramento simulado.
+ */
+struct i2c_inst
+{
+    uint baudrate;                                   /**< Taxa configurada (0 = desligado). */
+    sim_i2c_device_t devices[SIM_I2C_MAX_DEVICES];   /**< Dispositivos conectados. */
+    uint8_t device_count;                            /**< Quantidade de dispositivos. */
+    uint32_t transactions;                           /**< Transações iniciadas. */
+    uint64_t bytes;                                  /**< Bytes de dados transferidos. */
+    uint64_t busy_us;                                /**< Tempo ocupado. */
+};
+
+i2c_inst_t i2c0_inst;
+i2c_inst_t i2c1_inst;
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate)
+{
+    return i2c_set_baudrate(i2c, baudrate);
+}
+
+void i2c_deinit(i2c_inst_t *i2c)
+{
+    i2c->baudrate = 0;
+}
+
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate)
+{
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+bool sim_i2c_attach(i2c_inst_t *i2c, uint8_t addr, sim_i2c_write_fn_t write, void *ctx)
+{
+    if(i2c->device_count >= SIM_I2C_MAX_DEVICES) return false;
+    sim_i2c_device_t *device = &i2c->devices[i2c->device_count++];
+    device->addr = addr;
+    device->write = write;
+    device->read = NULL;
+    device->ctx = ctx;
+    return true;
+}
+
+bool sim_i2c_set_reader(i2c_inst_t *i2c, uint8_t addr, sim_i2c_read_fn_t read)
+{
+    for(uint8_t i = 0; i < i2c->device_count; i++)
+    {
+        if(i2c->devices[i].addr != addr) continue;
+        i2c->devices[i].read = read;
+        return true;
+    }
+    return false;
+}
+
+uint32_t sim_i2c_transfer_us(uint baudrate, size_t len)
+{
+    // 9 bits por byte (8 + ACK), mais o byte de endereço, START e STOP
+    uint64_t bits = (uint64_t) (len + 1u) * 9u + 2u;
+    if(baudrate == 0) return 0;
+    return (uint32_t) ((bits * 1000000u + baudrate - 1u) / baudrate);
+}
+
+void sim_i2c_get_stats(i2c_inst_t *i2c, uint32_t *transactions, uint64_t *bytes, uint64_t *busy_us)
+{
+    if(transactions != NULL) *transactions = i2c->transactions;
+    if(bytes != NULL) *bytes = i2c->bytes;
+    if(busy_us != NULL) *busy_us = i2c->busy_us;
+}
+
+/**
+ * @brief Procura o dispositivo de um endereço.
+ *
+ * @param i2c Barramento.
+ * @param addr Endereço.
+ * @return Dispositivo, ou `NULL` se ninguém responde no endereço.
+ */
+static sim_i2c_device_t *sim_i2c_find(i2c_inst_t *i2c, uint8_t addr)
+{
+    for(uint8_t i = 0; i < i2c->device_count; i++)
+    {
+        if(i2c->devices[i].addr == addr) return &i2c->devices[i];
+    }
+    return NULL;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    sim_i2c_device_t *device = sim_i2c_find(i2c, addr);
+    i2c->transactions++;
+
+    // Sem dispositivo, o NACK vem logo após o byte de endereço
+    size_t sent = device != NULL ? len : 0u;
+    int result = device != NULL ? device->write(device->ctx, src, len, nostop) : PICO_ERROR_GENERIC;
+    if(result < 0) sent = 0;
+
+    uint32_t duration_us = sim_i2c_transfer_us(i2c->baudrate, sent);
+    i2c->bytes += sent;
+    i2c->busy_us += duration_us;
+    sim_wait_until(time_us_64() + duration_us);
+    return result < 0 ? PICO_ERROR_GENERIC : (int) sent;
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop)
+{
+    // Sem leitor, a leitura é respondida com NACK logo após o byte de endereço
+    sim_i2c_device_t *device = sim_i2c_find(i2c, addr);
+    i2c->transactions++;
+
+    int result = device != NULL && device->read != NULL ? device->read(device->ctx, dst, len, nostop)
+                                                         : PICO_ERROR_GENERIC;
+    size_t received = result < 0 ? 0u : len;
+    uint32_t duration_us = sim_i2c_transfer_us(i2c->baudrate, received);
+    i2c->bytes += received;
+    i2c->busy_us += duration_us;
+    sim_wait_until(time_us_64() + duration_us);
+    return result < 0 ? PICO_ERROR_GENERIC : (int) received;
+}
@@ -0,0 +1,141 @@
+#include "sim.h"
+#include "hardware/pwm.h"
+
+/**
+ * @file sim_pwm.c
+ * @brief PWM simulado: registradores em memória e registro das mudanças de nível.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+static pwm_hw_t sim_pwm_regs;
+pwm_hw_t *const pwm_hw = &sim_pwm_regs;
+
+/** @brief Último valor de CC registrado por slice, para detectar mudanças. */
+static uint32_t sim_pwm_logged_cc[NUM_PWM_SLICES];
+static FILE *sim_pwm_log = NULL;
+
+void sim_pwm_set_log(FILE *log)
+{
+    sim_pwm_log = log;
+}
+
+bool sim_pwm_is_output(uint gpio)
+{
+    return gpio < NUM_BANK0_GPIOS && gpio_get_function(gpio) == GPIO_FUNC_PWM;
+}
+
+uint16_t sim_pwm_get_level(uint gpio, uint32_t *period)
+{
+    const pwm_slice_hw_t *slice = &pwm_hw->slice[pwm_gpio_to_slice_num(gpio)];
+    if(period != NULL) *period = (slice->top & 0xFFFFu) + 1u;
+    return (uint16_t) (pwm_gpio_to_channel(gpio) ? slice->cc >> PWM_CH0_CC_B_LSB : slice->cc);
+}
+
+/**
+ * @brief Registra os canais de um slice cujo nível mudou desde o último registro.
+ *
+ * @param slice_num Slice.
+ */
+static void sim_pwm_record(uint slice_num)
+{
+    uint32_t cc = pwm_hw->slice[slice_num].cc;
+    uint32_t changed = cc ^ sim_pwm_logged_cc[slice_num];
+    sim_pwm_logged_cc[slice_num] = cc;
+    if(sim_pwm_log == NULL || changed == 0) return;
+
+    for(uint gpio = 0; gpio < NUM_BANK0_GPIOS; gpio++)
+    {
+        if(pwm_gpio_to_slice_num(gpio) != slice_num || !sim_pwm_is_output(gpio)) continue;
+        uint32_t bits = pwm_gpio_to_channel(gpio) ? PWM_CH0_CC_B_BITS : PWM_CH0_CC_A_BITS;
+        if(!(changed & bits)) continue;
+
+        uint32_t period;
+        uint16_t level = sim_pwm_get_level(gpio, &period);
+        fprintf(sim_pwm_log, "%llu %u %u %lu\n", (unsigned long long) time_us_64(), gpio, level,
+                (unsigned long) period);
+    }
+}
+
+void hw_write_masked(volatile uint32_t *addr, uint32_t values, uint32_t write_mask)
+{
+    *addr = (*addr & ~write_mask) | (values & write_mask);
+
+    for(uint s = 0; s < NUM_PWM_SLICES; s++)
+    {
+        if(addr == &pwm_hw->slice[s].cc) sim_pwm_record(s);
+    }
+}
+
+pwm_config pwm_get_default_config(void)
+{
+    pwm_config c = {0, 1u << PWM_CH0_DIV_INT_LSB, 0xFFFFu};
+    return c;
+}
+
+void pwm_config_set_clkdiv(pwm_config *c, float div)
+{
+    c->div = (uint32_t) (div * (float) (1u << PWM_CH0_DIV_INT_LSB));
+}
+
+void pwm_config_set_clkdiv_int(pwm_config *c, uint div)
+{
+    c->div = div << PWM_CH0_DIV_INT_LSB;
+}
+
+void pwm_config_set_wrap(pwm_config *c, uint16_t wrap)
+{
+    c->top = wrap;
+}
+
+void pwm_init(uint slice_num, pwm_config *c, bool start)
+{
+    pwm_slice_hw_t *slice = &pwm_hw->slice[slice_num];
+    slice->csr = 0;
+    slice->ctr = 0;
+    slice->cc = 0;
+    slice->top = c->top;
+    slice->div = c->div;
+    slice->csr = c->csr | (start ? PWM_CH0_CSR_EN_BITS : 0u);
+    sim_pwm_record(slice_num);
+}
+
+void pwm_set_clkdiv(uint slice_num, float divider)
+{
+    pwm_hw->slice[slice_num].div = (uint32_t) (divider * (float) (1u << PWM_CH0_DIV_INT_LSB));
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap)
+{
+    pwm_hw->slice[slice_num].top = wrap;
+}
+
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level)
+{
+    hw_write_masked(&pwm_hw->slice[slice_num].cc,
+                    (uint32_t) level << (chan ? PWM_CH0_CC_B_LSB : PWM_CH0_CC_A_LSB),
+                    chan ? PWM_CH0_CC_B_BITS : PWM_CH0_CC_A_BITS);
+}
+
+void pwm_set_both_levels(uint slice_num, uint16_t level_a, uint16_t level_b)
+{
+    hw_write_masked(&pwm_hw->slice[slice_num].cc,
+                    ((uint32_t) level_b << PWM_CH0_CC_B_LSB) | level_a, 0xFFFFFFFFu);
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level)
+{
+    pwm_set_chan_level(pwm_gpio_to_slice_num(gpio), pwm_gpio_to_channel(gpio), level);
+}
+
+void pwm_set_enabled(uint slice_num, bool enabled)
+{
+    if(enabled)
+        pwm_hw->slice[slice_num].csr |= PWM_CH0_CSR_EN_BITS;
+    else
+        pwm_hw->slice[slice_num].csr &= ~PWM_CH0_CSR_EN_BITS;
+}
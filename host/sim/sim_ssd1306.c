@@ -0,0 +1,241 @@
+#include "sim_ssd1306.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file sim_ssd1306.c
+ * @brief Decodificação dos comandos e dados do SSD1306 e exportação dos quadros.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Bits do byte de controle. */
+#define SIM_SSD1306_CONTROL_CO 0x80u
+#define SIM_SSD1306_CONTROL_DC 0x40u
+
+void sim_ssd1306_init(sim_ssd1306_t *display)
+{
+    memset(display, 0, sizeof(*display));
+    display->addr_mode = 2;
+    display->col_end = SIM_SSD1306_WIDTH - 1;
+    display->page_end = SIM_SSD1306_PAGES - 1;
+    display->contrast = 0x7F;
+}
+
+/**
+ * @brief Quantidade de bytes (opcode incluído) de um comando.
+ *
+ * @param opcode Primeiro byte do comando.
+ * @return Tamanho total do comando.
+ */
+static uint8_t sim_ssd1306_command_length(uint8_t opcode)
+{
+    switch(opcode)
+    {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 2;
+        case 0x21: case 0x22: case 0xA3:
+            return 3;
+        case 0x29: case 0x2A:
+            return 6;
+        case 0x26: case 0x27:
+            return 7;
+        default:
+            return 1;
+    }
+}
+
+/**
+ * @brief Executa um comando completo.
+ *
+ * @param display Controlador.
+ */
+static void sim_ssd1306_execute(sim_ssd1306_t *display)
+{
+    const uint8_t *cmd = display->cmd;
+    uint8_t op = cmd[0];
+    display->commands++;
+
+    if(op <= 0x0F)
+    {
+        display->col = (uint8_t) ((display->col & 0xF0u) | op); // Coluna inicial (nibble baixo), modo página
+    }
+    else if(op <= 0x1F)
+    {
+        display->col = (uint8_t) ((display->col & 0x0Fu) | ((op & 0x07u) << 4));
+    }
+    else if(op >= 0x40 && op <= 0x7F)
+    {
+        display->start_line = op & 0x3Fu;
+    }
+    else if(op >= 0xB0 && op <= 0xB7)
+    {
+        display->page = op & 0x07u;
+    }
+    else
+    {
+        switch(op)
+        {
+            case 0x20:
+                display->addr_mode = cmd[1] & 0x03u;
+                break;
+            case 0x21:
+                display->col_start = cmd[1] & 0x7Fu;
+                display->col_end = cmd[2] & 0x7Fu;
+                display->col = display->col_start;
+                break;
+            case 0x22:
+                display->page_start = cmd[1] & 0x07u;
+                display->page_end = cmd[2] & 0x07u;
+                display->page = display->page_start;
+                break;
+            case 0x81:
+                display->contrast = cmd[1];
+                break;
+            case 0xA0: case 0xA1:
+                display->seg_remap = op & 1u;
+                break;
+            case 0xA4: case 0xA5:
+                display->entire_on = op & 1u;
+                break;
+            case 0xA6: case 0xA7:
+                display->inverted = op & 1u;
+                break;
+            case 0xAE: case 0xAF:
+                display->display_on = op & 1u;
+                break;
+            case 0xC0: case 0xC8:
+                display->com_remap = (op & 0x08u) != 0;
+                break;
+            default:
+                break; // Temporização, carga, multiplexação e rolagem não afetam a imagem simulada
+        }
+    }
+}
+
+/**
+ * @brief Recebe um byte de comando, montando comandos com argumentos.
+ *
+ * @param display Controlador.
+ * @param byte Byte recebido.
+ */
+static void sim_ssd1306_command_byte(sim_ssd1306_t *display, uint8_t byte)
+{
+    if(display->cmd_len == 0) display->cmd_need = sim_ssd1306_command_length(byte);
+    display->cmd[display->cmd_len++] = byte;
+    if(display->cmd_len < display->cmd_need) return;
+
+    sim_ssd1306_execute(display);
+    display->cmd_len = 0;
+}
+
+/**
+ * @brief Grava um byte na GDDRAM e avança os ponteiros conforme o modo de endereçamento.
+ *
+ * @param display Controlador.
+ * @param byte Byte de dados.
+ */
+static void sim_ssd1306_data_byte(sim_ssd1306_t *display, uint8_t byte)
+{
+    display->gddram[display->page & 0x07u][display->col & 0x7Fu] = byte;
+    display->data_bytes++;
+
+    switch(display->addr_mode)
+    {
+        case 0: // Horizontal: coluna, depois página
+            if(display->col++ >= display->col_end)
+            {
+                display->col = display->col_start;
+                display->page = display->page >= display->page_end ? display->page_start : display->page + 1u;
+                display->window_done |= display->page == display->page_start;
+            }
+            break;
+        case 1: // Vertical: página, depois coluna
+            if(display->page++ >= display->page_end)
+            {
+                display->page = display->page_start;
+                display->col = display->col >= display->col_end ? display->col_start : display->col + 1u;
+                display->window_done |= display->col == display->col_start;
+            }
+            break;
+        default: // Página: só a coluna avança, voltando ao início da linha; sem janela, cada transação é um quadro
+            display->col = display->col >= SIM_SSD1306_WIDTH - 1 ? 0 : display->col + 1u;
+            display->window_done = true;
+            break;
+    }
+}
+
+int sim_ssd1306_write(void *ctx, const uint8_t *src, size_t len, bool nostop)
+{
+    sim_ssd1306_t *display = (sim_ssd1306_t *) ctx;
+    bool wrote_data = false;
+    size_t i = 0;
+    (void) nostop;
+    display->window_done = false;
+
+    while(i < len)
+    {
+        uint8_t control = src[i++];
+        bool data = (control & SIM_SSD1306_CONTROL_DC) != 0;
+
+        // Co = 1: um único byte segue este controle; Co = 0: o restante da transação
+        size_t end = (control & SIM_SSD1306_CONTROL_CO) ? (i < len ? i + 1u : len) : len;
+        wrote_data |= data && end > i;
+        for(; i < end; i++)
+        {
+            if(data)
+                sim_ssd1306_data_byte(display, src[i]);
+            else
+                sim_ssd1306_command_byte(display, src[i]);
+        }
+    }
+
+    if(wrote_data && display->window_done)
+    {
+        display->data_writes++;
+        if(display->on_data != NULL) display->on_data(display->on_data_ctx, display);
+    }
+    return (int) len;
+}
+
+bool sim_ssd1306_get_pixel(const sim_ssd1306_t *display, uint x, uint y)
+{
+    if(!display->display_on) return false;
+    if(display->entire_on) return true;
+
+    uint col = display->seg_remap ? x : SIM_SSD1306_WIDTH - 1u - x;
+    uint row = display->com_remap ? y : SIM_SSD1306_HEIGHT - 1u - y;
+    row = (row + display->start_line) % SIM_SSD1306_HEIGHT;
+
+    bool lit = (display->gddram[row >> 3][col] >> (row & 7u)) & 1u;
+    return lit != display->inverted;
+}
+
+bool sim_ssd1306_write_pbm(const sim_ssd1306_t *display, const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if(file == NULL) return false;
+
+    fprintf(file, "P4\n%d %d\n", SIM_SSD1306_WIDTH, SIM_SSD1306_HEIGHT);
+    for(uint y = 0; y < SIM_SSD1306_HEIGHT; y++)
+    {
+        uint8_t row[SIM_SSD1306_WIDTH / 8];
+        for(uint b = 0; b < sizeof(row); b++)
+        {
+            uint8_t bits = 0;
+            for(uint k = 0; k < 8; k++)
+            {
+                // No PBM, 1 é preto: pixels apagados
+                if(!sim_ssd1306_get_pixel(display, b * 8u + k, y)) bits |= (uint8_t) (0x80u >> k);
+            }
+            row[b] = bits;
+        }
+        fwrite(row, 1, sizeof(row), file);
+    }
+    return fclose(file) == 0;
+}
@@ -0,0 +1,119 @@
+#ifndef SIM_SSD1306_H
+#define SIM_SSD1306_H
+
+#include "pico/types.h"
+
+/**
+ * @file sim_ssd1306.h
+ * @brief Controlador SSD1306 simulado: decodifica os bytes do I2C em uma GDDRAM virtual.
+ *
+ * Interpreta o byte de controle (Co, D/C) de cada transação, os comandos de
+ * configuração e de endereçamento (modos horizontal, vertical e de página,
+ * janelas de coluna e página, remapeamentos) e grava os dados na GDDRAM de
+ * 128x64. Comandos cujos argumentos chegam em transações separadas (como faz
+ * `ssd1306_command`) são montados entre transações.
+ *
+ * O quadro visível considera o remapeamento de segmentos e a varredura de COM
+ * da forma como o módulo é montado: com `SET_SEG_REMAP | 1` e `SET_COM_OUT_DIR
+ * | 8`, a coluna 0 da RAM fica à esquerda e a página 0 no topo.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Sim_SSD1306 SSD1306 simulado
+ * @brief GDDRAM virtual alimentada pelas transações I2C.
+ * @{
+ */
+
+#define SIM_SSD1306_WIDTH 128
+#define SIM_SSD1306_HEIGHT 64
+#define SIM_SSD1306_PAGES (SIM_SSD1306_HEIGHT / 8)
+
+typedef struct sim_ssd1306 sim_ssd1306_t;
+
+/**
+ * @brief Callback chamado ao fim de cada transação que completou a janela de endereçamento.
+ *
+ * Um quadro enviado em trechos notifica uma vez; no modo página, toda
+ * transação com dados notifica.
+ */
+typedef void (*sim_ssd1306_data_fn_t)(void *ctx, const sim_ssd1306_t *display);
+
+/**
+ * @brief Estado do controlador.
+ */
+struct sim_ssd1306
+{
+    uint8_t gddram[SIM_SSD1306_PAGES][SIM_SSD1306_WIDTH]; /**< Memória de vídeo. */
+    uint8_t addr_mode;        /**< 0 = horizontal, 1 = vertical, 2 = página. */
+    uint8_t col_start;        /**< Janela de colunas. */
+    uint8_t col_end;
+    uint8_t page_start;       /**< Janela de páginas. */
+    uint8_t page_end;
+    uint8_t col;              /**< Ponteiro de coluna. */
+    uint8_t page;             /**< Ponteiro de página. */
+    uint8_t start_line;       /**< Linha inicial da varredura. */
+    uint8_t contrast;         /**< Contraste. */
+    bool display_on;          /**< Painel ligado. */
+    bool inverted;            /**< Vídeo inverso. */
+    bool entire_on;           /**< Todos os pixels acesos, ignorando a RAM. */
+    bool seg_remap;           /**< Coluna 127 no SEG0. */
+    bool com_remap;           /**< Varredura de COM invertida. */
+    uint8_t cmd[8];           /**< Comando em montagem (opcode e argumentos). */
+    uint8_t cmd_len;          /**< Bytes recebidos do comando em montagem. */
+    uint8_t cmd_need;         /**< Bytes que o comando em montagem exige. */
+    uint32_t commands;        /**< Comandos completos recebidos. */
+    uint64_t data_bytes;      /**< Bytes gravados na GDDRAM. */
+    bool window_done;         /**< A transação em curso completou a janela (ponteiros de volta ao início). */
+    uint32_t data_writes;     /**< Quadros: transações que completaram a janela. */
+    sim_ssd1306_data_fn_t on_data; /**< Notificação de dados gravados. */
+    void *on_data_ctx;        /**< Contexto da notificação. */
+};
+
+/**
+ * @brief Inicializa o controlador no estado de reset (painel desligado).
+ *
+ * @param[out] display Controlador.
+ */
+void sim_ssd1306_init(sim_ssd1306_t *display);
+
+/**
+ * @brief Recebe uma transação de escrita (compatível com `sim_i2c_write_fn_t`).
+ *
+ * @param[in,out] ctx Controlador.
+ * @param[in] src Bytes da transação (sem o endereço).
+ * @param[in] len Quantidade de bytes.
+ * @param[in] nostop Ignorado.
+ * @return `len`.
+ */
+int sim_ssd1306_write(void *ctx, const uint8_t *src, size_t len, bool nostop);
+
+/**
+ * @brief Estado visível de um pixel, com remapeamentos, inversão e painel desligado.
+ *
+ * @param[in] display Controlador.
+ * @param[in] x Coluna visível (0-127).
+ * @param[in] y Linha visível (0-63).
+ * @return `true` se o pixel está aceso.
+ */
+bool sim_ssd1306_get_pixel(const sim_ssd1306_t *display, uint x, uint y);
+
+/**
+ * @brief Grava o quadro visível em PBM binário (P4): aceso = branco, apagado = preto.
+ *
+ * @param[in] display Controlador.
+ * @param[in] path Caminho do arquivo.
+ * @return `true` se o arquivo foi gravado.
+ */
+bool sim_ssd1306_write_pbm(const sim_ssd1306_t *display, const char *path);
+
+/** @} */ // Fim do grupo "Sim_SSD1306"
+
+#endif // SIM_SSD1306_H
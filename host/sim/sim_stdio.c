@@ -0,0 +1,40 @@
+#include "sim.h"
+
+/**
+ * @file sim_stdio.c
+ * @brief stdio simulado: saída no stdout do processo e entrada pelas teclas injetadas.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Capacidade da fila de teclas (potência de dois). */
+#define SIM_STDIN_SIZE 64u
+
+static char sim_stdin_buffer[SIM_STDIN_SIZE];
+static uint32_t sim_stdin_head = 0;
+static uint32_t sim_stdin_tail = 0;
+
+bool stdio_init_all(void)
+{
+    return true;
+}
+
+void sim_stdin_push(char c)
+{
+    if(sim_stdin_head - sim_stdin_tail >= SIM_STDIN_SIZE) return;
+    sim_stdin_buffer[sim_stdin_head++ & (SIM_STDIN_SIZE - 1u)] = c;
+}
+
+int getchar_timeout_us(uint32_t timeout_us)
+{
+    if(sim_stdin_head == sim_stdin_tail && timeout_us > 0)
+    {
+        sim_wait_until(time_us_64() + timeout_us);
+    }
+    if(sim_stdin_head == sim_stdin_tail) return PICO_ERROR_TIMEOUT;
+    return (unsigned char) sim_stdin_buffer[sim_stdin_tail++ & (SIM_STDIN_SIZE - 1u)];
+}
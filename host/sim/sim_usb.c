@@ -0,0 +1,103 @@
+#include "sim.h"
+#include "tusb.h"
+
+/**
+ * @file sim_usb.c
+ * @brief Host USB simulado: início de quadro a cada 1 ms, relatórios HID e interfaces CDC.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Interfaces CDC. */
+#define SIM_USB_CDC_COUNT 2
+
+/** @brief Bytes aceitos por interface CDC a cada quadro (um pacote bulk de tamanho máximo). */
+#define SIM_USB_CDC_PACKET 64u
+
+static bool sim_usb_sof_enabled = false;
+static uint32_t sim_usb_frame = 0;
+static uint32_t sim_usb_hid_reports = 0;
+static FILE *sim_usb_cdc_out[SIM_USB_CDC_COUNT];
+static uint32_t sim_usb_cdc_budget[SIM_USB_CDC_COUNT];
+
+/**
+ * @brief Início de quadro USB: renova a vazão das interfaces CDC e chama `tud_sof_cb`.
+ */
+static void sim_usb_sof(void *ctx)
+{
+    (void) ctx;
+    for(uint i = 0; i < SIM_USB_CDC_COUNT; i++)
+    {
+        sim_usb_cdc_budget[i] = SIM_USB_CDC_PACKET;
+    }
+    if(!sim_usb_sof_enabled) return;
+
+    tud_sof_cb(sim_usb_frame++ & 0x7FFu);
+    sim_schedule(time_us_64() + 1000u, sim_usb_sof, NULL);
+}
+
+bool tusb_init(void)
+{
+    return true;
+}
+
+void tud_sof_cb_enable(bool en)
+{
+    bool was_enabled = sim_usb_sof_enabled;
+    sim_usb_sof_enabled = en;
+    if(en && !was_enabled) sim_schedule(time_us_64() + 1000u, sim_usb_sof, NULL);
+}
+
+bool tud_hid_n_ready(uint8_t instance)
+{
+    (void) instance;
+    return true;
+}
+
+bool tud_hid_n_report(uint8_t instance, uint8_t report_id, void const *report, uint16_t len)
+{
+    (void) instance;
+    (void) report_id;
+    (void) report;
+    (void) len;
+    sim_usb_hid_reports++;
+    return true;
+}
+
+uint32_t sim_usb_get_hid_report_count(void)
+{
+    return sim_usb_hid_reports;
+}
+
+void sim_usb_set_cdc_output(uint8_t itf, FILE *out)
+{
+    if(itf < SIM_USB_CDC_COUNT) sim_usb_cdc_out[itf] = out;
+}
+
+bool tud_cdc_n_connected(uint8_t itf)
+{
+    return itf < SIM_USB_CDC_COUNT && sim_usb_cdc_out[itf] != NULL;
+}
+
+uint32_t tud_cdc_n_write_available(uint8_t itf)
+{
+    return tud_cdc_n_connected(itf) ? sim_usb_cdc_budget[itf] : 0u;
+}
+
+uint32_t tud_cdc_n_write(uint8_t itf, void const *buffer, uint32_t bufsize)
+{
+    if(!tud_cdc_n_connected(itf)) return 0;
+    if(bufsize > sim_usb_cdc_budget[itf]) bufsize = sim_usb_cdc_budget[itf];
+    sim_usb_cdc_budget[itf] -= bufsize;
+    return (uint32_t) fwrite(buffer, 1, bufsize, sim_usb_cdc_out[itf]);
+}
+
+uint32_t tud_cdc_n_write_flush(uint8_t itf)
+{
+    if(tud_cdc_n_connected(itf)) fflush(sim_usb_cdc_out[itf]);
+    return 0;
+}
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Confere as ferramentas de tools/ com os arquivos gravados pelos testes do build nativo.
+
+Cada modo lê o diretório preenchido pelo executável de mesmo nome e falha
+(código de saída 1) na primeira divergência:
+
+    cobs      test_cobs: cobs_decode e read_frames de telemetry_decode.py
+    recorder  test_recorder: recorder_decode.py sobre flash.bin
+    mirror    test_fb_mirror: fb_mirror_view.py sobre stream.bin
+
+Uso:
+    check_decoders.py cobs build-host/tests
+"""
+
+import argparse
+import csv
+import io
+import os
+import subprocess
+import sys
+import tempfile
+
+TOOLS = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "tools")
+sys.path.insert(0, TOOLS)
+
+from fb_mirror_view import FB_SIZE, write_pbm  # noqa: E402
+from telemetry_decode import cobs_decode, read_frames  # noqa: E402
+
+
+def fail(message):
+    print(f"falhou: {message}", file=sys.stderr)
+    sys.exit(1)
+
+
+def read_csv(path):
+    with open(path, newline="") as handle:
+        return list(csv.reader(handle))
+
+
+def run_tool(name, *args):
+    subprocess.run([sys.executable, os.path.join(TOOLS, name), *args], check=True)
+
+
+def check_cobs(directory):
+    vectors = []
+    with open(os.path.join(directory, "cobs.txt")) as handle:
+        for line in handle:
+            payload, frame = line.split()
+            vectors.append((bytes.fromhex(payload) if payload != "-" else b"", bytes.fromhex(frame)))
+    for n, (payload, frame) in enumerate(vectors):
+        if cobs_decode(frame[:-1]) != payload:
+            fail(f"vetor {n} ({len(payload)} bytes) decodifica diferente")
+    frames = list(read_frames(io.BytesIO(b"".join(frame for _, frame in vectors))))
+    if [cobs_decode(frame) for frame in frames] != [payload for payload, _ in vectors]:
+        fail("fluxo concatenado decodifica diferente")
+    return f"{len(vectors)} vetores"
+
+
+def check_recorder(directory):
+    with tempfile.TemporaryDirectory() as output:
+        run_tool("recorder_decode.py", os.path.join(directory, "flash.bin"), "-o", output)
+        for name in ("samples", "events"):
+            decoded = read_csv(os.path.join(output, f"{name}.csv"))
+            expected = read_csv(os.path.join(directory, f"expected_{name}.csv"))
+            for n, (got, want) in enumerate(zip(decoded, expected)):
+                if got != want:
+                    fail(f"{name}.csv, linha {n + 1}: {got} != {want}")
+            if len(decoded) != len(expected):
+                fail(f"{name}.csv: {len(decoded)} linhas, esperadas {len(expected)}")
+    return f"{len(read_csv(os.path.join(directory, 'expected_samples.csv'))) - 1} amostras"
+
+
+def check_mirror(directory):
+    with open(os.path.join(directory, "expected.bin"), "rb") as handle:
+        data = handle.read()
+    expected = [data[i:i + FB_SIZE] for i in range(0, len(data), FB_SIZE)]
+    with tempfile.TemporaryDirectory() as output:
+        run_tool("fb_mirror_view.py", os.path.join(directory, "stream.bin"), "-o", output)
+        index = read_csv(os.path.join(output, "frames.csv"))[1:]
+        if len(index) != len(expected):
+            fail(f"{len(index)} quadros reconstruídos, esperados {len(expected)}")
+        reference = os.path.join(output, "expected.pbm")
+        for (name, *_), framebuffer in zip(index, expected):
+            write_pbm(reference, framebuffer)
+            with open(reference, "rb") as want, open(os.path.join(output, name), "rb") as got:
+                if got.read() != want.read():
+                    fail(f"{name} difere do framebuffer capturado")
+        if index and index[0][3] != "1":
+            fail("o primeiro quadro não é quadro-chave")
+    return f"{len(expected)} quadros"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("mode", choices=("cobs", "recorder", "mirror"))
+    parser.add_argument("directory", help="diretório gravado pelo teste")
+    args = parser.parse_args()
+    check = {"cobs": check_cobs, "recorder": check_recorder, "mirror": check_mirror}[args.mode]
+    print(f"{args.mode}: ok ({check(args.directory)})")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,64 @@
+# Teste de regressão do build nativo: executa o roteiro de demonstração no
+# joytracker_sim e compara os quadros enviados ao OLED (PBM) e o resumo
+# impresso (comandos do console e estatísticas da simulação) com os de
+# referência. A simulação é determinística: qualquer diferença é uma mudança
+# de comportamento.
+#
+#   cmake -DSIM=joytracker_sim -DSCRIPT=demo.txt -DDURATION_MS=3000 -DGOLDEN=golden/demo -DWORK=dir
+#         [-DUPDATE=ON] -P demo_golden.cmake
+#
+# Com UPDATE=ON, os arquivos de referência são substituídos pela execução atual
+# (alvo `update_golden` do build nativo).
+
+foreach(var SIM SCRIPT DURATION_MS GOLDEN WORK)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "demo_golden: ${var} não definido")
+    endif()
+endforeach()
+
+file(REMOVE_RECURSE ${WORK})
+file(MAKE_DIRECTORY ${WORK}/frames)
+execute_process(COMMAND ${SIM} -s ${SCRIPT} -t ${DURATION_MS} -f ${WORK}/frames
+                OUTPUT_FILE ${WORK}/stats.txt ERROR_FILE ${WORK}/stderr.txt RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "demo_golden: ${SIM} terminou com ${result}")
+endif()
+
+if(UPDATE)
+    file(REMOVE_RECURSE ${GOLDEN})
+    file(MAKE_DIRECTORY ${GOLDEN})
+    file(COPY ${WORK}/frames ${WORK}/stats.txt DESTINATION ${GOLDEN})
+    message(STATUS "demo_golden: referência atualizada em ${GOLDEN}")
+    return()
+endif()
+
+file(GLOB expected_frames RELATIVE ${GOLDEN}/frames ${GOLDEN}/frames/*.pbm)
+file(GLOB actual_frames RELATIVE ${WORK}/frames ${WORK}/frames/*.pbm)
+list(SORT expected_frames)
+list(SORT actual_frames)
+set(failures "")
+if(NOT expected_frames STREQUAL actual_frames)
+    list(LENGTH expected_frames expected_count)
+    list(LENGTH actual_frames actual_count)
+    list(APPEND failures "quadros: ${actual_count} gravados, ${expected_count} na referência")
+endif()
+
+foreach(frame ${expected_frames})
+    if(EXISTS ${WORK}/frames/${frame})
+        execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${GOLDEN}/frames/${frame} ${WORK}/frames/${frame}
+                        RESULT_VARIABLE differs)
+        if(differs)
+            list(APPEND failures "quadro ${frame} difere")
+        endif()
+    endif()
+endforeach()
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${GOLDEN}/stats.txt ${WORK}/stats.txt RESULT_VARIABLE differs)
+if(differs)
+    list(APPEND failures "resumo (stats.txt) difere")
+endif()
+
+if(failures)
+    string(REPLACE ";" "\n  " report "${failures}")
+    message(FATAL_ERROR "demo_golden: saída diferente da referência (${WORK}):\n  ${report}")
+endif()
@@ -0,0 +1,92 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @file test.h
+ * @brief Verificações e gerador pseudoaleatório dos testes do build nativo (host/tests).
+ *
+ * Cada teste é um executável registrado no CTest: as verificações que falham
+ * são impressas com arquivo e linha, e o código de saída é o resultado. O
+ * gerador é fixo (xorshift32), para que uma falha se repita em qualquer
+ * plataforma.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Test Testes do build nativo
+ * @brief Verificações e gerador dos testes.
+ * @{
+ */
+
+/** @brief Verificações que falharam no executável. */
+static unsigned test_failures = 0;
+
+/** @brief Estado do gerador pseudoaleatório. */
+static uint32_t test_random_state = 2463534242u;
+
+/**
+ * @brief Verifica uma condição; se falsa, imprime a mensagem formatada e conta a falha.
+ */
+#define TEST_CHECK(cond, ...)                                                      \
+    do                                                                             \
+    {                                                                              \
+        if(!(cond))                                                                \
+        {                                                                          \
+            test_failures++;                                                       \
+            fprintf(stderr, "%s:%d: falhou: %s: ", __FILE__, __LINE__, #cond);     \
+            fprintf(stderr, __VA_ARGS__);                                          \
+            fputc('\n', stderr);                                                   \
+        }                                                                          \
+    } while(0)
+
+/**
+ * @brief Próximo valor do gerador (xorshift32).
+ */
+static inline uint32_t test_random(void)
+{
+    uint32_t x = test_random_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    test_random_state = x;
+    return x;
+}
+
+/**
+ * @brief Valor do gerador em `[0, n)`.
+ */
+static inline uint32_t test_random_below(uint32_t n)
+{
+    return test_random() % n;
+}
+
+/**
+ * @brief Imprime o resultado do executável e devolve o código de saída.
+ *
+ * @param[in] name Nome do teste.
+ * @return 0 sem falhas, 1 com alguma.
+ */
+static inline int test_result(const char *name)
+{
+    if(test_failures != 0)
+    {
+        printf("%s: %u verificacoes falharam\n", name, test_failures);
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+/** @} */ // Fim do grupo "Test"
+
+#endif // TEST_H
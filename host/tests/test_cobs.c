@@ -0,0 +1,113 @@
+#include <stdlib.h>
+#include <string.h>
+#include "telemetry.h"
+#include "test.h"
+
+/**
+ * @file test_cobs.c
+ * @brief Vetores de `telemetry_cobs_encode`, decodificados por tools/telemetry_decode.py.
+ *
+ * Blocos nas fronteiras do código COBS (254 e 255 bytes sem zero), só de
+ * zeros, sem zeros e ao acaso são codificados aqui; o quadro deve terminar no
+ * delimitador, sem outro zero, e caber no tamanho documentado. O arquivo
+ * `cobs.txt` (uma linha `<bloco> <quadro>` em hexadecimal por vetor) é
+ * conferido por check_decoders.py com `cobs_decode` e `read_frames`.
+ *
+ * Uso: test_cobs <diretório>
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Maior bloco dos vetores. */
+#define TEST_MAX_LEN 1100u
+
+/** @brief Vetores ao acaso, além dos de fronteira. */
+#define TEST_RANDOM_VECTORS 300
+
+/** @brief Conteúdo dos vetores. */
+typedef enum
+{
+    TEST_FILL_ZEROS,   /**< Só zeros. */
+    TEST_FILL_NONZERO, /**< Nenhum zero. */
+    TEST_FILL_SPARSE,  /**< Zeros esparsos. */
+    TEST_FILL_RANDOM,  /**< Bytes ao acaso. */
+    TEST_FILL_COUNT,
+} test_fill_t;
+
+static uint8_t test_src[TEST_MAX_LEN];
+static uint8_t test_dst[TEST_MAX_LEN + TEST_MAX_LEN / 254u + 2u + 1u];
+
+/**
+ * @brief Grava `data` em hexadecimal (`-` se vazio).
+ */
+static void test_write_hex(FILE *file, const uint8_t *data, uint32_t len)
+{
+    if(len == 0) fputc('-', file);
+    for(uint32_t i = 0; i < len; i++) fprintf(file, "%02x", data[i]);
+}
+
+/**
+ * @brief Codifica um vetor, verifica o quadro e o grava em `file`.
+ */
+static void test_vector(FILE *file, uint32_t len, test_fill_t fill)
+{
+    for(uint32_t i = 0; i < len; i++)
+    {
+        switch(fill)
+        {
+        case TEST_FILL_ZEROS: test_src[i] = 0; break;
+        case TEST_FILL_NONZERO: test_src[i] = (uint8_t) (1u + test_random_below(255)); break;
+        case TEST_FILL_SPARSE: test_src[i] = test_random_below(40) == 0 ? 0 : (uint8_t) (1u + test_random_below(255)); break;
+        default: test_src[i] = (uint8_t) test_random(); break;
+        }
+    }
+
+    // Um byte de guarda após o tamanho máximo documentado
+    uint32_t bound = len + len / 254u + 2u;
+    test_dst[bound] = 0xA5;
+    uint32_t out = telemetry_cobs_encode(test_src, len, test_dst);
+    TEST_CHECK(out <= bound && test_dst[bound] == 0xA5, "len=%u: %u bytes, limite %u", (unsigned) len,
+               (unsigned) out, (unsigned) bound);
+    TEST_CHECK(out >= len + 2u && test_dst[out - 1] == 0x00, "len=%u: quadro sem delimitador", (unsigned) len);
+    TEST_CHECK(memchr(test_dst, 0x00, out - 1u) == NULL, "len=%u: zero dentro do quadro", (unsigned) len);
+
+    test_write_hex(file, test_src, len);
+    fputc(' ', file);
+    test_write_hex(file, test_dst, out);
+    fputc('\n', file);
+}
+
+int main(int argc, char **argv)
+{
+    if(argc != 2)
+    {
+        fprintf(stderr, "uso: %s <diretorio>\n", argv[0]);
+        return 2;
+    }
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/cobs.txt", argv[1]);
+    FILE *file = fopen(path, "w");
+    if(file == NULL)
+    {
+        perror(path);
+        return 2;
+    }
+
+    // Fronteiras dos blocos de 254 bytes, com cada tipo de conteúdo
+    static const uint32_t lengths[] = {0, 1, 2, 253, 254, 255, 256, 507, 508, 509, 510, 1016, TEST_MAX_LEN};
+    for(uint32_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        for(int fill = 0; fill < TEST_FILL_COUNT; fill++) test_vector(file, lengths[i], (test_fill_t) fill);
+    }
+    for(int i = 0; i < TEST_RANDOM_VECTORS; i++)
+    {
+        test_vector(file, test_random_below(TEST_MAX_LEN + 1u), (test_fill_t) test_random_below(TEST_FILL_COUNT));
+    }
+
+    TEST_CHECK(fclose(file) == 0, "%s", path);
+    return test_result("test_cobs");
+}
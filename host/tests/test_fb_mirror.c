@@ -0,0 +1,144 @@
+#include <string.h>
+#include "fb_mirror.h"
+#include "sim.h"
+#include "test.h"
+
+/**
+ * @file test_fb_mirror.c
+ * @brief Deltas XOR + RLE de lib/fb_mirror.c, reconstruídos por tools/fb_mirror_view.py.
+ *
+ * Uma sequência de quadros (sem mudança, bytes isolados, faixas preenchidas,
+ * telas ao acaso) é capturada e drenada em trechos de tamanhos variados para
+ * `stream.bin`, como a interface CDC receberia. Cada quadro emitido é gravado
+ * em `expected.bin` (FB_MIRROR_FB_SIZE bytes por quadro); check_decoders.py
+ * reconstrói o fluxo e compara os PBMs.
+ *
+ * Uso: test_fb_mirror <diretório>
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Quadros capturados (passa de alguns quadros-chave periódicos). */
+#define TEST_FRAMES 400
+
+/** @brief Maior delta de um único byte alterado: os saltos até ele e o literal. */
+#define TEST_SINGLE_BYTE_MAX (FB_MIRROR_FB_SIZE / FB_MIRROR_TOKEN_MAX_RUN + 2u)
+
+static uint8_t test_fb[FB_MIRROR_FB_SIZE];
+static FILE *test_stream;
+
+static void test_write(const uint8_t *data, uint32_t len)
+{
+    fwrite(data, 1, len, test_stream);
+}
+
+/**
+ * @brief Altera o quadro; devolve `true` se só um byte mudou.
+ */
+static bool test_mutate(void)
+{
+    uint32_t kind = test_random_below(10);
+    if(kind < 2) return false; // Sem mudança
+    if(kind < 4)
+    {
+        uint32_t i = test_random_below(FB_MIRROR_FB_SIZE);
+        test_fb[i] = (uint8_t) (test_fb[i] ^ (1u + test_random_below(255)));
+        return true;
+    }
+    if(kind < 8)
+    {
+        uint32_t count = 1u + test_random_below(12);
+        for(uint32_t k = 0; k < count; k++)
+        {
+            uint32_t start = test_random_below(FB_MIRROR_FB_SIZE);
+            uint32_t len = 1u + test_random_below(200);
+            if(start + len > FB_MIRROR_FB_SIZE) len = FB_MIRROR_FB_SIZE - start;
+            if(test_random_below(2))
+                memset(test_fb + start, (int) test_random_below(256), len);
+            else
+                for(uint32_t i = 0; i < len; i++) test_fb[start + i] = (uint8_t) test_random();
+        }
+        return false;
+    }
+    if(kind < 9)
+    {
+        for(uint32_t i = 0; i < FB_MIRROR_FB_SIZE; i++) test_fb[i] = (uint8_t) test_random();
+        return false;
+    }
+    memset(test_fb, 0, sizeof(test_fb));
+    return false;
+}
+
+int main(int argc, char **argv)
+{
+    if(argc != 2)
+    {
+        fprintf(stderr, "uso: %s <diretorio>\n", argv[0]);
+        return 2;
+    }
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/stream.bin", argv[1]);
+    test_stream = fopen(path, "wb");
+    snprintf(path, sizeof(path), "%s/expected.bin", argv[1]);
+    FILE *expected = fopen(path, "wb");
+    if(test_stream == NULL || expected == NULL)
+    {
+        perror(path);
+        return 2;
+    }
+
+    sim_init(UINT64_MAX, NULL);
+    fb_mirror_init(3);
+    fb_mirror_set_enabled(true);
+
+    uint32_t emitted = 0;
+    for(uint32_t n = 0; n < TEST_FRAMES; n++)
+    {
+        bool single = n > 0 && test_mutate();
+        uint32_t now_us = (n + 1u) * FB_MIRROR_MIN_PERIOD_US;
+
+        fb_mirror_stats_t before, after;
+        fb_mirror_get_stats(&before);
+        fb_mirror_capture(test_fb, now_us);
+        fb_mirror_get_stats(&after);
+        bool keyframe = after.keyframes != before.keyframes;
+
+        // Antes do intervalo mínimo, nada é capturado
+        fb_mirror_capture(test_fb, now_us + FB_MIRROR_MIN_PERIOD_US / 2u);
+        fb_mirror_stats_t early;
+        fb_mirror_get_stats(&early);
+        TEST_CHECK(early.frames == after.frames && early.busy == after.busy, "quadro %u: captura antecipada",
+                   (unsigned) n);
+
+        if(after.frames == before.frames) continue;
+        TEST_CHECK(after.frames == before.frames + 1u, "quadro %u", (unsigned) n);
+        if(single && !keyframe)
+        {
+            uint32_t len = after.encoded_bytes - before.encoded_bytes;
+            TEST_CHECK(len <= TEST_SINGLE_BYTE_MAX, "quadro %u: %u bytes para um byte alterado", (unsigned) n,
+                       (unsigned) len);
+        }
+        TEST_CHECK(after.encoded_bytes - before.encoded_bytes <= FB_MIRROR_MAX_ENCODED, "quadro %u: %u bytes",
+                   (unsigned) n, (unsigned) (after.encoded_bytes - before.encoded_bytes));
+        fwrite(test_fb, 1, sizeof(test_fb), expected);
+        emitted++;
+
+        // Trechos do tamanho de vários quadros USB
+        uint32_t max_bytes = 64u + test_random_below(512);
+        uint32_t calls = 0;
+        while(fb_mirror_drain(max_bytes, test_write) > 0) calls++;
+        TEST_CHECK(calls > 0, "quadro %u: nada drenado", (unsigned) n);
+    }
+
+    fb_mirror_stats_t stats;
+    fb_mirror_get_stats(&stats);
+    TEST_CHECK(stats.frames == emitted && stats.keyframes == 1u + (emitted - 1u) / FB_MIRROR_KEYFRAME_INTERVAL,
+               "%u quadros, %u quadros-chave", (unsigned) stats.frames, (unsigned) stats.keyframes);
+    TEST_CHECK(emitted < TEST_FRAMES, "quadros sem mudanca foram emitidos");
+    TEST_CHECK(fclose(test_stream) == 0 && fclose(expected) == 0, "arquivos de saida");
+    return test_result("test_fb_mirror");
+}
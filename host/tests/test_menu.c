@@ -0,0 +1,211 @@
+#include <string.h>
+#include "menu.h"
+#include "test.h"
+
+/**
+ * @file test_menu.c
+ * @brief Janelas de `menu_draw`: casos conhecidos e navegação ao acaso contra um redesenho completo.
+ *
+ * Um painel simulado só recebe os bytes das janelas devolvidas. Depois de
+ * cada quadro, ele deve mostrar o mesmo que o menu desenhado do zero em uma
+ * tela apagada: uma área que mudou fora das janelas, ou uma janela a menos,
+ * deixa o painel diferente.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Passos da navegação ao acaso. */
+#define TEST_STEPS 5000
+
+/** @brief Bytes do framebuffer (sem o byte de controle). */
+#define TEST_FB_SIZE (WIDTH * HEIGHT / 8)
+
+static menu_widget_t test_sub_items[10] = {
+    MENU_SLIDER_INIT("S0", 0, 0, 9, 1, NULL),   MENU_SLIDER_INIT("S1", 1, 0, 9, 1, NULL),
+    MENU_SLIDER_INIT("S2", 2, 0, 9, 1, NULL),   MENU_SLIDER_INIT("S3", 3, 0, 9, 1, NULL),
+    MENU_SLIDER_INIT("S4", 4, 0, 9, 1, NULL),   MENU_SLIDER_INIT("S5", 5, 0, 9, 1, NULL),
+    MENU_SLIDER_INIT("S6", 6, 0, 9, 1, NULL),   MENU_SLIDER_INIT("S7", 7, 0, 9, 1, NULL),
+    MENU_TOGGLE_INIT("T8", 0, NULL),            MENU_LABEL_INIT("L9"),
+};
+static menu_widget_t *const test_sub_list[] = {
+    &test_sub_items[0], &test_sub_items[1], &test_sub_items[2], &test_sub_items[3], &test_sub_items[4],
+    &test_sub_items[5], &test_sub_items[6], &test_sub_items[7], &test_sub_items[8], &test_sub_items[9],
+};
+
+static menu_widget_t test_toggle = MENU_TOGGLE_INIT("Toggle", 0, NULL);
+static menu_widget_t test_slider = MENU_SLIDER_INIT("Slider", 50, 0, 100, 5, NULL);
+static menu_widget_t test_label = MENU_LABEL_INIT("Label");
+static menu_widget_t test_sub = MENU_LIST_INIT("Sub", test_sub_list);
+static menu_widget_t test_extra[5] = {
+    MENU_TOGGLE_INIT("E0", 1, NULL), MENU_TOGGLE_INIT("E1", 0, NULL), MENU_SLIDER_INIT("E2", -3, -10, 10, 1, NULL),
+    MENU_LABEL_INIT("E3"),           MENU_TOGGLE_INIT("E4", 0, NULL),
+};
+static menu_widget_t *const test_root_list[] = {
+    &test_toggle, &test_slider, &test_label, &test_sub,
+    &test_extra[0], &test_extra[1], &test_extra[2], &test_extra[3], &test_extra[4],
+};
+static menu_widget_t test_root = MENU_LIST_INIT("Config", test_root_list);
+
+static uint8_t test_buffer[1 + TEST_FB_SIZE];
+static uint8_t test_panel[1 + TEST_FB_SIZE];
+static uint8_t test_reference[1 + TEST_FB_SIZE];
+
+/**
+ * @brief Display sem barramento sobre um framebuffer estático.
+ */
+static void test_display(ssd1306_t *ssd, uint8_t *buffer)
+{
+    memset(ssd, 0, sizeof(*ssd));
+    ssd->width = WIDTH;
+    ssd->height = HEIGHT;
+    ssd->pages = HEIGHT / 8;
+    ssd->ram_buffer = buffer;
+    ssd->bufsize = 1 + TEST_FB_SIZE;
+}
+
+/**
+ * @brief Desenha um quadro, copia as janelas para o painel e devolve os bytes enviados.
+ */
+static uint32_t test_frame(menu_t *menu, menu_view_t *view, ssd1306_t *ssd, ssd1306_window_t *windows,
+                           uint8_t *count)
+{
+    *count = menu_draw(menu, view, ssd, windows);
+    TEST_CHECK(*count <= MENU_MAX_WINDOWS, "%u janelas", *count);
+    uint32_t bytes = 0;
+    for(uint8_t i = 0; i < *count && i < MENU_MAX_WINDOWS; i++)
+    {
+        const ssd1306_window_t *w = &windows[i];
+        TEST_CHECK(w->x0 <= w->x1 && w->x1 < WIDTH && w->page0 <= w->page1 && w->page1 < HEIGHT / 8,
+                   "janela %u invalida (%u-%u, %u-%u)", i, w->x0, w->x1, w->page0, w->page1);
+        if(i > 0) TEST_CHECK(windows[i - 1].page1 < w->page0, "janelas %u e %u fora de ordem", i - 1u, i);
+        for(uint32_t x = w->x0; x <= w->x1; x++)
+        {
+            for(uint32_t page = w->page0; page <= w->page1; page++)
+            {
+                test_panel[1 + x * ssd->pages + page] = test_buffer[1 + x * ssd->pages + page];
+            }
+        }
+        bytes += (uint32_t) (w->x1 - w->x0 + 1u) * (w->page1 - w->page0 + 1u);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Indica se o painel mostra o mesmo que o menu desenhado do zero.
+ */
+static bool test_panel_matches(const menu_t *menu)
+{
+    ssd1306_t reference;
+    test_display(&reference, test_reference);
+    memset(test_reference, 0, sizeof(test_reference));
+    menu_t copy = *menu;
+    menu_view_t view;
+    memset(&view, 0, sizeof(view));
+    ssd1306_window_t windows[MENU_MAX_WINDOWS];
+    menu_draw(&copy, &view, &reference, windows);
+    return memcmp(test_reference + 1, test_panel + 1, TEST_FB_SIZE) == 0;
+}
+
+static void test_known_windows(menu_t *menu, menu_view_t *view, ssd1306_t *ssd)
+{
+    ssd1306_window_t w[MENU_MAX_WINDOWS];
+    uint8_t count;
+
+    // Primeiro quadro: a tela inteira
+    uint32_t bytes = test_frame(menu, view, ssd, w, &count);
+    TEST_CHECK(bytes == TEST_FB_SIZE, "primeiro quadro: %u bytes", (unsigned) bytes);
+    TEST_CHECK(test_panel_matches(menu), "primeiro quadro difere da referencia");
+
+    // Sem mudanças: nada
+    bytes = test_frame(menu, view, ssd, w, &count);
+    TEST_CHECK(count == 0 && bytes == 0, "sem mudancas: %u janelas", count);
+
+    // Foco para baixo: a posição no título e as duas linhas, unidas em uma janela
+    menu_handle_key(menu, MENU_KEY_DOWN);
+    bytes = test_frame(menu, view, ssd, w, &count);
+    TEST_CHECK(count == 2, "foco: %u janelas", count);
+    if(count == 2)
+    {
+        TEST_CHECK(w[0].x0 == MENU_VALUE_X && w[0].x1 == WIDTH - 1 && w[0].page0 == 0 && w[0].page1 == 0,
+                   "foco: titulo (%u-%u, %u-%u)", w[0].x0, w[0].x1, w[0].page0, w[0].page1);
+        TEST_CHECK(w[1].x0 == 0 && w[1].x1 == WIDTH - 1 && w[1].page0 == 1 && w[1].page1 == 2,
+                   "foco: linhas (%u-%u, %u-%u)", w[1].x0, w[1].x1, w[1].page0, w[1].page1);
+    }
+    TEST_CHECK(bytes == (WIDTH - MENU_VALUE_X) + 2u * WIDTH, "foco: %u bytes", (unsigned) bytes);
+
+    // Valor do controle deslizante: só a área de valor da sua linha
+    menu_handle_key(menu, MENU_KEY_RIGHT);
+    TEST_CHECK(test_slider.value == 55, "slider=%d", (int) test_slider.value);
+    test_frame(menu, view, ssd, w, &count);
+    TEST_CHECK(count == 1 && w[0].x0 == MENU_VALUE_X && w[0].page0 == 2 && w[0].page1 == 2,
+               "valor: %u janelas (%u-%u, %u-%u)", count, w[0].x0, w[0].x1, w[0].page0, w[0].page1);
+
+    // Rótulo atualizado de fora do menu
+    menu_set_value(&test_label, 1234);
+    test_frame(menu, view, ssd, w, &count);
+    TEST_CHECK(count == 1 && w[0].x0 == MENU_VALUE_X && w[0].page0 == 3 && w[0].page1 == 3,
+               "rotulo: %u janelas (%u-%u, %u-%u)", count, w[0].x0, w[0].x1, w[0].page0, w[0].page1);
+    menu_set_value(&test_label, 1234);
+    test_frame(menu, view, ssd, w, &count);
+    TEST_CHECK(count == 0, "rotulo sem mudanca: %u janelas", count);
+
+    // Entrar em uma lista troca a tela inteira
+    menu_handle_key(menu, MENU_KEY_DOWN);
+    menu_handle_key(menu, MENU_KEY_DOWN);
+    test_frame(menu, view, ssd, w, &count);
+    menu_handle_key(menu, MENU_KEY_SELECT);
+    TEST_CHECK(menu->depth == 2, "profundidade=%u", menu->depth);
+    bytes = test_frame(menu, view, ssd, w, &count);
+    TEST_CHECK(bytes == TEST_FB_SIZE, "lista: %u bytes", (unsigned) bytes);
+    TEST_CHECK(test_panel_matches(menu), "lista difere da referencia");
+
+    menu_handle_key(menu, MENU_KEY_BACK);
+    test_frame(menu, view, ssd, w, &count);
+    TEST_CHECK(test_panel_matches(menu), "volta difere da referencia");
+}
+
+static void test_random_navigation(menu_t *menu, menu_view_t *view, ssd1306_t *ssd)
+{
+    static const menu_key_t keys[] = {MENU_KEY_UP,    MENU_KEY_DOWN,   MENU_KEY_DOWN, MENU_KEY_LEFT,
+                                      MENU_KEY_RIGHT, MENU_KEY_SELECT, MENU_KEY_BACK};
+    uint32_t mismatches = 0;
+    for(uint32_t step = 0; step < TEST_STEPS; step++)
+    {
+        uint32_t actions = test_random_below(3);
+        for(uint32_t a = 0; a < actions; a++)
+        {
+            if(test_random_below(4) == 0)
+                menu_set_value(test_random_below(2) ? &test_label : &test_sub_items[9], (int32_t) test_random_below(100000));
+            else
+                menu_handle_key(menu, keys[test_random_below(sizeof(keys) / sizeof(keys[0]))]);
+        }
+
+        ssd1306_window_t w[MENU_MAX_WINDOWS];
+        uint8_t count;
+        test_frame(menu, view, ssd, w, &count);
+        if(actions == 0) TEST_CHECK(count == 0, "passo %u: sem acoes, %u janelas", (unsigned) step, count);
+        if(!test_panel_matches(menu)) mismatches++;
+    }
+    TEST_CHECK(mismatches == 0, "%u quadros com o painel diferente da referencia", (unsigned) mismatches);
+}
+
+int main(void)
+{
+    ssd1306_t ssd;
+    test_display(&ssd, test_buffer);
+
+    menu_t menu;
+    menu_view_t view;
+    menu_init(&menu, &test_root);
+    memset(&view, 0, sizeof(view));
+    menu_view_invalidate(&view);
+
+    test_known_windows(&menu, &view, &ssd);
+    test_random_navigation(&menu, &view, &ssd);
+    TEST_CHECK(menu.frames > 0 && menu.bytes_flushed > 0, "contadores zerados");
+    return test_result("test_menu");
+}
@@ -0,0 +1,159 @@
+#include "predict.h"
+#include "test.h"
+
+/**
+ * @file test_predict.c
+ * @brief Casos de `predict_position`: histórico, extrapolação e as proteções contra ultrapassagem.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Período da tarefa de entrada (200 Hz). */
+#define TEST_PERIOD_US 5000u
+
+/** @brief Horizonte usado nos casos (~ a latência input-to-photon). */
+#define TEST_HORIZON_US 20000u
+
+/**
+ * @brief Alimenta o preditor com `count` amostras a partir de (x, y), com passo (dx, dy) por período.
+ *
+ * @return Instante da última amostra.
+ */
+static uint32_t test_feed(predict_t *pred, uint32_t t_us, int32_t x, int32_t y, int32_t dx, int32_t dy, uint32_t count)
+{
+    for(uint32_t i = 0; i < count; i++)
+    {
+        predict_add(pred, (uint16_t) (x + dx * (int32_t) i), (uint16_t) (y + dy * (int32_t) i), t_us);
+        t_us += TEST_PERIOD_US;
+    }
+    return t_us - TEST_PERIOD_US;
+}
+
+static void test_history(void)
+{
+    predict_t pred;
+    uint16_t x, y;
+
+    // Sem amostras: o centro
+    predict_init(&pred);
+    predict_position(&pred, TEST_HORIZON_US, &x, &y);
+    TEST_CHECK(x == 2047 && y == 2047, "vazio: (%u, %u)", x, y);
+
+    // Menos de 2 * PREDICT_WINDOW + 1 amostras: a última, sem extrapolar
+    test_feed(&pred, 0, 1000, 3000, 40, -40, 2 * PREDICT_WINDOW);
+    predict_position(&pred, TEST_HORIZON_US, &x, &y);
+    TEST_CHECK(x == 1000 + 40 * (2 * PREDICT_WINDOW - 1) && y == 3000 - 40 * (2 * PREDICT_WINDOW - 1),
+               "historico curto: (%u, %u)", x, y);
+    TEST_CHECK(pred.predictions == 0, "previsoes=%u", (unsigned) pred.predictions);
+
+    // A mesma amostra vista duas vezes não entra no histórico
+    predict_init(&pred);
+    uint32_t t = test_feed(&pred, 0, 1000, 1000, 10, 10, 3);
+    predict_add(&pred, 1020, 1020, t);
+    TEST_CHECK(pred.count == 3, "amostra repetida: count=%u", (unsigned) pred.count);
+
+    // Uma lacuna maior que PREDICT_MAX_GAP_US recomeça o histórico
+    predict_init(&pred);
+    t = test_feed(&pred, 0, 1000, 1000, 40, 40, 8);
+    predict_add(&pred, 1500, 1500, t + PREDICT_MAX_GAP_US + 1u);
+    TEST_CHECK(pred.count == 1, "lacuna: count=%u", (unsigned) pred.count);
+    predict_position(&pred, TEST_HORIZON_US, &x, &y);
+    TEST_CHECK(x == 1500 && y == 1500, "lacuna: (%u, %u)", x, y);
+}
+
+static void test_extrapolation(void)
+{
+    predict_t pred;
+    uint16_t x, y;
+
+    // Velocidade constante: 8 contagens por período (1,6 contagens/ms), sem aceleração
+    predict_init(&pred);
+    test_feed(&pred, 1000, 1000, 3000, 8, 0, 8);
+    predict_position(&pred, TEST_HORIZON_US, &x, &y);
+    uint16_t last = 1000 + 8 * 7;
+    TEST_CHECK(x == last + 8 * TEST_HORIZON_US / TEST_PERIOD_US, "x=%u esperado %u", x,
+               (unsigned) (last + 8 * TEST_HORIZON_US / TEST_PERIOD_US));
+    TEST_CHECK(y == 3000, "eixo parado: y=%u", y);
+    TEST_CHECK(pred.still == 1 && pred.predictions == 1, "parados=%u previsoes=%u", (unsigned) pred.still,
+               (unsigned) pred.predictions);
+
+    // Sentido negativo, simétrico
+    predict_init(&pred);
+    test_feed(&pred, 0, 3000, 1000, -8, 0, 8);
+    predict_position(&pred, TEST_HORIZON_US, &x, &y);
+    TEST_CHECK(x == 3000 - 8 * 7 - 8 * TEST_HORIZON_US / TEST_PERIOD_US, "x=%u", x);
+
+    // Horizonte zero: a própria amostra
+    predict_position(&pred, 0, &x, &y);
+    TEST_CHECK(x == 3000 - 8 * 7, "horizonte zero: x=%u", x);
+
+    // Horizonte acima de PREDICT_MAX_HORIZON_US é limitado
+    uint16_t limited_x, limited_y;
+    predict_position(&pred, PREDICT_MAX_HORIZON_US, &limited_x, &limited_y);
+    predict_position(&pred, 10u * PREDICT_MAX_HORIZON_US, &x, &y);
+    TEST_CHECK(x == limited_x, "horizonte limitado: %u != %u", x, limited_x);
+}
+
+static void test_guards(void)
+{
+    predict_t pred;
+    uint16_t x, y;
+
+    // Avanço limitado a PREDICT_MAX_LEAD
+    predict_init(&pred);
+    test_feed(&pred, 0, 100, 1000, 200, 0, 8);
+    predict_position(&pred, PREDICT_MAX_HORIZON_US, &x, &y);
+    TEST_CHECK(x == 100 + 200 * 7 + PREDICT_MAX_LEAD, "avanco: x=%u", x);
+    TEST_CHECK(pred.clamped >= 1, "limitados=%u", (unsigned) pred.clamped);
+
+    // E à faixa do ADC
+    predict_init(&pred);
+    test_feed(&pred, 0, 3600, 1000, 60, 0, 8);
+    predict_position(&pred, TEST_HORIZON_US * 2u, &x, &y);
+    TEST_CHECK(x == 4095, "faixa: x=%u", x);
+    predict_init(&pred);
+    test_feed(&pred, 0, 500, 1000, -60, 0, 8);
+    predict_position(&pred, TEST_HORIZON_US * 2u, &x, &y);
+    TEST_CHECK(x == 0, "faixa: x=%u", x);
+
+    // Uma amostra no centro (zona morta) suspende a extrapolação do eixo
+    predict_init(&pred);
+    test_feed(&pred, 0, 2048 - 4 * 40, 1000, 40, 0, 5);
+    predict_position(&pred, TEST_HORIZON_US, &x, &y);
+    TEST_CHECK(x == 2048 && pred.deadzone == 1, "zona morta: x=%u zona_morta=%u", x, (unsigned) pred.deadzone);
+
+    // Inversão de sentido: a predição espera o novo sentido se firmar
+    predict_init(&pred);
+    uint32_t t = test_feed(&pred, 0, 1000, 1000, 40, 0, 6);
+    t = test_feed(&pred, t + TEST_PERIOD_US, 1000 + 40 * 5 - 40, 1000, -40, 0, 2);
+    predict_position(&pred, TEST_HORIZON_US, &x, &y);
+    TEST_CHECK(x == 1000 + 40 * 5 - 80 && pred.reversals == 1, "inversao: x=%u inversoes=%u", x,
+               (unsigned) pred.reversals);
+
+    // Desacelerando: não passa do ponto de parada da parábola
+    predict_init(&pred);
+    static const uint16_t decel[] = {1000, 1100, 1190, 1270, 1340, 1400, 1450, 1490};
+    for(uint32_t i = 0; i < sizeof(decel) / sizeof(decel[0]); i++)
+    {
+        predict_add(&pred, decel[i], 1000, i * TEST_PERIOD_US);
+    }
+    uint16_t stop_x;
+    predict_position(&pred, TEST_HORIZON_US, &x, &y);
+    TEST_CHECK(x > 1490 && pred.stops == 0, "antes da parada: x=%u paradas=%u", x, (unsigned) pred.stops);
+    predict_position(&pred, PREDICT_MAX_HORIZON_US * 3u / 4u, &stop_x, &y);
+    predict_position(&pred, PREDICT_MAX_HORIZON_US, &x, &y);
+    TEST_CHECK(pred.stops == 2, "paradas=%u", (unsigned) pred.stops);
+    TEST_CHECK(x == stop_x && x > 1490, "depois da parada: x=%u (%u)", x, stop_x);
+}
+
+int main(void)
+{
+    test_history();
+    test_extrapolation();
+    test_guards();
+    return test_result("test_predict");
+}
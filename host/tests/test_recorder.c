@@ -0,0 +1,155 @@
+#include <string.h>
+#include "recorder.h"
+#include "sim.h"
+#include "test.h"
+
+/**
+ * @file test_recorder.c
+ * @brief Sessões gravadas por lib/recorder.c na flash simulada, decodificadas por tools/recorder_decode.py.
+ *
+ * Duas sessões de um passeio ao acaso (paradas longas, saltos, lacunas de
+ * vários períodos e eventos de botão, inclusive páginas abertas só para um
+ * evento) são gravadas como o firmware faz; a segunda atravessa a volta do
+ * contador de 32 bits e, por começar com a reserva apagada entre as sessões,
+ * não pode apagar nada enquanto grava. A imagem `flash.bin` e os CSVs esperados
+ * (`expected_samples.csv` e `expected_events.csv`) são conferidos por
+ * check_decoders.py com a saída do decodificador.
+ *
+ * Uso: test_recorder <diretório>
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Período de amostragem (200 Hz). */
+#define TEST_PERIOD_US 5000u
+
+/** @brief Amostras de cada sessão (a primeira passa do limite de idade da página). */
+#define TEST_SESSION1_SAMPLES 3000u
+#define TEST_SESSION2_SAMPLES 2000u
+
+/** @brief Início da segunda sessão, a alguns segundos da volta do contador. */
+#define TEST_SESSION2_START_US 0xFFF00000u
+
+/** @brief GPIOs dos eventos (botões A, B e do joystick). */
+static const uint8_t test_gpios[] = {5, 6, 22};
+
+/** @brief Nomes dos eventos, como em recorder_decode.py. */
+static const char *const test_event_names[] = {"press", "release", "long_press", "repeat"};
+
+static FILE *test_samples;
+static FILE *test_events;
+
+/**
+ * @brief Atende a fila do gravador como o núcleo 1.
+ */
+static void test_service(uint32_t calls)
+{
+    for(uint32_t i = 0; i < calls; i++) recorder_service();
+}
+
+/**
+ * @brief Grava uma sessão de `count` amostras a partir de `t_us` e a encerra.
+ *
+ * @return Segmentos apagados enquanto a sessão gravava.
+ */
+static uint32_t test_session(uint16_t session, uint32_t t_us, uint32_t count)
+{
+    int32_t x = 2047, y = 2047;
+    recorder_stats_t stats;
+    recorder_get_stats(&stats);
+    uint32_t erased_before = stats.erased_segments;
+    recorder_start();
+    for(uint32_t i = 0; i < count; i++)
+    {
+        // Posição: parada, passo curto ou salto
+        uint32_t kind = test_random_below(10);
+        if(kind >= 4 && kind < 9)
+        {
+            x += (int32_t) test_random_below(41) - 20;
+            y += (int32_t) test_random_below(41) - 20;
+        }
+        else if(kind == 9)
+        {
+            x = (int32_t) test_random_below(4096);
+            y = (int32_t) test_random_below(4096);
+        }
+        x = x < 0 ? 0 : (x > 4095 ? 4095 : x);
+        y = y < 0 ? 0 : (y > 4095 ? 4095 : y);
+
+        recorder_sample(t_us, (uint16_t) x, (uint16_t) y);
+        fprintf(test_samples, "%u,%lu,%d,%d\n", session, (unsigned long) t_us, (int) x, (int) y);
+
+        // Rajadas de eventos, para que alguns abram uma página de continuação
+        uint32_t events = test_random_below(30) == 0 ? 1u + test_random_below(30) : 0u;
+        for(uint32_t e = 0; e < events; e++)
+        {
+            uint32_t t_event = t_us + test_random_below(3u * TEST_PERIOD_US) - TEST_PERIOD_US;
+            uint8_t gpio = test_gpios[test_random_below(sizeof(test_gpios))];
+            uint8_t type = (uint8_t) (1u + test_random_below(4));
+            recorder_event(t_event, gpio, type);
+            fprintf(test_events, "%u,%lu,%u,%s\n", session, (unsigned long) t_event, gpio, test_event_names[type - 1u]);
+        }
+        test_service(2);
+
+        // Na grade do período, às vezes com uma lacuna
+        t_us += TEST_PERIOD_US * (test_random_below(50) == 0 ? 2u + test_random_below(40) : 1u);
+    }
+
+    recorder_get_stats(&stats);
+    uint32_t erased_recording = stats.erased_segments - erased_before;
+
+    // A amostra seguinte ao pedido de parada só fecha a página; o restante repõe a reserva
+    recorder_stop();
+    recorder_sample(t_us, 0, 0);
+    test_service(64);
+
+    recorder_get_stats(&stats);
+    TEST_CHECK(stats.session == session && !stats.recording, "sessao %u: sessao=%u gravando=%d", session,
+               stats.session, stats.recording);
+    TEST_CHECK(stats.samples == count, "sessao %u: %u amostras, esperadas %u", session, (unsigned) stats.samples,
+               (unsigned) count);
+    TEST_CHECK(stats.dropped_pages == 0 && stats.flash_failures == 0, "sessao %u: %u paginas perdidas, %u falhas",
+               session, (unsigned) stats.dropped_pages, (unsigned) stats.flash_failures);
+    return erased_recording;
+}
+
+int main(int argc, char **argv)
+{
+    if(argc != 2)
+    {
+        fprintf(stderr, "uso: %s <diretorio>\n", argv[0]);
+        return 2;
+    }
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/expected_samples.csv", argv[1]);
+    test_samples = fopen(path, "w");
+    snprintf(path, sizeof(path), "%s/expected_events.csv", argv[1]);
+    test_events = fopen(path, "w");
+    if(test_samples == NULL || test_events == NULL)
+    {
+        perror(path);
+        return 2;
+    }
+    fprintf(test_samples, "session,t_us,x,y\n");
+    fprintf(test_events, "session,t_us,gpio,event\n");
+
+    sim_init(UINT64_MAX, NULL);
+    TEST_CHECK(recorder_init(TEST_PERIOD_US), "recorder_init");
+    test_session(1, 1000000u, TEST_SESSION1_SAMPLES);
+    uint32_t erased = test_session(2, TEST_SESSION2_START_US, TEST_SESSION2_SAMPLES);
+    TEST_CHECK(erased == 0, "sessao 2: %u segmentos apagados durante a gravacao", (unsigned) erased);
+
+    recorder_stats_t stats;
+    recorder_get_stats(&stats);
+    TEST_CHECK(stats.committed_pages > 2u * RECORDER_SEGMENT_SIZE / RECORDER_PAGE_SIZE, "%u paginas gravadas",
+               (unsigned) stats.committed_pages);
+
+    snprintf(path, sizeof(path), "%s/flash.bin", argv[1]);
+    TEST_CHECK(sim_flash_save(path), "%s", path);
+    TEST_CHECK(fclose(test_samples) == 0 && fclose(test_events) == 0, "CSVs esperados");
+    return test_result("test_recorder");
+}
@@ -0,0 +1,161 @@
+#include <string.h>
+#include "sprite.h"
+#include "pixaddr.h"
+#include "test.h"
+
+/**
+ * @file test_sprite.c
+ * @brief Áreas sujas de `sprite_layer_render` contra uma composição completa de referência.
+ *
+ * Sprites de formas, alturas e ordens z variadas são movidos, escondidos,
+ * reordenados e trocados de forma ao acaso. A cada composição, o framebuffer
+ * deve ser igual ao desenho de todos os sprites visíveis, em ordem z, sobre
+ * uma tela apagada (`pixaddr_blit`); e um painel que só recebe as áreas
+ * devolvidas deve mostrar a mesma imagem, isto é, nenhum byte mudou fora delas.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Sprites da camada, formas e altura máxima (em páginas). */
+#define TEST_SPRITES 24
+#define TEST_SHAPES 4
+#define TEST_SHAPE_PAGES 3
+#define TEST_SHAPE_WIDTH 20
+
+/** @brief Composições, e a cada quantas a tela é limpa e a camada invalidada. */
+#define TEST_ITERATIONS 20000
+#define TEST_CLEAR_INTERVAL 500
+
+/** @brief Áreas aceitas por composição (poucas, para exercitar a união em uma só). */
+#define TEST_RECTS 3
+
+static uint8_t test_shapes[TEST_SHAPES][TEST_SHAPE_PAGES * TEST_SHAPE_WIDTH];
+static uint8_t test_buffer[1 + WIDTH * HEIGHT / 8];
+static uint8_t test_panel[1 + WIDTH * HEIGHT / 8];
+static uint8_t test_reference[1 + WIDTH * HEIGHT / 8];
+
+/**
+ * @brief Aplica ao sprite `id` uma mudança ao acaso.
+ */
+static void test_mutate(sprite_layer_t *layer, int id)
+{
+    uint32_t kind = test_random_below(10);
+    if(kind < 6)
+        sprite_move(layer, id, (uint8_t) test_random_below(WIDTH), (uint8_t) test_random_below(HEIGHT));
+    else if(kind < 8)
+        sprite_set_visible(layer, id, test_random_below(2) != 0);
+    else if(kind < 9)
+        sprite_set_z(layer, id, (int8_t) (test_random_below(5) - 2));
+    else
+        sprite_set_shape(layer, id, test_shapes[test_random_below(TEST_SHAPES)],
+                         (uint8_t) (1 + test_random_below(TEST_SHAPE_WIDTH)), (uint8_t) (1 + test_random_below(TEST_SHAPE_PAGES)));
+}
+
+/**
+ * @brief Verifica as áreas devolvidas: dentro da tela, de cima para baixo e sem sobreposição.
+ */
+static void test_check_rects(const ssd1306_window_t *rects, uint8_t count, uint32_t iteration)
+{
+    TEST_CHECK(count <= TEST_RECTS, "iteracao %u: %u areas", (unsigned) iteration, count);
+    for(uint8_t i = 0; i < count && i < TEST_RECTS; i++)
+    {
+        const ssd1306_window_t *r = &rects[i];
+        TEST_CHECK(r->x0 <= r->x1 && r->x1 < WIDTH && r->page0 <= r->page1 && r->page1 < SPRITE_PAGES,
+                   "iteracao %u: area %u invalida (%u-%u, %u-%u)", (unsigned) iteration, i, r->x0, r->x1, r->page0,
+                   r->page1);
+        if(i > 0)
+        {
+            TEST_CHECK(rects[i - 1].page1 < r->page0, "iteracao %u: areas %u e %u fora de ordem", (unsigned) iteration,
+                       i - 1u, i);
+        }
+    }
+}
+
+int main(void)
+{
+    ssd1306_t ssd;
+    memset(&ssd, 0, sizeof(ssd));
+    ssd.width = WIDTH;
+    ssd.height = HEIGHT;
+    ssd.pages = HEIGHT / 8;
+    ssd.ram_buffer = test_buffer;
+    ssd.bufsize = sizeof(test_buffer);
+
+    for(uint32_t s = 0; s < TEST_SHAPES; s++)
+    {
+        for(uint32_t i = 0; i < sizeof(test_shapes[s]); i++)
+        {
+            test_shapes[s][i] = (uint8_t) test_random();
+        }
+    }
+
+    sprite_layer_t layer;
+    sprite_layer_init(&layer);
+    for(int id = 0; id < TEST_SPRITES; id++)
+    {
+        int added = sprite_add(&layer, test_shapes[test_random_below(TEST_SHAPES)],
+                               (uint8_t) (1 + test_random_below(TEST_SHAPE_WIDTH)),
+                               (uint8_t) (1 + test_random_below(TEST_SHAPE_PAGES)), (int8_t) (test_random_below(5) - 2));
+        TEST_CHECK(added == id, "sprite_add devolveu %d, esperado %d", added, id);
+        sprite_move(&layer, id, (uint8_t) test_random_below(WIDTH), (uint8_t) test_random_below(HEIGHT));
+        sprite_set_visible(&layer, id, test_random_below(2) != 0);
+    }
+
+    // Camada cheia
+    sprite_layer_t full;
+    sprite_layer_init(&full);
+    for(int id = 0; id < SPRITE_MAX; id++) sprite_add(&full, test_shapes[0], 1, 1, 0);
+    TEST_CHECK(sprite_add(&full, test_shapes[0], 1, 1, 0) == SPRITE_INVALID, "camada cheia aceitou um sprite");
+
+    uint32_t frame_mismatches = 0, panel_mismatches = 0;
+    for(uint32_t it = 0; it < TEST_ITERATIONS; it++)
+    {
+        uint32_t changes = test_random_below(4);
+        for(uint32_t m = 0; m < changes; m++) test_mutate(&layer, (int) test_random_below(TEST_SPRITES));
+
+        if(it % TEST_CLEAR_INTERVAL == 0)
+        {
+            memset(test_buffer, 0, sizeof(test_buffer));
+            memset(test_panel, 0, sizeof(test_panel));
+            sprite_layer_invalidate(&layer);
+        }
+
+        ssd1306_window_t rects[TEST_RECTS];
+        uint8_t count = sprite_layer_render(&layer, &ssd, rects, TEST_RECTS);
+        test_check_rects(rects, count, it);
+        if(changes == 0 && it % TEST_CLEAR_INTERVAL != 0)
+        {
+            TEST_CHECK(count == 0, "iteracao %u: nada mudou, mas %u areas", (unsigned) it, count);
+        }
+
+        // O painel só recebe as áreas devolvidas
+        for(uint8_t i = 0; i < count && i < TEST_RECTS; i++)
+        {
+            for(uint32_t x = rects[i].x0; x <= rects[i].x1; x++)
+            {
+                for(uint32_t page = rects[i].page0; page <= rects[i].page1; page++)
+                {
+                    test_panel[1 + x * ssd.pages + page] = test_buffer[1 + x * ssd.pages + page];
+                }
+            }
+        }
+
+        memset(test_reference, 0, sizeof(test_reference));
+        for(uint8_t rank = 0; rank < layer.count; rank++)
+        {
+            const sprite_t *s = &layer.sprites[layer.by_rank[rank]];
+            if(s->visible) pixaddr_blit(test_reference, s->x, s->y, s->bitmap, s->width, s->pages, true, false);
+        }
+        if(memcmp(test_reference + 1, test_buffer + 1, WIDTH * HEIGHT / 8) != 0) frame_mismatches++;
+        if(memcmp(test_reference + 1, test_panel + 1, WIDTH * HEIGHT / 8) != 0) panel_mismatches++;
+    }
+    TEST_CHECK(frame_mismatches == 0, "%u composicoes diferentes da referencia", (unsigned) frame_mismatches);
+    TEST_CHECK(panel_mismatches == 0, "%u paineis diferentes da referencia (mudanca fora das areas)",
+               (unsigned) panel_mismatches);
+    TEST_CHECK(layer.renders > 0 && layer.dirty_bytes > 0, "contadores zerados");
+    return test_result("test_sprite");
+}
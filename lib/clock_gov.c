@@ -0,0 +1,243 @@
+#include "clock_gov.h"
+#include "i2c_trace.h"
+#include "event_trace.h"
+#include "hardware/clocks.h"
+#include "hardware/pwm.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file clock_gov.c
+ * @brief Política por quadro, troca de nível e verificação dos periféricos.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Faixa do divisor do PWM em ponto fixo 8.4 (1,0 a 255 + 15/16). */
+#define CLOCK_GOV_PWM_DIV_MIN 0x010u
+#define CLOCK_GOV_PWM_DIV_MAX 0xFFFu
+
+/**
+ * @brief Desvio relativo entre dois valores, em partes por milhão.
+ */
+static uint32_t clock_gov_error_ppm(uint64_t actual, uint64_t expected)
+{
+    if(expected == 0) return 0;
+    uint64_t diff = actual > expected ? actual - expected : expected - actual;
+    return (uint32_t) (diff * 1000000u / expected);
+}
+
+/**
+ * @brief Frequência atual de um slice PWM, pelos registradores.
+ */
+static uint32_t clock_gov_pwm_hz(uint slice)
+{
+    uint64_t div = pwm_hw->slice[slice].div;
+    uint64_t period = (uint64_t) pwm_hw->slice[slice].top + 1u;
+    if(div == 0) return 0;
+    return (uint32_t) ((uint64_t) clock_get_hz(clk_sys) * 16u / (div * period));
+}
+
+bool clock_gov_init(clock_gov_t *gov, const uint32_t *levels_khz, uint8_t count)
+{
+    memset(gov, 0, sizeof(*gov));
+    if(count == 0 || count > CLOCK_GOV_MAX_LEVELS) return false;
+
+    memcpy(gov->levels_khz, levels_khz, count * sizeof(uint32_t));
+    gov->level_count = count;
+    gov->level = count - 1u;
+    gov->enabled = true;
+
+    bool applied = set_sys_clock_khz(gov->levels_khz[gov->level], false);
+    if(!applied) gov->failures++;
+    gov->level_since_us = time_us_32();
+    return applied;
+}
+
+bool clock_gov_track_pwm(clock_gov_t *gov, uint slice)
+{
+    if(gov->pwm_count >= CLOCK_GOV_MAX_PWM) return false;
+    for(uint i = 0; i < gov->pwm_count; i++)
+    {
+        if(gov->pwm[i].slice == slice) return true; // Dois pinos do mesmo slice
+    }
+
+    clock_gov_pwm_t *pwm = &gov->pwm[gov->pwm_count++];
+    pwm->slice = (uint8_t) slice;
+    pwm->base_div = pwm_hw->slice[slice].div;
+    pwm->base_khz = clock_get_hz(clk_sys) / 1000u;
+    pwm->target_hz = clock_gov_pwm_hz(slice);
+    return true;
+}
+
+void clock_gov_track_i2c(clock_gov_t *gov, i2c_inst_t *i2c, uint baudrate)
+{
+    gov->i2c = i2c;
+    gov->i2c_baudrate = baudrate;
+    gov->i2c_actual_baudrate = baudrate;
+}
+
+/**
+ * @brief Confere, após uma troca, `clk_sys` medido, as frequências dos PWMs e a taxa do I2C.
+ */
+static void clock_gov_verify(clock_gov_t *gov)
+{
+    uint32_t requested_khz = gov->levels_khz[gov->level];
+    uint32_t measured_khz = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_SYS);
+    uint32_t error = clock_gov_error_ppm(measured_khz, requested_khz);
+    if(error > gov->sys_error_ppm_max) gov->sys_error_ppm_max = error;
+
+    for(uint i = 0; i < gov->pwm_count; i++)
+    {
+        error = clock_gov_error_ppm(clock_gov_pwm_hz(gov->pwm[i].slice), gov->pwm[i].target_hz);
+        if(error > gov->pwm_error_ppm_max) gov->pwm_error_ppm_max = error;
+    }
+
+    if(gov->i2c != NULL)
+    {
+        error = clock_gov_error_ppm(gov->i2c_actual_baudrate, gov->i2c_baudrate);
+        if(error > gov->i2c_error_ppm_max) gov->i2c_error_ppm_max = error;
+    }
+}
+
+bool clock_gov_set_level(clock_gov_t *gov, uint8_t level)
+{
+    if(level >= gov->level_count) return false;
+    if(level == gov->level) return true;
+    EVENT_TRACE_MARK(EVENT_TRACE_CLOCK, level);
+
+    uint32_t khz = gov->levels_khz[level];
+    uint32_t start_us = time_us_32();
+    if(!set_sys_clock_khz(khz, false))
+    {
+        gov->failures++;
+        return false;
+    }
+
+    // Divisores relativos ao registro, para que erros de arredondamento não se acumulem
+    for(uint i = 0; i < gov->pwm_count; i++)
+    {
+        const clock_gov_pwm_t *pwm = &gov->pwm[i];
+        uint32_t div = (uint32_t) (((uint64_t) pwm->base_div * khz + pwm->base_khz / 2u) / pwm->base_khz);
+        if(div < CLOCK_GOV_PWM_DIV_MIN) div = CLOCK_GOV_PWM_DIV_MIN;
+        if(div > CLOCK_GOV_PWM_DIV_MAX) div = CLOCK_GOV_PWM_DIV_MAX;
+        pwm_hw->slice[pwm->slice].div = div;
+    }
+
+    if(gov->i2c != NULL)
+    {
+        gov->i2c_actual_baudrate = i2c_set_baudrate(gov->i2c, gov->i2c_baudrate);
+        i2c_trace_set_baudrate(gov->i2c_actual_baudrate);
+    }
+
+    uint32_t end_us = time_us_32();
+    uint32_t elapsed_us = end_us - start_us;
+    if(elapsed_us > gov->switch_us_max) gov->switch_us_max = elapsed_us;
+
+    // A troca conta no nível de destino
+    gov->level_us[gov->level] += start_us - gov->level_since_us;
+    gov->level_since_us = start_us;
+    gov->level = level;
+    gov->transitions++;
+
+    clock_gov_verify(gov);
+    return true;
+}
+
+/**
+ * @brief Nível mais baixo cujo quadro estimado cabe na meta do orçamento.
+ */
+static uint8_t clock_gov_required_level(const clock_gov_t *gov, uint32_t budget_us)
+{
+    uint32_t top_khz = gov->levels_khz[gov->level_count - 1u];
+    uint64_t limit_us = (uint64_t) budget_us * CLOCK_GOV_TARGET_PCT / 100u;
+
+    for(uint8_t n = 0; n < gov->level_count; n++)
+    {
+        uint64_t render_us = (uint64_t) gov->peak_render_us * top_khz / gov->levels_khz[n];
+        if(render_us + gov->peak_flush_us <= limit_us) return n;
+    }
+    return gov->level_count - 1u;
+}
+
+/**
+ * @brief Atualiza um pico com decaimento: sobe na hora, desce aos poucos.
+ */
+static uint32_t clock_gov_peak(uint32_t peak, uint32_t sample)
+{
+    if(sample >= peak) return sample;
+    return peak - ((peak - sample) >> CLOCK_GOV_PEAK_DECAY_SHIFT) - 1u;
+}
+
+void clock_gov_frame(clock_gov_t *gov, uint32_t render_us, uint32_t flush_us, uint32_t budget_us)
+{
+    uint32_t top_khz = gov->levels_khz[gov->level_count - 1u];
+    uint32_t render_top_us = (uint32_t) ((uint64_t) render_us * gov->levels_khz[gov->level] / top_khz);
+
+    gov->peak_render_us = clock_gov_peak(gov->peak_render_us, render_top_us);
+    gov->peak_flush_us = clock_gov_peak(gov->peak_flush_us, flush_us);
+
+    uint8_t target = gov->enabled ? clock_gov_required_level(gov, budget_us) : gov->level_count - 1u;
+    if(target > gov->level || !gov->enabled)
+    {
+        gov->calm_frames = 0;
+        clock_gov_set_level(gov, target);
+    }
+    else if(target < gov->level)
+    {
+        if(++gov->calm_frames >= CLOCK_GOV_DOWN_HOLD)
+        {
+            gov->calm_frames = 0;
+            clock_gov_set_level(gov, gov->level - 1u);
+        }
+    }
+    else
+    {
+        gov->calm_frames = 0;
+    }
+}
+
+void clock_gov_set_enabled(clock_gov_t *gov, bool enabled)
+{
+    gov->enabled = enabled;
+}
+
+void clock_gov_print(clock_gov_t *gov)
+{
+    uint8_t level = gov->level;
+    uint32_t now_us = time_us_32();
+    uint64_t level_us[CLOCK_GOV_MAX_LEVELS];
+    uint64_t total_us = 0;
+    uint64_t weighted = 0;
+
+    for(uint i = 0; i < gov->level_count; i++)
+    {
+        level_us[i] = gov->level_us[i];
+        if(i == level) level_us[i] += now_us - gov->level_since_us;
+        total_us += level_us[i];
+        weighted += level_us[i] / 1000u * gov->levels_khz[i];
+    }
+
+    uint32_t top_khz = gov->levels_khz[gov->level_count - 1u];
+    uint32_t mean_khz = total_us >= 1000u ? (uint32_t) (weighted / (total_us / 1000u)) : top_khz;
+    printf("clock: %s nivel=%lukHz medido=%lukHz trocas=%lu falhas=%lu troca_max=%luus\n",
+           gov->enabled ? "auto" : "fixo", (unsigned long) gov->levels_khz[level],
+           (unsigned long) (clock_get_hz(clk_sys) / 1000u), (unsigned long) gov->transitions,
+           (unsigned long) gov->failures, (unsigned long) gov->switch_us_max);
+    for(uint i = 0; i < gov->level_count; i++)
+    {
+        printf("clock: %6lukHz %8llums %3lu%%\n", (unsigned long) gov->levels_khz[i],
+               (unsigned long long) (level_us[i] / 1000u),
+               (unsigned long) (total_us ? level_us[i] * 100u / total_us : 0u));
+    }
+    printf("clock: media=%lukHz (%lu%% do nivel mais alto) pico_composicao=%luus pico_envio=%luus\n",
+           (unsigned long) mean_khz, (unsigned long) ((uint64_t) mean_khz * 100u / top_khz),
+           (unsigned long) gov->peak_render_us, (unsigned long) gov->peak_flush_us);
+    printf("clock: desvio_max sys=%luppm pwm=%luppm i2c=%luppm (i2c=%uHz)\n",
+           (unsigned long) gov->sys_error_ppm_max, (unsigned long) gov->pwm_error_ppm_max,
+           (unsigned long) gov->i2c_error_ppm_max, gov->i2c_actual_baudrate);
+}
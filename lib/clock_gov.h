@@ -0,0 +1,175 @@
+#ifndef CLOCK_GOV_H
+#define CLOCK_GOV_H
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+/**
+ * @file clock_gov.h
+ * @brief Governador da frequência do sistema guiado pela carga do quadro.
+ *
+ * O governador escolhe, entre alguns níveis de `clk_sys`, o mais baixo que
+ * comporta o quadro do display com folga. A cada quadro recebe o tempo de
+ * composição (proporcional à frequência) e o de envio (limitado pelo I2C, que
+ * não depende dela) e estima o tempo do quadro em cada nível:
+ *
+ *     estimado(n) = composição * f_atual / f(n) + envio
+ *
+ * Sobe imediatamente para o nível necessário quando o pior quadro recente não
+ * cabe em CLOCK_GOV_TARGET_PCT do orçamento; desce um nível por vez depois de
+ * CLOCK_GOV_DOWN_HOLD quadros seguidos com folga. Quadros sem alteração na
+ * tela (ocioso) contam como carga zero.
+ *
+ * A troca deve ser feita com o I2C parado (o pipeline a faz entre quadros, no
+ * núcleo 1). Depois de `set_sys_clock_khz`, o divisor de cada slice PWM
+ * registrado é recalculado para manter a frequência original, e a taxa do I2C,
+ * que no RP2040 deriva de `clk_sys`, é reprogramada. O temporizador, o ADC e o
+ * USB usam clocks próprios e não são afetados. Após cada troca, a frequência
+ * de `clk_sys` é medida pelo contador de frequência e comparada com a pedida,
+ * assim como as frequências resultantes dos PWMs e a taxa efetiva do I2C.
+ *
+ * Como métrica de energia, é contabilizado o tempo em cada nível e a média de
+ * frequência ponderada pelo tempo.
+ *
+ * @note As durações do profiler (em ciclos do SysTick) passam a misturar
+ * frequências; para medir etapas em ciclos, desligue o governador.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Clock_Gov Governador de clock
+ * @brief Níveis de frequência, política por quadro e verificação dos periféricos.
+ * @{
+ */
+
+/** @brief Quantidade máxima de níveis. */
+#define CLOCK_GOV_MAX_LEVELS 4
+
+/** @brief Quantidade máxima de slices PWM acompanhados. */
+#define CLOCK_GOV_MAX_PWM 4
+
+/** @brief Ocupação máxima do orçamento do quadro no nível escolhido, em %. */
+#define CLOCK_GOV_TARGET_PCT 75
+
+/** @brief Quadros seguidos com folga antes de descer um nível. */
+#define CLOCK_GOV_DOWN_HOLD 30
+
+/** @brief Decaimento do pior quadro recente: perde 1/2^n da diferença a cada quadro. */
+#define CLOCK_GOV_PEAK_DECAY_SHIFT 4
+
+/**
+ * @brief Slice PWM cuja frequência deve ser preservada.
+ */
+typedef struct
+{
+    uint8_t slice;       /**< Slice. */
+    uint32_t base_div;   /**< Divisor (8.4) em `base_khz`. */
+    uint32_t base_khz;   /**< Frequência do sistema no momento do registro. */
+    uint32_t target_hz;  /**< Frequência do PWM no momento do registro. */
+} clock_gov_pwm_t;
+
+/**
+ * @brief Estado do governador.
+ */
+typedef struct
+{
+    uint32_t levels_khz[CLOCK_GOV_MAX_LEVELS]; /**< Níveis, em ordem crescente. */
+    uint8_t level_count;       /**< Quantidade de níveis. */
+    uint8_t level;             /**< Nível atual. */
+    volatile bool enabled;     /**< Política ativa; desligada, fixa o nível mais alto. */
+
+    clock_gov_pwm_t pwm[CLOCK_GOV_MAX_PWM]; /**< Slices acompanhados. */
+    uint8_t pwm_count;         /**< Quantidade de slices. */
+    i2c_inst_t *i2c;           /**< Barramento reprogramado a cada troca (ou `NULL`). */
+    uint i2c_baudrate;         /**< Taxa pedida do barramento. */
+
+    uint32_t peak_render_us;   /**< Pior composição recente, normalizada ao nível mais alto. */
+    uint32_t peak_flush_us;    /**< Pior envio recente. */
+    uint16_t calm_frames;      /**< Quadros seguidos em que um nível abaixo bastaria. */
+
+    uint64_t level_us[CLOCK_GOV_MAX_LEVELS]; /**< Tempo em cada nível. */
+    uint32_t level_since_us;   /**< Início da permanência no nível atual. */
+    uint32_t transitions;      /**< Trocas de nível. */
+    uint32_t failures;         /**< Trocas recusadas por `set_sys_clock_khz`. */
+    uint32_t switch_us_max;    /**< Maior duração de uma troca (PLL, divisores e I2C). */
+    uint32_t sys_error_ppm_max;  /**< Maior desvio medido de `clk_sys`. */
+    uint32_t pwm_error_ppm_max;  /**< Maior desvio da frequência dos PWMs. */
+    uint32_t i2c_error_ppm_max;  /**< Maior desvio da taxa efetiva do I2C. */
+    uint i2c_actual_baudrate;  /**< Última taxa efetiva do I2C. */
+} clock_gov_t;
+
+/**
+ * @brief Inicializa o governador e ajusta `clk_sys` para o nível mais alto.
+ *
+ * Deve ser chamado antes de configurar os periféricos que dependem de `clk_sys`.
+ *
+ * @param[out] gov Governador.
+ * @param[in] levels_khz Níveis, em ordem crescente (cada um aceito por `set_sys_clock_khz`).
+ * @param[in] count Quantidade de níveis (até CLOCK_GOV_MAX_LEVELS).
+ * @return `true` se o nível mais alto foi aplicado.
+ */
+bool clock_gov_init(clock_gov_t *gov, const uint32_t *levels_khz, uint8_t count);
+
+/**
+ * @brief Passa a preservar a frequência atual de um slice PWM nas trocas.
+ *
+ * Chame com o slice já configurado. O divisor no nível mais baixo precisa
+ * continuar ≥ 1; um divisor que sairia da faixa é limitado, e o desvio aparece
+ * na verificação.
+ *
+ * @param[in,out] gov Governador.
+ * @param[in] slice Slice PWM.
+ * @return `true` se o slice foi registrado.
+ */
+bool clock_gov_track_pwm(clock_gov_t *gov, uint slice);
+
+/**
+ * @brief Passa a reprogramar a taxa de um barramento I2C nas trocas.
+ *
+ * @param[in,out] gov Governador.
+ * @param[in] i2c Barramento.
+ * @param[in] baudrate Taxa pedida.
+ */
+void clock_gov_track_i2c(clock_gov_t *gov, i2c_inst_t *i2c, uint baudrate);
+
+/**
+ * @brief Informa a carga de um quadro e, se necessário, troca de nível.
+ *
+ * Chamado pelo dono do I2C, entre quadros.
+ *
+ * @param[in,out] gov Governador.
+ * @param[in] render_us Tempo de composição do quadro (0 se não houve quadro).
+ * @param[in] flush_us Tempo de envio do quadro (0 se não houve quadro).
+ * @param[in] budget_us Período do quadro.
+ */
+void clock_gov_frame(clock_gov_t *gov, uint32_t render_us, uint32_t flush_us, uint32_t budget_us);
+
+/**
+ * @brief Troca de nível imediatamente, recalculando os periféricos e verificando-os.
+ *
+ * @param[in,out] gov Governador.
+ * @param[in] level Nível desejado.
+ * @return `true` se a troca foi aplicada (ou o nível já era o atual).
+ */
+bool clock_gov_set_level(clock_gov_t *gov, uint8_t level);
+
+/**
+ * @brief Liga ou desliga a política; desligada, o próximo quadro volta ao nível mais alto.
+ */
+void clock_gov_set_enabled(clock_gov_t *gov, bool enabled);
+
+/**
+ * @brief Imprime o nível atual, o tempo em cada nível, a frequência média e a verificação dos periféricos.
+ */
+void clock_gov_print(clock_gov_t *gov);
+
+/** @} */ // Fim do grupo "Clock_Gov"
+
+#endif // CLOCK_GOV_H
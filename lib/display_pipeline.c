@@ -0,0 +1,362 @@
+#include "display_pipeline.h"
+#include "pico/multicore.h"
+#include "oledgfx.h"
+#include "latency.h"
+#include "snapshot.h"
+#include "profile.h"
+#include "fb_mirror.h"
+#include "event_trace.h"
+
+/**
+ * @file display_pipeline.c
+ * @brief Implementação do pipeline do display no núcleo 1.
+ *
+ * O núcleo 1 executa seu próprio escalonador (sched.h) com a tarefa de quadro a
+ * DISPLAY_FRAME_PERIOD_US; entre quadros, dorme até a próxima liberação. Se não
+ * houve publicação desde o quadro anterior, ou se o estado publicado é igual ao
+ * exibido, a liberação é encerrada sem enviar nada; na visão do mapa, o mesmo
+ * vale quando nenhuma célula mudou de nível, e na do menu, quando nenhum widget
+ * mudou. O menu envia só as janelas redesenhadas, não o framebuffer inteiro.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Borda inválida: força a limpeza da tela no primeiro quadro. */
+#define DISPLAY_NO_BORDER 0xFF
+
+/** @brief Estado compartilhado entre os núcleos e suas quatro posições. */
+static snapshot_t display_snapshot;
+static display_state_t display_slots[SNAPSHOT_SLOTS];
+
+/** @brief Display, fluxo de telemetria, latência e duração dos quadros: usados apenas pelo núcleo 1. */
+static ssd1306_t *display_ssd;
+static telemetry_stream_t *display_telemetry;
+static latency_stats_t display_latency;
+static latency_stats_t display_frame_time;
+
+/** @brief Escalonador do núcleo 1. */
+static sched_t display_sched;
+
+/** @brief Governador de clock alimentado a cada liberação (opcional). */
+static clock_gov_t *display_clock_gov = NULL;
+
+/** @brief Mapa de cobertura (opcional) e os níveis já desenhados de cada célula. */
+static const heatmap_t *display_heatmap = NULL;
+static heatmap_view_t display_heatmap_view;
+
+/** @brief Sprites da visão do cursor: o marcador da posição medida, atrás, e o cursor. */
+static sprite_layer_t display_sprites;
+static int display_cursor_sprite;
+static int display_marker_sprite;
+
+/** @brief Menu (opcional) e o estado da tela desenhada. */
+static menu_t *display_menu = NULL;
+static menu_view_t display_menu_view;
+
+/** @brief Função de fundo executada ao fim de cada liberação (opcional). */
+static void (*display_background)(void) = NULL;
+
+/** @brief Quadros enviados (escrito pelo núcleo 1). */
+static volatile uint32_t display_frames = 0;
+
+/** @brief Média móvel da latência input-to-photon (escrita pelo núcleo 1, lida pelo núcleo 0). */
+static volatile uint32_t display_latency_estimate_us = 0;
+
+/** @brief Pedido de zerar a latência (escrito pelo núcleo 0, atendido pelo núcleo 1). */
+static volatile bool display_latency_reset_requested = false;
+
+/**
+ * @brief Envia o framebuffer, ou só algumas janelas dele, ao display e registra os tempos do quadro.
+ *
+ * @param state Estado exibido (instante da amostra, para a latência).
+ * @param frame_start_us Início da composição.
+ * @param windows Janelas a enviar, ou `NULL` para o quadro inteiro.
+ * @param window_count Quantidade de janelas.
+ * @param[out] render_us Tempo de composição.
+ * @param[out] flush_us Tempo de envio.
+ */
+static void display_pipeline_flush(const display_state_t *state, uint32_t frame_start_us,
+                                   const ssd1306_window_t *windows, uint8_t window_count, uint32_t *render_us,
+                                   uint32_t *flush_us)
+{
+    EVENT_TRACE_SCOPE(EVENT_TRACE_FLUSH, 0);
+    uint32_t flush_start_us = time_us_32();
+    if(windows == NULL)
+    {
+        oledgfx_render(display_ssd);
+    }
+    else
+    {
+        for(uint8_t i = 0; i < window_count; i++)
+        {
+            ssd1306_send_window(display_ssd, &windows[i]);
+        }
+    }
+
+    // O envio I2C é bloqueante: ao retornar, o último byte do quadro já está no barramento
+    uint32_t frame_end_us = time_us_32();
+    uint32_t latency_us = frame_end_us - state->sample_timestamp_us;
+    latency_record(&display_latency, latency_us);
+    uint32_t estimate_us = display_latency_estimate_us;
+    if(estimate_us == 0)
+        estimate_us = latency_us;
+    else
+        estimate_us = (uint32_t) ((int32_t) estimate_us + ((int32_t) (latency_us - estimate_us) >> DISPLAY_LATENCY_EWMA_SHIFT));
+    display_latency_estimate_us = estimate_us;
+    *render_us = flush_start_us - frame_start_us;
+    *flush_us = frame_end_us - flush_start_us;
+    latency_record(&display_frame_time, frame_end_us - frame_start_us);
+    telemetry_emit_frame(display_telemetry, frame_end_us, *render_us, *flush_us, latency_us);
+    display_frames = display_frames + 1u;
+}
+
+/**
+ * @brief Move os sprites para o estado e recompõe as áreas dos que mudaram.
+ *
+ * @param state Estado a ser exibido.
+ * @param[out] rects Áreas sujas (DISPLAY_SPRITE_RECTS).
+ * @return Áreas preenchidas.
+ */
+static uint8_t display_pipeline_compose_sprites(const display_state_t *state, ssd1306_window_t *rects)
+{
+    PROFILE_SCOPE(PROFILE_OLEDGFX_CURSOR);
+    sprite_move(&display_sprites, display_cursor_sprite, state->cursor_x, state->cursor_y);
+    sprite_move(&display_sprites, display_marker_sprite, state->marker_x, state->marker_y);
+    sprite_set_visible(&display_sprites, display_marker_sprite, state->marker_visible);
+    return sprite_layer_render(&display_sprites, display_ssd, rects, DISPLAY_SPRITE_RECTS);
+}
+
+/**
+ * @brief Compõe os sprites e a borda no framebuffer e envia as áreas que mudaram.
+ *
+ * A troca de borda limpa a tela e envia o quadro inteiro; nos demais quadros,
+ * só as áreas sujas dos sprites vão ao barramento.
+ *
+ * @param state Estado a ser exibido.
+ * @param border Borda atualmente desenhada; atualizada se o estado trouxer outra.
+ * @param[out] render_us Tempo de composição.
+ * @param[out] flush_us Tempo de envio.
+ */
+static void display_pipeline_render(const display_state_t *state, uint8_t *border, uint32_t *render_us,
+                                    uint32_t *flush_us)
+{
+    PROFILE_SCOPE(PROFILE_DISPLAY_FRAME);
+    EVENT_TRACE_SCOPE(EVENT_TRACE_RENDER, DISPLAY_VIEW_CURSOR);
+    uint32_t frame_start_us = time_us_32();
+    bool full = false;
+
+    if(state->border != *border)
+    {
+        oledgfx_clear_screen(display_ssd);
+        sprite_layer_invalidate(&display_sprites);
+        *border = state->border;
+        full = true;
+    }
+    ssd1306_window_t rects[DISPLAY_SPRITE_RECTS];
+    uint8_t count = display_pipeline_compose_sprites(state, rects);
+    // A camada apaga o que estava sob os sprites: a borda é redesenhada por cima
+    oledgfx_draw_border(display_ssd, *border);
+    if(full)
+        display_pipeline_flush(state, frame_start_us, NULL, 0, render_us, flush_us);
+    else if(count > 0)
+        display_pipeline_flush(state, frame_start_us, rects, count, render_us, flush_us);
+}
+
+/**
+ * @brief Redesenha as células do mapa que mudaram de nível e, se houver alguma, envia o quadro.
+ *
+ * @param state Estado publicado (instante da amostra).
+ * @param[out] render_us Tempo de composição.
+ * @param[out] flush_us Tempo de envio.
+ */
+static void display_pipeline_render_heatmap(const display_state_t *state, uint32_t *render_us, uint32_t *flush_us)
+{
+    PROFILE_SCOPE(PROFILE_DISPLAY_FRAME);
+    EVENT_TRACE_SCOPE(EVENT_TRACE_RENDER, DISPLAY_VIEW_HEATMAP);
+    uint32_t frame_start_us = time_us_32();
+    if(heatmap_draw(display_heatmap, &display_heatmap_view, display_ssd) == 0) return;
+    display_pipeline_flush(state, frame_start_us, NULL, 0, render_us, flush_us);
+}
+
+/**
+ * @brief Redesenha as linhas e os valores do menu que mudaram e envia só as suas janelas.
+ *
+ * @param state Estado publicado (instante da amostra).
+ * @param[out] render_us Tempo de composição.
+ * @param[out] flush_us Tempo de envio.
+ */
+static void display_pipeline_render_menu(const display_state_t *state, uint32_t *render_us, uint32_t *flush_us)
+{
+    PROFILE_SCOPE(PROFILE_DISPLAY_FRAME);
+    EVENT_TRACE_SCOPE(EVENT_TRACE_RENDER, DISPLAY_VIEW_MENU);
+    uint32_t frame_start_us = time_us_32();
+    ssd1306_window_t windows[MENU_MAX_WINDOWS];
+    uint8_t count = menu_draw(display_menu, &display_menu_view, display_ssd, windows);
+    if(count == 0) return;
+    display_pipeline_flush(state, frame_start_us, windows, count, render_us, flush_us);
+}
+
+/**
+ * @brief Tarefa de quadro: gera o quadro do estado mais recente, do mapa ou do menu, se ele mudar a tela.
+ *
+ * Ao final, com o I2C parado, entrega o framebuffer ao espelho, informa a carga ao governador
+ * de clock (com o barramento I2C tomado, pois a troca de nível reprograma sua taxa) e roda
+ * a função de fundo.
+ *
+ * @param ctx Não utilizado.
+ * @param release_us Instante de liberação.
+ */
+static void display_pipeline_frame_task(void *ctx, uint32_t release_us)
+{
+    (void) ctx;
+    (void) release_us;
+    EVENT_TRACE_SCOPE(EVENT_TRACE_TASK_FRAME, 0);
+    static uint8_t border = DISPLAY_NO_BORDER;
+    static uint8_t view = DISPLAY_VIEW_CURSOR;
+    static display_state_t shown;
+    uint32_t render_us = 0, flush_us = 0;
+
+    if(display_latency_reset_requested)
+    {
+        latency_reset(&display_latency);
+        latency_reset(&display_frame_time);
+        display_latency_reset_requested = false;
+    }
+
+    bool fresh;
+    const display_state_t *state = snapshot_read(&display_snapshot, &fresh);
+    uint8_t wanted_view = state->view;
+    if((wanted_view == DISPLAY_VIEW_HEATMAP && display_heatmap == NULL) ||
+       (wanted_view == DISPLAY_VIEW_MENU && display_menu == NULL))
+        wanted_view = DISPLAY_VIEW_CURSOR;
+    if(wanted_view != view)
+    {
+        // A troca de visão limpa a tela: a borda, todas as células e todo o menu são redesenhados
+        oledgfx_clear_screen(display_ssd);
+        heatmap_view_invalidate(&display_heatmap_view);
+        menu_view_invalidate(&display_menu_view);
+        border = DISPLAY_NO_BORDER;
+        view = wanted_view;
+    }
+
+    if(view == DISPLAY_VIEW_HEATMAP)
+    {
+        // O mapa muda sem novas publicações: as células são comparadas a cada liberação
+        display_pipeline_render_heatmap(state, &render_us, &flush_us);
+    }
+    else if(view == DISPLAY_VIEW_MENU)
+    {
+        // Os valores mudam sem novas publicações (rótulos, ajustes pelo console): também comparados a cada liberação
+        display_pipeline_render_menu(state, &render_us, &flush_us);
+    }
+    else
+    {
+        bool changed = state->border != border || state->cursor_x != shown.cursor_x ||
+                       state->cursor_y != shown.cursor_y || state->marker_visible != shown.marker_visible ||
+                       (state->marker_visible && (state->marker_x != shown.marker_x || state->marker_y != shown.marker_y));
+        if(fresh && changed)
+        {
+            display_pipeline_render(state, &border, &render_us, &flush_us);
+            shown = *state;
+        }
+    }
+
+    // O espelho codifica o framebuffer só quando está livre: nunca espera pelo USB
+    fb_mirror_capture(display_ssd->ram_buffer + 1, time_us_32());
+
+    if(display_clock_gov != NULL)
+    {
+        // A troca de nível reprograma a taxa do I2C: nenhuma transação de outro dispositivo pode estar no meio
+        if(display_ssd->bus != NULL) i2c_bus_acquire(display_ssd->bus);
+        clock_gov_frame(display_clock_gov, render_us, flush_us, DISPLAY_FRAME_PERIOD_US);
+        if(display_ssd->bus != NULL) i2c_bus_release(display_ssd->bus);
+    }
+    if(display_background != NULL) display_background();
+}
+
+/**
+ * @brief Ponto de entrada do núcleo 1: executa o escalonador do display.
+ */
+static void display_pipeline_core1_entry(void)
+{
+    profile_init_core();
+    sched_run(&display_sched);
+}
+
+void display_pipeline_set_clock_gov(clock_gov_t *gov)
+{
+    display_clock_gov = gov;
+}
+
+void display_pipeline_set_heatmap(const heatmap_t *map)
+{
+    display_heatmap = map;
+}
+
+void display_pipeline_set_menu(menu_t *menu)
+{
+    display_menu = menu;
+}
+
+void display_pipeline_set_background(void (*fn)(void))
+{
+    display_background = fn;
+}
+
+void display_pipeline_start(ssd1306_t *ssd, telemetry_stream_t *telemetry)
+{
+    display_ssd = ssd;
+    display_telemetry = telemetry;
+    latency_reset(&display_latency);
+    latency_reset(&display_frame_time);
+    snapshot_init(&display_snapshot, display_slots, sizeof(display_state_t));
+    sprite_layer_init(&display_sprites);
+    display_marker_sprite = sprite_add(&display_sprites, oledgfx_marker_bitmap, MARKER_SIDE, 1, 0);
+    display_cursor_sprite = sprite_add(&display_sprites, oledgfx_cursor_bitmap, CURSOR_SIDE, 1, 1);
+    sprite_set_visible(&display_sprites, display_cursor_sprite, true);
+    sched_init(&display_sched);
+    sched_add(&display_sched, "frame", display_pipeline_frame_task, NULL, DISPLAY_FRAME_PERIOD_US, 0, 0);
+    multicore_launch_core1(display_pipeline_core1_entry);
+}
+
+void display_pipeline_publish(const display_state_t *state)
+{
+    display_state_t *slot = (display_state_t *) snapshot_write_begin(&display_snapshot);
+    *slot = *state;
+    snapshot_write_end(&display_snapshot);
+}
+
+uint32_t display_pipeline_get_frame_count(void)
+{
+    return display_frames;
+}
+
+uint32_t display_pipeline_get_latency_estimate(void)
+{
+    return display_latency_estimate_us;
+}
+
+void display_pipeline_print_sprites(void)
+{
+    sprite_layer_print(&display_sprites, "sprites");
+}
+
+void display_pipeline_print_latency(void)
+{
+    latency_print(&display_latency, "input-to-photon");
+    latency_print(&display_frame_time, "frame-time");
+}
+
+void display_pipeline_reset_latency(void)
+{
+    display_latency_reset_requested = true;
+}
+
+sched_t *display_pipeline_get_sched(void)
+{
+    return &display_sched;
+}
@@ -0,0 +1,189 @@
+#ifndef DISPLAY_PIPELINE_H
+#define DISPLAY_PIPELINE_H
+
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+#include "telemetry.h"
+#include "sched.h"
+#include "clock_gov.h"
+#include "heatmap.h"
+#include "menu.h"
+#include "sprite.h"
+
+/**
+ * @file display_pipeline.h
+ * @brief Composição e envio dos quadros do OLED no núcleo 1.
+ *
+ * O núcleo 0 (amostragem, botões, LEDs, USB) publica a cada iteração um
+ * `display_state_t` com o estado a ser exibido; o núcleo 1 compõe o quadro a
+ * partir do estado mais recente e o envia pelo I2C. A troca usa snapshot.h:
+ * nenhum dos lados espera pelo outro, e estados publicados durante um envio
+ * (que leva ~25 ms a 400 kHz) são simplesmente substituídos pelo mais novo.
+ * Assim, a taxa de entrada deixa de ser limitada pela taxa de quadros.
+ *
+ * Os quadros são gerados a taxa fixa (DISPLAY_FRAME_PERIOD_US) pelo escalonador
+ * do núcleo 1. Depois de `display_pipeline_start`, o display e o barramento I2C pertencem
+ * ao núcleo 1, assim como o acumulador de latência input-to-photon e o fluxo de
+ * telemetria informado (um produtor por fluxo).
+ *
+ * Um estado igual ao último exibido (mesmo cursor e mesma borda) não gera
+ * quadro: a tela não mudaria, e o barramento e a CPU ficam livres. O cursor e
+ * o marcador da posição medida são sprites (sprite.h): a cada quadro, só as
+ * áreas dos sprites que se moveram são recompostas e enviadas, em janelas do
+ * display; o quadro inteiro só é enviado quando a tela é limpa. Na visão do
+ * mapa de cobertura (heatmap.h), o quadro só é enviado quando alguma célula
+ * muda de nível, e só essas células são redesenhadas. Na visão do menu
+ * (menu.h), só as linhas e os valores que mudaram são redesenhados, e só as
+ * janelas correspondentes do display são enviadas. Se houver
+ * um governador de clock, ele recebe a carga de cada liberação e troca de
+ * nível entre quadros, com o I2C parado. Em seguida, roda a função de fundo
+ * registrada (a gravação da flash, por exemplo).
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Display_Pipeline Pipeline do display
+ * @brief Núcleo 1 dedicado à composição e ao envio dos quadros.
+ * @{
+ */
+
+/**
+ * @brief Período dos quadros (30 Hz).
+ *
+ * A 400 kHz, o envio de um quadro (1025 bytes + comandos) ocupa ~23 ms do
+ * barramento, então 60 Hz não é alcançável; 30 Hz deixa folga para o prazo.
+ */
+#define DISPLAY_FRAME_PERIOD_US 33333
+
+/**
+ * @brief Áreas sujas enviadas por quadro na visão do cursor (acima disso, uma só que cobre todas).
+ */
+#define DISPLAY_SPRITE_RECTS 4
+
+/**
+ * @brief Peso das novas medições na estimativa da latência input-to-photon (1/2^n).
+ *
+ * Com n = 3, a estimativa acompanha uma mudança de regime (troca de clock,
+ * quadros ociosos) em algumas dezenas de quadros.
+ */
+#define DISPLAY_LATENCY_EWMA_SHIFT 3
+
+/**
+ * @brief Visões do display.
+ */
+typedef enum
+{
+    DISPLAY_VIEW_CURSOR = 0, /**< Cursor e borda. */
+    DISPLAY_VIEW_HEATMAP,    /**< Mapa de cobertura das posições. */
+    DISPLAY_VIEW_MENU        /**< Menu de configuração. */
+} display_view_t;
+
+/**
+ * @brief Estado publicado pelo núcleo 0 para o próximo quadro.
+ */
+typedef struct
+{
+    uint8_t cursor_x;           /**< Posição X do cursor. */
+    uint8_t cursor_y;           /**< Posição Y do cursor. */
+    uint8_t border;             /**< Espessura da borda (a troca limpa a tela). */
+    uint8_t view;               /**< `display_view_t` (a troca limpa a tela). */
+    uint8_t marker_x;           /**< Posição X do marcador da posição medida. */
+    uint8_t marker_y;           /**< Posição Y do marcador. */
+    bool marker_visible;        /**< Marcador exibido (com a predição, o cursor mostra a posição prevista). */
+    uint32_t sample_timestamp_us; /**< Instante da leitura do ADC que originou o estado. */
+} display_state_t;
+
+/**
+ * @brief Define o governador de clock alimentado pelos quadros (antes de `display_pipeline_start`).
+ *
+ * @param[in] gov Governador, ou `NULL`.
+ */
+void display_pipeline_set_clock_gov(clock_gov_t *gov);
+
+/**
+ * @brief Define o mapa exibido na visão DISPLAY_VIEW_HEATMAP (antes de `display_pipeline_start`).
+ *
+ * @param[in] map Mapa alimentado pelo núcleo 0, ou `NULL` (a visão mostra o cursor).
+ */
+void display_pipeline_set_heatmap(const heatmap_t *map);
+
+/**
+ * @brief Define o menu exibido na visão DISPLAY_VIEW_MENU (antes de `display_pipeline_start`).
+ *
+ * @param[in] menu Menu operado pelo núcleo 0, ou `NULL` (a visão mostra o cursor).
+ */
+void display_pipeline_set_menu(menu_t *menu);
+
+/**
+ * @brief Define a função executada pelo núcleo 1 ao fim de cada liberação, com o I2C parado.
+ *
+ * Deve ser chamada antes de `display_pipeline_start`.
+ *
+ * @param[in] fn Função de fundo (ou `NULL`).
+ */
+void display_pipeline_set_background(void (*fn)(void));
+
+/**
+ * @brief Inicia o núcleo 1 com o laço de composição e envio.
+ *
+ * @param[in] ssd Display já inicializado pelo núcleo 0.
+ * @param[in] telemetry Fluxo que recebe os tempos de cada quadro (produzido só pelo núcleo 1).
+ */
+void display_pipeline_start(ssd1306_t *ssd, telemetry_stream_t *telemetry);
+
+/**
+ * @brief Publica um novo estado para o núcleo 1, sem esperar (núcleo 0).
+ *
+ * @param[in] state Estado a ser exibido.
+ */
+void display_pipeline_publish(const display_state_t *state);
+
+/**
+ * @brief Retorna a quantidade de quadros enviados ao display.
+ *
+ * @return Quadros concluídos desde o início.
+ */
+uint32_t display_pipeline_get_frame_count(void);
+
+/**
+ * @brief Retorna a média móvel exponencial da latência input-to-photon dos quadros enviados.
+ *
+ * É o horizonte da predição de entrada (predict.h): o intervalo esperado entre a
+ * leitura de uma amostra e o fim do envio do quadro que a exibe.
+ *
+ * @return Latência estimada em us (0 antes do primeiro quadro).
+ */
+uint32_t display_pipeline_get_latency_estimate(void);
+
+/**
+ * @brief Imprime os contadores da camada de sprites da visão do cursor.
+ */
+void display_pipeline_print_sprites(void);
+
+/**
+ * @brief Imprime a latência input-to-photon e a duração dos quadros (composição e envio) acumuladas pelo núcleo 1.
+ */
+void display_pipeline_print_latency(void);
+
+/**
+ * @brief Pede ao núcleo 1 que zere os acumuladores de latência e de duração antes do próximo quadro.
+ */
+void display_pipeline_reset_latency(void);
+
+/**
+ * @brief Retorna o escalonador do núcleo 1, para consulta das estatísticas.
+ *
+ * @return Escalonador do display.
+ */
+sched_t *display_pipeline_get_sched(void);
+
+/** @} */ // Fim do grupo "Display_Pipeline"
+
+#endif // DISPLAY_PIPELINE_H
@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include "event_trace.h"
+#include "hardware/sync.h"
+#include "ram_func.h"
+
+/**
+ * @file event_trace.c
+ * @brief Buffers por núcleo, janela de registro e despejo da linha do tempo.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#if EVENT_TRACE_ENABLED
+
+/**
+ * @brief Buffer de um núcleo: `head` só é escrito pelo próprio núcleo.
+ */
+typedef struct
+{
+    event_trace_event_t *events;
+    uint32_t mask;
+    volatile uint32_t head;
+} event_trace_ring_t;
+
+static event_trace_event_t event_trace_core0[EVENT_TRACE_CORE0_EVENTS];
+static event_trace_event_t event_trace_core1[EVENT_TRACE_CORE1_EVENTS];
+static event_trace_ring_t event_trace_rings[2] = {
+    {event_trace_core0, EVENT_TRACE_CORE0_EVENTS - 1u, 0},
+    {event_trace_core1, EVENT_TRACE_CORE1_EVENTS - 1u, 0},
+};
+
+/** @brief Janela em andamento (escrita pelo console e pela sonda que a encerra). */
+static volatile bool event_trace_active = false;
+static uint32_t event_trace_start_us = 0;
+static uint32_t event_trace_window_us = 0;
+
+/** @brief Nomes exibidos, na ordem de `event_trace_id_t`. */
+static const char *const event_trace_names[EVENT_TRACE_ID_COUNT] = {
+    "sampling_isr",
+    "usb_frame",
+    "button",
+    "task_input",
+    "task_led",
+    "task_console",
+    "task_frame",
+    "render",
+    "flush",
+    "i2c",
+    "mirror",
+    "flash",
+    "clock",
+};
+
+void RAM_FUNC(event_trace_emit)(uint8_t phase, uint8_t id, uint16_t arg)
+{
+    if(!event_trace_active) return;
+    event_trace_ring_t *ring = &event_trace_rings[get_core_num()];
+
+    // Instante e posição lidos juntos: os eventos de cada núcleo ficam em ordem no buffer
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t now_us = time_us_32();
+    uint32_t index = ring->head;
+    if(event_trace_window_us != 0 && now_us - event_trace_start_us >= event_trace_window_us)
+    {
+        event_trace_active = false;
+        restore_interrupts(irq);
+        return;
+    }
+    ring->head = index + 1u;
+    restore_interrupts(irq);
+
+    event_trace_event_t *event = &ring->events[index & ring->mask];
+    event->timestamp_us = now_us;
+    event->phase = phase;
+    event->id = id;
+    event->arg = arg;
+}
+
+void event_trace_start(uint32_t window_us)
+{
+    event_trace_active = false;
+    event_trace_rings[0].head = 0;
+    event_trace_rings[1].head = 0;
+    event_trace_window_us = window_us;
+    event_trace_start_us = time_us_32();
+    __sync_synchronize();
+    event_trace_active = true;
+}
+
+bool event_trace_is_active(void)
+{
+    return event_trace_active;
+}
+
+void event_trace_dump(void)
+{
+    event_trace_active = false;
+    __sync_synchronize();
+
+    printf("# event_trace cores=2 janela=%lu\n", (unsigned long) event_trace_window_us);
+    for(uint id = 0; id < EVENT_TRACE_ID_COUNT; id++)
+    {
+        printf("N %u %s\n", id, event_trace_names[id]);
+    }
+    for(uint core = 0; core < 2; core++)
+    {
+        const event_trace_ring_t *ring = &event_trace_rings[core];
+        uint32_t head = ring->head;
+        uint32_t count = head > ring->mask ? ring->mask + 1u : head;
+        printf("C %u eventos=%lu sobrescritos=%lu\n", core, (unsigned long) count, (unsigned long) (head - count));
+        for(uint32_t i = head - count; i != head; i++)
+        {
+            const event_trace_event_t *event = &ring->events[i & ring->mask];
+            printf("E %u %lu %c %u %u\n", core, (unsigned long) event->timestamp_us, event->phase, event->id,
+                   event->arg);
+        }
+    }
+    printf("# fim\n");
+}
+
+#else
+
+void event_trace_start(uint32_t window_us)
+{
+    (void) window_us;
+}
+
+bool event_trace_is_active(void)
+{
+    return false;
+}
+
+void event_trace_dump(void)
+{
+    printf("event_trace: desativado (compile com -DJOYTRACKER_EVENT_TRACE=ON)\n");
+}
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @file event_trace.h
+ * @brief Registro de eventos na linha do tempo, por núcleo, exportável para o formato de trace do Chrome.
+ *
+ * Os acumuladores (latency.h, profile.h, sched.h) resumem durações, mas não
+ * mostram como interrupções, amostragem, composição e barramento se intercalam.
+ * As sondas deste módulo registram eventos de início, fim e instantâneos, com
+ * o instante em us, em um buffer circular por núcleo: cada núcleo só escreve
+ * no seu, e a reserva da posição é feita com as interrupções desligadas por
+ * alguns ciclos, de modo que interrupções e tarefas do mesmo núcleo podem
+ * registrar sem trava entre os núcleos.
+ *
+ * O registro é armado pelo console por uma janela (1 s por padrão) e para
+ * sozinho no fim dela; com o buffer cheio, os eventos mais antigos são
+ * sobrescritos. O despejo é lido por tools/trace_to_chrome.py, que gera o
+ * JSON aberto por chrome://tracing ou pelo Perfetto:
+ *
+ *     # event_trace cores=2 janela=<us>
+ *     N <id> <nome>
+ *     C <núcleo> eventos=<n> sobrescritos=<n>
+ *     E <núcleo> <instante em us> <B|E|I> <id> <argumento>
+ *     # fim
+ *
+ * As sondas só são compiladas com `EVENT_TRACE_ENABLED=1` (opção
+ * JOYTRACKER_EVENT_TRACE do CMake); caso contrário, as macros não geram código.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Event_Trace Linha do tempo
+ * @brief Eventos de início/fim/instantâneos em buffers circulares por núcleo.
+ * @{
+ */
+
+#ifndef EVENT_TRACE_ENABLED
+#define EVENT_TRACE_ENABLED 0
+#endif
+
+/** @brief Eventos por núcleo (potências de dois): ~5 mil eventos/s no núcleo 0, ~1 mil no núcleo 1. */
+#define EVENT_TRACE_CORE0_EVENTS 8192
+#define EVENT_TRACE_CORE1_EVENTS 2048
+
+/** @brief Janela padrão do registro. */
+#define EVENT_TRACE_WINDOW_US 1000000u
+
+/** @brief Fases de um evento. */
+#define EVENT_TRACE_BEGIN   'B'
+#define EVENT_TRACE_END     'E'
+#define EVENT_TRACE_INSTANT 'I'
+
+/**
+ * @brief Eventos instrumentados; o núcleo é o que executa a sonda.
+ */
+typedef enum
+{
+    EVENT_TRACE_SAMPLING_ISR = 0, /**< Interrupção de amostragem (núcleo 0). */
+    EVENT_TRACE_USB_FRAME,        /**< Tratadores do início de quadro USB (núcleo 0). */
+    EVENT_TRACE_BUTTON,           /**< Evento de botão; argumento: gpio << 8 | tipo. */
+    EVENT_TRACE_TASK_INPUT,       /**< Tarefa de entrada (núcleo 0). */
+    EVENT_TRACE_TASK_LED,         /**< Tarefa dos LEDs (núcleo 0). */
+    EVENT_TRACE_TASK_CONSOLE,     /**< Tarefa do console (núcleo 0). */
+    EVENT_TRACE_TASK_FRAME,       /**< Tarefa de quadro (núcleo 1). */
+    EVENT_TRACE_RENDER,           /**< Composição do quadro (núcleo 1); argumento: visão. */
+    EVENT_TRACE_FLUSH,            /**< Envio do quadro (núcleo 1). */
+    EVENT_TRACE_I2C,              /**< Transação I2C; argumento: bytes. */
+    EVENT_TRACE_MIRROR,           /**< Codificação do espelho do framebuffer (núcleo 1). */
+    EVENT_TRACE_FLASH,            /**< Operação na flash do gravador (núcleo 1); argumento: 0 grava, 1 apaga. */
+    EVENT_TRACE_CLOCK,            /**< Troca de nível de clock; argumento: novo nível. */
+    EVENT_TRACE_ID_COUNT
+} event_trace_id_t;
+
+/**
+ * @brief Evento registrado (8 bytes).
+ */
+typedef struct
+{
+    uint32_t timestamp_us; /**< Instante do evento. */
+    uint8_t phase;         /**< EVENT_TRACE_BEGIN, _END ou _INSTANT. */
+    uint8_t id;            /**< `event_trace_id_t`. */
+    uint16_t arg;          /**< Argumento do evento. */
+} event_trace_event_t;
+
+#if EVENT_TRACE_ENABLED
+
+/**
+ * @brief Registra um evento no buffer do núcleo que chama (interrupções inclusive).
+ *
+ * @param phase Fase.
+ * @param id Evento.
+ * @param arg Argumento.
+ */
+void event_trace_emit(uint8_t phase, uint8_t id, uint16_t arg);
+
+/**
+ * @brief Fecha o intervalo aberto por `EVENT_TRACE_SCOPE` (chamada pelo `cleanup` do GCC).
+ */
+static inline void event_trace_scope_end(const uint8_t *id)
+{
+    event_trace_emit(EVENT_TRACE_END, *id, 0);
+}
+
+/**
+ * @brief Abre o intervalo de um escopo.
+ */
+static inline uint8_t event_trace_scope_begin(uint8_t id, uint16_t arg)
+{
+    event_trace_emit(EVENT_TRACE_BEGIN, id, arg);
+    return id;
+}
+
+#define EVENT_TRACE_CONCAT_(a, b) a##b
+#define EVENT_TRACE_CONCAT(a, b) EVENT_TRACE_CONCAT_(a, b)
+
+/**
+ * @brief Registra o restante do bloco atual como um intervalo do evento `id`.
+ */
+#define EVENT_TRACE_SCOPE(id, arg) \
+    uint8_t EVENT_TRACE_CONCAT(event_trace_scope_, __LINE__) __attribute__((cleanup(event_trace_scope_end))) = \
+        event_trace_scope_begin(id, arg)
+
+/**
+ * @brief Registra um evento instantâneo.
+ */
+#define EVENT_TRACE_MARK(id, arg) event_trace_emit(EVENT_TRACE_INSTANT, id, arg)
+
+#else
+
+#define EVENT_TRACE_SCOPE(id, arg) ((void) 0)
+#define EVENT_TRACE_MARK(id, arg) ((void) 0)
+
+#endif
+
+/**
+ * @brief Esvazia os buffers e registra pelos próximos `window_us` microssegundos.
+ *
+ * Um evento concorrente do outro núcleo pode ficar da janela anterior.
+ *
+ * @param[in] window_us Duração da janela (0: até o próximo despejo).
+ */
+void event_trace_start(uint32_t window_us);
+
+/**
+ * @brief Indica se há uma janela em andamento.
+ */
+bool event_trace_is_active(void);
+
+/**
+ * @brief Encerra a janela e imprime os eventos dos dois núcleos pelo USB stdio.
+ */
+void event_trace_dump(void);
+
+/** @} */ // Fim do grupo "Event_Trace"
+
+#endif // EVENT_TRACE_H
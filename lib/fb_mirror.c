@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <string.h>
+#include "fb_mirror.h"
+#include "event_trace.h"
+
+/**
+ * @file fb_mirror.c
+ * @brief Implementação do espelho do framebuffer.
+ *
+ * O quadro codificado é passado do núcleo 1 ao núcleo 0 por `mirror_ready`:
+ * o núcleo 1 só escreve no buffer com a flag desligada e o núcleo 0 só o lê
+ * com ela ligada, desligando-a após o último registro.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Sobrecarga de um registro: cabeçalho da telemetria, do trecho e do COBS (até 254 bytes). */
+#define FB_MIRROR_RECORD_OVERHEAD (TELEMETRY_HEADER_SIZE + FB_MIRROR_CHUNK_HEADER + 2)
+
+/** @brief Último quadro espelhado, como o host o reconstrói (núcleo 1). */
+static uint8_t mirror_reference[FB_MIRROR_FB_SIZE];
+static uint32_t mirror_last_capture_us = 0;
+static uint32_t mirror_since_keyframe = 0;
+
+/** @brief Quadro codificado, entregue ao núcleo 0 por `mirror_ready`. */
+static uint8_t mirror_encoded[FB_MIRROR_MAX_ENCODED];
+static uint32_t mirror_encoded_len = 0;
+static uint32_t mirror_encoded_timestamp_us = 0;
+static uint16_t mirror_frame_id = 0;
+static uint8_t mirror_encoded_flags = 0;
+static volatile bool mirror_ready = false;
+
+/** @brief Estado do envio (núcleo 0). */
+static uint32_t mirror_sent = 0;
+static uint16_t mirror_sequence = 0;
+static uint8_t mirror_stream_id = 0;
+
+/** @brief Pedidos do núcleo 0, atendidos pelo núcleo 1 na próxima captura. */
+static volatile bool mirror_enabled = false;
+static volatile bool mirror_keyframe_requested = true;
+
+/** @brief Contadores: os do envio são escritos pelo núcleo 0, os demais pelo núcleo 1. */
+static fb_mirror_stats_t mirror_stats;
+static uint32_t mirror_records = 0;
+static uint32_t mirror_discarded = 0;
+
+/**
+ * @brief Comprimento da sequência de XOR iguais a partir de `i` (até FB_MIRROR_TOKEN_MAX_RUN).
+ */
+static uint32_t fb_mirror_run(const uint8_t *fb, uint32_t i, uint8_t value)
+{
+    uint32_t run = 1;
+    while(i + run < FB_MIRROR_FB_SIZE && run < FB_MIRROR_TOKEN_MAX_RUN &&
+          (uint8_t) (fb[i + run] ^ mirror_reference[i + run]) == value)
+    {
+        run++;
+    }
+    return run;
+}
+
+/**
+ * @brief Codifica o XOR entre o framebuffer e a referência.
+ *
+ * @return Bytes escritos em `mirror_encoded` (0 se nada mudou).
+ */
+static uint32_t fb_mirror_encode(const uint8_t *fb)
+{
+    // Depois do último byte alterado não há nada a enviar
+    uint32_t end = FB_MIRROR_FB_SIZE;
+    while(end > 0 && fb[end - 1] == mirror_reference[end - 1]) end--;
+
+    uint32_t out = 0;
+    uint32_t i = 0;
+    while(i < end)
+    {
+        uint8_t value = fb[i] ^ mirror_reference[i];
+        uint32_t run = fb_mirror_run(fb, i, value);
+        if(value == 0)
+        {
+            mirror_encoded[out++] = (uint8_t) (FB_MIRROR_TOKEN_SKIP | (run - 1u));
+            i += run;
+        }
+        else if(run >= 3)
+        {
+            mirror_encoded[out++] = (uint8_t) (FB_MIRROR_TOKEN_FILL | (run - 1u));
+            mirror_encoded[out++] = value;
+            i += run;
+        }
+        else
+        {
+            // Literais até o início de uma sequência que compense um token próprio
+            uint32_t token = out++;
+            uint32_t count = 0;
+            while(i < end && count < FB_MIRROR_TOKEN_MAX_RUN)
+            {
+                value = fb[i] ^ mirror_reference[i];
+                run = fb_mirror_run(fb, i, value);
+                if(count > 0 && (run >= 3 || (value == 0 && run >= 2))) break;
+                mirror_encoded[out++] = value;
+                count++;
+                i++;
+            }
+            mirror_encoded[token] = (uint8_t) (FB_MIRROR_TOKEN_LITERAL | (count - 1u));
+        }
+    }
+    return out;
+}
+
+void fb_mirror_init(uint8_t stream_id)
+{
+    mirror_stream_id = stream_id;
+}
+
+void fb_mirror_set_enabled(bool enabled)
+{
+    if(enabled && !mirror_enabled) mirror_keyframe_requested = true;
+    mirror_enabled = enabled;
+}
+
+bool fb_mirror_is_enabled(void)
+{
+    return mirror_enabled;
+}
+
+void fb_mirror_capture(const uint8_t *fb, uint32_t now_us)
+{
+    if(!mirror_enabled || now_us - mirror_last_capture_us < FB_MIRROR_MIN_PERIOD_US) return;
+    if(mirror_ready)
+    {
+        mirror_stats.busy++;
+        return;
+    }
+
+    EVENT_TRACE_SCOPE(EVENT_TRACE_MIRROR, 0);
+    uint32_t start_us = time_us_32();
+    uint8_t flags = FB_MIRROR_FLAG_LAST;
+    if(mirror_keyframe_requested || mirror_since_keyframe >= FB_MIRROR_KEYFRAME_INTERVAL)
+    {
+        mirror_keyframe_requested = false;
+        memset(mirror_reference, 0, sizeof(mirror_reference));
+        mirror_since_keyframe = 0;
+        flags |= FB_MIRROR_FLAG_KEYFRAME;
+    }
+
+    uint32_t len = fb_mirror_encode(fb);
+    mirror_last_capture_us = now_us;
+    if(len == 0 && !(flags & FB_MIRROR_FLAG_KEYFRAME)) return; // Nada mudou
+    memcpy(mirror_reference, fb, sizeof(mirror_reference));
+
+    mirror_encoded_len = len;
+    mirror_encoded_flags = flags;
+    mirror_encoded_timestamp_us = now_us;
+    mirror_frame_id++;
+    mirror_since_keyframe++;
+    mirror_stats.frames++;
+    if(flags & FB_MIRROR_FLAG_KEYFRAME) mirror_stats.keyframes++;
+    mirror_stats.encoded_bytes += len;
+    uint32_t encode_us = time_us_32() - start_us;
+    if(encode_us > mirror_stats.encode_us_max) mirror_stats.encode_us_max = encode_us;
+
+    __sync_synchronize(); // O quadro codificado fica visível antes da flag
+    mirror_ready = true;
+}
+
+uint32_t fb_mirror_drain(uint32_t max_bytes, telemetry_write_fn_t write)
+{
+    if(!mirror_ready) return 0;
+    if(write == NULL)
+    {
+        // Sem host, o quadro se perde: o próximo precisa ser um quadro-chave
+        mirror_sent = 0;
+        mirror_keyframe_requested = true;
+        mirror_discarded++;
+        mirror_ready = false;
+        return 0;
+    }
+
+    uint8_t record[TELEMETRY_HEADER_SIZE + FB_MIRROR_CHUNK_HEADER + FB_MIRROR_CHUNK_MAX];
+    uint8_t frame[sizeof(record) + 2];
+    uint32_t written = 0;
+    while(mirror_ready)
+    {
+        uint32_t remaining = mirror_encoded_len - mirror_sent;
+        uint32_t room = max_bytes - written;
+        if(room < FB_MIRROR_RECORD_OVERHEAD) break;
+        uint32_t chunk = room - FB_MIRROR_RECORD_OVERHEAD;
+        if(chunk > FB_MIRROR_CHUNK_MAX) chunk = FB_MIRROR_CHUNK_MAX;
+        if(chunk >= remaining)
+            chunk = remaining;
+        else if(chunk < FB_MIRROR_CHUNK_MIN)
+            break;
+
+        bool last = mirror_sent + chunk == mirror_encoded_len;
+        uint8_t flags = (uint8_t) ((mirror_encoded_flags & FB_MIRROR_FLAG_KEYFRAME) | (last ? FB_MIRROR_FLAG_LAST : 0u));
+        uint16_t sequence = mirror_sequence++;
+        uint32_t t = mirror_encoded_timestamp_us;
+        uint8_t header[TELEMETRY_HEADER_SIZE + FB_MIRROR_CHUNK_HEADER] = {
+            TELEMETRY_FRAMEBUFFER, mirror_stream_id, (uint8_t) sequence, (uint8_t) (sequence >> 8),
+            (uint8_t) t, (uint8_t) (t >> 8), (uint8_t) (t >> 16), (uint8_t) (t >> 24),
+            (uint8_t) mirror_frame_id, (uint8_t) (mirror_frame_id >> 8),
+            (uint8_t) mirror_sent, (uint8_t) (mirror_sent >> 8), flags,
+        };
+        memcpy(record, header, sizeof(header));
+        memcpy(record + sizeof(header), mirror_encoded + mirror_sent, chunk);
+        uint32_t frame_len = telemetry_cobs_encode(record, sizeof(header) + chunk, frame);
+        write(frame, frame_len);
+        written += frame_len;
+        mirror_records++;
+
+        mirror_sent += chunk;
+        if(last)
+        {
+            mirror_sent = 0;
+            __sync_synchronize();
+            mirror_ready = false;
+        }
+    }
+    return written;
+}
+
+void fb_mirror_get_stats(fb_mirror_stats_t *stats)
+{
+    *stats = mirror_stats;
+    stats->enabled = mirror_enabled;
+    stats->records = mirror_records;
+    stats->discarded = mirror_discarded;
+}
+
+void fb_mirror_print_stats(void)
+{
+    fb_mirror_stats_t stats;
+    fb_mirror_get_stats(&stats);
+    uint32_t mean = stats.frames ? stats.encoded_bytes / stats.frames : 0;
+    printf("mirror: %s quadros=%lu chave=%lu ocupado=%lu descartados=%lu registros=%lu\n",
+           stats.enabled ? "on" : "off", (unsigned long) stats.frames, (unsigned long) stats.keyframes,
+           (unsigned long) stats.busy, (unsigned long) stats.discarded, (unsigned long) stats.records);
+    printf("mirror: bytes=%lu media=%lu B/quadro (bruto %u, %lu%%) codificacao_max=%luus\n",
+           (unsigned long) stats.encoded_bytes, (unsigned long) mean, FB_MIRROR_FB_SIZE,
+           (unsigned long) (mean * 100u / FB_MIRROR_FB_SIZE), (unsigned long) stats.encode_us_max);
+}
@@ -0,0 +1,154 @@
+#ifndef FB_MIRROR_H
+#define FB_MIRROR_H
+
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+#include "telemetry.h"
+
+/**
+ * @file fb_mirror.h
+ * @brief Espelhamento do framebuffer do OLED pela interface CDC de telemetria.
+ *
+ * Quando ativado, o núcleo 1 compara, a cada liberação da tarefa de quadro, o
+ * framebuffer (`ram_buffer`, 1024 bytes de colunas) com o último quadro
+ * espelhado e codifica a diferença: XOR byte a byte, comprimido em sequências
+ * (RLE). Cada token tem 1 byte, com o tipo nos 2 bits altos e a contagem - 1
+ * (1 a 64 bytes) nos 6 baixos:
+ *
+ *     SKIP    (0x00): n bytes sem mudança (XOR zero)
+ *     FILL    (0x40): n bytes com o mesmo XOR, dado no byte seguinte
+ *     LITERAL (0x80): n valores de XOR, nos bytes seguintes
+ *
+ * As sequências finais sem mudança são omitidas: um quadro igual ao anterior
+ * não gera nada. O quadro-chave é o XOR contra uma tela apagada; ele é enviado
+ * na ativação, após uma desconexão e a cada FB_MIRROR_KEYFRAME_INTERVAL
+ * quadros espelhados.
+ *
+ * O quadro codificado fica em um buffer até ser enviado pelo núcleo 0, no
+ * início de quadro USB, em registros TELEMETRY_FRAMEBUFFER com o espaço que a
+ * telemetria deixou livre. Enquanto o envio anterior não termina, ou antes de
+ * FB_MIRROR_MIN_PERIOD_US desde o último, o núcleo 1 não codifica nada e
+ * segue com os quadros: o espelho pula estados intermediários, mas nunca
+ * atrasa o display.
+ *
+ * Conteúdo de um registro TELEMETRY_FRAMEBUFFER (após o cabeçalho de 8 bytes):
+ *
+ *     u16 quadro   u16 deslocamento no quadro codificado   u8 flags   dados
+ *
+ * O reconstrutor do host está em tools/fb_mirror_view.py.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Fb_Mirror Espelho do framebuffer
+ * @brief Codificação XOR + RLE do framebuffer e envio em registros de telemetria.
+ * @{
+ */
+
+/** @brief Bytes do framebuffer espelhado (sem o byte de controle do SSD1306). */
+#define FB_MIRROR_FB_SIZE (WIDTH * HEIGHT / 8)
+
+/** @brief Maior quadro codificado: um token a cada 64 literais. */
+#define FB_MIRROR_MAX_ENCODED (FB_MIRROR_FB_SIZE + FB_MIRROR_FB_SIZE / 64)
+
+/** @brief Intervalo mínimo entre quadros espelhados (10 quadros/s). */
+#define FB_MIRROR_MIN_PERIOD_US 100000
+
+/** @brief Quadros espelhados entre dois quadros-chave. */
+#define FB_MIRROR_KEYFRAME_INTERVAL 50
+
+/** @brief Dados por registro: o registro codificado cabe em um pacote USB de 64 bytes. */
+#define FB_MIRROR_CHUNK_MAX 48
+
+/** @brief Menor trecho enviado antes do último de um quadro. */
+#define FB_MIRROR_CHUNK_MIN 8
+
+/** @brief Cabeçalho do conteúdo de um registro: quadro, deslocamento e flags. */
+#define FB_MIRROR_CHUNK_HEADER 5
+
+/** @brief Tokens da codificação. */
+#define FB_MIRROR_TOKEN_SKIP    0x00u
+#define FB_MIRROR_TOKEN_FILL    0x40u
+#define FB_MIRROR_TOKEN_LITERAL 0x80u
+#define FB_MIRROR_TOKEN_MAX_RUN 64u
+
+/** @brief Flags de um registro. */
+#define FB_MIRROR_FLAG_KEYFRAME 0x01u /**< O quadro é relativo a uma tela apagada. */
+#define FB_MIRROR_FLAG_LAST     0x02u /**< Último registro do quadro. */
+
+/**
+ * @brief Contadores do espelho.
+ */
+typedef struct
+{
+    bool enabled;            /**< Espelhamento ativo. */
+    uint32_t frames;         /**< Quadros codificados. */
+    uint32_t keyframes;      /**< Dos quais quadros-chave. */
+    uint32_t busy;           /**< Liberações puladas com o quadro anterior ainda em envio. */
+    uint32_t discarded;      /**< Quadros descartados sem host conectado. */
+    uint32_t encoded_bytes;  /**< Bytes codificados. */
+    uint32_t records;        /**< Registros enviados. */
+    uint32_t encode_us_max;  /**< Maior tempo de codificação no núcleo 1. */
+} fb_mirror_stats_t;
+
+/**
+ * @brief Define o identificador de fluxo dos registros (antes de ativar).
+ *
+ * @param[in] stream_id Identificador repetido em cada registro, com sequência própria.
+ */
+void fb_mirror_init(uint8_t stream_id);
+
+/**
+ * @brief Ativa ou desativa o espelhamento; a ativação começa por um quadro-chave.
+ *
+ * @param[in] enabled Novo estado.
+ */
+void fb_mirror_set_enabled(bool enabled);
+
+/**
+ * @brief Indica se o espelhamento está ativo.
+ */
+bool fb_mirror_is_enabled(void);
+
+/**
+ * @brief Codifica o framebuffer, se o espelho estiver ativo, livre e fora do intervalo mínimo.
+ *
+ * Chamada pelo núcleo 1 a cada liberação da tarefa de quadro.
+ *
+ * @param[in] fb Framebuffer (FB_MIRROR_FB_SIZE bytes, após o byte de controle).
+ * @param[in] now_us Instante atual.
+ */
+void fb_mirror_capture(const uint8_t *fb, uint32_t now_us);
+
+/**
+ * @brief Envia registros do quadro codificado pendente, sem exceder `max_bytes`.
+ *
+ * Chamada pelo núcleo 0 no início de quadro USB. Sem destino (`write == NULL`),
+ * descarta o quadro pendente e pede um quadro-chave.
+ *
+ * @param[in] max_bytes Espaço disponível no destino.
+ * @param[in] write Destino dos quadros COBS, ou `NULL`.
+ * @return Bytes entregues a `write`.
+ */
+uint32_t fb_mirror_drain(uint32_t max_bytes, telemetry_write_fn_t write);
+
+/**
+ * @brief Copia os contadores.
+ */
+void fb_mirror_get_stats(fb_mirror_stats_t *stats);
+
+/**
+ * @brief Imprime os contadores, os bytes médios por quadro e a razão em relação ao quadro bruto.
+ */
+void fb_mirror_print_stats(void);
+
+/** @} */ // Fim do grupo "Fb_Mirror"
+
+#endif // FB_MIRROR_H
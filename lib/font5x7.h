@@ -0,0 +1,46 @@
+#ifndef FONT5X7_H
+#define FONT5X7_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @file font5x7.h
+ * @brief Fonte de 5x7 pixels no formato do framebuffer do SSD1306.
+ *
+ * Cada glifo tem 5 colunas de um byte (bit 0 em cima), o formato de página do
+ * display, e é desenhado por `pixaddr_blit` sem conversão. Cobre os códigos
+ * ASCII de ' ' a 'Z'; as minúsculas usam as maiúsculas e os demais códigos,
+ * o glifo de '?'. Com uma coluna de espaço, cabem 21 caracteres por linha.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Font5x7 Fonte 5x7
+ * @brief Glifos para os textos do menu.
+ * @{
+ */
+
+/** @brief Colunas de um glifo. */
+#define FONT5X7_WIDTH 5
+
+/** @brief Avanço entre caracteres (glifo e uma coluna de espaço). */
+#define FONT5X7_ADVANCE 6
+
+/**
+ * @brief Colunas do glifo de um caractere.
+ *
+ * @param[in] c Caractere.
+ * @return FONT5X7_WIDTH bytes, um por coluna.
+ */
+const uint8_t *font5x7_glyph(char c);
+
+/** @} */ // Fim do grupo "Font5x7"
+
+#endif // FONT5X7_H
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <string.h>
+#include "heatmap.h"
+#include "ram_func.h"
+
+/**
+ * @file heatmap.c
+ * @brief Implementação do mapa de cobertura e de seu desenho por pontilhado ordenado.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Matriz de Bayer 4x4: um pixel acende quando o nível da célula é maior que o seu limiar. */
+static const uint8_t heatmap_bayer[HEATMAP_CELL_SIZE][HEATMAP_CELL_SIZE] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5},
+};
+
+void heatmap_init(heatmap_t *map)
+{
+    memset(map->counts, 0, sizeof(map->counts));
+    map->samples = 0;
+    map->reset_requested = false;
+}
+
+void RAM_FUNC(heatmap_add)(heatmap_t *map, uint16_t x, uint16_t y)
+{
+    if(map->reset_requested) heatmap_init(map);
+
+    // Linha 0 no alto da tela: o eixo Y cresce para cima, como o cursor
+    uint16_t *count = &map->counts[HEATMAP_ROWS - 1 - ((y >> HEATMAP_Y_SHIFT) & (HEATMAP_ROWS - 1))]
+                                  [(x >> HEATMAP_X_SHIFT) & (HEATMAP_COLS - 1)];
+    if(*count != UINT16_MAX) (*count)++;
+    map->samples++;
+}
+
+void heatmap_request_reset(heatmap_t *map)
+{
+    map->reset_requested = true;
+}
+
+void heatmap_view_invalidate(heatmap_view_t *view)
+{
+    memset(view->shown, HEATMAP_NO_LEVEL, sizeof(view->shown));
+}
+
+/**
+ * @brief Desenha o padrão de um nível em uma célula.
+ */
+static void RAM_FUNC(heatmap_draw_cell)(ssd1306_t *ssd, uint8_t col, uint8_t row, uint8_t level)
+{
+    uint8_t x0 = (uint8_t) (col * HEATMAP_CELL_SIZE);
+    uint8_t y0 = (uint8_t) (row * HEATMAP_CELL_SIZE);
+    for(uint8_t j = 0; j < HEATMAP_CELL_SIZE; j++)
+    {
+        for(uint8_t i = 0; i < HEATMAP_CELL_SIZE; i++)
+        {
+            ssd1306_pixel(ssd, x0 + i, y0 + j, heatmap_bayer[j][i] < level);
+        }
+    }
+}
+
+uint32_t RAM_FUNC(heatmap_draw)(const heatmap_t *map, heatmap_view_t *view, ssd1306_t *ssd)
+{
+    uint32_t drawn = 0;
+    for(uint8_t row = 0; row < HEATMAP_ROWS; row++)
+    {
+        for(uint8_t col = 0; col < HEATMAP_COLS; col++)
+        {
+            uint8_t level = heatmap_level(map->counts[row][col]);
+            if(level == view->shown[row][col]) continue;
+            heatmap_draw_cell(ssd, col, row, level);
+            view->shown[row][col] = level;
+            drawn++;
+        }
+    }
+    view->cells_drawn += drawn;
+    return drawn;
+}
+
+void heatmap_print(const heatmap_t *map)
+{
+    uint32_t levels[HEATMAP_LEVELS] = {0};
+    uint32_t reached = 0, saturated = 0;
+    for(uint row = 0; row < HEATMAP_ROWS; row++)
+    {
+        for(uint col = 0; col < HEATMAP_COLS; col++)
+        {
+            uint16_t count = map->counts[row][col];
+            levels[heatmap_level(count)]++;
+            if(count != 0) reached++;
+            if(count == UINT16_MAX) saturated++;
+        }
+    }
+
+    printf("heatmap: amostras=%lu celulas=%lu/%u (%lu%%) saturadas=%lu\n", (unsigned long) map->samples,
+           (unsigned long) reached, HEATMAP_ROWS * HEATMAP_COLS,
+           (unsigned long) (reached * 100u / (HEATMAP_ROWS * HEATMAP_COLS)), (unsigned long) saturated);
+    printf("heatmap: niveis");
+    for(uint level = 0; level < HEATMAP_LEVELS; level++)
+    {
+        printf(" %lu", (unsigned long) levels[level]);
+    }
+    printf("\n");
+}
@@ -0,0 +1,137 @@
+#ifndef HEATMAP_H
+#define HEATMAP_H
+
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+
+/**
+ * @file heatmap.h
+ * @brief Mapa de cobertura das posições do joystick e sua exibição no OLED.
+ *
+ * Cada amostra filtrada incrementa o contador da célula que contém a posição.
+ * A grade tem 32x16 células de 4x4 pixels do display: os índices saem dos bits
+ * mais altos dos eixos de 12 bits (x >> 7, y >> 8), sem divisão, e os
+ * contadores de 16 bits saturam em vez de voltar a zero. O custo por amostra é
+ * constante e a memória é fixa (1 KB).
+ *
+ * Na tela, cada célula recebe um dos 17 níveis do pontilhado ordenado 4x4
+ * (Bayer): o nível é a quantidade de bits do contador, de modo que a escala é
+ * logarítmica (1 amostra acende um pixel; 32768 ou mais acendem a célula
+ * inteira). Como as células estão alinhadas à matriz, o pontilhado é contínuo
+ * entre vizinhas. A cada quadro só são redesenhadas as células cujo nível
+ * mudou desde o quadro anterior.
+ *
+ * Os contadores são escritos pela interrupção de amostragem (núcleo 0) e lidos
+ * pelo núcleo 1; a leitura de um contador de 16 bits é atômica. O pedido de
+ * zerar é atendido pela própria interrupção.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Heatmap Mapa de cobertura
+ * @brief Histograma 2D das posições e pontilhado ordenado no display.
+ * @{
+ */
+
+/** @brief Grade do mapa: células de 4x4 pixels no display de 128x64. */
+#define HEATMAP_COLS 32
+#define HEATMAP_ROWS 16
+#define HEATMAP_CELL_SIZE 4
+
+/** @brief Deslocamentos que levam os eixos de 12 bits às colunas e às linhas. */
+#define HEATMAP_X_SHIFT 7
+#define HEATMAP_Y_SHIFT 8
+
+/** @brief Níveis de densidade do pontilhado 4x4 (0 a 16 pixels acesos). */
+#define HEATMAP_LEVELS 17
+
+/** @brief Nível inválido: força o redesenho da célula. */
+#define HEATMAP_NO_LEVEL 0xFF
+
+/**
+ * @brief Contadores do mapa (uma instância, escrita pela interrupção de amostragem).
+ */
+typedef struct
+{
+    uint16_t counts[HEATMAP_ROWS][HEATMAP_COLS]; /**< Amostras por célula (saturam em 65535). */
+    uint32_t samples;                            /**< Amostras acumuladas. */
+    volatile bool reset_requested;               /**< Pedido de zerar, atendido na próxima amostra. */
+} heatmap_t;
+
+/**
+ * @brief Níveis exibidos, mantidos por quem desenha (núcleo 1).
+ */
+typedef struct
+{
+    uint8_t shown[HEATMAP_ROWS][HEATMAP_COLS]; /**< Nível desenhado em cada célula. */
+    uint32_t cells_drawn;                      /**< Células redesenhadas desde o início. */
+} heatmap_view_t;
+
+/**
+ * @brief Zera os contadores.
+ *
+ * @param[out] map Mapa.
+ */
+void heatmap_init(heatmap_t *map);
+
+/**
+ * @brief Acumula uma amostra. Chamada pela interrupção de amostragem.
+ *
+ * @param[in,out] map Mapa.
+ * @param[in] x Eixo X (0-4095).
+ * @param[in] y Eixo Y (0-4095); valores maiores ficam no alto da tela, como o cursor.
+ */
+void heatmap_add(heatmap_t *map, uint16_t x, uint16_t y);
+
+/**
+ * @brief Pede que os contadores sejam zerados na próxima amostra.
+ *
+ * @param[in,out] map Mapa.
+ */
+void heatmap_request_reset(heatmap_t *map);
+
+/**
+ * @brief Converte um contador no nível de densidade (quantidade de bits, 0 a 16).
+ *
+ * @param[in] count Contador da célula.
+ * @return Nível entre 0 e HEATMAP_LEVELS - 1.
+ */
+static inline uint8_t heatmap_level(uint16_t count)
+{
+    return count == 0 ? 0 : (uint8_t) (32 - __builtin_clz(count));
+}
+
+/**
+ * @brief Marca todas as células como não desenhadas (após limpar a tela).
+ *
+ * @param[out] view Níveis exibidos.
+ */
+void heatmap_view_invalidate(heatmap_view_t *view);
+
+/**
+ * @brief Redesenha no framebuffer as células cujo nível mudou.
+ *
+ * @param[in] map Mapa.
+ * @param[in,out] view Níveis exibidos.
+ * @param[in,out] ssd Display.
+ * @return Quantidade de células redesenhadas (0: o quadro não mudou).
+ */
+uint32_t heatmap_draw(const heatmap_t *map, heatmap_view_t *view, ssd1306_t *ssd);
+
+/**
+ * @brief Imprime as amostras, as células alcançadas, as saturadas e a quantidade de células por nível.
+ *
+ * @param[in] map Mapa.
+ */
+void heatmap_print(const heatmap_t *map);
+
+/** @} */ // Fim do grupo "Heatmap"
+
+#endif // HEATMAP_H
@@ -0,0 +1,100 @@
+#include "hid_report.h"
+#include <string.h>
+
+/**
+ * @file hid_report.c
+ * @brief Implementação da geração dos relatórios HID a partir do joystick.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Valor máximo, em módulo, de um eixo do relatório. */
+#define HID_AXIS_MAX 127
+
+void hid_report_init(hid_report_state_t *state, uint16_t deadzone)
+{
+    state->remainder_x = 0;
+    state->remainder_y = 0;
+    state->deadzone = deadzone;
+}
+
+int8_t hid_report_map_axis(uint16_t raw, uint16_t deadzone)
+{
+    int32_t offset = (int32_t) raw - HID_ADC_CENTER;
+    int32_t magnitude = (offset < 0) ? -offset : offset;
+
+    if(deadzone >= HID_ADC_CENTER - 1 || magnitude <= deadzone) return 0;
+
+    // Reescala o trecho fora da zona morta para 1..127, sem salto na borda
+    int32_t value = ((magnitude - deadzone) * HID_AXIS_MAX) / (HID_ADC_CENTER - 1 - deadzone);
+    if(value > HID_AXIS_MAX) value = HID_AXIS_MAX;
+    return (int8_t) ((offset < 0) ? -value : value);
+}
+
+void hid_report_build_gamepad(const hid_report_state_t *state, const hid_report_input_t *input,
+                              hid_report_gamepad_t *report)
+{
+    memset(report, 0, sizeof(*report));
+    report->x = hid_report_map_axis(input->x, state->deadzone);
+    // No ADC o eixo Y cresce para cima; no HID, para baixo
+    report->y = (int8_t) -hid_report_map_axis(input->y, state->deadzone);
+    report->buttons = input->buttons;
+}
+
+/**
+ * @brief Converte um eixo em velocidade Q8 com curva quadrática.
+ *
+ * A curva dá precisão às deflexões pequenas e mantém a velocidade máxima
+ * próxima de HID_MOUSE_MAX_SPEED_Q8 nos extremos.
+ *
+ * @param axis Valor do eixo (-127 a 127).
+ * @return Deslocamento por relatório, em Q8.
+ */
+static int32_t hid_report_axis_speed(int8_t axis)
+{
+    int32_t value = axis;
+    int32_t magnitude = (value < 0) ? -value : value;
+    return (value * magnitude * HID_MOUSE_MAX_SPEED_Q8) / (HID_AXIS_MAX * HID_AXIS_MAX);
+}
+
+/**
+ * @brief Extrai a parte inteira de um acumulador Q8, mantendo a fração.
+ *
+ * @param remainder Acumulador Q8, atualizado com a fração restante.
+ * @return Deslocamento inteiro a ser enviado.
+ */
+static int8_t hid_report_take_integer(int32_t *remainder)
+{
+    int32_t integer = *remainder / 256;
+    if(integer > HID_AXIS_MAX) integer = HID_AXIS_MAX;
+    if(integer < -HID_AXIS_MAX) integer = -HID_AXIS_MAX;
+    *remainder -= integer * 256;
+    return (int8_t) integer;
+}
+
+void hid_report_build_mouse(hid_report_state_t *state, const hid_report_input_t *input,
+                            hid_report_mouse_t *report)
+{
+    memset(report, 0, sizeof(*report));
+
+    int8_t axis_x = hid_report_map_axis(input->x, state->deadzone);
+    int8_t axis_y = (int8_t) -hid_report_map_axis(input->y, state->deadzone);
+
+    // Sem deflexão a fração é descartada, para o ponteiro parar imediatamente
+    if(axis_x == 0) state->remainder_x = 0;
+    if(axis_y == 0) state->remainder_y = 0;
+
+    state->remainder_x += hid_report_axis_speed(axis_x);
+    state->remainder_y += hid_report_axis_speed(axis_y);
+    report->x = hid_report_take_integer(&state->remainder_x);
+    report->y = hid_report_take_integer(&state->remainder_y);
+
+    // Botão A = esquerdo, B = direito, joystick = meio
+    if(input->buttons & HID_BUTTON_A) report->buttons |= 0x01;
+    if(input->buttons & HID_BUTTON_B) report->buttons |= 0x02;
+    if(input->buttons & HID_BUTTON_JOYSTICK) report->buttons |= 0x04;
+}
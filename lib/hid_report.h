@@ -0,0 +1,156 @@
+#ifndef HID_REPORT_H
+#define HID_REPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file hid_report.h
+ * @brief Geração dos relatórios HID (gamepad e mouse relativo) a partir do joystick.
+ *
+ * Este módulo não depende da pilha USB nem do pico-sdk: ele apenas converte as
+ * leituras do ADC e o estado dos botões nos relatórios enviados ao host. Dessa
+ * forma o mapeamento dos eixos pode ser compilado e verificado fora da placa.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup HID_Report Relatórios HID
+ * @brief Mapeamento dos eixos e botões para relatórios de gamepad e mouse.
+ * @{
+ */
+
+/** @brief Identificador do relatório de gamepad no descritor HID. */
+#define HID_REPORT_ID_GAMEPAD 1
+
+/** @brief Identificador do relatório de mouse no descritor HID. */
+#define HID_REPORT_ID_MOUSE 2
+
+/** @brief Máscara do botão A nos relatórios. */
+#define HID_BUTTON_A        (1u << 0)
+
+/** @brief Máscara do botão B nos relatórios. */
+#define HID_BUTTON_B        (1u << 1)
+
+/** @brief Máscara do botão do joystick nos relatórios. */
+#define HID_BUTTON_JOYSTICK (1u << 2)
+
+/** @brief Centro nominal do ADC de 12 bits. */
+#define HID_ADC_CENTER 2048
+
+/**
+ * @brief Deslocamento máximo do mouse, em unidades Q8, por relatório.
+ *
+ * Com relatórios a cada 1 ms, a deflexão máxima move o ponteiro 1000 contagens/s.
+ */
+#define HID_MOUSE_MAX_SPEED_Q8 256
+
+/**
+ * @brief Modos de operação da interface HID.
+ */
+typedef enum
+{
+    HID_MODE_GAMEPAD = 0, /**< Eixos absolutos e três botões. */
+    HID_MODE_MOUSE        /**< Deslocamento relativo proporcional à deflexão. */
+} hid_mode_t;
+
+/**
+ * @brief Entrada usada para montar um relatório.
+ */
+typedef struct
+{
+    uint16_t x;       /**< Leitura do eixo X (0 - 4095). */
+    uint16_t y;       /**< Leitura do eixo Y (0 - 4095). */
+    uint8_t buttons;  /**< Botões pressionados (HID_BUTTON_*). */
+} hid_report_input_t;
+
+/**
+ * @brief Relatório de gamepad, no mesmo leiaute de `TUD_HID_REPORT_DESC_GAMEPAD`.
+ */
+typedef struct __attribute__((packed))
+{
+    int8_t x;          /**< Eixo X (-127 a 127). */
+    int8_t y;          /**< Eixo Y (-127 a 127, positivo para baixo). */
+    int8_t z;          /**< Não utilizado. */
+    int8_t rz;         /**< Não utilizado. */
+    int8_t rx;         /**< Não utilizado. */
+    int8_t ry;         /**< Não utilizado. */
+    uint8_t hat;       /**< Direcional, sempre centralizado. */
+    uint32_t buttons;  /**< Botões pressionados. */
+} hid_report_gamepad_t;
+
+/**
+ * @brief Relatório de mouse, no mesmo leiaute de `TUD_HID_REPORT_DESC_MOUSE`.
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t buttons; /**< Botões pressionados (esquerdo, direito, meio). */
+    int8_t x;        /**< Deslocamento horizontal. */
+    int8_t y;        /**< Deslocamento vertical (positivo para baixo). */
+    int8_t wheel;    /**< Rolagem vertical, não utilizada. */
+    int8_t pan;      /**< Rolagem horizontal, não utilizada. */
+} hid_report_mouse_t;
+
+/**
+ * @brief Estado mantido entre relatórios de mouse consecutivos.
+ *
+ * Guarda a fração de deslocamento ainda não enviada, para que deflexões
+ * pequenas produzam movimento mesmo a 1000 relatórios por segundo.
+ */
+typedef struct
+{
+    int32_t remainder_x; /**< Fração acumulada do eixo X, em Q8. */
+    int32_t remainder_y; /**< Fração acumulada do eixo Y, em Q8. */
+    uint16_t deadzone;   /**< Zona morta em torno do centro, em contagens do ADC. */
+} hid_report_state_t;
+
+/**
+ * @brief Inicializa o estado de geração de relatórios.
+ *
+ * @param[out] state Estado a ser inicializado.
+ * @param[in] deadzone Zona morta em torno do centro, em contagens do ADC.
+ */
+void hid_report_init(hid_report_state_t *state, uint16_t deadzone);
+
+/**
+ * @brief Converte uma leitura do ADC em um eixo com sinal de -127 a 127.
+ *
+ * Leituras dentro da zona morta resultam em 0; fora dela a escala é linear
+ * até os extremos, sem saltos na borda da zona morta.
+ *
+ * @param[in] raw Leitura do ADC (0 - 4095).
+ * @param[in] deadzone Zona morta em torno do centro.
+ * @return Valor do eixo.
+ */
+int8_t hid_report_map_axis(uint16_t raw, uint16_t deadzone);
+
+/**
+ * @brief Monta um relatório de gamepad.
+ *
+ * @param[in] state Estado de geração (zona morta).
+ * @param[in] input Leitura dos eixos e botões.
+ * @param[out] report Relatório preenchido.
+ */
+void hid_report_build_gamepad(const hid_report_state_t *state, const hid_report_input_t *input,
+                              hid_report_gamepad_t *report);
+
+/**
+ * @brief Monta um relatório de mouse relativo.
+ *
+ * @param[in,out] state Estado de geração, com as frações acumuladas.
+ * @param[in] input Leitura dos eixos e botões.
+ * @param[out] report Relatório preenchido.
+ */
+void hid_report_build_mouse(hid_report_state_t *state, const hid_report_input_t *input,
+                            hid_report_mouse_t *report);
+
+/** @} */ // Fim do grupo "HID_Report"
+
+#endif // HID_REPORT_H
@@ -0,0 +1,338 @@
+#include <stdio.h>
+#include <string.h>
+#include "i2c_bus.h"
+#include "i2c_trace.h"
+#include "ram_func.h"
+
+/**
+ * @file i2c_bus.c
+ * @brief Implementação do gerenciador do barramento I2C.
+ *
+ * A unidade de execução é um trecho (ou uma leitura completa, com START
+ * repetido). Quem conduz o barramento toma a posse (`busy`) junto com a
+ * escolha da próxima transação, sob o spin lock, executa a unidade sem o lock
+ * e devolve a posse: entre duas unidades, outro núcleo, `i2c_bus_acquire` ou
+ * uma transação mais urgente podem entrar. As estatísticas de cada
+ * dispositivo só são escritas por quem detém a posse.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Instâncias de I2C do RP2040. */
+#define I2C_BUS_INSTANCES 2
+
+static i2c_bus_t i2c_buses[I2C_BUS_INSTANCES];
+static bool i2c_bus_ready[I2C_BUS_INSTANCES];
+
+/**
+ * @brief Zera as estatísticas de todos os dispositivos (com a posse do barramento).
+ */
+static void i2c_bus_clear_stats(i2c_bus_t *bus)
+{
+    for(uint8_t i = 0; i < bus->device_count; i++)
+    {
+        i2c_bus_device_t *device = &bus->devices[i];
+        device->transactions = 0;
+        device->chunks = 0;
+        device->errors = 0;
+        device->deadline_misses = 0;
+        device->bytes = 0;
+        device->busy_us = 0;
+        latency_reset(&device->queue_delay);
+    }
+    bus->stats_start_us = time_us_32();
+}
+
+i2c_bus_t *i2c_bus_init(i2c_inst_t *i2c)
+{
+    uint index = i2c_hw_index(i2c);
+    if(i2c_bus_ready[index]) return &i2c_buses[index];
+
+    int lock_num = spin_lock_claim_unused(false);
+    if(lock_num < 0) return NULL;
+
+    i2c_bus_t *bus = &i2c_buses[index];
+    memset(bus, 0, sizeof(*bus));
+    bus->i2c = i2c;
+    bus->lock = spin_lock_instance((uint) lock_num);
+    bus->stats_start_us = time_us_32();
+    i2c_bus_ready[index] = true;
+    return bus;
+}
+
+i2c_bus_t *i2c_bus_get(i2c_inst_t *i2c)
+{
+    uint index = i2c_hw_index(i2c);
+    return i2c_bus_ready[index] ? &i2c_buses[index] : NULL;
+}
+
+i2c_bus_device_t *i2c_bus_add_device(i2c_bus_t *bus, const char *name, uint8_t address, uint8_t priority,
+                                     uint16_t chunk_bytes, uint32_t budget_us, bool traced)
+{
+    if(chunk_bytes == 1 || chunk_bytes > I2C_BUS_MAX_CHUNK) return NULL; // O trecho repete o primeiro byte
+
+    uint32_t irq = spin_lock_blocking(bus->lock);
+    if(bus->device_count >= I2C_BUS_MAX_DEVICES)
+    {
+        spin_unlock(bus->lock, irq);
+        return NULL;
+    }
+    i2c_bus_device_t *device = &bus->devices[bus->device_count];
+    memset(device, 0, sizeof(*device));
+    device->name = name;
+    device->address = address;
+    device->priority = priority;
+    device->chunk_bytes = chunk_bytes;
+    device->budget_us = budget_us;
+    device->traced = traced;
+    latency_reset(&device->queue_delay);
+    bus->device_count = bus->device_count + 1u;
+    spin_unlock(bus->lock, irq);
+    return device;
+}
+
+/**
+ * @brief Prepara a transação do dispositivo e a torna visível a quem conduz o barramento.
+ */
+static bool RAM_FUNC(i2c_bus_enqueue)(i2c_bus_t *bus, i2c_bus_device_t *device, const uint8_t *src, size_t len,
+                                      uint8_t *dst, size_t read_len, bool waited)
+{
+    if(device->pending || len == 0) return false;
+    device->src = src;
+    device->len = len;
+    device->dst = dst;
+    device->read_len = dst != NULL ? read_len : 0u;
+    device->offset = 0;
+    device->written = 0;
+    device->started = false;
+    device->waited = waited;
+    device->submit_us = time_us_32();
+    device->deadline_us = device->submit_us + device->budget_us;
+
+    uint32_t irq = spin_lock_blocking(bus->lock);
+    device->pending = true;
+    spin_unlock(bus->lock, irq);
+    return true;
+}
+
+bool RAM_FUNC(i2c_bus_submit)(i2c_bus_t *bus, i2c_bus_device_t *device, const uint8_t *src, size_t len,
+                              uint8_t *dst, size_t read_len)
+{
+    return i2c_bus_enqueue(bus, device, src, len, dst, read_len, false);
+}
+
+bool i2c_bus_poll_result(const i2c_bus_device_t *device, int *result)
+{
+    if(device->pending) return false;
+    if(result != NULL) *result = device->result;
+    return true;
+}
+
+/**
+ * @brief Ordem de execução: prioridade, prazo (os sem prazo por último) e ordem de submissão.
+ */
+static bool RAM_FUNC(i2c_bus_before)(const i2c_bus_device_t *a, const i2c_bus_device_t *b)
+{
+    if(a->priority != b->priority) return a->priority < b->priority;
+    bool a_deadline = a->budget_us != 0;
+    bool b_deadline = b->budget_us != 0;
+    if(a_deadline != b_deadline) return a_deadline;
+    if(a_deadline) return (int32_t) (a->deadline_us - b->deadline_us) < 0;
+    return (int32_t) (a->submit_us - b->submit_us) < 0;
+}
+
+/**
+ * @brief Toma a posse do barramento e escolhe a transação mais urgente.
+ *
+ * @param bus Barramento.
+ * @param async_only Só transações sem quem as espere (`i2c_bus_service`).
+ * @return O dispositivo a executar (com a posse tomada), ou `NULL`.
+ */
+static i2c_bus_device_t *RAM_FUNC(i2c_bus_take_next)(i2c_bus_t *bus, bool async_only)
+{
+    i2c_bus_device_t *next = NULL;
+    uint32_t irq = spin_lock_blocking(bus->lock);
+    if(!bus->busy)
+    {
+        for(uint8_t i = 0; i < bus->device_count; i++)
+        {
+            i2c_bus_device_t *device = &bus->devices[i];
+            if(!device->pending || (async_only && device->waited)) continue;
+            if(next == NULL || i2c_bus_before(device, next)) next = device;
+        }
+        if(next != NULL) bus->busy = true;
+    }
+    spin_unlock(bus->lock, irq);
+
+    if(next != NULL && bus->reset_requested)
+    {
+        i2c_bus_clear_stats(bus);
+        bus->reset_requested = false;
+    }
+    return next;
+}
+
+/**
+ * @brief Devolve a posse do barramento.
+ */
+static void RAM_FUNC(i2c_bus_give)(i2c_bus_t *bus)
+{
+    uint32_t irq = spin_lock_blocking(bus->lock);
+    bus->busy = false;
+    spin_unlock(bus->lock, irq);
+}
+
+/**
+ * @brief Executa uma unidade (trecho ou leitura) da transação do dispositivo, com a posse do barramento.
+ */
+static void RAM_FUNC(i2c_bus_run_unit)(i2c_bus_t *bus, i2c_bus_device_t *device)
+{
+    uint32_t start_us = time_us_32();
+    if(!device->started)
+    {
+        device->started = true;
+        latency_record(&device->queue_delay, start_us - device->submit_us);
+    }
+
+    int result;
+    uint32_t moved;
+    if(device->read_len > 0)
+    {
+        // Endereço do registrador e leitura com START repetido: uma unidade só
+        result = i2c_write_blocking(bus->i2c, device->address, device->src, device->len, true);
+        if(result >= 0) result = i2c_read_blocking(bus->i2c, device->address, device->dst, device->read_len, false);
+        moved = result >= 0 ? (uint32_t) (device->len + device->read_len) : 0u;
+        device->offset = device->len;
+    }
+    else
+    {
+        const uint8_t *chunk = device->src + device->offset;
+        size_t chunk_len = device->len - device->offset;
+        size_t consumed;
+        if(device->offset == 0)
+        {
+            if(device->chunk_bytes != 0 && chunk_len > device->chunk_bytes) chunk_len = device->chunk_bytes;
+            consumed = chunk_len;
+        }
+        else
+        {
+            // Trechos seguintes: o primeiro byte da transação (controle) antes da continuação
+            if(chunk_len > device->chunk_bytes - 1u) chunk_len = device->chunk_bytes - 1u;
+            bus->chunk_buffer[0] = device->src[0];
+            memcpy(&bus->chunk_buffer[1], chunk, chunk_len);
+            consumed = chunk_len;
+            chunk = bus->chunk_buffer;
+            chunk_len++;
+        }
+
+        if(device->traced)
+            result = i2c_trace_write_blocking(bus->i2c, device->address, chunk, chunk_len, false);
+        else
+            result = i2c_write_blocking(bus->i2c, device->address, chunk, chunk_len, false);
+        moved = result >= 0 ? (uint32_t) chunk_len : 0u;
+        device->offset += consumed;
+        if(result >= 0) device->written += (int) consumed;
+    }
+
+    uint32_t end_us = time_us_32();
+    device->chunks++;
+    device->bytes += moved;
+    device->busy_us += end_us - start_us;
+    if(result >= 0 && device->offset < device->len) return;
+
+    // Concluída (ou interrompida por NACK)
+    device->transactions++;
+    if(result < 0) device->errors++;
+    if(device->budget_us != 0 && (int32_t) (end_us - device->deadline_us) > 0) device->deadline_misses++;
+    device->result = result < 0 ? result : (device->read_len > 0 ? result : device->written);
+
+    uint32_t irq = spin_lock_blocking(bus->lock);
+    device->pending = false;
+    spin_unlock(bus->lock, irq);
+}
+
+int RAM_FUNC(i2c_bus_transfer)(i2c_bus_t *bus, i2c_bus_device_t *device, const uint8_t *src, size_t len,
+                               uint8_t *dst, size_t read_len)
+{
+    if(!i2c_bus_enqueue(bus, device, src, len, dst, read_len, true)) return PICO_ERROR_GENERIC;
+    while(device->pending)
+    {
+        i2c_bus_device_t *next = i2c_bus_take_next(bus, false);
+        if(next == NULL)
+        {
+            busy_wait_us(1); // Outro contexto está no meio de uma unidade (talvez da nossa transação)
+            continue;
+        }
+        i2c_bus_run_unit(bus, next);
+        i2c_bus_give(bus);
+    }
+    return device->result;
+}
+
+uint32_t i2c_bus_service(i2c_bus_t *bus)
+{
+    uint32_t completed = 0;
+    i2c_bus_device_t *next;
+    while((next = i2c_bus_take_next(bus, true)) != NULL)
+    {
+        i2c_bus_run_unit(bus, next);
+        if(!next->pending) completed++;
+        i2c_bus_give(bus);
+    }
+    return completed;
+}
+
+void i2c_bus_acquire(i2c_bus_t *bus)
+{
+    while(true)
+    {
+        uint32_t irq = spin_lock_blocking(bus->lock);
+        bool taken = !bus->busy;
+        bus->busy = true;
+        spin_unlock(bus->lock, irq);
+        if(taken) return;
+        busy_wait_us(1);
+    }
+}
+
+void i2c_bus_release(i2c_bus_t *bus)
+{
+    i2c_bus_give(bus);
+}
+
+void i2c_bus_reset_stats(i2c_bus_t *bus)
+{
+    bus->reset_requested = true;
+}
+
+void i2c_bus_print_stats(i2c_bus_t *bus)
+{
+    uint32_t elapsed_us = time_us_32() - bus->stats_start_us;
+    if(elapsed_us == 0) elapsed_us = 1;
+    uint64_t total_busy_us = 0;
+
+    printf("i2c_bus: dispositivos=%u janela=%lums\n", bus->device_count, (unsigned long) (elapsed_us / 1000u));
+    for(uint8_t i = 0; i < bus->device_count; i++)
+    {
+        const i2c_bus_device_t *device = &bus->devices[i];
+        latency_summary_t delay;
+        latency_get_summary(&device->queue_delay, &delay);
+        uint32_t permille = (uint32_t) (device->busy_us * 1000u / elapsed_us);
+        total_busy_us += device->busy_us;
+
+        printf("i2c_bus: %-8s 0x%02x prio=%u trecho=%u prazo=%luus trans=%lu trechos=%lu bytes=%llu erros=%lu\n",
+               device->name, device->address, device->priority, device->chunk_bytes,
+               (unsigned long) device->budget_us, (unsigned long) device->transactions,
+               (unsigned long) device->chunks, (unsigned long long) device->bytes, (unsigned long) device->errors);
+        printf("i2c_bus: %-8s uso=%lu.%lu%% fila media=%luus p99=%luus max=%luus prazos_perdidos=%lu\n",
+               device->name, (unsigned long) (permille / 10u), (unsigned long) (permille % 10u),
+               (unsigned long) delay.mean_us, (unsigned long) delay.p99_us, (unsigned long) delay.max_us,
+               (unsigned long) device->deadline_misses);
+    }
+    uint32_t permille = (uint32_t) (total_busy_us * 1000u / elapsed_us);
+    printf("i2c_bus: uso_total=%lu.%lu%%\n", (unsigned long) (permille / 10u), (unsigned long) (permille % 10u));
+}
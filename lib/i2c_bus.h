@@ -0,0 +1,210 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/sync.h"
+#include "latency.h"
+
+/**
+ * @file i2c_bus.h
+ * @brief Gerenciador de um barramento I2C compartilhado por vários dispositivos.
+ *
+ * Cada driver registra seu dispositivo (endereço, prioridade, prazo e tamanho
+ * máximo de trecho) e entrega transações ao gerenciador em vez de chamar
+ * `i2c_write_blocking`. Cada dispositivo tem uma transação pendente por vez.
+ *
+ * Não há uma tarefa dona do barramento: quem espera por uma transação
+ * (`i2c_bus_transfer`) conduz o barramento enquanto ele estiver livre, e entre
+ * duas unidades executa a transação pendente mais urgente de qualquer
+ * dispositivo: menor prioridade numérica e, na mesma prioridade, o prazo mais
+ * próximo (EDF). Uma escrita maior que o trecho do dispositivo é dividida em
+ * transações de até `chunk_bytes` bytes, repetindo o primeiro byte (o byte de
+ * controle do SSD1306, que segue gravando do ponto em que parou); assim, o
+ * quadro de 1 KB do display deixa de ocupar o barramento por ~23 ms seguidos e
+ * uma leitura curta de sensor espera no máximo um trecho.
+ *
+ * Transações submetidas de interrupções (`i2c_bus_submit`) são executadas
+ * entre os trechos de quem estiver conduzindo o barramento ou no próximo
+ * `i2c_bus_service` (no firmware, chamada pela tarefa de entrada do núcleo 0).
+ * A fila e a posse do barramento são protegidas por um spin lock, válido entre
+ * os núcleos.
+ *
+ * Por dispositivo são contados transações, trechos, bytes, tempo de
+ * barramento (utilização), atraso de fila (da submissão ao primeiro trecho) e
+ * prazos perdidos. Dispositivos marcados com `traced` passam por
+ * `i2c_trace_write_blocking` (o display, cujo registro é reproduzido pelo
+ * host/i2c_replay.c).
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup I2C_Bus Gerenciador do barramento I2C
+ * @brief Transações com prioridade e prazo, divididas em trechos, com estatísticas por dispositivo.
+ * @{
+ */
+
+/** @brief Dispositivos por barramento. */
+#define I2C_BUS_MAX_DEVICES 4
+
+/** @brief Maior trecho de uma escrita dividida, em bytes (incluindo o byte repetido). */
+#define I2C_BUS_MAX_CHUNK 256
+
+/** @brief Prioridades usuais (menor valor, mais urgente). */
+#define I2C_BUS_PRIORITY_SENSOR  0
+#define I2C_BUS_PRIORITY_DISPLAY 2
+
+/**
+ * @brief Dispositivo registrado e sua transação pendente.
+ */
+typedef struct
+{
+    const char *name;            /**< Nome nas estatísticas. */
+    uint8_t address;             /**< Endereço I2C (7 bits). */
+    uint8_t priority;            /**< Prioridade (0, mais urgente). */
+    bool traced;                 /**< Escritas registradas por i2c_trace. */
+    uint16_t chunk_bytes;        /**< Maior transação de escrita (0: sem divisão). */
+    uint32_t budget_us;          /**< Prazo relativo à submissão (0: sem prazo). */
+
+    volatile bool pending;       /**< Transação submetida e não concluída. */
+    bool started;                /**< Primeiro trecho já executado. */
+    bool waited;                 /**< Há quem espere e conduza a transação (`i2c_bus_transfer`). */
+    const uint8_t *src;          /**< Bytes a escrever. */
+    size_t len;                  /**< Quantidade de bytes a escrever. */
+    uint8_t *dst;                /**< Destino da leitura (ou `NULL`). */
+    size_t read_len;             /**< Bytes a ler após a escrita, com START repetido. */
+    size_t offset;               /**< Bytes de `src` já enviados. */
+    uint32_t submit_us;          /**< Instante da submissão. */
+    uint32_t deadline_us;        /**< Instante limite (`submit_us + budget_us`). */
+    int written;                 /**< Bytes escritos até aqui. */
+    volatile int result;         /**< Retorno da transação concluída (bytes ou erro). */
+
+    uint32_t transactions;       /**< Transações concluídas. */
+    uint32_t chunks;             /**< Transações no barramento (trechos). */
+    uint32_t errors;             /**< Transações sem ACK. */
+    uint32_t deadline_misses;    /**< Transações concluídas após o prazo. */
+    uint64_t bytes;              /**< Bytes escritos e lidos. */
+    uint64_t busy_us;            /**< Tempo ocupando o barramento. */
+    latency_stats_t queue_delay; /**< Da submissão ao início do primeiro trecho. */
+} i2c_bus_device_t;
+
+/**
+ * @brief Barramento gerenciado.
+ */
+typedef struct
+{
+    i2c_inst_t *i2c;                                /**< Instância do hardware. */
+    spin_lock_t *lock;                              /**< Protege a fila e `busy`. */
+    i2c_bus_device_t devices[I2C_BUS_MAX_DEVICES];  /**< Dispositivos registrados. */
+    volatile uint8_t device_count;                  /**< Dispositivos registrados. */
+    bool busy;                                      /**< Um contexto conduz o barramento. */
+    uint8_t chunk_buffer[I2C_BUS_MAX_CHUNK];        /**< Trecho com o primeiro byte repetido. */
+    uint32_t stats_start_us;                        /**< Início da janela das estatísticas. */
+    volatile bool reset_requested;                  /**< Pedido de zerar as estatísticas. */
+} i2c_bus_t;
+
+/**
+ * @brief Passa a gerenciar o barramento `i2c` (já inicializado por `i2c_init`).
+ *
+ * @param[in] i2c Instância do hardware.
+ * @return O gerenciador do barramento, ou `NULL` sem spin lock livre.
+ */
+i2c_bus_t *i2c_bus_init(i2c_inst_t *i2c);
+
+/**
+ * @brief Gerenciador do barramento `i2c`.
+ *
+ * @return O gerenciador, ou `NULL` se `i2c_bus_init` não foi chamada.
+ */
+i2c_bus_t *i2c_bus_get(i2c_inst_t *i2c);
+
+/**
+ * @brief Registra um dispositivo.
+ *
+ * @param[in,out] bus Barramento.
+ * @param[in] name Nome nas estatísticas (não copiado).
+ * @param[in] address Endereço I2C.
+ * @param[in] priority Prioridade (0, mais urgente).
+ * @param[in] chunk_bytes Maior transação de escrita; as maiores são divididas (0: sem divisão).
+ * @param[in] budget_us Prazo de cada transação, a partir da submissão (0: sem prazo).
+ * @param[in] traced Registrar as escritas por i2c_trace.
+ * @return O dispositivo, ou `NULL` se não há espaço ou o trecho excede I2C_BUS_MAX_CHUNK.
+ */
+i2c_bus_device_t *i2c_bus_add_device(i2c_bus_t *bus, const char *name, uint8_t address, uint8_t priority,
+                                     uint16_t chunk_bytes, uint32_t budget_us, bool traced);
+
+/**
+ * @brief Enfileira uma transação sem esperar (pode ser chamada de interrupções).
+ *
+ * Os buffers pertencem ao gerenciador até a conclusão (`i2c_bus_poll_result`).
+ *
+ * @param[in,out] bus Barramento.
+ * @param[in,out] device Dispositivo.
+ * @param[in] src Bytes a escrever (ao menos um: o endereço do registrador, em leituras).
+ * @param[in] len Quantidade de bytes a escrever.
+ * @param[out] dst Destino da leitura após a escrita (ou `NULL`).
+ * @param[in] read_len Bytes a ler.
+ * @return `false` se o dispositivo ainda tem uma transação pendente.
+ */
+bool i2c_bus_submit(i2c_bus_t *bus, i2c_bus_device_t *device, const uint8_t *src, size_t len, uint8_t *dst,
+                    size_t read_len);
+
+/**
+ * @brief Consulta a conclusão da última transação submetida pelo dispositivo.
+ *
+ * @param[in] device Dispositivo.
+ * @param[out] result Retorno da transação (bytes transferidos ou erro do SDK).
+ * @return `true` se não há transação pendente.
+ */
+bool i2c_bus_poll_result(const i2c_bus_device_t *device, int *result);
+
+/**
+ * @brief Executa uma transação e espera sua conclusão, conduzindo o barramento se ele estiver livre.
+ *
+ * Não pode ser chamada de interrupções.
+ *
+ * @return Bytes transferidos, ou o erro do SDK.
+ */
+int i2c_bus_transfer(i2c_bus_t *bus, i2c_bus_device_t *device, const uint8_t *src, size_t len, uint8_t *dst,
+                     size_t read_len);
+
+/**
+ * @brief Executa as transações submetidas sem espera, se o barramento estiver livre.
+ *
+ * @param[in,out] bus Barramento.
+ * @return Transações concluídas.
+ */
+uint32_t i2c_bus_service(i2c_bus_t *bus);
+
+/**
+ * @brief Toma o barramento para uso exclusivo (troca da taxa), esperando a unidade em andamento.
+ *
+ * Transações submetidas nesse intervalo esperam `i2c_bus_release`.
+ */
+void i2c_bus_acquire(i2c_bus_t *bus);
+
+/**
+ * @brief Devolve o barramento tomado por `i2c_bus_acquire`.
+ */
+void i2c_bus_release(i2c_bus_t *bus);
+
+/**
+ * @brief Pede que as estatísticas sejam zeradas (atendido por quem conduzir o barramento em seguida).
+ */
+void i2c_bus_reset_stats(i2c_bus_t *bus);
+
+/**
+ * @brief Imprime, por dispositivo, a utilização do barramento, o atraso de fila e os prazos perdidos.
+ */
+void i2c_bus_print_stats(i2c_bus_t *bus);
+
+/** @} */ // Fim do grupo "I2C_Bus"
+
+#endif // I2C_BUS_H
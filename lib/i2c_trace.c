@@ -0,0 +1,402 @@
+#include "i2c_trace.h"
+#include "ram_func.h"
+#include "event_trace.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file i2c_trace.c
+ * @brief Buffer circular de transações, classificação dos bytes e resumo por quadro.
+ *
+ * Cada registro ocupa um cabeçalho de 8 bytes (instante, endereço, flags e
+ * tamanho) seguido dos bytes da transação. Sem espaço, os registros mais
+ * antigos são descartados.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Bits do byte de controle do SSD1306. */
+#define I2C_TRACE_CONTROL_CO 0x80u
+#define I2C_TRACE_CONTROL_DC 0x40u
+
+/** @brief Comandos de endereçamento do SSD1306 (dois argumentos: início e fim). */
+#define I2C_TRACE_SET_COL_ADDR  0x21u
+#define I2C_TRACE_SET_PAGE_ADDR 0x22u
+
+/** @brief Bits de `i2c_trace_window_t.known`. */
+#define I2C_TRACE_WINDOW_COLS  0x01u
+#define I2C_TRACE_WINDOW_PAGES 0x02u
+
+/** @brief Flags do registro. */
+#define I2C_TRACE_FLAG_NOSTOP    0x01u
+#define I2C_TRACE_FLAG_TRUNCATED 0x02u
+
+/** @brief Tamanho do cabeçalho de um registro. */
+#define I2C_TRACE_HEADER_SIZE 8u
+
+/** @brief Máscara dos índices do buffer (tamanho potência de dois). */
+#define I2C_TRACE_MASK (I2C_TRACE_BUFFER_SIZE - 1u)
+
+#if (I2C_TRACE_BUFFER_SIZE & (I2C_TRACE_BUFFER_SIZE - 1)) != 0
+#error "I2C_TRACE_BUFFER_SIZE deve ser potência de dois"
+#endif
+
+/**
+ * @brief Resumo por quadro, lido pelo console por meio do contador de sequência.
+ */
+typedef struct
+{
+    i2c_trace_frame_t history[I2C_TRACE_FRAME_HISTORY]; /**< Últimos quadros, circular. */
+    i2c_trace_frame_t total;  /**< Acumulado dos quadros fechados. */
+    i2c_trace_frame_t worst;  /**< Quadro de maior custo no barramento. */
+    uint32_t frames;          /**< Quadros fechados. */
+    uint32_t records;         /**< Transações guardadas no buffer. */
+    uint32_t overwritten;     /**< Registros descartados por falta de espaço. */
+    uint32_t skipped;         /**< Transações não guardadas durante a impressão. */
+} i2c_trace_stats_t;
+
+static uint8_t trace_buffer[I2C_TRACE_BUFFER_SIZE];
+static uint32_t trace_head = 0;  // Posições crescentes; o índice no buffer é a posição & I2C_TRACE_MASK
+static uint32_t trace_tail = 0;
+
+static i2c_trace_frame_t trace_current;
+static i2c_trace_window_t trace_window;
+static i2c_trace_stats_t trace_stats;
+
+static volatile uint32_t trace_sequence = 0; // Ímpar enquanto o escritor altera o estado
+static volatile bool trace_frozen = false;
+static volatile bool trace_reset_requested = false;
+
+static uint trace_baudrate = 0;
+static i2c_trace_sink_t trace_sink = NULL;
+static void *trace_sink_ctx = NULL;
+
+void i2c_trace_set_baudrate(uint baudrate)
+{
+    trace_baudrate = baudrate;
+}
+
+uint i2c_trace_get_baudrate(void)
+{
+    return trace_baudrate;
+}
+
+void i2c_trace_set_sink(i2c_trace_sink_t sink, void *ctx)
+{
+    trace_sink = sink;
+    trace_sink_ctx = ctx;
+}
+
+uint32_t i2c_trace_bits_to_us(uint32_t bits, uint baudrate)
+{
+    if(baudrate == 0) return 0;
+    return (uint32_t) (((uint64_t) bits * 1000000u + baudrate - 1u) / baudrate);
+}
+
+/**
+ * @brief Argumentos de um comando do SSD1306, para não confundi-los com comandos.
+ */
+static uint8_t RAM_FUNC(trace_command_args)(uint8_t command)
+{
+    switch(command)
+    {
+        case 0x26: case 0x27: // Rolagem horizontal
+            return 6;
+        case 0x29: case 0x2A: // Rolagem vertical e horizontal
+            return 5;
+        case I2C_TRACE_SET_COL_ADDR: case I2C_TRACE_SET_PAGE_ADDR: case 0xA3:
+            return 2;
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Acompanha um byte de comando, atualizando a janela nos comandos de endereçamento.
+ */
+static void RAM_FUNC(trace_window_command)(i2c_trace_window_t *window, uint8_t byte)
+{
+    if(window->args_pending == 0)
+    {
+        window->command = byte;
+        window->args_pending = trace_command_args(byte);
+        return;
+    }
+
+    window->args_pending--;
+    if(window->command != I2C_TRACE_SET_COL_ADDR && window->command != I2C_TRACE_SET_PAGE_ADDR) return;
+    if(window->args_pending == 1)
+    {
+        window->arg = byte;
+        return;
+    }
+    // Mesmas máscaras do controlador: 128 colunas, 8 páginas
+    if(window->command == I2C_TRACE_SET_COL_ADDR)
+    {
+        window->col_start = window->arg & 0x7Fu;
+        window->col_end = byte & 0x7Fu;
+        window->known |= I2C_TRACE_WINDOW_COLS;
+    }
+    else
+    {
+        window->page_start = window->arg & 0x07u;
+        window->page_end = byte & 0x07u;
+        window->known |= I2C_TRACE_WINDOW_PAGES;
+    }
+    window->written = 0; // O ponteiro da GDDRAM volta ao início da janela
+}
+
+/**
+ * @brief Bytes da janela de endereçamento, ou 0 se ela é desconhecida.
+ */
+static uint32_t RAM_FUNC(trace_window_size)(const i2c_trace_window_t *window)
+{
+    if(window->known != (I2C_TRACE_WINDOW_COLS | I2C_TRACE_WINDOW_PAGES)) return 0;
+    if(window->col_end < window->col_start || window->page_end < window->page_start) return 0;
+    return (uint32_t) (window->col_end - window->col_start + 1u) * (window->page_end - window->page_start + 1u);
+}
+
+bool RAM_FUNC(i2c_trace_account)(i2c_trace_frame_t *frame, i2c_trace_window_t *window, const uint8_t *src, size_t len)
+{
+    bool end_of_frame = false;
+    size_t i = 0;
+
+    frame->transactions++;
+    frame->bus_bits += (uint32_t) (len + 1u) * 9u + 2u;
+
+    while(i < len)
+    {
+        uint8_t control = src[i++];
+        frame->control_bytes++;
+
+        // Co = 1: um único byte segue este controle; Co = 0: o restante da transação
+        size_t count = (control & I2C_TRACE_CONTROL_CO) ? (i < len ? 1u : 0u) : len - i;
+        if(control & I2C_TRACE_CONTROL_DC)
+        {
+            frame->data_bytes += (uint32_t) count;
+            uint32_t size = trace_window_size(window);
+            if(size == 0)
+            {
+                end_of_frame |= count > 0;
+            }
+            else
+            {
+                window->written += (uint32_t) count;
+                if(window->written >= size)
+                {
+                    window->written %= size; // O ponteiro dá a volta na janela
+                    end_of_frame = true;
+                }
+            }
+        }
+        else
+        {
+            frame->command_bytes += (uint32_t) count;
+            for(size_t j = 0; j < count; j++)
+                trace_window_command(window, src[i + j]);
+        }
+        i += count;
+    }
+    return end_of_frame;
+}
+
+/**
+ * @brief Copia bytes para o buffer a partir de `trace_head`, dando a volta no fim.
+ */
+static void RAM_FUNC(trace_put)(const void *src, uint32_t len)
+{
+    uint32_t index = trace_head & I2C_TRACE_MASK;
+    uint32_t first = I2C_TRACE_BUFFER_SIZE - index;
+    if(first > len) first = len;
+    memcpy(&trace_buffer[index], src, first);
+    memcpy(trace_buffer, (const uint8_t *) src + first, len - first);
+    trace_head += len;
+}
+
+/**
+ * @brief Copia bytes do buffer a partir de `pos`, dando a volta no fim.
+ */
+static void trace_get(uint32_t pos, void *dst, uint32_t len)
+{
+    uint32_t index = pos & I2C_TRACE_MASK;
+    uint32_t first = I2C_TRACE_BUFFER_SIZE - index;
+    if(first > len) first = len;
+    memcpy(dst, &trace_buffer[index], first);
+    memcpy((uint8_t *) dst + first, trace_buffer, len - first);
+}
+
+/**
+ * @brief Guarda uma transação, descartando os registros mais antigos se preciso.
+ */
+static void RAM_FUNC(trace_record)(uint32_t t_us, uint8_t addr, bool nostop, const uint8_t *src, size_t len)
+{
+    uint8_t flags = nostop ? I2C_TRACE_FLAG_NOSTOP : 0u;
+    uint32_t stored = (uint32_t) len;
+    if(stored > I2C_TRACE_BUFFER_SIZE - I2C_TRACE_HEADER_SIZE)
+    {
+        stored = I2C_TRACE_BUFFER_SIZE - I2C_TRACE_HEADER_SIZE;
+        flags |= I2C_TRACE_FLAG_TRUNCATED;
+    }
+
+    uint32_t needed = I2C_TRACE_HEADER_SIZE + stored;
+    while(I2C_TRACE_BUFFER_SIZE - (trace_head - trace_tail) < needed)
+    {
+        uint8_t header[I2C_TRACE_HEADER_SIZE];
+        trace_get(trace_tail, header, sizeof(header));
+        trace_tail += I2C_TRACE_HEADER_SIZE + (uint32_t) (header[6] | (header[7] << 8));
+        trace_stats.overwritten++;
+    }
+
+    uint8_t header[I2C_TRACE_HEADER_SIZE] = {
+        (uint8_t) t_us, (uint8_t) (t_us >> 8), (uint8_t) (t_us >> 16), (uint8_t) (t_us >> 24),
+        addr, flags, (uint8_t) stored, (uint8_t) (stored >> 8),
+    };
+    trace_put(header, sizeof(header));
+    trace_put(src, stored);
+    trace_stats.records++;
+}
+
+/**
+ * @brief Fecha o quadro corrente: histórico, acumulado e pior caso.
+ */
+static void RAM_FUNC(trace_close_frame)(void)
+{
+    i2c_trace_stats_t *s = &trace_stats;
+    s->history[s->frames % I2C_TRACE_FRAME_HISTORY] = trace_current;
+    s->frames++;
+
+    s->total.transactions += trace_current.transactions;
+    s->total.control_bytes += trace_current.control_bytes;
+    s->total.command_bytes += trace_current.command_bytes;
+    s->total.data_bytes += trace_current.data_bytes;
+    s->total.bus_bits += trace_current.bus_bits;
+    s->total.wire_us += trace_current.wire_us;
+    if(trace_current.bus_bits > s->worst.bus_bits) s->worst = trace_current;
+
+    memset(&trace_current, 0, sizeof(trace_current));
+}
+
+int RAM_FUNC(i2c_trace_write_blocking)(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    EVENT_TRACE_SCOPE(EVENT_TRACE_I2C, (uint16_t) len);
+    uint32_t start_us = time_us_32();
+    int result = i2c_write_blocking(i2c, addr, src, len, nostop);
+    uint32_t wire_us = time_us_32() - start_us;
+
+    trace_sequence = trace_sequence + 1u;
+    __sync_synchronize();
+
+    if(trace_reset_requested && !trace_frozen)
+    {
+        trace_head = trace_tail = 0;
+        memset(&trace_current, 0, sizeof(trace_current));
+        memset(&trace_stats, 0, sizeof(trace_stats));
+        trace_window.written = 0; // A janela continua valendo: só o quadro parcial é descartado
+        trace_reset_requested = false;
+    }
+
+    trace_current.wire_us += wire_us;
+    bool end_of_frame = i2c_trace_account(&trace_current, &trace_window, src, len);
+    if(!trace_frozen)
+        trace_record(start_us, addr, nostop, src, len);
+    else
+        trace_stats.skipped++;
+    if(end_of_frame) trace_close_frame();
+
+    __sync_synchronize();
+    trace_sequence = trace_sequence + 1u;
+
+    if(trace_sink != NULL) trace_sink(trace_sink_ctx, start_us, addr, nostop, src, len);
+    return result;
+}
+
+/**
+ * @brief Copia o resumo de forma consistente com o escritor do outro núcleo.
+ */
+static void trace_read_stats(i2c_trace_stats_t *out)
+{
+    uint32_t sequence;
+    do
+    {
+        sequence = trace_sequence;
+        __sync_synchronize();
+        memcpy(out, &trace_stats, sizeof(*out));
+        __sync_synchronize();
+    } while((sequence & 1u) || sequence != trace_sequence);
+}
+
+/**
+ * @brief Imprime uma linha do resumo.
+ */
+static void trace_print_frame(const char *label, const i2c_trace_frame_t *f, uint32_t divisor)
+{
+    if(divisor == 0) divisor = 1;
+    uint32_t bus_us = i2c_trace_bits_to_us(f->bus_bits, trace_baudrate) / divisor;
+    printf("%-6s %6lu %7lu %7lu %7lu %8lu %8lu\n", label,
+           (unsigned long) (f->transactions / divisor), (unsigned long) (f->control_bytes / divisor),
+           (unsigned long) (f->command_bytes / divisor), (unsigned long) (f->data_bytes / divisor),
+           (unsigned long) bus_us, (unsigned long) (f->wire_us / divisor));
+}
+
+void i2c_trace_print_summary(void)
+{
+    static i2c_trace_stats_t s; // Fora da pilha do console
+    trace_read_stats(&s);
+
+    printf("i2c: baud=%u quadros=%lu registros=%lu descartados=%lu nao_gravados=%lu\n", trace_baudrate,
+           (unsigned long) s.frames, (unsigned long) s.records, (unsigned long) s.overwritten,
+           (unsigned long) s.skipped);
+    printf("quadro  trans controle comando   dados  barr_us  medido_us\n");
+
+    uint32_t shown = s.frames < I2C_TRACE_FRAME_HISTORY ? s.frames : I2C_TRACE_FRAME_HISTORY;
+    for(uint32_t i = s.frames - shown; i < s.frames; i++)
+    {
+        char label[12];
+        snprintf(label, sizeof(label), "%lu", (unsigned long) i);
+        trace_print_frame(label, &s.history[i % I2C_TRACE_FRAME_HISTORY], 1);
+    }
+    if(s.frames == 0) return;
+    trace_print_frame("media", &s.total, s.frames);
+    trace_print_frame("pior", &s.worst, 1);
+}
+
+void i2c_trace_dump(void)
+{
+    trace_frozen = true;
+    __sync_synchronize();
+    while(trace_sequence & 1u)
+        tight_loop_contents(); // Espera o fim de uma escrita em andamento
+
+    printf("# i2c_trace baud=%u\n", trace_baudrate);
+    for(uint32_t pos = trace_tail; pos != trace_head;)
+    {
+        uint8_t header[I2C_TRACE_HEADER_SIZE];
+        trace_get(pos, header, sizeof(header));
+        uint32_t t_us = header[0] | (header[1] << 8) | (header[2] << 16) | ((uint32_t) header[3] << 24);
+        uint32_t len = header[6] | (header[7] << 8);
+        pos += I2C_TRACE_HEADER_SIZE;
+
+        printf("%lu %02x %c%s ", (unsigned long) t_us, header[4], (header[5] & I2C_TRACE_FLAG_NOSTOP) ? 'N' : 'S',
+               (header[5] & I2C_TRACE_FLAG_TRUNCATED) ? "+" : "");
+        for(uint32_t i = 0; i < len; i++)
+            printf("%02x", trace_buffer[(pos + i) & I2C_TRACE_MASK]);
+        putchar('\n');
+        pos += len;
+    }
+    printf("# fim\n");
+
+    __sync_synchronize();
+    trace_frozen = false;
+}
+
+void i2c_trace_reset(void)
+{
+    // Aplicado pelo escritor na próxima transação
+    trace_reset_requested = true;
+}
@@ -0,0 +1,161 @@
+#ifndef I2C_TRACE_H
+#define I2C_TRACE_H
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+/**
+ * @file i2c_trace.h
+ * @brief Registro das transações I2C do display e contabilidade do barramento por quadro.
+ *
+ * `i2c_trace_write_blocking` substitui `i2c_write_blocking` no driver SSD1306:
+ * executa a escrita, contabiliza a transação e guarda-a (instante, endereço e
+ * bytes) em um buffer circular. Cada transação é classificada pelos bytes de
+ * controle do SSD1306 (Co, D/C) em bytes de controle, de comando e de dados, e
+ * seu custo no barramento é estimado na taxa configurada: 9 bits por byte
+ * (8 + ACK), incluindo o de endereço, mais START e STOP.
+ *
+ * Os comandos de endereçamento (SET_COL_ADDR e SET_PAGE_ADDR) definem a janela
+ * da GDDRAM; um quadro termina na transação de dados que completa a janela, e
+ * os comandos que a precedem contam no mesmo quadro. Assim, um envio dividido
+ * em trechos pelo gerenciador do barramento (i2c_bus.h) continua sendo um
+ * quadro. Sem janela conhecida (registro iniciado no meio da sessão), cada
+ * transação de dados fecha um quadro.
+ *
+ * O registro é impresso em texto, formato também gravado pelo build nativo e
+ * lido pelo reprodutor (host/i2c_replay.c):
+ *
+ *     # i2c_trace baud=<taxa>
+ *     <t_us> <endereço hex> <S|N> <bytes hex>
+ *
+ * `S` indica STOP ao fim da transação; `N`, `nostop`. Uma transação maior que
+ * o buffer é registrada só com os primeiros bytes e marcada com `+` após a
+ * flag; o reprodutor a ignora.
+ *
+ * O escritor (núcleo 1, pelo pipeline do display) e os leitores (console, no
+ * núcleo 0) se coordenam por um contador de sequência.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup I2C_Trace Registro de transações I2C
+ * @brief Buffer circular de transações e custo de barramento por quadro.
+ * @{
+ */
+
+/** @brief Tamanho do buffer circular, em bytes (cabeçalhos e conteúdo das transações). */
+#define I2C_TRACE_BUFFER_SIZE 8192
+
+/** @brief Quadros mantidos no histórico do resumo. */
+#define I2C_TRACE_FRAME_HISTORY 16
+
+/**
+ * @brief Custo de um quadro (ou de um acumulado de quadros) no barramento.
+ */
+typedef struct
+{
+    uint32_t transactions;  /**< Transações (pares START/STOP). */
+    uint32_t control_bytes; /**< Bytes de controle do SSD1306. */
+    uint32_t command_bytes; /**< Bytes de comando. */
+    uint32_t data_bytes;    /**< Bytes gravados na GDDRAM. */
+    uint32_t bus_bits;      /**< Bits no barramento, com endereço, ACK, START e STOP. */
+    uint32_t wire_us;       /**< Tempo medido dentro de `i2c_write_blocking`. */
+} i2c_trace_frame_t;
+
+/**
+ * @brief Janela de endereçamento do SSD1306, acompanhada ao longo das transações.
+ *
+ * Zerada, a janela é desconhecida.
+ */
+typedef struct
+{
+    uint8_t command;      /**< Comando cujos argumentos estão chegando. */
+    uint8_t args_pending; /**< Argumentos que faltam para `command`. */
+    uint8_t arg;          /**< Primeiro argumento do comando de endereçamento. */
+    uint8_t col_start;    /**< Primeira coluna da janela. */
+    uint8_t col_end;      /**< Última coluna da janela. */
+    uint8_t page_start;   /**< Primeira página da janela. */
+    uint8_t page_end;     /**< Última página da janela. */
+    uint8_t known;        /**< Bits 0 (colunas) e 1 (páginas): faixas recebidas. */
+    uint32_t written;     /**< Bytes de dados gravados na janela atual. */
+} i2c_trace_window_t;
+
+/**
+ * @brief Recebe cada transação registrada (usado pelo build nativo para gravar em arquivo).
+ */
+typedef void (*i2c_trace_sink_t)(void *ctx, uint32_t t_us, uint8_t addr, bool nostop,
+                                 const uint8_t *src, size_t len);
+
+/**
+ * @brief Informa a taxa do barramento usada na estimativa de tempo.
+ *
+ * @param[in] baudrate Taxa efetiva, em Hz (retorno de `i2c_init`).
+ */
+void i2c_trace_set_baudrate(uint baudrate);
+
+/**
+ * @brief Taxa do barramento configurada.
+ */
+uint i2c_trace_get_baudrate(void);
+
+/**
+ * @brief Escreve no barramento, como `i2c_write_blocking`, registrando a transação.
+ *
+ * @return O retorno de `i2c_write_blocking`.
+ */
+int i2c_trace_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+/**
+ * @brief Define o destino adicional das transações (ou `NULL`).
+ *
+ * @param[in] sink Callback chamado após cada transação.
+ * @param[in] ctx Contexto do callback.
+ */
+void i2c_trace_set_sink(i2c_trace_sink_t sink, void *ctx);
+
+/**
+ * @brief Contabiliza uma transação, sem executá-la nem registrá-la.
+ *
+ * @param[in,out] frame Acumulador.
+ * @param[in,out] window Janela de endereçamento (mantida entre quadros).
+ * @param[in] src Bytes da transação (sem o endereço).
+ * @param[in] len Quantidade de bytes.
+ * @return `true` se a transação completou a janela, ou gravou dados com a janela desconhecida (fim de quadro).
+ */
+bool i2c_trace_account(i2c_trace_frame_t *frame, i2c_trace_window_t *window, const uint8_t *src, size_t len);
+
+/**
+ * @brief Converte bits de barramento em microssegundos na taxa dada.
+ */
+uint32_t i2c_trace_bits_to_us(uint32_t bits, uint baudrate);
+
+/**
+ * @brief Imprime os últimos quadros, a média e o máximo do custo no barramento.
+ */
+void i2c_trace_print_summary(void);
+
+/**
+ * @brief Imprime o conteúdo do buffer circular no formato de texto do registro.
+ *
+ * O registro é suspenso durante a impressão; as transações desse intervalo
+ * são contabilizadas, mas não guardadas.
+ */
+void i2c_trace_dump(void);
+
+/**
+ * @brief Esvazia o buffer e zera o histórico e os acumulados.
+ *
+ * O pedido é atendido pelo escritor, na próxima transação.
+ */
+void i2c_trace_reset(void);
+
+/** @} */ // Fim do grupo "I2C_Trace"
+
+#endif // I2C_TRACE_H
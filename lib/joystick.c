@@ -1,6 +1,10 @@
 #include "joystick.h"
 #include "push_button.h"
 #include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "profile.h"
+#include "ram_func.h"
 
 /**
  * @file joystick.c
@@ -26,6 +30,22 @@
  * @{
  */
 
+/** @brief Posições do anel: X e Y alternados, na ordem do rodízio do ADC. */
+#define JOYSTICK_CAPTURE_SIZE (2u * JOYSTICK_CAPTURE_PAIRS)
+
+/** @brief Anel da captura, escrito pelo DMA. */
+static volatile uint16_t joystick_ring[JOYSTICK_CAPTURE_SIZE];
+
+/** @brief Início do anel, lido pelo canal de controle a cada volta. */
+static volatile uint16_t *joystick_ring_start = joystick_ring;
+
+/** @brief Estado da captura (interrupção de amostragem); `joystick_data_chan` < 0 sem captura. */
+static int joystick_data_chan = -1;
+static int joystick_ctrl_chan = -1;
+static uint32_t joystick_read_index = 0; // Próxima posição a ler (sempre um X)
+static uint32_t joystick_next_us = 0;    // Instante da conversão da próxima amostra
+static uint32_t joystick_period_us = 0;
+
 /**
  * @brief Converte um número de GPIO para o número do canal ADC correspondente.
  *
@@ -78,10 +98,27 @@ void joystick_init_all(joystick_t *joy, uint8_t joy_vrx, uint8_t joy_vry, uint8_
     joy->deadzone = (uint8_t) (120);
 }
 
-static uint16_t joystick_read_filtered(uint8_t channel, uint8_t deadzone)
+/**
+ * @brief Lê o valor bruto de um canal do ADC.
+ *
+ * @param channel Canal ADC a ser lido.
+ * @return Leitura de 12 bits, sem filtragem.
+ */
+static uint16_t RAM_FUNC(joystick_read_raw)(uint8_t channel)
 {
     adc_select_input(channel);
-    uint16_t raw_value = adc_read(); // Leitura do ADC
+    return adc_read(); // Leitura do ADC
+}
+
+/**
+ * @brief Aplica a zona morta a uma leitura bruta.
+ *
+ * @param raw_value Leitura de 12 bits do ADC.
+ * @param deadzone Largura da zona morta em torno do centro.
+ * @return O centro, se a leitura estiver na zona morta; caso contrário, a própria leitura.
+ */
+static uint16_t RAM_FUNC(joystick_apply_deadzone)(uint16_t raw_value, uint8_t deadzone)
+{
     uint16_t center = 2048; // Centro do joystick em um ADC de 12 bits
     // Se estiver dentro da deadzone, retorna o centro para evitar ruído
     if (raw_value > (center - deadzone) && raw_value < (center + deadzone))
@@ -91,6 +128,11 @@ static uint16_t joystick_read_filtered(uint8_t channel, uint8_t deadzone)
     return raw_value;
 }
 
+static uint16_t RAM_FUNC(joystick_read_filtered)(uint8_t channel, uint8_t deadzone)
+{
+    return joystick_apply_deadzone(joystick_read_raw(channel), deadzone);
+}
+
 /**
  * @brief Obtém o valor do eixo X do joystick.
  *
@@ -103,7 +145,7 @@ static uint16_t joystick_read_filtered(uint8_t channel, uint8_t deadzone)
  * @param[in] joy Ponteiro para a estrutura do joystick.
  * @return Valor do ADC correspondente ao eixo X (exemplo: 0 - 4095 em ADC de 12 bits).
  */
-uint16_t joystick_get_x(const joystick_t *joy)
+uint16_t RAM_FUNC(joystick_get_x)(const joystick_t *joy)
 {
     return joystick_read_filtered(joy->channel_x, joy->deadzone);
 }
@@ -119,11 +161,138 @@ uint16_t joystick_get_x(const joystick_t *joy)
  * @param[in] joy Ponteiro para a estrutura do joystick.
  * @return Valor do ADC correspondente ao eixo Y (exemplo: 0 - 4095 em ADC de 12 bits).
  */
-uint16_t joystick_get_y(const joystick_t *joy)
+uint16_t RAM_FUNC(joystick_get_y)(const joystick_t *joy)
 {
     return joystick_read_filtered(joy->channel_y, joy->deadzone);
 }
 
+/**
+ * @brief Lê os dois eixos do joystick e marca a amostra com o instante da leitura.
+ *
+ * O carimbo de tempo é obtido imediatamente antes da conversão do ADC, de modo
+ * que a latência medida inclua também o tempo de leitura dos dois canais. Com a
+ * captura por DMA, a amostra é a próxima do anel e o carimbo fica na grade do
+ * período, contada do início da captura (o ADC e o temporizador vêm do mesmo cristal).
+ *
+ * @param[in] joy Ponteiro para a estrutura do joystick.
+ * @param[out] sample Amostra preenchida com os eixos X e Y e o carimbo de tempo.
+ */
+void RAM_FUNC(joystick_read_sample)(const joystick_t *joy, joystick_sample_t *sample)
+{
+    PROFILE_SCOPE(PROFILE_JOYSTICK_SAMPLE);
+    if(joystick_data_chan >= 0)
+    {
+        sample->timestamp_us = joystick_next_us;
+        sample->raw_x = joystick_ring[joystick_read_index];
+        sample->raw_y = joystick_ring[joystick_read_index + 1u];
+        joystick_read_index = (joystick_read_index + 2u) % JOYSTICK_CAPTURE_SIZE;
+        joystick_next_us += joystick_period_us;
+    }
+    else
+    {
+        sample->timestamp_us = time_us_32();
+        sample->raw_x = joystick_read_raw(joy->channel_x);
+        sample->raw_y = joystick_read_raw(joy->channel_y);
+    }
+    sample->x = joystick_apply_deadzone(sample->raw_x, joy->deadzone);
+    sample->y = joystick_apply_deadzone(sample->raw_y, joy->deadzone);
+}
+
+bool joystick_capture_start(const joystick_t *joy, uint32_t period_us)
+{
+    joystick_data_chan = dma_claim_unused_channel(false);
+    joystick_ctrl_chan = dma_claim_unused_channel(false);
+    if(joystick_data_chan < 0 || joystick_ctrl_chan < 0)
+    {
+        if(joystick_data_chan >= 0) dma_channel_unclaim(joystick_data_chan);
+        if(joystick_ctrl_chan >= 0) dma_channel_unclaim(joystick_ctrl_chan);
+        joystick_data_chan = -1;
+        return false;
+    }
+
+    // Controle: devolve o canal de dados ao início do anel; a contagem é recarregada a cada disparo
+    dma_channel_config config = dma_channel_get_default_config(joystick_ctrl_chan);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, false);
+    dma_channel_configure(joystick_ctrl_chan, &config, &dma_hw->ch[joystick_data_chan].al2_write_addr_trig,
+                          &joystick_ring_start, 1, false);
+
+    // Dados: cada conversão, do FIFO do ADC para o anel
+    config = dma_channel_get_default_config(joystick_data_chan);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_dreq(&config, DREQ_ADC);
+    channel_config_set_chain_to(&config, joystick_ctrl_chan);
+    dma_channel_configure(joystick_data_chan, &config, joystick_ring, &adc_hw->fifo, JOYSTICK_CAPTURE_SIZE, true);
+
+    // Uma conversão a cada meio período, em rodízio a partir do eixo X
+    adc_select_input(joy->channel_x);
+    adc_set_round_robin(1u << joy->channel_x | 1u << joy->channel_y);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv((float) (clock_get_hz(clk_adc) / 1000000u * period_us / 2u - 1u));
+    joystick_period_us = period_us;
+    joystick_read_index = 0;
+    joystick_next_us = time_us_32();
+    adc_run(true);
+    return true;
+}
+
+uint32_t RAM_FUNC(joystick_samples_pending)(void)
+{
+    if(joystick_data_chan < 0) return 1;
+
+    uint32_t write_index = (dma_hw->ch[joystick_data_chan].write_addr - (uint32_t) (uintptr_t) joystick_ring) / 2u
+                           % JOYSTICK_CAPTURE_SIZE;
+
+    // Sem leitura por mais de uma volta, o anel foi sobrescrito: recomeça pela posição atual do DMA
+    int32_t behind_us = (int32_t) (time_us_32() - joystick_next_us);
+    if(behind_us >= (int32_t) (JOYSTICK_CAPTURE_PAIRS * joystick_period_us))
+    {
+        joystick_read_index = write_index & ~1u;
+        joystick_next_us += (uint32_t) behind_us / joystick_period_us * joystick_period_us;
+        return 0;
+    }
+    return (write_index + JOYSTICK_CAPTURE_SIZE - joystick_read_index) % JOYSTICK_CAPTURE_SIZE / 2u;
+}
+
+/**
+ * @brief Publica uma nova amostra como a mais recente.
+ *
+ * O contador de sequência fica ímpar durante a cópia; as barreiras de memória
+ * garantem que os leitores observem o contador antes e depois dos dados.
+ *
+ * @param[in,out] latest Ponteiro para a amostra compartilhada.
+ * @param[in] sample Amostra a ser publicada.
+ */
+void RAM_FUNC(joystick_publish_sample)(joystick_latest_t *latest, const joystick_sample_t *sample)
+{
+    latest->sequence++;
+    __sync_synchronize();
+    latest->sample = *sample;
+    __sync_synchronize();
+    latest->sequence++;
+}
+
+/**
+ * @brief Obtém uma cópia consistente da amostra mais recente.
+ *
+ * @param[in] latest Ponteiro para a amostra compartilhada.
+ * @param[out] sample Cópia da amostra mais recente.
+ */
+void joystick_get_latest_sample(const joystick_latest_t *latest, joystick_sample_t *sample)
+{
+    uint32_t sequence;
+    do
+    {
+        sequence = latest->sequence;
+        __sync_synchronize();
+        *sample = latest->sample;
+        __sync_synchronize();
+    } while((sequence & 1u) || sequence != latest->sequence);
+}
+
 /**
  * @brief Verifica se o botão do joystick está pressionado.
  *
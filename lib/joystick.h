@@ -113,6 +113,34 @@ typedef struct
     uint8_t deadzone;        /**< Valor da zona morta para evitar ruídos no centro. */
 } joystick_t;
 
+/**
+ * @brief Amostra dos dois eixos do joystick marcada com o instante da leitura.
+ *
+ * O carimbo de tempo acompanha a amostra por todo o pipeline (normalização,
+ * rasterização e envio ao display), permitindo medir a latência até a imagem.
+ */
+typedef struct
+{
+    uint16_t x;            /**< Valor filtrado do eixo X (0 - 4095). */
+    uint16_t y;            /**< Valor filtrado do eixo Y (0 - 4095). */
+    uint16_t raw_x;        /**< Leitura bruta do eixo X, antes da zona morta. */
+    uint16_t raw_y;        /**< Leitura bruta do eixo Y, antes da zona morta. */
+    uint32_t timestamp_us; /**< Instante da leitura do ADC, em microssegundos desde o boot. */
+} joystick_sample_t;
+
+/**
+ * @brief Última amostra publicada, protegida por um contador de sequência.
+ *
+ * Um único produtor (a interrupção de amostragem) publica amostras e qualquer
+ * leitor de prioridade igual ou menor obtém uma cópia consistente sem bloqueio:
+ * se a leitura coincidir com uma escrita, o leitor simplesmente repete a cópia.
+ */
+typedef struct
+{
+    volatile uint32_t sequence;   /**< Ímpar durante a escrita, par quando estável. */
+    joystick_sample_t sample;     /**< Amostra mais recente. */
+} joystick_latest_t;
+
 /**
  * @brief Inicializa o joystick, configurando os pinos ADC e o botão de push.
  *
@@ -156,6 +184,70 @@ uint16_t joystick_get_x(const joystick_t *joy);
  */
 uint16_t joystick_get_y(const joystick_t *joy);
 
+/**
+ * @brief Lê os dois eixos do joystick e marca a amostra com o instante da leitura.
+ *
+ * @note O ADC deve estar corretamente inicializado antes da leitura.
+ *
+ * @param[in] joy Ponteiro para a estrutura do joystick.
+ * @param[out] sample Amostra preenchida com os eixos X e Y e o carimbo de tempo.
+ */
+void joystick_read_sample(const joystick_t *joy, joystick_sample_t *sample);
+
+/**
+ * @brief Amostras do anel de captura por DMA (meio segundo a 1 kHz).
+ *
+ * Cobre com folga o pior apagamento de um setor da flash, durante o qual o
+ * núcleo 0 fica pausado sem ler o anel.
+ */
+#define JOYSTICK_CAPTURE_PAIRS 512u
+
+/**
+ * @brief Liga a captura contínua dos dois eixos pelo ADC e por DMA.
+ *
+ * O ADC converte os dois canais em rodízio, um a cada meio período, e um canal
+ * de DMA copia o FIFO para um anel na RAM; um segundo canal devolve o primeiro
+ * ao início do anel a cada volta. A captura não depende da CPU: continua com o
+ * núcleo 0 pausado pelas operações na flash, e as amostras acumuladas são
+ * entregues depois, cada uma com o instante da sua conversão.
+ *
+ * Com a captura ligada, `joystick_read_sample` entrega a próxima amostra do
+ * anel, e só deve ser chamada por quem consulta `joystick_samples_pending`.
+ * Sem canais de DMA livres, a leitura continua direta pelo ADC.
+ *
+ * @param[in] joy Ponteiro para a estrutura do joystick.
+ * @param[in] period_us Período de amostragem.
+ * @return `true` se a captura foi ligada.
+ */
+bool joystick_capture_start(const joystick_t *joy, uint32_t period_us);
+
+/**
+ * @brief Quantidade de amostras prontas para `joystick_read_sample`.
+ *
+ * Sem a captura, sempre 1: a leitura é feita na hora.
+ *
+ * @return Amostras convertidas e ainda não lidas.
+ */
+uint32_t joystick_samples_pending(void);
+
+/**
+ * @brief Publica uma nova amostra como a mais recente.
+ *
+ * @note Deve ser chamada por um único produtor.
+ *
+ * @param[in,out] latest Ponteiro para a amostra compartilhada.
+ * @param[in] sample Amostra a ser publicada.
+ */
+void joystick_publish_sample(joystick_latest_t *latest, const joystick_sample_t *sample);
+
+/**
+ * @brief Obtém uma cópia consistente da amostra mais recente.
+ *
+ * @param[in] latest Ponteiro para a amostra compartilhada.
+ * @param[out] sample Cópia da amostra mais recente.
+ */
+void joystick_get_latest_sample(const joystick_latest_t *latest, joystick_sample_t *sample);
+
 /**
  * @brief Verifica se o botão do joystick está pressionado.
  *
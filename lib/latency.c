@@ -0,0 +1,101 @@
+#include "latency.h"
+#include "ram_func.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file latency.c
+ * @brief Implementação do acumulador de latências input-to-photon.
+ *
+ * O histograma é log-linear: valores abaixo de 8 us possuem uma faixa cada, e
+ * cada oitava acima disso é dividida em 8 sub-faixas de mesma largura.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @brief Converte uma latência no índice da faixa correspondente.
+ *
+ * @param value Latência em microssegundos.
+ * @return Índice da faixa no histograma.
+ */
+static uint32_t RAM_FUNC(latency_bucket_index)(uint32_t value)
+{
+    if(value < LATENCY_SUB_BUCKETS) return value;
+
+    uint32_t msb = 31u - (uint32_t) __builtin_clz(value);
+    if(msb > LATENCY_MAX_MSB) return LATENCY_BUCKETS - 1;
+
+    uint32_t sub = (value >> (msb - 3u)) & (LATENCY_SUB_BUCKETS - 1);
+    return (msb - 2u) * LATENCY_SUB_BUCKETS + sub;
+}
+
+/**
+ * @brief Retorna o maior valor representado por uma faixa do histograma.
+ *
+ * @param index Índice da faixa.
+ * @return Limite superior da faixa em microssegundos.
+ */
+static uint32_t latency_bucket_upper(uint32_t index)
+{
+    if(index < LATENCY_SUB_BUCKETS) return index;
+
+    uint32_t msb = index / LATENCY_SUB_BUCKETS + 2u;
+    uint32_t sub = index % LATENCY_SUB_BUCKETS;
+    uint32_t lower = (LATENCY_SUB_BUCKETS + sub) << (msb - 3u);
+    return lower + (1u << (msb - 3u)) - 1u;
+}
+
+void latency_reset(latency_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->min_us = UINT32_MAX;
+}
+
+void RAM_FUNC(latency_record)(latency_stats_t *stats, uint32_t latency_us)
+{
+    stats->count++;
+    stats->sum_us += latency_us;
+    if(latency_us < stats->min_us) stats->min_us = latency_us;
+    if(latency_us > stats->max_us) stats->max_us = latency_us;
+    stats->buckets[latency_bucket_index(latency_us)]++;
+}
+
+void latency_get_summary(const latency_stats_t *stats, latency_summary_t *summary)
+{
+    memset(summary, 0, sizeof(*summary));
+    if(stats->count == 0) return;
+
+    summary->count = stats->count;
+    summary->min_us = stats->min_us;
+    summary->max_us = stats->max_us;
+    summary->mean_us = (uint32_t) (stats->sum_us / stats->count);
+
+    // Menor faixa cuja contagem acumulada cobre 99% das medições
+    uint32_t target = stats->count - stats->count / 100u;
+    uint32_t accumulated = 0;
+    for(uint32_t i = 0; i < LATENCY_BUCKETS; i++)
+    {
+        accumulated += stats->buckets[i];
+        if(accumulated >= target)
+        {
+            uint32_t upper = latency_bucket_upper(i);
+            summary->p99_us = (upper < stats->max_us) ? upper : stats->max_us;
+            break;
+        }
+    }
+}
+
+void latency_print(const latency_stats_t *stats, const char *label)
+{
+    latency_summary_t summary;
+    latency_get_summary(stats, &summary);
+    printf("%s: n=%lu min=%luus mean=%luus p99=%luus max=%luus\n", label,
+           (unsigned long) summary.count, (unsigned long) summary.min_us,
+           (unsigned long) summary.mean_us, (unsigned long) summary.p99_us,
+           (unsigned long) summary.max_us);
+}
@@ -0,0 +1,108 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+
+/**
+ * @file latency.h
+ * @brief Medição da latência de entrada até a imagem (input-to-photon).
+ *
+ * Cada amostra do joystick carrega o instante em que o ADC foi lido. Quando o
+ * envio do quadro ao display termina, a diferença entre esse instante e o fim
+ * da transmissão I2C é acumulada em um histograma log-linear, do qual são
+ * extraídos mínimo, média, percentil 99 e máximo.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Latency Latência de Entrada
+ * @brief Acumulação e resumo estatístico de latências em microssegundos.
+ * @{
+ */
+
+/**
+ * @brief Quantidade de sub-faixas por oitava do histograma.
+ *
+ * Com 8 sub-faixas o erro de quantização de cada faixa é de no máximo 12,5%.
+ */
+#define LATENCY_SUB_BUCKETS 8
+
+/**
+ * @brief Maior bit significativo representado (2^24 us ~ 16 s).
+ *
+ * Latências acima desse limite são contabilizadas na última faixa.
+ */
+#define LATENCY_MAX_MSB 23
+
+/**
+ * @brief Número total de faixas do histograma.
+ */
+#define LATENCY_BUCKETS ((LATENCY_MAX_MSB - 1) * LATENCY_SUB_BUCKETS)
+
+/**
+ * @brief Acumulador de latências.
+ */
+typedef struct
+{
+    uint32_t count;                     /**< Quantidade de medições registradas. */
+    uint32_t min_us;                    /**< Menor latência observada. */
+    uint32_t max_us;                    /**< Maior latência observada. */
+    uint64_t sum_us;                    /**< Soma das latências, para a média. */
+    uint32_t buckets[LATENCY_BUCKETS];  /**< Histograma log-linear. */
+} latency_stats_t;
+
+/**
+ * @brief Resumo estatístico de um acumulador de latências.
+ */
+typedef struct
+{
+    uint32_t count;   /**< Quantidade de medições. */
+    uint32_t min_us;  /**< Latência mínima. */
+    uint32_t mean_us; /**< Latência média. */
+    uint32_t p99_us;  /**< Percentil 99 (limite superior da faixa). */
+    uint32_t max_us;  /**< Latência máxima. */
+} latency_summary_t;
+
+/**
+ * @brief Zera o acumulador de latências.
+ *
+ * @param[out] stats Ponteiro para o acumulador.
+ */
+void latency_reset(latency_stats_t *stats);
+
+/**
+ * @brief Registra uma medição de latência.
+ *
+ * O custo é constante: uma contagem de zeros à esquerda e alguns deslocamentos.
+ *
+ * @param[in,out] stats Ponteiro para o acumulador.
+ * @param[in] latency_us Latência medida em microssegundos.
+ */
+void latency_record(latency_stats_t *stats, uint32_t latency_us);
+
+/**
+ * @brief Calcula o resumo (mín/média/p99/máx) do acumulador.
+ *
+ * @param[in] stats Ponteiro para o acumulador.
+ * @param[out] summary Resumo calculado.
+ */
+void latency_get_summary(const latency_stats_t *stats, latency_summary_t *summary);
+
+/**
+ * @brief Imprime o resumo do acumulador na saída padrão (USB stdio).
+ *
+ * @param[in] stats Ponteiro para o acumulador.
+ * @param[in] label Rótulo impresso antes dos valores.
+ */
+void latency_print(const latency_stats_t *stats, const char *label);
+
+/** @} */ // Fim do grupo "Latency"
+
+#endif // LATENCY_H
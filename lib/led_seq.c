@@ -0,0 +1,104 @@
+#include "led_seq.h"
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+
+/**
+ * @file led_seq.c
+ * @brief Implementação do sequenciador de efeitos do LED por DMA.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Divisor inteiro do marcapasso: 125 MHz / 250 = 500 kHz de contagem. */
+#define LED_SEQ_PACER_CLKDIV 250u
+
+void led_seq_pacer_init(uint slice, uint32_t step_hz)
+{
+    pwm_config config = pwm_get_default_config();
+    uint32_t counts = clock_get_hz(clk_sys) / LED_SEQ_PACER_CLKDIV / step_hz;
+
+    if(counts > 0x10000u) counts = 0x10000u;
+    if(counts < 2u) counts = 2u;
+
+    pwm_config_set_clkdiv_int(&config, LED_SEQ_PACER_CLKDIV);
+    pwm_config_set_wrap(&config, (uint16_t) (counts - 1u));
+    pwm_init(slice, &config, true);
+}
+
+bool led_seq_init(led_seq_t *seq, uint slice, uint pacer_slice)
+{
+    seq->slice = slice;
+    seq->pacer_slice = pacer_slice;
+    seq->loop_words = NULL;
+
+    seq->data_chan = dma_claim_unused_channel(false);
+    seq->ctrl_chan = dma_claim_unused_channel(false);
+    if(seq->data_chan < 0 || seq->ctrl_chan < 0)
+    {
+        if(seq->data_chan >= 0) dma_channel_unclaim(seq->data_chan);
+        if(seq->ctrl_chan >= 0) dma_channel_unclaim(seq->ctrl_chan);
+        return false;
+    }
+
+    // Controle: uma palavra (início do laço) para o alias que reinicia o canal de dados.
+    // Como o endereço de leitura não avança, o mesmo disparo pode se repetir indefinidamente.
+    dma_channel_config config = dma_channel_get_default_config(seq->ctrl_chan);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, false);
+    dma_channel_configure(seq->ctrl_chan, &config, &dma_hw->ch[seq->data_chan].al3_read_addr_trig,
+                          &seq->loop_words, 1, false);
+    return true;
+}
+
+void led_seq_play(led_seq_t *seq, const led_wave_t *once, const led_wave_t *loop)
+{
+    led_seq_stop(seq);
+
+    bool has_loop = (loop != NULL) && (loop->length > 0);
+    if(once == NULL || once->length == 0) once = has_loop ? loop : NULL;
+    if(once == NULL) return;
+
+    seq->loop_words = has_loop ? loop->words : NULL;
+
+    // Dados: uma palavra por wrap do marcapasso, direto no registrador CC do slice
+    dma_channel_config config = dma_channel_get_default_config(seq->data_chan);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, pwm_get_dreq(seq->pacer_slice));
+    channel_config_set_chain_to(&config, has_loop ? seq->ctrl_chan : seq->data_chan);
+    dma_channel_configure(seq->data_chan, &config, &pwm_hw->slice[seq->slice].cc,
+                          once->words, once->length, true);
+
+    // Com o canal já em andamento, escrever a contagem altera apenas o valor de recarga,
+    // usado a cada reinício pelo canal de controle. O primeiro passo leva um período do
+    // marcapasso, então não há risco de a forma inicial terminar antes desta escrita.
+    if(has_loop) dma_channel_set_trans_count(seq->data_chan, loop->length, false);
+}
+
+void led_seq_set_loop(led_seq_t *seq, const led_wave_t *loop)
+{
+    seq->loop_words = loop->words;
+}
+
+void led_seq_stop(led_seq_t *seq)
+{
+    // Desfaz o encadeamento antes de abortar, para o controle não reiniciar os dados
+    dma_channel_config config = dma_get_channel_config(seq->data_chan);
+    channel_config_set_chain_to(&config, seq->data_chan);
+    dma_channel_set_config(seq->data_chan, &config, false);
+
+    dma_channel_abort(seq->ctrl_chan);
+    dma_channel_abort(seq->data_chan);
+}
+
+bool led_seq_is_busy(const led_seq_t *seq)
+{
+    return dma_channel_is_busy(seq->data_chan) || dma_channel_is_busy(seq->ctrl_chan);
+}
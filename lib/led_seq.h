@@ -0,0 +1,121 @@
+#ifndef LED_SEQ_H
+#define LED_SEQ_H
+
+#include "pico/stdlib.h"
+#include "led_wave.h"
+
+/**
+ * @file led_seq.h
+ * @brief Sequenciador de efeitos do LED por DMA, sem uso da CPU após o início.
+ *
+ * Um canal de DMA copia as palavras de uma forma de onda (led_wave.h) para o
+ * registrador CC de um slice de PWM, uma palavra por passo. O ritmo é dado pelo
+ * DREQ de fim de período (wrap) de um slice "marcapasso", configurado com um
+ * período longo (por exemplo, 100 Hz): usar o wrap do próprio slice do LED
+ * exigiria uma palavra a cada período do PWM (~61 kHz com wrap 2048).
+ *
+ * Uma reprodução é composta por uma forma de onda inicial, tocada uma vez, e
+ * por uma forma de onda de laço, repetida indefinidamente. Ao fim da inicial, o
+ * canal de dados dispara um canal de controle, que recarrega o endereço de
+ * leitura com o início do laço e reinicia o canal de dados; o processo se
+ * repete sem intervenção da CPU. Sem laço, o LED mantém o último nível.
+ *
+ * Enquanto um sequenciador está ativo, o slice pertence a ele: o restante do
+ * programa não deve escrever nos canais desse slice (ver `rgb_set_color_masked`).
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup LED_Seq Sequenciador do LED
+ * @brief Reprodução de formas de onda no PWM por DMA.
+ * @{
+ */
+
+/** @brief Slice usado como marcapasso (GPIO 14/15, usados pelo I2C, não dependem dele). */
+#define LED_SEQ_PACER_SLICE 7
+
+/** @brief Passos por segundo do marcapasso padrão. */
+#define LED_SEQ_STEP_HZ 100
+
+/**
+ * @brief Sequenciador de um slice de PWM.
+ */
+typedef struct
+{
+    uint slice;              /**< Slice cujos canais são atualizados. */
+    uint pacer_slice;        /**< Slice cujo wrap dá o ritmo dos passos. */
+    int data_chan;           /**< Canal de DMA que escreve no registrador CC. */
+    int ctrl_chan;           /**< Canal de DMA que reinicia o laço. */
+    const uint32_t *volatile loop_words; /**< Início do laço, lido pelo canal de controle. */
+} led_seq_t;
+
+/**
+ * @brief Configura um slice como marcapasso dos sequenciadores.
+ *
+ * O slice passa a contar continuamente; seus pinos não precisam estar na função PWM.
+ *
+ * @param slice Slice a ser usado.
+ * @param step_hz Passos por segundo (de 8 Hz a alguns kHz).
+ */
+void led_seq_pacer_init(uint slice, uint32_t step_hz);
+
+/**
+ * @brief Reserva os canais de DMA de um sequenciador.
+ *
+ * @param[out] seq Sequenciador.
+ * @param[in] slice Slice do LED controlado.
+ * @param[in] pacer_slice Slice marcapasso (já configurado com `led_seq_pacer_init`).
+ * @return `true` se os canais foram reservados, `false` se não há canais livres.
+ */
+bool led_seq_init(led_seq_t *seq, uint slice, uint pacer_slice);
+
+/**
+ * @brief Inicia uma reprodução, interrompendo a anterior.
+ *
+ * As formas de onda não são copiadas: devem permanecer válidas (e inalteradas)
+ * enquanto a reprodução estiver ativa.
+ *
+ * @param[in,out] seq Sequenciador.
+ * @param[in] once Forma de onda tocada uma vez (`NULL` ou vazia para começar pelo laço).
+ * @param[in] loop Forma de onda repetida ao final (`NULL` ou vazia para parar).
+ */
+void led_seq_play(led_seq_t *seq, const led_wave_t *once, const led_wave_t *loop);
+
+/**
+ * @brief Troca a forma de onda de laço de uma reprodução em andamento.
+ *
+ * A troca é uma única escrita do ponteiro lido pelo canal de controle: passa a
+ * valer no próximo reinício do laço, sem interromper o ciclo atual. A nova forma
+ * de onda deve ter o mesmo comprimento da atual (a contagem de recarga do DMA
+ * não é alterada), e a anterior só pode ser reescrita depois de um ciclo completo.
+ *
+ * @param[in,out] seq Sequenciador.
+ * @param[in] loop Nova forma de onda de laço.
+ */
+void led_seq_set_loop(led_seq_t *seq, const led_wave_t *loop);
+
+/**
+ * @brief Interrompe a reprodução; o LED mantém o último nível escrito.
+ *
+ * @param[in,out] seq Sequenciador.
+ */
+void led_seq_stop(led_seq_t *seq);
+
+/**
+ * @brief Informa se há reprodução em andamento.
+ *
+ * @param[in] seq Sequenciador.
+ * @return `true` enquanto o DMA estiver escrevendo no slice.
+ */
+bool led_seq_is_busy(const led_seq_t *seq);
+
+/** @} */ // Fim do grupo "LED_Seq"
+
+#endif // LED_SEQ_H
@@ -0,0 +1,171 @@
+#include "led_wave.h"
+#include <string.h>
+
+/**
+ * @file led_wave.c
+ * @brief Implementação da geração de formas de onda para o PWM.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Escala das frações usadas nas interpolações (Q16). */
+#define LED_WAVE_ONE (1u << 16)
+
+void led_wave_init(led_wave_t *wave, uint32_t *storage, uint32_t capacity, const uint16_t *gamma)
+{
+    wave->words = storage;
+    wave->capacity = capacity;
+    wave->length = 0;
+    wave->gamma = gamma;
+}
+
+void led_wave_clear(led_wave_t *wave)
+{
+    wave->length = 0;
+}
+
+uint32_t led_wave_word(const led_wave_t *wave, uint8_t level_a, uint8_t level_b)
+{
+    return (uint32_t) wave->gamma[level_a] | ((uint32_t) wave->gamma[level_b] << LED_WAVE_CHANNEL_B_SHIFT);
+}
+
+/**
+ * @brief Verifica se ainda cabem `steps` palavras.
+ *
+ * @param wave Forma de onda.
+ * @param steps Palavras a acrescentar.
+ * @return `true` se houver espaço.
+ */
+static bool led_wave_fits(const led_wave_t *wave, uint32_t steps)
+{
+    return steps <= wave->capacity - wave->length;
+}
+
+/**
+ * @brief Interpola entre dois níveis perceptuais.
+ *
+ * @param from Nível para t = 0.
+ * @param to Nível para t = LED_WAVE_ONE.
+ * @param t Fração em Q16.
+ * @return Nível interpolado, arredondado.
+ */
+static uint8_t led_wave_lerp(uint8_t from, uint8_t to, uint32_t t)
+{
+    int32_t delta = (int32_t) to - (int32_t) from;
+    int32_t value = (int32_t) from + (int32_t) (((int64_t) delta * t + LED_WAVE_ONE / 2) >> 16);
+    return (uint8_t) value;
+}
+
+/**
+ * @brief Curva smoothstep (3t² - 2t³) em Q16.
+ *
+ * @param t Fração em Q16 (0 a LED_WAVE_ONE).
+ * @return Fração suavizada em Q16.
+ */
+static uint32_t led_wave_smoothstep(uint32_t t)
+{
+    uint64_t t2 = ((uint64_t) t * t) >> 16;
+    uint64_t t3 = (t2 * t) >> 16;
+    return (uint32_t) (3u * t2 - 2u * t3);
+}
+
+bool led_wave_hold(led_wave_t *wave, uint8_t level_a, uint8_t level_b, uint32_t steps)
+{
+    if(!led_wave_fits(wave, steps)) return false;
+
+    uint32_t word = led_wave_word(wave, level_a, level_b);
+    for(uint32_t i = 0; i < steps; i++)
+    {
+        wave->words[wave->length++] = word;
+    }
+    return true;
+}
+
+bool led_wave_ramp(led_wave_t *wave, uint8_t from_a, uint8_t from_b, uint8_t to_a, uint8_t to_b,
+                   uint32_t steps)
+{
+    if(!led_wave_fits(wave, steps)) return false;
+    if(steps == 1) return led_wave_hold(wave, to_a, to_b, 1);
+
+    for(uint32_t i = 0; i < steps; i++)
+    {
+        uint32_t t = (uint32_t) (((uint64_t) i * LED_WAVE_ONE) / (steps - 1));
+        wave->words[wave->length++] = led_wave_word(wave, led_wave_lerp(from_a, to_a, t),
+                                                    led_wave_lerp(from_b, to_b, t));
+    }
+    return true;
+}
+
+bool led_wave_breathe(led_wave_t *wave, uint8_t peak_a, uint8_t peak_b, uint32_t steps)
+{
+    if(!led_wave_fits(wave, steps)) return false;
+
+    // Subida em [0, half) e descida em [half, steps), simétricas em torno do pico
+    uint32_t half = steps / 2;
+    for(uint32_t i = 0; i < steps; i++)
+    {
+        uint32_t t;
+        if(i < half) t = (uint32_t) (((uint64_t) i * LED_WAVE_ONE) / half);
+        else t = (uint32_t) (((uint64_t) (steps - i) * LED_WAVE_ONE) / (steps - half));
+
+        uint32_t s = led_wave_smoothstep(t);
+        wave->words[wave->length++] = led_wave_word(wave, led_wave_lerp(0, peak_a, s),
+                                                    led_wave_lerp(0, peak_b, s));
+    }
+    return true;
+}
+
+bool led_wave_blink(led_wave_t *wave, uint8_t level_a, uint8_t level_b, uint32_t on_steps, uint32_t off_steps)
+{
+    if(on_steps > wave->capacity || !led_wave_fits(wave, on_steps + off_steps)) return false;
+
+    led_wave_hold(wave, level_a, level_b, on_steps);
+    led_wave_hold(wave, 0, 0, off_steps);
+    return true;
+}
+
+bool led_wave_dither(led_wave_t *wave, uint32_t duty_a, uint32_t duty_b, uint8_t frac_bits)
+{
+    uint32_t periods = 1u << frac_bits;
+    if(!led_wave_fits(wave, periods)) return false;
+
+    uint32_t frac_mask = periods - 1u;
+    uint32_t base = (duty_a >> frac_bits) | ((duty_b >> frac_bits) << LED_WAVE_CHANNEL_B_SHIFT);
+
+    // Acumuladores começam em meia contagem: o erro fica centrado em torno do valor pedido
+    uint32_t acc_a = periods / 2u, acc_b = periods / 2u;
+    for(uint32_t i = 0; i < periods; i++)
+    {
+        uint32_t word = base;
+
+        acc_a += duty_a & frac_mask;
+        if(acc_a >= periods)
+        {
+            acc_a -= periods;
+            word += 1u;
+        }
+
+        acc_b += duty_b & frac_mask;
+        if(acc_b >= periods)
+        {
+            acc_b -= periods;
+            word += 1u << LED_WAVE_CHANNEL_B_SHIFT;
+        }
+
+        wave->words[wave->length++] = word;
+    }
+    return true;
+}
+
+bool led_wave_append(led_wave_t *wave, const led_wave_t *other)
+{
+    if(!led_wave_fits(wave, other->length)) return false;
+
+    memcpy(&wave->words[wave->length], other->words, other->length * sizeof(uint32_t));
+    wave->length += other->length;
+    return true;
+}
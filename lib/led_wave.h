@@ -0,0 +1,162 @@
+#ifndef LED_WAVE_H
+#define LED_WAVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file led_wave.h
+ * @brief Geração de formas de onda para os registradores de comparação do PWM.
+ *
+ * Uma forma de onda é uma sequência de palavras de 32 bits no formato do
+ * registrador CC de um slice: nível do canal A nos 16 bits baixos e do canal B
+ * nos 16 bits altos. Cada palavra é aplicada durante um passo do sequenciador
+ * (ver led_seq.h), que a copia para o slice por DMA.
+ *
+ * Os níveis são informados na escala perceptual (0 a 255) e convertidos pela
+ * tabela de correção do LED (`rgb_t::gamma`), de modo que rampas lineares
+ * resultam em variações de brilho aparentemente lineares. Segmentos são
+ * concatenados na mesma forma de onda; efeitos prontos podem ser encadeados
+ * com `led_wave_append`.
+ *
+ * Este módulo não depende do pico-sdk e pode ser compilado e verificado no host.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup LED_Wave Formas de onda do LED
+ * @brief Rampas, patamares e efeitos pré-calculados para o sequenciador.
+ * @{
+ */
+
+/** @brief Deslocamento do nível do canal B na palavra CC. */
+#define LED_WAVE_CHANNEL_B_SHIFT 16
+
+/**
+ * @brief Forma de onda em construção, sobre uma área estática.
+ */
+typedef struct
+{
+    uint32_t *words;        /**< Palavras CC, uma por passo. */
+    uint32_t capacity;      /**< Quantidade máxima de palavras. */
+    uint32_t length;        /**< Palavras já geradas. */
+    const uint16_t *gamma;  /**< Tabela de correção (256 entradas) do LED. */
+} led_wave_t;
+
+/**
+ * @brief Inicializa uma forma de onda vazia.
+ *
+ * @param[out] wave Forma de onda.
+ * @param[in] storage Área para as palavras (estática: é lida pelo DMA).
+ * @param[in] capacity Quantidade de palavras em `storage`.
+ * @param[in] gamma Tabela de correção perceptual (256 entradas).
+ */
+void led_wave_init(led_wave_t *wave, uint32_t *storage, uint32_t capacity, const uint16_t *gamma);
+
+/**
+ * @brief Descarta o conteúdo, mantendo a área e a tabela.
+ *
+ * @param[in,out] wave Forma de onda.
+ */
+void led_wave_clear(led_wave_t *wave);
+
+/**
+ * @brief Monta a palavra CC para um par de níveis perceptuais.
+ *
+ * @param[in] wave Forma de onda (tabela de correção).
+ * @param[in] level_a Nível perceptual do canal A.
+ * @param[in] level_b Nível perceptual do canal B.
+ * @return Palavra no formato do registrador CC.
+ */
+uint32_t led_wave_word(const led_wave_t *wave, uint8_t level_a, uint8_t level_b);
+
+/**
+ * @brief Acrescenta um patamar constante.
+ *
+ * @param[in,out] wave Forma de onda.
+ * @param[in] level_a Nível perceptual do canal A.
+ * @param[in] level_b Nível perceptual do canal B.
+ * @param[in] steps Duração, em passos do sequenciador.
+ * @return `true` se coube; `false` (sem alterar a forma de onda) caso contrário.
+ */
+bool led_wave_hold(led_wave_t *wave, uint8_t level_a, uint8_t level_b, uint32_t steps);
+
+/**
+ * @brief Acrescenta uma rampa linear, na escala perceptual, entre dois pares de níveis.
+ *
+ * O primeiro passo vale `from` e o último vale `to`.
+ *
+ * @param[in,out] wave Forma de onda.
+ * @param[in] from_a Nível inicial do canal A.
+ * @param[in] from_b Nível inicial do canal B.
+ * @param[in] to_a Nível final do canal A.
+ * @param[in] to_b Nível final do canal B.
+ * @param[in] steps Duração, em passos do sequenciador.
+ * @return `true` se coube; `false` (sem alterar a forma de onda) caso contrário.
+ */
+bool led_wave_ramp(led_wave_t *wave, uint8_t from_a, uint8_t from_b, uint8_t to_a, uint8_t to_b,
+                   uint32_t steps);
+
+/**
+ * @brief Acrescenta um ciclo de "respiração": sobe e desce suavemente a partir do apagado.
+ *
+ * Usa a curva smoothstep (3t² - 2t³) em cada metade, sem degraus de velocidade
+ * nos extremos; repetido em laço, o efeito é contínuo.
+ *
+ * @param[in,out] wave Forma de onda.
+ * @param[in] peak_a Nível máximo do canal A.
+ * @param[in] peak_b Nível máximo do canal B.
+ * @param[in] steps Duração do ciclo completo, em passos do sequenciador.
+ * @return `true` se coube; `false` (sem alterar a forma de onda) caso contrário.
+ */
+bool led_wave_breathe(led_wave_t *wave, uint8_t peak_a, uint8_t peak_b, uint32_t steps);
+
+/**
+ * @brief Acrescenta um ciclo de pisca: aceso por `on_steps`, apagado por `off_steps`.
+ *
+ * @param[in,out] wave Forma de onda.
+ * @param[in] level_a Nível aceso do canal A.
+ * @param[in] level_b Nível aceso do canal B.
+ * @param[in] on_steps Passos aceso.
+ * @param[in] off_steps Passos apagado.
+ * @return `true` se coube; `false` (sem alterar a forma de onda) caso contrário.
+ */
+bool led_wave_blink(led_wave_t *wave, uint8_t level_a, uint8_t level_b, uint32_t on_steps, uint32_t off_steps);
+
+/**
+ * @brief Acrescenta um padrão de dithering sigma-delta de `1 << frac_bits` períodos.
+ *
+ * Os ciclos ativos são informados em contagens do PWM com `frac_bits` bits
+ * fracionários. Cada palavra recebe a parte inteira ou a parte inteira + 1,
+ * escolhidas por um modulador sigma-delta de primeira ordem, de modo que a
+ * média do padrão é exatamente o valor pedido e os períodos "+1" ficam
+ * espalhados de forma uniforme (sem concentrar o erro em um trecho do padrão).
+ * Diferente dos demais geradores, os valores não passam pela tabela de correção.
+ *
+ * @param[in,out] wave Forma de onda.
+ * @param[in] duty_a Ciclo ativo do canal A, em ponto fixo.
+ * @param[in] duty_b Ciclo ativo do canal B, em ponto fixo.
+ * @param[in] frac_bits Bits fracionários (o padrão tem `1 << frac_bits` palavras).
+ * @return `true` se coube; `false` (sem alterar a forma de onda) caso contrário.
+ */
+bool led_wave_dither(led_wave_t *wave, uint32_t duty_a, uint32_t duty_b, uint8_t frac_bits);
+
+/**
+ * @brief Encadeia outra forma de onda ao final desta.
+ *
+ * @param[in,out] wave Forma de onda de destino.
+ * @param[in] other Forma de onda copiada.
+ * @return `true` se coube; `false` (sem alterar a forma de onda) caso contrário.
+ */
+bool led_wave_append(led_wave_t *wave, const led_wave_t *other);
+
+/** @} */ // Fim do grupo "LED_Wave"
+
+#endif // LED_WAVE_H
@@ -0,0 +1,317 @@
+#include <stdio.h>
+#include <string.h>
+#include "menu.h"
+#include "oledgfx.h"
+#include "font5x7.h"
+#include "ram_func.h"
+
+/**
+ * @file menu.c
+ * @brief Navegação do menu (núcleo 0) e desenho por linha e por área de valor (núcleo 1).
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Coluna do nome e largura da barra do controle deslizante. */
+#define MENU_LABEL_X 2
+#define MENU_BAR_WIDTH 20
+
+/** @brief Caracteres que cabem na área de valor, e o texto de um `int32_t` com o terminador. */
+#define MENU_VALUE_CHARS ((WIDTH - MENU_VALUE_X) / FONT5X7_ADVANCE)
+#define MENU_TEXT_SIZE 12
+
+void menu_init(menu_t *menu, menu_widget_t *root)
+{
+    menu->stack[0] = root;
+    menu->depth = 1;
+    menu->frames = 0;
+    menu->rows_drawn = 0;
+    menu->values_drawn = 0;
+    menu->bytes_flushed = 0;
+}
+
+/**
+ * @brief Muda o valor de um widget: o valor antes da revisão, para o núcleo 1 nunca ver a revisão nova com o valor antigo.
+ *
+ * @return `true` se o valor mudou.
+ */
+static bool menu_store(menu_widget_t *widget, int32_t value)
+{
+    if(value == widget->value) return false;
+    widget->value = value;
+    widget->revision = (uint16_t) (widget->revision + 1u);
+    return true;
+}
+
+void menu_set_value(menu_widget_t *widget, int32_t value)
+{
+    menu_store(widget, value);
+}
+
+/**
+ * @brief Muda o valor por uma tecla, limitado à faixa, e aplica a mudança.
+ */
+static void menu_change(menu_widget_t *widget, int32_t value)
+{
+    if(value < widget->min) value = widget->min;
+    if(value > widget->max) value = widget->max;
+    if(menu_store(widget, value) && widget->on_change != NULL) widget->on_change(widget);
+}
+
+/**
+ * @brief Move o foco da lista, rolando-a para mantê-lo visível.
+ */
+static void menu_focus(menu_widget_t *list, uint8_t focus)
+{
+    if(focus < list->scroll)
+        list->scroll = focus;
+    else if(focus >= list->scroll + MENU_ROWS)
+        list->scroll = (uint8_t) (focus - MENU_ROWS + 1);
+    list->focus = focus;
+}
+
+bool menu_handle_key(menu_t *menu, menu_key_t key)
+{
+    menu_widget_t *list = menu->stack[menu->depth - 1];
+    menu_widget_t *widget = list->child_count > 0 ? list->children[list->focus] : NULL;
+
+    switch(key)
+    {
+    case MENU_KEY_UP:
+        if(list->focus > 0) menu_focus(list, (uint8_t) (list->focus - 1));
+        return true;
+    case MENU_KEY_DOWN:
+        if(list->focus + 1 < list->child_count) menu_focus(list, (uint8_t) (list->focus + 1));
+        return true;
+    case MENU_KEY_LEFT:
+    case MENU_KEY_RIGHT:
+    case MENU_KEY_SELECT:
+        if(widget == NULL) break;
+        if(widget->kind == MENU_SLIDER && key != MENU_KEY_SELECT)
+        {
+            menu_change(widget, widget->value + (key == MENU_KEY_RIGHT ? widget->step : -widget->step));
+            return true;
+        }
+        if(widget->kind == MENU_TOGGLE)
+        {
+            menu_change(widget, key == MENU_KEY_SELECT ? !widget->value : key == MENU_KEY_RIGHT);
+            return true;
+        }
+        if(widget->kind == MENU_LIST && key != MENU_KEY_LEFT)
+        {
+            // A lista entra na pilha antes da profundidade: o núcleo 1 nunca lê uma posição vazia
+            if(menu->depth < MENU_MAX_DEPTH)
+            {
+                menu->stack[menu->depth] = widget;
+                menu->depth = (uint8_t) (menu->depth + 1u);
+            }
+            return true;
+        }
+        if(key != MENU_KEY_LEFT) return true;
+        break; // Esquerda sobre uma lista ou um rótulo: volta
+    default:
+        break;
+    }
+
+    if(key == MENU_KEY_LEFT || key == MENU_KEY_BACK)
+    {
+        if(menu->depth <= 1) return key == MENU_KEY_LEFT;
+        menu->depth = (uint8_t) (menu->depth - 1u);
+    }
+    return true;
+}
+
+menu_key_t menu_nav_poll(menu_nav_t *nav, uint16_t x, uint16_t y, uint32_t now_us)
+{
+    // O eixo de maior deflexão decide a tecla
+    int32_t dx = (int32_t) x - 2048;
+    int32_t dy = (int32_t) y - 2048;
+    int32_t ax = dx < 0 ? -dx : dx;
+    int32_t ay = dy < 0 ? -dy : dy;
+    menu_key_t key = MENU_KEY_NONE;
+    if(ay >= ax && ay > MENU_NAV_THRESHOLD)
+        key = dy > 0 ? MENU_KEY_UP : MENU_KEY_DOWN;
+    else if(ax > MENU_NAV_THRESHOLD)
+        key = dx > 0 ? MENU_KEY_RIGHT : MENU_KEY_LEFT;
+
+    if(key != nav->held)
+    {
+        nav->held = key;
+        nav->next_us = now_us + MENU_NAV_DELAY_US;
+        return key;
+    }
+    if(key != MENU_KEY_NONE && (int32_t) (now_us - nav->next_us) >= 0)
+    {
+        nav->next_us += MENU_NAV_REPEAT_US;
+        return key;
+    }
+    return MENU_KEY_NONE;
+}
+
+void menu_view_invalidate(menu_view_t *view)
+{
+    view->valid = false;
+}
+
+/**
+ * @brief Preenche (`on`) ou limpa uma página a partir da coluna `x0`, um byte por coluna.
+ */
+static void menu_fill_page(ssd1306_t *ssd, uint8_t x0, uint8_t page, bool on)
+{
+    for(uint8_t x = x0; x < WIDTH; x++)
+    {
+        ssd->ram_buffer[1 + x * ssd->pages + page] = on ? 0xFF : 0x00;
+    }
+}
+
+/**
+ * @brief Escreve um texto alinhado à direita da tela, mantendo só os últimos caracteres que cabem na área de valor.
+ */
+static void menu_text_right(ssd1306_t *ssd, uint8_t y, const char *text, bool value)
+{
+    size_t length = strlen(text);
+    if(length > MENU_VALUE_CHARS)
+    {
+        text += length - MENU_VALUE_CHARS;
+        length = MENU_VALUE_CHARS;
+    }
+    oledgfx_draw_text(ssd, (uint8_t) (WIDTH - length * FONT5X7_ADVANCE), y, text, value);
+}
+
+/**
+ * @brief Desenha o valor de um widget na área de valor da linha (já limpa).
+ *
+ * @param ink Cor do texto e da barra (apagada nas linhas em vídeo inverso).
+ */
+static void menu_draw_value(ssd1306_t *ssd, const menu_widget_t *widget, int32_t value, uint8_t y, bool ink)
+{
+    char text[MENU_TEXT_SIZE];
+    switch(widget->kind)
+    {
+    case MENU_TOGGLE:
+        menu_text_right(ssd, y, value ? "ON" : "OFF", ink);
+        break;
+    case MENU_SLIDER:
+    {
+        // Barra proporcional ao valor, seguida do número em até 3 algarismos
+        uint32_t span = (uint32_t) (widget->max - widget->min);
+        uint32_t filled = span == 0 ? 0 : (uint32_t) (value - widget->min) * (MENU_BAR_WIDTH - 2) / span;
+        ssd1306_rect(ssd, y + 1, MENU_VALUE_X, MENU_BAR_WIDTH, 5, ink, false);
+        if(filled > 0) ssd1306_rect(ssd, y + 2, MENU_VALUE_X + 1, (uint8_t) filled, 3, ink, true);
+        snprintf(text, sizeof(text), "%ld", (long) value);
+        menu_text_right(ssd, y, text, ink);
+        break;
+    }
+    case MENU_LABEL:
+        snprintf(text, sizeof(text), "%ld", (long) value);
+        menu_text_right(ssd, y, text, ink);
+        break;
+    default:
+        menu_text_right(ssd, y, ">", ink);
+        break;
+    }
+}
+
+/**
+ * @brief Acrescenta uma janela de uma página, unindo-a à anterior se for a página de baixo, com as mesmas colunas.
+ */
+static uint8_t menu_add_window(ssd1306_window_t *windows, uint8_t count, uint8_t x0, uint8_t page)
+{
+    if(count > 0)
+    {
+        ssd1306_window_t *last = &windows[count - 1];
+        if(last->x0 == x0 && last->page1 + 1 == page)
+        {
+            last->page1 = page;
+            return count;
+        }
+    }
+    windows[count].x0 = x0;
+    windows[count].x1 = WIDTH - 1;
+    windows[count].page0 = page;
+    windows[count].page1 = page;
+    return (uint8_t) (count + 1);
+}
+
+uint8_t RAM_FUNC(menu_draw)(menu_t *menu, menu_view_t *view, ssd1306_t *ssd, ssd1306_window_t *windows)
+{
+    uint8_t count = 0;
+    uint32_t rows = 0, values = 0;
+    const menu_widget_t *list = menu->stack[menu->depth - 1];
+    uint8_t focus = list->focus;
+    uint8_t scroll = list->scroll;
+
+    // Título: nome da lista e posição do foco, sublinhados
+    if(!view->valid || list != view->list || focus != view->focus)
+    {
+        char text[MENU_TEXT_SIZE];
+        bool full = !view->valid || list != view->list;
+        uint8_t x0 = full ? 0 : MENU_VALUE_X;
+        menu_fill_page(ssd, x0, 0, false);
+        if(full) oledgfx_draw_text(ssd, 0, 0, list->label, true);
+        snprintf(text, sizeof(text), "%u/%u", (unsigned) (focus + 1u), (unsigned) list->child_count);
+        menu_text_right(ssd, 0, text, true);
+        ssd1306_hline(ssd, x0, WIDTH - 1, MENU_ROW_HEIGHT - 1, true);
+        view->list = list;
+        view->focus = focus;
+        count = menu_add_window(windows, count, x0, 0);
+        if(full) rows++; else values++;
+    }
+
+    for(uint8_t row = 0; row < MENU_ROWS; row++)
+    {
+        uint8_t index = (uint8_t) (scroll + row);
+        menu_widget_t *widget = index < list->child_count ? list->children[index] : NULL;
+        bool focused = widget != NULL && index == focus;
+        uint8_t y = (uint8_t) ((row + 1) * MENU_ROW_HEIGHT);
+
+        // A revisão é lida antes do valor: se o valor mudar no meio, a linha é redesenhada no próximo quadro
+        uint16_t revision = widget != NULL ? widget->revision : 0;
+        int32_t value = widget != NULL ? widget->value : 0;
+
+        bool full = !view->valid || widget != view->widgets[row] || focused != view->focused[row];
+        if(!full && (widget == NULL || revision == view->revisions[row])) continue;
+
+        uint8_t x0 = full ? 0 : MENU_VALUE_X;
+        menu_fill_page(ssd, x0, (uint8_t) (row + 1), focused);
+        if(widget != NULL)
+        {
+            if(full) oledgfx_draw_text(ssd, MENU_LABEL_X, y, widget->label, !focused);
+            menu_draw_value(ssd, widget, value, y, !focused);
+            widget->box = (menu_box_t) {0, y, WIDTH, MENU_ROW_HEIGHT};
+        }
+        view->widgets[row] = widget;
+        view->focused[row] = focused;
+        view->revisions[row] = revision;
+        count = menu_add_window(windows, count, x0, (uint8_t) (row + 1));
+        if(full) rows++; else values++;
+    }
+    view->valid = true;
+    if(count == 0) return 0;
+
+    uint32_t bytes = 0;
+    for(uint8_t i = 0; i < count; i++)
+    {
+        bytes += (uint32_t) (windows[i].x1 - windows[i].x0 + 1) * (windows[i].page1 - windows[i].page0 + 1u);
+    }
+    menu->frames = menu->frames + 1u;
+    menu->rows_drawn = menu->rows_drawn + rows;
+    menu->values_drawn = menu->values_drawn + values;
+    menu->bytes_flushed = menu->bytes_flushed + bytes;
+    return count;
+}
+
+void menu_print_stats(const menu_t *menu, bool open)
+{
+    const menu_widget_t *list = menu->stack[menu->depth - 1];
+    uint32_t frames = menu->frames;
+    printf("menu: %s lista=%s profundidade=%u foco=%u/%u\n", open ? "aberto" : "fechado", list->label,
+           (unsigned) menu->depth, (unsigned) (list->focus + 1u), (unsigned) list->child_count);
+    printf("menu: quadros=%lu linhas=%lu valores=%lu bytes=%lu (%lu/quadro)\n", (unsigned long) frames,
+           (unsigned long) menu->rows_drawn, (unsigned long) menu->values_drawn, (unsigned long) menu->bytes_flushed,
+           (unsigned long) (frames != 0 ? menu->bytes_flushed / frames : 0));
+}
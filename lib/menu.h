@@ -0,0 +1,241 @@
+#ifndef MENU_H
+#define MENU_H
+
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+
+/**
+ * @file menu.h
+ * @brief Menu no OLED com widgets estáticos e redesenho só do que mudou.
+ *
+ * O menu é uma árvore de widgets declarada em memória estática (sem alocação):
+ * listas, que contêm outros widgets e abrem como uma nova tela; chaves
+ * liga/desliga; controles deslizantes com faixa e passo; e rótulos de valor,
+ * só para leitura. A tela tem uma linha de título (nome da lista e a posição
+ * do foco) e MENU_ROWS linhas de 8 pixels, uma por widget, com o nome à
+ * esquerda e o valor a partir de MENU_VALUE_X; o widget em foco aparece em
+ * vídeo inverso e a lista rola para mantê-lo visível.
+ *
+ * O modelo pertence ao núcleo 0: a tarefa de entrada traduz o joystick e os
+ * botões em teclas (`menu_nav_poll`, `menu_handle_key`), e cada mudança de
+ * valor incrementa a revisão do widget e chama sua função de aplicação. O
+ * núcleo 1 desenha (`menu_draw`) comparando o modelo com o que está na tela
+ * (`menu_view_t`): uma linha cujo widget ou foco mudou é redesenhada inteira;
+ * uma cuja revisão mudou, só na área do valor. Cada área redesenhada vira uma
+ * janela do SSD1306 (áreas vizinhas de mesmas colunas são unidas), e só essas
+ * janelas vão ao barramento: mover o foco envia duas linhas (256 bytes) e
+ * mudar um valor, ~42 bytes, em vez do quadro de 1 KB.
+ *
+ * O núcleo 1 lê o modelo sem trava: o núcleo 0 grava o valor antes da revisão,
+ * e uma leitura no meio de uma mudança é corrigida no quadro seguinte, pois o
+ * estado desenhado deixa de coincidir com o modelo.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Menu Menu no OLED
+ * @brief Árvore de widgets navegada pelo joystick, com redesenho e envio por área.
+ * @{
+ */
+
+/** @brief Linhas de widgets visíveis abaixo do título. */
+#define MENU_ROWS 7
+
+/** @brief Altura de uma linha (uma página do display). */
+#define MENU_ROW_HEIGHT 8
+
+/** @brief Coluna inicial da área de valor (42 pixels, 7 caracteres). */
+#define MENU_VALUE_X 86
+
+/** @brief Listas abertas ao mesmo tempo (a raiz e as sublistas). */
+#define MENU_MAX_DEPTH 4
+
+/** @brief Janelas de um quadro do menu: título e linhas. */
+#define MENU_MAX_WINDOWS (MENU_ROWS + 1)
+
+/** @brief Deflexão do joystick, a partir do centro, que conta como tecla. */
+#define MENU_NAV_THRESHOLD 1024
+
+/** @brief Espera até a primeira repetição de uma tecla mantida, e o intervalo das seguintes. */
+#define MENU_NAV_DELAY_US 400000u
+#define MENU_NAV_REPEAT_US 150000u
+
+/**
+ * @brief Tipos de widget.
+ */
+typedef enum
+{
+    MENU_LIST = 0, /**< Lista de widgets, aberta como uma tela. */
+    MENU_TOGGLE,   /**< Liga/desliga (`value` 0 ou 1). */
+    MENU_SLIDER,   /**< Valor entre `min` e `max`, em passos de `step`, com barra. */
+    MENU_LABEL     /**< Valor só para leitura. */
+} menu_kind_t;
+
+/**
+ * @brief Teclas do menu.
+ */
+typedef enum
+{
+    MENU_KEY_NONE = 0,
+    MENU_KEY_UP,     /**< Foco no widget anterior. */
+    MENU_KEY_DOWN,   /**< Foco no widget seguinte. */
+    MENU_KEY_LEFT,   /**< Diminui o valor, desliga ou volta. */
+    MENU_KEY_RIGHT,  /**< Aumenta o valor, liga ou abre a lista. */
+    MENU_KEY_SELECT, /**< Inverte a chave ou abre a lista. */
+    MENU_KEY_BACK    /**< Volta à lista anterior (na raiz, fecha o menu). */
+} menu_key_t;
+
+/**
+ * @brief Retângulo ocupado na tela.
+ */
+typedef struct
+{
+    uint8_t x, y, w, h;
+} menu_box_t;
+
+typedef struct menu_widget menu_widget_t;
+
+/**
+ * @brief Aplica o novo valor de um widget (núcleo 0).
+ */
+typedef void (*menu_change_fn_t)(menu_widget_t *widget);
+
+/**
+ * @brief Widget do menu (declarado estático, com os inicializadores abaixo).
+ */
+struct menu_widget
+{
+    uint8_t kind;                    /**< `menu_kind_t`. */
+    const char *label;               /**< Nome exibido (até 14 caracteres). */
+    volatile int32_t value;          /**< Valor atual. */
+    int32_t min, max, step;          /**< Faixa e passo (controle deslizante). */
+    menu_widget_t *const *children;  /**< Widgets da lista. */
+    uint8_t child_count;             /**< Quantidade de widgets da lista. */
+    volatile uint8_t focus;          /**< Widget em foco na lista. */
+    volatile uint8_t scroll;         /**< Primeiro widget visível da lista. */
+    menu_change_fn_t on_change;      /**< Aplicação das mudanças feitas pelo menu (ou `NULL`). */
+    volatile uint16_t revision;      /**< Incrementada a cada mudança de valor. */
+    menu_box_t box;                  /**< Linha ocupada no último desenho (núcleo 1). */
+};
+
+/** @brief Inicializadores dos widgets. */
+#define MENU_LIST_INIT(name, widgets) \
+    {.kind = MENU_LIST, .label = (name), .children = (widgets), \
+     .child_count = (uint8_t) (sizeof(widgets) / sizeof((widgets)[0]))}
+#define MENU_TOGGLE_INIT(name, initial, fn) \
+    {.kind = MENU_TOGGLE, .label = (name), .value = (initial), .max = 1, .step = 1, .on_change = (fn)}
+#define MENU_SLIDER_INIT(name, initial, lo, hi, inc, fn) \
+    {.kind = MENU_SLIDER, .label = (name), .value = (initial), .min = (lo), .max = (hi), .step = (inc), .on_change = (fn)}
+#define MENU_LABEL_INIT(name) \
+    {.kind = MENU_LABEL, .label = (name)}
+
+/**
+ * @brief Menu: pilha das listas abertas e contadores do desenho.
+ */
+typedef struct
+{
+    menu_widget_t *stack[MENU_MAX_DEPTH]; /**< Listas abertas; a do topo está na tela. */
+    volatile uint8_t depth;               /**< Listas na pilha (ao menos a raiz). */
+    volatile uint32_t frames;             /**< Quadros com alguma área redesenhada (núcleo 1). */
+    volatile uint32_t rows_drawn;         /**< Linhas redesenhadas inteiras. */
+    volatile uint32_t values_drawn;       /**< Áreas de valor redesenhadas. */
+    volatile uint32_t bytes_flushed;      /**< Bytes de pixels enviados nas janelas. */
+} menu_t;
+
+/**
+ * @brief Estado da tela desenhada pelo núcleo 1.
+ */
+typedef struct
+{
+    bool valid;                                   /**< Falso: a próxima chamada redesenha tudo. */
+    const menu_widget_t *list;                    /**< Lista do título. */
+    uint8_t focus;                                /**< Foco exibido no título. */
+    const menu_widget_t *widgets[MENU_ROWS];      /**< Widget de cada linha (ou `NULL`). */
+    bool focused[MENU_ROWS];                      /**< Linha em vídeo inverso. */
+    uint16_t revisions[MENU_ROWS];                /**< Revisão desenhada de cada linha. */
+} menu_view_t;
+
+/**
+ * @brief Estado da navegação pelo joystick (tecla mantida e próxima repetição).
+ */
+typedef struct
+{
+    menu_key_t held;  /**< Tecla correspondente à deflexão atual. */
+    uint32_t next_us; /**< Instante da próxima repetição. */
+} menu_nav_t;
+
+/**
+ * @brief Abre o menu na lista raiz e zera os contadores.
+ *
+ * @param[out] menu Menu.
+ * @param[in] root Lista raiz.
+ */
+void menu_init(menu_t *menu, menu_widget_t *root);
+
+/**
+ * @brief Aplica uma tecla (núcleo 0).
+ *
+ * @param[in,out] menu Menu.
+ * @param[in] key Tecla.
+ * @return `false` se a tecla fecha o menu (voltar na raiz).
+ */
+bool menu_handle_key(menu_t *menu, menu_key_t key);
+
+/**
+ * @brief Atualiza o valor de um widget sem chamar sua função de aplicação.
+ *
+ * Usada para refletir mudanças feitas fora do menu (console, botões) e para os
+ * rótulos. A revisão só muda se o valor mudar.
+ *
+ * @param[in,out] widget Widget.
+ * @param[in] value Novo valor.
+ */
+void menu_set_value(menu_widget_t *widget, int32_t value);
+
+/**
+ * @brief Converte a posição do joystick em teclas, com repetição enquanto mantida.
+ *
+ * @param[in,out] nav Estado da navegação.
+ * @param[in] x Eixo X (0 - 4095).
+ * @param[in] y Eixo Y (0 - 4095; para cima, maior).
+ * @param[in] now_us Instante atual.
+ * @return Tecla a aplicar, ou MENU_KEY_NONE.
+ */
+menu_key_t menu_nav_poll(menu_nav_t *nav, uint16_t x, uint16_t y, uint32_t now_us);
+
+/**
+ * @brief Descarta o estado da tela (após limpá-la): o próximo desenho é completo.
+ *
+ * @param[out] view Estado da tela.
+ */
+void menu_view_invalidate(menu_view_t *view);
+
+/**
+ * @brief Redesenha as áreas que mudaram e devolve as janelas a enviar (núcleo 1).
+ *
+ * @param[in,out] menu Menu (contadores).
+ * @param[in,out] view Estado da tela.
+ * @param[in,out] ssd Display (framebuffer).
+ * @param[out] windows Janelas redesenhadas, de cima para baixo (MENU_MAX_WINDOWS).
+ * @return Janelas preenchidas (0: nada mudou).
+ */
+uint8_t menu_draw(menu_t *menu, menu_view_t *view, ssd1306_t *ssd, ssd1306_window_t *windows);
+
+/**
+ * @brief Imprime a lista aberta e os contadores do desenho.
+ *
+ * @param[in] menu Menu.
+ * @param[in] open Se o menu está na tela.
+ */
+void menu_print_stats(const menu_t *menu, bool open);
+
+/** @} */ // Fim do grupo "Menu"
+
+#endif // MENU_H
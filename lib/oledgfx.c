@@ -1,4 +1,9 @@
 #include "oledgfx.h"
+#include "profile.h"
+#include "ram_func.h"
+#include "i2c_trace.h"
+#include "pixaddr.h"
+#include "font5x7.h"
 
 /**
  * @file oledgfx.c
@@ -47,7 +52,8 @@ volatile int8_t last_cursor_y = INVALID_CURSOR;
 /**
  * @brief Inicializa o display OLED SSD1306.
  *
- * Configura o barramento I2C e inicializa o driver SSD1306 para exibição gráfica.
+ * Configura o barramento I2C, entrega-o ao gerenciador (i2c_bus.h), registrando
+ * o display, e inicializa o driver SSD1306 para exibição gráfica.
  *
  * @todo Implementar a configuração do I2C e a inicialização do display OLED.
  *
@@ -60,12 +66,21 @@ volatile int8_t last_cursor_y = INVALID_CURSOR;
  */
 void oledgfx_init_all(ssd1306_t *ssd, i2c_inst_t *i2c, uint baudrate, uint8_t sda, uint8_t scl, uint8_t address)
 {
-    i2c_init(i2c, baudrate); // Inicializa a comunicação I2C com a taxa especificada
+    uint actual_baudrate = i2c_init(i2c, baudrate); // Inicializa a comunicação I2C com a taxa especificada
+    i2c_trace_set_baudrate(actual_baudrate); // Taxa efetiva, para a estimativa do tempo de barramento
     gpio_set_function(sda, GPIO_FUNC_I2C); // Define os pinos SDA e SCL para função I2C
     gpio_set_function(scl, GPIO_FUNC_I2C);
     gpio_pull_up(sda); // Habilita pull-up nos pinos I2C
     gpio_pull_up(scl);
     ssd1306_init(ssd, WIDTH, HEIGHT, false, address, i2c); // Inicializa o display SSD1306
+
+    // O barramento passa ao gerenciador: o quadro é enviado em trechos, intercalável com outros dispositivos
+    i2c_bus_t *bus = i2c_bus_init(i2c);
+    if(bus != NULL)
+    {
+        ssd1306_set_bus(ssd, bus, i2c_bus_add_device(bus, "oled", address, I2C_BUS_PRIORITY_DISPLAY,
+                                                     OLED_BUS_CHUNK_BYTES, OLED_BUS_BUDGET_US, true));
+    }
     ssd1306_config(ssd); // Configura o display
     ssd1306_send_data(ssd); // Atualiza o display
 }
@@ -79,31 +94,36 @@ void oledgfx_init_all(ssd1306_t *ssd, i2c_inst_t *i2c, uint baudrate, uint8_t sd
  *
  * @param[out] ssd Ponteiro para a estrutura do display SSD1306.
  */
-void oledgfx_clear_screen(ssd1306_t *ssd)
+void RAM_FUNC(oledgfx_clear_screen)(ssd1306_t *ssd)
 {
     ssd1306_fill(ssd, 0);
 }
 
+/**
+ * @brief Bitmap do cursor: 8 colunas de uma página, todas acesas.
+ */
+const uint8_t oledgfx_cursor_bitmap[CURSOR_SIDE] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+/**
+ * @brief Bitmap do marcador: contorno de 6x6 pixels.
+ */
+const uint8_t oledgfx_marker_bitmap[MARKER_SIDE] = {0x3F, 0x21, 0x21, 0x21, 0x21, 0x3F};
+
 /**
  * @brief Desenha ou apaga o cursor no display SSD1306.
  *
  * O cursor é representado por um quadrado de 8x8 pixels. 
  * Ele pode ser desenhado (state = 1) ou apagado (state = 0).
+ * É desenhado como um blit (pixaddr.h): uma escrita por coluna e página, em vez de 64 pixels.
  *
  * @param ssd Ponteiro para a estrutura do display SSD1306.
  * @param x Coordenada X do canto superior esquerdo do cursor.
  * @param y Coordenada Y do canto superior esquerdo do cursor.
  * @param state Estado do cursor (1 = desenha, 0 = apaga).
  */
-static void oledgfx_toggle_cursor(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t state)
+static void RAM_FUNC(oledgfx_toggle_cursor)(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t state)
 {
-    for (uint8_t i = 0; i < 8; ++i)
-    {
-        for (uint8_t j = 0; j < 8; ++j)
-        {
-            ssd1306_pixel(ssd, x + i, y + j, state);
-        }
-    }
+    pixaddr_blit(ssd->ram_buffer, x, y, oledgfx_cursor_bitmap, CURSOR_SIDE, 1, state != 0, PIXADDR_USE_INTERP);
 }
 
 /**
@@ -117,7 +137,7 @@ static void oledgfx_toggle_cursor(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t
  * @param[in] x Posição X do cursor.
  * @param[in] y Posição Y do cursor.
  */
-void oledgfx_draw_cursor(ssd1306_t *ssd, uint8_t x, uint8_t y)
+void RAM_FUNC(oledgfx_draw_cursor)(ssd1306_t *ssd, uint8_t x, uint8_t y)
 {
     oledgfx_toggle_cursor(ssd, x, y, 1);
     last_cursor_x = x;
@@ -136,9 +156,12 @@ void oledgfx_draw_cursor(ssd1306_t *ssd, uint8_t x, uint8_t y)
  * @param[in] x Nova posição X do cursor.
  * @param[in] y Nova posição Y do cursor.
  */
-void oledgfx_update_cursor(ssd1306_t *ssd, uint8_t x, uint8_t y)
+void RAM_FUNC(oledgfx_update_cursor)(ssd1306_t *ssd, uint8_t x, uint8_t y)
 {
-    oledgfx_toggle_cursor(ssd, last_cursor_x, last_cursor_y, 0);
+    PROFILE_SCOPE(PROFILE_OLEDGFX_CURSOR);
+    // Na primeira chamada não há cursor anterior a apagar
+    if(last_cursor_x != INVALID_CURSOR)
+        oledgfx_toggle_cursor(ssd, last_cursor_x, last_cursor_y, 0);
     oledgfx_toggle_cursor(ssd, x, y, 1);
     last_cursor_x = x;
     last_cursor_y = y;
@@ -153,16 +176,13 @@ void oledgfx_update_cursor(ssd1306_t *ssd, uint8_t x, uint8_t y)
  * @param[in] x Posição X inicial da linha.
  * @param[in] thickness Espessura da linha em quantidade de pixels.
  */
-void oledgfx_draw_vline(ssd1306_t *ssd, uint8_t x, uint8_t thickness)
+void RAM_FUNC(oledgfx_draw_vline)(ssd1306_t *ssd, uint8_t x, uint8_t thickness)
 {
-    uint8_t i, j;
+    uint8_t j;
     if(x + thickness > WIDTH) x = WIDTH - thickness;
     for(j = x; j < x + thickness; j++)
     {
-        for(i = 0; i < HEIGHT; i++)
-        {
-            ssd1306_pixel(ssd, j, i, 1);
-        }
+        pixaddr_span(ssd->ram_buffer, PIXADDR_PACK(j, 0), PIXADDR_STEP_Y, HEIGHT, 1, PIXADDR_USE_INTERP);
     }
 }
 
@@ -175,16 +195,13 @@ void oledgfx_draw_vline(ssd1306_t *ssd, uint8_t x, uint8_t thickness)
  * @param[in] y Posição Y inicial da linha.
  * @param[in] thickness Espessura da linha em quantidade de pixels.
  */
-void oledgfx_draw_hline(ssd1306_t *ssd, uint8_t y, uint8_t thickness)
+void RAM_FUNC(oledgfx_draw_hline)(ssd1306_t *ssd, uint8_t y, uint8_t thickness)
 {
-    uint8_t i, j;
+    uint8_t j;
     if(y + thickness > HEIGHT) y = HEIGHT - thickness;
     for(j = y; j < y + thickness; j++)
     {
-        for(i = 0; i < WIDTH; i++)
-        {
-            ssd1306_pixel(ssd, i, j, 1);
-        }
+        pixaddr_span(ssd->ram_buffer, PIXADDR_PACK(0, j), PIXADDR_STEP_X, WIDTH, 1, PIXADDR_USE_INTERP);
     }
 }
 
@@ -225,7 +242,7 @@ void oledgfx_clear_hline(ssd1306_t *ssd, uint8_t x, uint8_t thickness)
  *
  * @param[out] ssd Ponteiro para a estrutura do display SSD1306.
  */
-void oledgfx_render(ssd1306_t *ssd)
+void RAM_FUNC(oledgfx_render)(ssd1306_t *ssd)
 {
     ssd1306_send_data(ssd);
 }
@@ -251,10 +268,31 @@ void oledgfx_render(ssd1306_t *ssd)
  * @param[in,out] ssd Ponteiro para a estrutura do display SSD1306.
  * @param[in] thickness Espessura da borda em pixels.
  */
-void oledgfx_draw_border(ssd1306_t *ssd, uint8_t thickness)
+void RAM_FUNC(oledgfx_draw_border)(ssd1306_t *ssd, uint8_t thickness)
 {
+    PROFILE_SCOPE(PROFILE_OLEDGFX_BORDER);
     oledgfx_draw_vline(ssd, 0, thickness);
     oledgfx_draw_vline(ssd, WIDTH, thickness);
     oledgfx_draw_hline(ssd, 0, thickness);
     oledgfx_draw_hline(ssd, HEIGHT, thickness);
 }
+
+/**
+ * @brief Escreve um texto com a fonte 5x7, um blit por caractere.
+ *
+ * @param[in,out] ssd Ponteiro para a estrutura do display SSD1306.
+ * @param[in] x Coluna do primeiro caractere.
+ * @param[in] y Linha do topo dos caracteres.
+ * @param[in] text Texto terminado em zero.
+ * @param[in] value Acender (`true`) ou apagar os pixels dos glifos.
+ * @return Coluna seguinte ao último caractere.
+ */
+uint8_t RAM_FUNC(oledgfx_draw_text)(ssd1306_t *ssd, uint8_t x, uint8_t y, const char *text, bool value)
+{
+    while(*text != '\0' && x < WIDTH)
+    {
+        pixaddr_blit(ssd->ram_buffer, x, y, font5x7_glyph(*text++), FONT5X7_WIDTH, 1, value, PIXADDR_USE_INTERP);
+        x = x + FONT5X7_ADVANCE > WIDTH ? WIDTH : (uint8_t) (x + FONT5X7_ADVANCE);
+    }
+    return x;
+}
@@ -45,9 +45,31 @@
 #define INVALID_CURSOR ((int8_t) (-1))
 
 #define CURSOR_SIDE 8
+#define MARKER_SIDE 6
 #define BORDER_THICK 3
 #define BORDER_LIGHT 1
 
+/** 
+ * @brief Maior transação do display no barramento: controle + 64 bytes (~1,5 ms a 400 kHz).
+ *
+ * Cada trecho a mais custa ~50 us (endereço, controle, START e STOP): 16 trechos
+ * somam ~0,75 ms ao quadro de ~24 ms.
+ */
+#define OLED_BUS_CHUNK_BYTES 65
+
+/** 
+ * @brief Prazo de cada transação do display: o quadro precisa caber no período de 30 Hz.
+ */
+#define OLED_BUS_BUDGET_US 30000u
+
+/**
+ * @brief Bitmaps do cursor (quadrado cheio) e do marcador (contorno), no formato de `pixaddr_blit`.
+ *
+ * Usados também como sprites (sprite.h) pelo pipeline do display.
+ */
+extern const uint8_t oledgfx_cursor_bitmap[CURSOR_SIDE];
+extern const uint8_t oledgfx_marker_bitmap[MARKER_SIDE];
+
 /** 
  * @brief Última posição X do cursor no display OLED.
  */
@@ -171,6 +193,22 @@ void oledgfx_render(ssd1306_t *ssd);
  */
 void oledgfx_draw_border(ssd1306_t *ssd, uint8_t thickness);
 
+/**
+ * @brief Escreve um texto com a fonte 5x7 (font5x7.h), um blit por caractere.
+ *
+ * Os pixels acesos dos glifos recebem `value`; os demais não são alterados,
+ * então um texto apagado (`value = false`) sobre um retângulo cheio aparece
+ * em vídeo inverso. O texto é cortado na borda direita.
+ *
+ * @param[in,out] ssd Ponteiro para a estrutura do display SSD1306.
+ * @param[in] x Coluna do primeiro caractere.
+ * @param[in] y Linha do topo dos caracteres.
+ * @param[in] text Texto terminado em zero.
+ * @param[in] value Acender (`true`) ou apagar os pixels dos glifos.
+ * @return Coluna seguinte ao último caractere.
+ */
+uint8_t oledgfx_draw_text(ssd1306_t *ssd, uint8_t x, uint8_t y, const char *text, bool value);
+
 /** @} */ // Fim do grupo "OLED_Graphics"
 
 #endif // OLEDGFX_H
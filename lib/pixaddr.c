@@ -0,0 +1,117 @@
+#include "pixaddr.h"
+#include "ram_func.h"
+
+/**
+ * @file pixaddr.c
+ * @brief Laços de span e blit sobre o cursor de pixels, e o mapeamento do joystick.
+ *
+ * Cada laço é escrito uma vez, numa função `always_inline` com o parâmetro
+ * `interp` constante; as funções públicas escolhem a instância, e o teste de
+ * `interp` nos acessos do cursor desaparece dentro dos laços.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+const uint8_t pixaddr_bit_masks[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+
+static inline __attribute__((always_inline)) void pixaddr_span_impl(uint8_t *ram_buffer, uint32_t packed,
+                                                                     int32_t step, uint16_t count, bool value,
+                                                                     bool interp)
+{
+    pixaddr_t a;
+    pixaddr_begin(&a, ram_buffer, packed, interp);
+    while(count-- > 0)
+    {
+        uint8_t *byte = pixaddr_byte(&a);
+        if(value)
+            *byte |= pixaddr_mask(&a);
+        else
+            *byte &= (uint8_t) ~pixaddr_mask(&a);
+        pixaddr_step(&a, step);
+    }
+}
+
+void RAM_FUNC(pixaddr_span)(uint8_t *ram_buffer, uint32_t packed, int32_t step, uint16_t count, bool value,
+                            bool interp)
+{
+    if(interp)
+        pixaddr_span_impl(ram_buffer, packed, step, count, value, true);
+    else
+        pixaddr_span_impl(ram_buffer, packed, step, count, value, false);
+}
+
+static inline __attribute__((always_inline)) void pixaddr_blit_impl(uint8_t *ram_buffer, uint8_t x, uint8_t y,
+                                                                     const uint8_t *bitmap, uint8_t width,
+                                                                     uint8_t pages, bool value, bool interp)
+{
+    if(x >= PIXADDR_COLUMNS || y >= PIXADDR_PAGES * 8) return;
+    uint8_t columns = width < PIXADDR_COLUMNS - x ? width : PIXADDR_COLUMNS - x;
+    uint8_t shift = y & 7u;
+
+    for(uint8_t page = 0; page < pages; page++)
+    {
+        uint8_t dst_page = (uint8_t) ((y >> 3) + page);
+        if(dst_page >= PIXADDR_PAGES) break;
+        // A parte de baixo de cada byte cai na página seguinte, se houver
+        bool spill = shift != 0 && dst_page + 1 < PIXADDR_PAGES;
+        const uint8_t *src = bitmap + (uint32_t) page * width;
+
+        pixaddr_t a;
+        pixaddr_begin(&a, ram_buffer, PIXADDR_PACK(x, dst_page << 3), interp);
+        for(uint8_t col = 0; col < columns; col++)
+        {
+            uint8_t *dst = pixaddr_byte(&a);
+            uint8_t upper = (uint8_t) (src[col] << shift);
+            uint8_t lower = (uint8_t) (src[col] >> (8u - shift));
+            if(value)
+            {
+                dst[0] |= upper;
+                if(spill) dst[1] |= lower;
+            }
+            else
+            {
+                dst[0] &= (uint8_t) ~upper;
+                if(spill) dst[1] &= (uint8_t) ~lower;
+            }
+            pixaddr_step(&a, PIXADDR_STEP_X);
+        }
+    }
+}
+
+void RAM_FUNC(pixaddr_blit)(uint8_t *ram_buffer, uint8_t x, uint8_t y, const uint8_t *bitmap, uint8_t width,
+                            uint8_t pages, bool value, bool interp)
+{
+    if(interp)
+        pixaddr_blit_impl(ram_buffer, x, y, bitmap, width, pages, value, true);
+    else
+        pixaddr_blit_impl(ram_buffer, x, y, bitmap, width, pages, value, false);
+}
+
+uint16_t RAM_FUNC(pixaddr_map)(uint16_t value, uint8_t new_max, bool interp)
+{
+#if PIXADDR_HAVE_INTERP
+    if(interp)
+    {
+        interp_config lane0 = interp_default_config();
+        interp_config_set_blend(&lane0, true);
+        interp_set_config(interp0, 0, &lane0);
+
+        interp_config lane1 = interp_default_config();
+        interp_config_set_shift(&lane1, 4);
+        interp_config_set_mask(&lane1, 0, 7);
+        interp_set_config(interp0, 1, &lane1);
+
+        interp0->base[0] = 0;
+        interp0->base[1] = new_max + 1u;
+        interp0->accum[1] = value;
+        return (uint16_t) interp0->peek[1];
+    }
+#else
+    (void) interp;
+#endif
+    return (uint16_t) (((uint32_t) ((value >> 4) & 0xFFu) * (new_max + 1u)) >> 8);
+}
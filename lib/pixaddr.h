@@ -0,0 +1,205 @@
+#ifndef PIXADDR_H
+#define PIXADDR_H
+
+#include "pico/stdlib.h"
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "hardware/interp.h"
+#endif
+
+/**
+ * @file pixaddr.h
+ * @brief Endereçamento de pixels e mapeamento ADC -> tela, com os interpoladores do RP2040.
+ *
+ * O framebuffer do SSD1306 usa endereçamento vertical: o pixel (x, y) está no
+ * bit `y & 7` do byte `1 + x * 8 + y / 8`. Com a coordenada empacotada em
+ * `p = (x << 6) | y` (y < 64), o byte é `1 + (p >> 3)` e o bit, `p & 7`; andar
+ * um pixel em x soma 64, em y soma 1, e uma diagonal soma 65 ou 63.
+ *
+ * Na versão com interpolador, `p` fica no ACCUM0 do INTERP1 do núcleo: a
+ * faixa 0 devolve o endereço do byte (BASE0 = ram_buffer + 1, deslocamento 3,
+ * máscara de 10 bits) e a faixa 1, lendo o mesmo acumulador (CROSS_INPUT), o
+ * endereço da máscara do bit numa tabela (BASE1). Cada passo é uma escrita em
+ * ACCUM0_ADD e cada pixel, duas leituras do SIO, sem deslocamentos nem somas
+ * no laço. A versão em software faz as mesmas contas e dá o mesmo resultado;
+ * é a usada no build nativo e, sem a opção JOYTRACKER_INTERP do CMake
+ * (`INTERP_ENABLED=1`), também no firmware.
+ *
+ * O mapeamento do joystick (0 - 4095 para 0 - `new_max`) usa o modo BLEND do
+ * INTERP0: a faixa 1 interpola entre BASE0 = 0 e BASE1 = `new_max + 1` pelos
+ * 8 bits mais altos da leitura, ou seja, `((v >> 4) * (new_max + 1)) >> 8`,
+ * sem a divisão por 4095. Cada posição da tela recebe a mesma fatia da faixa
+ * do ADC (a divisão só chegava a `new_max` com a leitura em 4095).
+ *
+ * Os interpoladores são de cada núcleo e as funções reconfiguram as faixas a
+ * cada chamada: podem ser usadas nos dois núcleos, mas não de interrupções
+ * que interrompam outra chamada no mesmo núcleo.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Pixaddr Endereçamento de pixels
+ * @brief Gerador de endereços de pixel, blit e mapeamento do joystick, com ou sem interpolador.
+ * @{
+ */
+
+/** @brief Há interpoladores (build para o RP2040). */
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#define PIXADDR_HAVE_INTERP 1
+#else
+#define PIXADDR_HAVE_INTERP 0
+#endif
+
+#ifndef INTERP_ENABLED
+#define INTERP_ENABLED 0
+#endif
+
+/** @brief Versão usada pelas primitivas de desenho e pelo mapeamento do joystick. */
+#define PIXADDR_USE_INTERP (INTERP_ENABLED && PIXADDR_HAVE_INTERP)
+
+/** @brief Colunas e páginas (8 linhas) do framebuffer. */
+#define PIXADDR_COLUMNS 128
+#define PIXADDR_PAGES 8
+
+/** @brief Coordenada empacotada do pixel (x, y). */
+#define PIXADDR_PACK(x, y) (((uint32_t) (x) << 6) | (uint32_t) (y))
+
+/** @brief Passos da coordenada empacotada. */
+#define PIXADDR_STEP_X 64
+#define PIXADDR_STEP_Y 1
+
+/** @brief Máscara de cada bit de uma página (tabela lida pela faixa 1). */
+extern const uint8_t pixaddr_bit_masks[8];
+
+/**
+ * @brief Cursor sobre o framebuffer.
+ */
+typedef struct
+{
+    uint8_t *pixels; /**< Primeiro byte de pixels (após o byte de controle). */
+    uint32_t packed; /**< Coordenada corrente (versão em software). */
+    bool interp;     /**< Coordenada no INTERP1 do núcleo. */
+} pixaddr_t;
+
+/**
+ * @brief Posiciona o cursor em um pixel.
+ *
+ * @param[out] a Cursor.
+ * @param[in] ram_buffer Framebuffer do SSD1306 (com o byte de controle).
+ * @param[in] packed Coordenada empacotada (PIXADDR_PACK).
+ * @param[in] interp Usar o interpolador (ignorado sem PIXADDR_HAVE_INTERP).
+ */
+static inline void pixaddr_begin(pixaddr_t *a, uint8_t *ram_buffer, uint32_t packed, bool interp)
+{
+    a->pixels = ram_buffer + 1;
+    a->packed = packed;
+    a->interp = interp && PIXADDR_HAVE_INTERP;
+#if PIXADDR_HAVE_INTERP
+    if(a->interp)
+    {
+        interp_config lane0 = interp_default_config();
+        interp_config_set_shift(&lane0, 3);
+        interp_config_set_mask(&lane0, 0, 9);
+        interp_set_config(interp1, 0, &lane0);
+
+        interp_config lane1 = interp_default_config();
+        interp_config_set_cross_input(&lane1, true);
+        interp_config_set_mask(&lane1, 0, 2);
+        interp_set_config(interp1, 1, &lane1);
+
+        interp1->base[0] = (uint32_t) (uintptr_t) a->pixels;
+        interp1->base[1] = (uint32_t) (uintptr_t) pixaddr_bit_masks;
+        interp1->accum[0] = packed;
+    }
+#endif
+}
+
+/**
+ * @brief Avança o cursor (`step` negativo recua).
+ */
+static inline void pixaddr_step(pixaddr_t *a, int32_t step)
+{
+#if PIXADDR_HAVE_INTERP
+    if(a->interp)
+    {
+        interp1->add_raw[0] = (uint32_t) step;
+        return;
+    }
+#endif
+    a->packed += (uint32_t) step;
+}
+
+/**
+ * @brief Byte do framebuffer que contém o pixel do cursor.
+ */
+static inline uint8_t *pixaddr_byte(const pixaddr_t *a)
+{
+#if PIXADDR_HAVE_INTERP
+    if(a->interp) return (uint8_t *) (uintptr_t) interp1->peek[0];
+#endif
+    return a->pixels + ((a->packed >> 3) & 0x3FFu);
+}
+
+/**
+ * @brief Máscara do bit do pixel do cursor.
+ */
+static inline uint8_t pixaddr_mask(const pixaddr_t *a)
+{
+#if PIXADDR_HAVE_INTERP
+    if(a->interp) return *(const uint8_t *) (uintptr_t) interp1->peek[1];
+#endif
+    return pixaddr_bit_masks[a->packed & 7u];
+}
+
+/**
+ * @brief Acende ou apaga `count` pixels a partir de `packed`, avançando `step` a cada um.
+ *
+ * @param[in,out] ram_buffer Framebuffer.
+ * @param[in] packed Primeiro pixel.
+ * @param[in] step Passo (PIXADDR_STEP_X para linhas, PIXADDR_STEP_Y para colunas).
+ * @param[in] count Pixels.
+ * @param[in] value Acender (`true`) ou apagar.
+ * @param[in] interp Usar o interpolador.
+ */
+void pixaddr_span(uint8_t *ram_buffer, uint32_t packed, int32_t step, uint16_t count, bool value, bool interp);
+
+/**
+ * @brief Desenha um bitmap de 1 bit em qualquer posição, recortado às bordas.
+ *
+ * O bitmap tem o formato do framebuffer: `pages` faixas de 8 linhas, cada uma
+ * com `width` bytes (uma coluna por byte, bit 0 em cima). Com `y` fora do
+ * múltiplo de 8, cada byte se divide entre duas páginas do framebuffer. Os
+ * bits em 1 acendem (`value`) ou apagam pixels; os em 0 não alteram a tela.
+ *
+ * @param[in,out] ram_buffer Framebuffer.
+ * @param[in] x Coluna do canto superior esquerdo.
+ * @param[in] y Linha do canto superior esquerdo.
+ * @param[in] bitmap Colunas do bitmap, página a página.
+ * @param[in] width Largura em pixels.
+ * @param[in] pages Altura em páginas de 8 linhas.
+ * @param[in] value Acender (`true`) ou apagar.
+ * @param[in] interp Usar o interpolador.
+ */
+void pixaddr_blit(uint8_t *ram_buffer, uint8_t x, uint8_t y, const uint8_t *bitmap, uint8_t width, uint8_t pages,
+                  bool value, bool interp);
+
+/**
+ * @brief Mapeia uma leitura do ADC (0 - 4095) para 0 - `new_max`.
+ *
+ * @param[in] value Leitura.
+ * @param[in] new_max Maior posição (até 255).
+ * @param[in] interp Usar o interpolador.
+ * @return `((value >> 4) * (new_max + 1)) >> 8`.
+ */
+uint16_t pixaddr_map(uint16_t value, uint8_t new_max, bool interp);
+
+/** @} */ // Fim do grupo "Pixaddr"
+
+#endif // PIXADDR_H
@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <string.h>
+#include "predict.h"
+
+/**
+ * @file predict.c
+ * @brief Implementação do preditor de posição em ponto fixo.
+ *
+ * As velocidades são contagens do ADC por ms em Q8 e as acelerações,
+ * contagens por ms² em Q8. Os produtos pelo horizonte usam 64 bits: o
+ * preditor roda a 200 Hz na tarefa de entrada, e o custo é irrelevante.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Maior valor de um eixo. */
+#define PREDICT_AXIS_MAX 4095
+
+/** @brief Valor devolvido pela zona morta do joystick (joystick.c). */
+#define PREDICT_AXIS_CENTER 2048
+
+void predict_init(predict_t *pred)
+{
+    memset(pred, 0, sizeof(*pred));
+}
+
+void predict_add(predict_t *pred, uint16_t x, uint16_t y, uint32_t timestamp_us)
+{
+    if(pred->count > 0)
+    {
+        uint32_t last_us = pred->history[(pred->count - 1u) & (PREDICT_HISTORY - 1)].timestamp_us;
+        if(timestamp_us == last_us) return; // A tarefa de entrada pode ver a mesma amostra duas vezes
+        if(timestamp_us - last_us > PREDICT_MAX_GAP_US) pred->count = 0;
+    }
+    predict_point_t *point = &pred->history[pred->count & (PREDICT_HISTORY - 1)];
+    point->x = x;
+    point->y = y;
+    point->timestamp_us = timestamp_us;
+    pred->count++;
+}
+
+/**
+ * @brief Avanço de um eixo, em contagens, com as limitações contra ultrapassagem.
+ *
+ * @param pred Preditor (contadores).
+ * @param x2 Amostra atual.
+ * @param x1 Amostra PREDICT_WINDOW posições atrás.
+ * @param x0 Amostra 2 * PREDICT_WINDOW posições atrás.
+ * @param dt1_us Intervalo entre `x1` e `x2`.
+ * @param dt0_us Intervalo entre `x0` e `x1`.
+ * @param horizon_us Horizonte.
+ * @return Avanço a somar à amostra atual.
+ */
+static int32_t predict_axis(predict_t *pred, int32_t x2, int32_t x1, int32_t x0, int64_t dt1_us, int64_t dt0_us,
+                            int64_t horizon_us)
+{
+    // A zona morta prende o eixo no centro e o solta com um salto: as diferenças não são velocidades
+    if(x2 == PREDICT_AXIS_CENTER || x1 == PREDICT_AXIS_CENTER || x0 == PREDICT_AXIS_CENTER)
+    {
+        pred->deadzone++;
+        return 0;
+    }
+
+    int64_t v1 = (int64_t) (x2 - x1) * 256000 / dt1_us;
+    int64_t v0 = (int64_t) (x1 - x0) * 256000 / dt0_us;
+    int64_t accel = (v1 - v0) * 2000 / (dt1_us + dt0_us) * PREDICT_ACCEL_GAIN / 256;
+    int64_t v = v1 + (v1 - v0) * dt1_us / (dt1_us + dt0_us); // Velocidade no instante da amostra atual
+
+    // Parado na última janela: a parábola inventaria uma volta
+    if(v1 > -PREDICT_MIN_SPEED && v1 < PREDICT_MIN_SPEED)
+    {
+        pred->still++;
+        return 0;
+    }
+    bool was_moving = v0 <= -PREDICT_MIN_SPEED || v0 >= PREDICT_MIN_SPEED;
+    if((was_moving && (v1 < 0) != (v0 < 0)) || (v != 0 && (v < 0) != (v1 < 0)))
+    {
+        pred->reversals++;
+        return 0;
+    }
+
+    // Avanço em Q8: v * h + a * h² / 2, com h em ms
+    int64_t lead;
+    if(accel != 0 && (accel < 0) != (v < 0) && -v * 1000 / accel < horizon_us)
+    {
+        // Desacelerando: para no ponto em que a velocidade zera, sem voltar pela parábola
+        int64_t stop_us = -v * 1000 / accel;
+        lead = v * stop_us / 2000;
+        pred->stops++;
+    }
+    else
+    {
+        lead = v * horizon_us / 1000 + accel * horizon_us / 1000 * horizon_us / 2000;
+    }
+
+    int32_t counts = (int32_t) ((lead + (lead >= 0 ? 128 : -128)) / 256);
+    if(counts > PREDICT_MAX_LEAD || counts < -PREDICT_MAX_LEAD)
+    {
+        counts = counts > 0 ? PREDICT_MAX_LEAD : -PREDICT_MAX_LEAD;
+        pred->clamped++;
+    }
+    return counts;
+}
+
+/**
+ * @brief Soma o avanço ao eixo, dentro da faixa do ADC.
+ */
+static uint16_t predict_apply(predict_t *pred, uint16_t value, int32_t lead)
+{
+    int32_t predicted = (int32_t) value + lead;
+    if(predicted < 0 || predicted > PREDICT_AXIS_MAX)
+    {
+        predicted = predicted < 0 ? 0 : PREDICT_AXIS_MAX;
+        pred->clamped++;
+    }
+    uint32_t applied = (uint32_t) (predicted > value ? predicted - value : value - predicted);
+    if(applied > pred->lead_max) pred->lead_max = applied;
+    return (uint16_t) predicted;
+}
+
+void predict_position(predict_t *pred, uint32_t horizon_us, uint16_t *x, uint16_t *y)
+{
+    if(pred->count == 0)
+    {
+        *x = *y = PREDICT_AXIS_MAX / 2;
+        return;
+    }
+    const predict_point_t *p2 = &pred->history[(pred->count - 1u) & (PREDICT_HISTORY - 1)];
+    *x = p2->x;
+    *y = p2->y;
+    if(pred->count < 2 * PREDICT_WINDOW + 1) return;
+
+    const predict_point_t *p1 = &pred->history[(pred->count - 1u - PREDICT_WINDOW) & (PREDICT_HISTORY - 1)];
+    const predict_point_t *p0 = &pred->history[(pred->count - 1u - 2 * PREDICT_WINDOW) & (PREDICT_HISTORY - 1)];
+    int64_t dt1_us = (int64_t) (p2->timestamp_us - p1->timestamp_us);
+    int64_t dt0_us = (int64_t) (p1->timestamp_us - p0->timestamp_us);
+    if(horizon_us > PREDICT_MAX_HORIZON_US) horizon_us = PREDICT_MAX_HORIZON_US;
+
+    int32_t lead_x = predict_axis(pred, p2->x, p1->x, p0->x, dt1_us, dt0_us, horizon_us);
+    int32_t lead_y = predict_axis(pred, p2->y, p1->y, p0->y, dt1_us, dt0_us, horizon_us);
+    *x = predict_apply(pred, p2->x, lead_x);
+    *y = predict_apply(pred, p2->y, lead_y);
+    pred->predictions++;
+}
+
+void predict_print(const predict_t *pred, bool enabled, uint32_t horizon_us)
+{
+    printf("predict: %s horizonte=%luus previsoes=%lu avanco_max=%lu\n", enabled ? "on" : "off",
+           (unsigned long) horizon_us, (unsigned long) pred->predictions, (unsigned long) pred->lead_max);
+    printf("predict: eixos zona_morta=%lu parados=%lu inversoes=%lu paradas=%lu limitados=%lu\n",
+           (unsigned long) pred->deadzone, (unsigned long) pred->still, (unsigned long) pred->reversals,
+           (unsigned long) pred->stops, (unsigned long) pred->clamped);
+}
@@ -0,0 +1,139 @@
+#ifndef PREDICT_H
+#define PREDICT_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @file predict.h
+ * @brief Predição da posição do joystick para compensar a latência do display.
+ *
+ * O cursor exibido corresponde à amostra lida antes da composição e do envio
+ * do quadro; com o quadro a 30 Hz e ~23 ms de I2C, a imagem chega dezenas de
+ * milissegundos depois. O preditor guarda as últimas amostras publicadas pela
+ * tarefa de entrada e extrapola cada eixo até o instante estimado do fim do
+ * envio (horizonte), pela parábola que passa pela amostra atual e pelas
+ * amostras PREDICT_WINDOW e 2 * PREDICT_WINDOW posições atrás:
+ *
+ *     v1 = (x[n] - x[n-W]) / dt1          v0 = (x[n-W] - x[n-2W]) / dt0
+ *     a  = (v1 - v0) / ((dt1 + dt0) / 2)  v  = v1 + a * dt1 / 2
+ *     x(h) = x[n] + v * h + a * h^2 / 2 * PREDICT_ACCEL_GAIN / 256
+ *
+ * Velocidade e aceleração são calculadas em ponto fixo (contagens do ADC por
+ * ms, Q8). Para não ultrapassar o alvo nas inversões de sentido:
+ *
+ * - com alguma das três amostras no centro, o eixo não é extrapolado: a zona
+ *   morta do joystick prende o valor no centro e o solta com um salto;
+ * - com v1 abaixo de PREDICT_MIN_SPEED, o cursor fica na amostra (ruído em
+ *   repouso, que a parábola tomaria por inversões);
+ * - com v1 e v0, ou v1 e v, em sentidos opostos, a inversão está em curso e a
+ *   predição é suspensa;
+ * - desacelerando, a posição extrapolada não passa do ponto de parada
+ *   (v = 0), em vez de seguir a parábola de volta;
+ * - o avanço fica limitado a PREDICT_MAX_LEAD e à faixa do ADC.
+ *
+ * A avaliação (latência percebida e erro de ultrapassagem) é feita pelo
+ * host/predict_replay.c sobre amostras gravadas.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Predict Predição de entrada
+ * @brief Extrapolação da posição do joystick até o instante do fim do envio do quadro.
+ * @{
+ */
+
+/** @brief Amostras guardadas (potência de dois, maior que 2 * PREDICT_WINDOW). */
+#define PREDICT_HISTORY 8
+
+/** @brief Distância, em amostras, entre os pontos da estimativa (10 ms a 200 Hz). */
+#define PREDICT_WINDOW 2
+
+/** @brief Maior horizonte aceito; acima dele, o horizonte é limitado. */
+#define PREDICT_MAX_HORIZON_US 100000u
+
+/** @brief Maior intervalo entre amostras consideradas: lacunas maiores recomeçam o histórico. */
+#define PREDICT_MAX_GAP_US 50000u
+
+/** @brief Velocidade mínima para extrapolar, em contagens/ms Q8 (1 contagem/ms). */
+#define PREDICT_MIN_SPEED 256
+
+/** @brief Maior avanço por eixo, em contagens do ADC (1/8 da faixa). */
+#define PREDICT_MAX_LEAD 512
+
+/** @brief Peso do termo de aceleração, em 1/256 (um quarto: a aceleração em 10 ms é ruidosa; ver predict_replay). */
+#define PREDICT_ACCEL_GAIN 64
+
+/**
+ * @brief Amostra do histórico.
+ */
+typedef struct
+{
+    uint16_t x;            /**< Eixo X (0 - 4095). */
+    uint16_t y;            /**< Eixo Y (0 - 4095). */
+    uint32_t timestamp_us; /**< Instante da leitura do ADC. */
+} predict_point_t;
+
+/**
+ * @brief Preditor de posição (usado por um único contexto).
+ */
+typedef struct
+{
+    predict_point_t history[PREDICT_HISTORY]; /**< Últimas amostras (circular). */
+    uint32_t count;                           /**< Amostras guardadas desde o início ou a última lacuna. */
+    uint32_t predictions;                     /**< Posições extrapoladas. */
+    uint32_t deadzone;                        /**< Eixos não extrapolados por passarem pela zona morta. */
+    uint32_t still;                           /**< Eixos abaixo da velocidade mínima. */
+    uint32_t reversals;                       /**< Eixos com a predição suspensa por inversão de sentido. */
+    uint32_t stops;                           /**< Eixos limitados ao ponto de parada. */
+    uint32_t clamped;                         /**< Eixos limitados por PREDICT_MAX_LEAD ou pela faixa. */
+    uint32_t lead_max;                        /**< Maior avanço aplicado, em contagens. */
+} predict_t;
+
+/**
+ * @brief Esvazia o histórico e zera os contadores.
+ *
+ * @param[out] pred Preditor.
+ */
+void predict_init(predict_t *pred);
+
+/**
+ * @brief Acrescenta uma amostra ao histórico (amostras repetidas são ignoradas).
+ *
+ * @param[in,out] pred Preditor.
+ * @param[in] x Eixo X.
+ * @param[in] y Eixo Y.
+ * @param[in] timestamp_us Instante da leitura.
+ */
+void predict_add(predict_t *pred, uint16_t x, uint16_t y, uint32_t timestamp_us);
+
+/**
+ * @brief Extrapola a última amostra por `horizon_us`.
+ *
+ * Sem histórico suficiente, devolve a última amostra.
+ *
+ * @param[in,out] pred Preditor (os contadores são atualizados).
+ * @param[in] horizon_us Intervalo entre a leitura da última amostra e o instante previsto.
+ * @param[out] x Eixo X previsto.
+ * @param[out] y Eixo Y previsto.
+ */
+void predict_position(predict_t *pred, uint32_t horizon_us, uint16_t *x, uint16_t *y);
+
+/**
+ * @brief Imprime os contadores do preditor.
+ *
+ * @param[in] pred Preditor.
+ * @param[in] enabled Se a predição está aplicada ao display.
+ * @param[in] horizon_us Horizonte atual.
+ */
+void predict_print(const predict_t *pred, bool enabled, uint32_t horizon_us);
+
+/** @} */ // Fim do grupo "Predict"
+
+#endif // PREDICT_H
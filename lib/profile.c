@@ -0,0 +1,104 @@
+#include "profile.h"
+#include "hardware/clocks.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file profile.c
+ * @brief Tabela dos escopos, inicialização do SysTick e impressão do profiler.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#if PROFILE_ENABLED
+
+/** @brief Quantidade de sondas vazias usadas na medição do custo por sonda. */
+#define PROFILE_CALIBRATION_RUNS 64
+
+profile_scope_t profile_scopes[PROFILE_SCOPE_COUNT];
+
+/** @brief Nomes exibidos, na ordem de `profile_scope_id_t`. */
+static const char *const profile_names[PROFILE_SCOPE_COUNT] = {
+    "ssd1306_fill",
+    "ssd1306_send",
+    "oled_cursor",
+    "oled_border",
+    "display_frame",
+    "joy_sample",
+    "task_input",
+    "task_led",
+    "calibration",
+};
+
+void profile_init_core(void)
+{
+    systick_hw->csr = 0;
+    systick_hw->rvr = PROFILE_SYSTICK_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // ENABLE, clock do processador, sem interrupção
+}
+
+/**
+ * @brief Mede o custo médio de uma sonda vazia, em ciclos.
+ *
+ * @return Ciclos por sonda (abertura, fechamento e registro).
+ */
+static uint32_t profile_calibrate(void)
+{
+    uint32_t start = systick_hw->cvr;
+    for(uint i = 0; i < PROFILE_CALIBRATION_RUNS; i++)
+    {
+        PROFILE_SCOPE(PROFILE_CALIBRATION);
+    }
+    uint32_t cycles = (start - systick_hw->cvr) & PROFILE_SYSTICK_MASK;
+    return cycles / PROFILE_CALIBRATION_RUNS;
+}
+
+void profile_print(void)
+{
+    uint32_t cycles_per_us = clock_get_hz(clk_sys) / 1000000u;
+
+    printf("profile: %lu ciclos/us, custo por sonda=%lu ciclos\n", (unsigned long) cycles_per_us,
+           (unsigned long) profile_calibrate());
+    for(uint i = 0; i < PROFILE_CALIBRATION; i++)
+    {
+        const profile_scope_t *scope = &profile_scopes[i];
+        if(scope->count == 0) continue;
+
+        uint32_t mean = (uint32_t) (scope->total_cycles / scope->count);
+        printf("  %-14s n=%lu med=%lu (%luus) max=%lu (%luus)\n   ", profile_names[i],
+               (unsigned long) scope->count, (unsigned long) mean, (unsigned long) (mean / cycles_per_us),
+               (unsigned long) scope->max_cycles, (unsigned long) (scope->max_cycles / cycles_per_us));
+        for(uint b = 0; b < PROFILE_BUCKETS; b++)
+        {
+            if(scope->hist[b]) printf(" 2^%u:%lu", b, (unsigned long) scope->hist[b]);
+        }
+        printf("\n");
+    }
+}
+
+void profile_reset(void)
+{
+    memset(profile_scopes, 0, sizeof(profile_scopes));
+}
+
+#else
+
+void profile_init_core(void)
+{
+}
+
+void profile_print(void)
+{
+    printf("profile: desativado (compile com -DJOYTRACKER_PROFILE=ON)\n");
+}
+
+void profile_reset(void)
+{
+}
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @file profile.h
+ * @brief Profiler por etapa, com contagem em ciclos e histogramas no próprio dispositivo.
+ *
+ * `PROFILE_SCOPE(id)` mede, em ciclos do processador, o trecho entre a
+ * declaração e o fim do bloco que a contém (inclusive em retornos antecipados).
+ * Cada escopo acumula chamadas, soma, máximo e um histograma com buckets de
+ * potência de dois em uma tabela estática, impressa e zerada pelo console.
+ *
+ * A base de tempo é o SysTick de cada núcleo, contando para baixo em 24 bits no
+ * clock do sistema: trechos acima de 2^24 ciclos (~134 ms a 125 MHz) são medidos
+ * módulo esse valor. Cada sonda custa algumas dezenas de ciclos (o valor medido
+ * é exibido junto com a tabela).
+ *
+ * As sondas só são compiladas com `PROFILE_ENABLED=1` (opção JOYTRACKER_PROFILE
+ * do CMake); caso contrário, as macros não geram código.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Profile Profiler
+ * @brief Sondas de escopo e histogramas de duração por etapa.
+ * @{
+ */
+
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED 0
+#endif
+
+/** @brief Buckets do histograma: o bucket k conta durações em [2^k, 2^(k+1)) ciclos. */
+#define PROFILE_BUCKETS 24
+
+/**
+ * @brief Escopos instrumentados. Cada escopo deve ser atualizado por um único núcleo.
+ */
+typedef enum
+{
+    PROFILE_SSD1306_FILL = 0, /**< Preenchimento do framebuffer, pixel a pixel (núcleo 1). */
+    PROFILE_SSD1306_SEND,     /**< Envio do framebuffer pelo I2C (núcleo 1). */
+    PROFILE_OLEDGFX_CURSOR,   /**< Apagar e redesenhar o cursor e o marcador, pela camada de sprites (núcleo 1). */
+    PROFILE_OLEDGFX_BORDER,   /**< Redesenho da borda (núcleo 1). */
+    PROFILE_DISPLAY_FRAME,    /**< Quadro completo: composição e envio (núcleo 1). */
+    PROFILE_JOYSTICK_SAMPLE,  /**< Leitura dos dois canais do ADC (interrupção, núcleo 0). */
+    PROFILE_TASK_INPUT,       /**< Tarefa de entrada (núcleo 0). */
+    PROFILE_TASK_LED,         /**< Tarefa dos LEDs (núcleo 0). */
+    PROFILE_CALIBRATION,      /**< Sonda vazia usada para medir o custo das sondas. */
+    PROFILE_SCOPE_COUNT
+} profile_scope_id_t;
+
+/**
+ * @brief Estatísticas de um escopo.
+ */
+typedef struct
+{
+    uint32_t count;                   /**< Chamadas. */
+    uint32_t max_cycles;              /**< Maior duração. */
+    uint64_t total_cycles;            /**< Soma das durações. */
+    uint32_t hist[PROFILE_BUCKETS];   /**< Histograma logarítmico das durações. */
+} profile_scope_t;
+
+/**
+ * @brief Sonda ativa: escopo e leitura do SysTick na entrada.
+ */
+typedef struct
+{
+    uint8_t id;     /**< Escopo. */
+    uint32_t start; /**< SysTick na entrada. */
+} profile_probe_t;
+
+#if PROFILE_ENABLED
+
+#include "hardware/structs/systick.h"
+
+/** @brief Máscara do contador de 24 bits do SysTick. */
+#define PROFILE_SYSTICK_MASK 0x00FFFFFFu
+
+/** @brief Tabela dos escopos (definida em profile.c). */
+extern profile_scope_t profile_scopes[PROFILE_SCOPE_COUNT];
+
+/**
+ * @brief Abre uma sonda.
+ *
+ * @param id Escopo.
+ * @return Sonda com a leitura atual do SysTick.
+ */
+static inline profile_probe_t profile_begin(uint8_t id)
+{
+    profile_probe_t probe = {id, systick_hw->cvr};
+    return probe;
+}
+
+/**
+ * @brief Fecha uma sonda e registra a duração (chamada pelo `cleanup` do GCC).
+ *
+ * @param probe Sonda aberta por `profile_begin`.
+ */
+static inline void profile_end(const profile_probe_t *probe)
+{
+    // O SysTick conta para baixo
+    uint32_t cycles = (probe->start - systick_hw->cvr) & PROFILE_SYSTICK_MASK;
+    profile_scope_t *scope = &profile_scopes[probe->id];
+
+    scope->count++;
+    scope->total_cycles += cycles;
+    if(cycles > scope->max_cycles) scope->max_cycles = cycles;
+    scope->hist[31 - __builtin_clz(cycles | 1u)]++;
+}
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+/**
+ * @brief Mede o restante do bloco atual no escopo `id`.
+ */
+#define PROFILE_SCOPE(id) \
+    profile_probe_t PROFILE_CONCAT(profile_probe_, __LINE__) __attribute__((cleanup(profile_end))) = profile_begin(id)
+
+#else
+
+#define PROFILE_SCOPE(id) ((void) 0)
+
+#endif
+
+/**
+ * @brief Liga o SysTick do núcleo que chama, como contador livre de 24 bits.
+ *
+ * Deve ser chamada uma vez em cada núcleo que executa sondas. Sem
+ * `PROFILE_ENABLED`, não faz nada.
+ */
+void profile_init_core(void);
+
+/**
+ * @brief Imprime, pelo USB stdio, a tabela dos escopos e o custo medido por sonda.
+ */
+void profile_print(void);
+
+/**
+ * @brief Zera a tabela dos escopos.
+ *
+ * Chamada pelo núcleo 0 enquanto o núcleo 1 executa sondas: uma sonda
+ * concorrente pode deixar uma amostra parcial na nova janela.
+ */
+void profile_reset(void);
+
+/** @} */ // Fim do grupo "Profile"
+
+#endif // PROFILE_H
@@ -1,10 +1,43 @@
 #include "push_button.h"
 #include "pico/stdlib.h"
+#include "ram_func.h"
 
 /**
- * @brief Tempo de debounce do botão em milissegundos.
+ * @brief Estado de debounce de um botão.
+ *
+ * Os campos `volatile` são escritos pela interrupção de GPIO; os demais apenas
+ * por `pb_debounce_poll`. As duas rotinas devem ter a mesma prioridade, para
+ * que uma nunca interrompa a outra no mesmo núcleo.
  */
-#define DEBOUNCE_DELAY_MS 300
+typedef struct
+{
+    uint8_t gpio;                    /**< Pino do botão */
+    bool stable_pressed;             /**< Estado confirmado após o debounce */
+    bool long_sent;                  /**< Pressionar longo já notificado */
+    volatile bool edge_pending;      /**< Há bordas ainda não confirmadas */
+    volatile uint32_t first_edge_us; /**< Primeira borda desde o último estado estável */
+    volatile uint32_t last_edge_us;  /**< Borda mais recente */
+    uint32_t press_start_us;         /**< Instante do pressionar confirmado */
+    uint32_t next_repeat_us;         /**< Instante da próxima repetição */
+    pb_timing_t timing;              /**< Tempos configurados */
+} pb_button_t;
+
+/**
+ * @brief Botões registrados no debounce.
+ */
+static pb_button_t pb_buttons[PB_MAX_BUTTONS];
+
+/**
+ * @brief Quantidade de botões registrados.
+ */
+static uint8_t pb_button_count = 0;
+
+/**
+ * @brief Função que recebe os eventos filtrados.
+ */
+static pb_event_callback_t pb_event_callback = NULL;
+
+static void pb_gpio_irq_handler(uint gpio, uint32_t events);
 
 /**
  * @brief Flag para indicar a primeira configuração de IRQ.
@@ -16,10 +49,6 @@ volatile bool FIRST_IRQ_USE = true;
  */
 volatile gpio_irq_callback_t PB_IRQ_CALLBACK = NULL;
 
-/**
- * @brief Armazena o tempo da última ativação do botão para controle de debounce.
- */
-volatile uint32_t PB_DEBOUNCE_LAST_TIME = 0;
 
 /**
  * @brief Configura o pino do botão como entrada e ativa o pull-up, se necessário.
@@ -48,8 +77,9 @@ void pb_set_irq_callback(gpio_irq_callback_t callback) { PB_IRQ_CALLBACK = callb
 void pb_enable_irq(uint button_pin)
 {
     if(FIRST_IRQ_USE) {
-        // Registra a callback e ativa a interrupção na borda de descida
-        gpio_set_irq_enabled_with_callback(button_pin, GPIO_IRQ_EDGE_FALL, true, PB_IRQ_CALLBACK);
+        // Registra o tratador do módulo (que repassa a callback) e ativa a borda de descida
+        gpio_set_irq_enabled_with_callback(button_pin, GPIO_IRQ_EDGE_FALL, true, pb_gpio_irq_handler);
+        FIRST_IRQ_USE = false;
     } else {
         gpio_set_irq_enabled(button_pin, GPIO_IRQ_EDGE_FALL, true); // Habilita a interrupção sem callback
     }
@@ -64,19 +94,130 @@ void pb_enable_irq(uint button_pin)
 bool pb_is_button_pressed(uint8_t button_pin) { return (!gpio_get(button_pin)); }
 
 /**
- * @brief Verifica se o tempo de debounce já passou desde o último acionamento.
+ * @brief Procura o estado de debounce de um pino.
+ *
+ * @param button_pin Pino do GPIO.
+ * @return Ponteiro para o estado, ou NULL se o pino não estiver registrado.
+ */
+static pb_button_t *RAM_FUNC(pb_find_button)(uint button_pin)
+{
+    for(uint8_t i = 0; i < pb_button_count; i++)
+    {
+        if(pb_buttons[i].gpio == button_pin) return &pb_buttons[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Tratador da interrupção de GPIO: apenas registra o instante da borda.
  *
- * @return `true` se o tempo de debounce já passou, `false` caso contrário.
+ * Pinos não registrados no debounce são repassados à callback definida por
+ * `pb_set_irq_callback`, se houver.
+ *
+ * @param gpio Pino que gerou a interrupção.
+ * @param events Bordas detectadas.
+ */
+static void RAM_FUNC(pb_gpio_irq_handler)(uint gpio, uint32_t events)
+{
+    pb_button_t *button = pb_find_button(gpio);
+    if(button == NULL)
+    {
+        if(PB_IRQ_CALLBACK != NULL) PB_IRQ_CALLBACK(gpio, events);
+        return;
+    }
+
+    uint32_t now = time_us_32();
+    if(!button->edge_pending)
+    {
+        button->first_edge_us = now;
+        button->edge_pending = true;
+    }
+    button->last_edge_us = now;
+}
+
+/**
+ * @brief Entrega um evento à callback registrada.
  */
-bool pb_is_debounce_delay_over()
+static void RAM_FUNC(pb_emit)(const pb_button_t *button, pb_event_type_t type, uint32_t timestamp_us)
+{
+    if(pb_event_callback == NULL) return;
+    pb_event_t event = { button->gpio, (uint8_t) type, timestamp_us };
+    pb_event_callback(&event);
+}
+
+bool pb_debounce_add(uint8_t button_pin, const pb_timing_t *timing)
 {
-    uint32_t current_time = to_ms_since_boot(get_absolute_time()); // Obtém o tempo atual desde o boot
-    bool debounce_time_elapsed = (current_time - PB_DEBOUNCE_LAST_TIME >= DEBOUNCE_DELAY_MS);
-    
-    if(debounce_time_elapsed)
+    static const pb_timing_t default_timing = {
+        PB_DEFAULT_DEBOUNCE_US, PB_DEFAULT_LONG_PRESS_US, PB_DEFAULT_REPEAT_US
+    };
+
+    if(pb_button_count >= PB_MAX_BUTTONS) return false;
+
+    pb_button_t *button = &pb_buttons[pb_button_count];
+    button->gpio = button_pin;
+    button->stable_pressed = pb_is_button_pressed(button_pin);
+    button->long_sent = false;
+    button->edge_pending = false;
+    button->press_start_us = time_us_32();
+    button->timing = (timing != NULL) ? *timing : default_timing;
+    pb_button_count++;
+
+    gpio_set_irq_enabled_with_callback(button_pin, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true,
+                                       pb_gpio_irq_handler);
+    FIRST_IRQ_USE = false;
+    return true;
+}
+
+void pb_set_event_callback(pb_event_callback_t callback) { pb_event_callback = callback; }
+
+void RAM_FUNC(pb_debounce_poll)(uint32_t now_us)
+{
+    for(uint8_t i = 0; i < pb_button_count; i++)
     {
-        PB_DEBOUNCE_LAST_TIME = current_time; // Atualiza o tempo do último acionamento
-        return true;
+        pb_button_t *button = &pb_buttons[i];
+
+        // Confirma o nível somente após `debounce_us` sem novas bordas
+        if(button->edge_pending && (now_us - button->last_edge_us) >= button->timing.debounce_us)
+        {
+            uint32_t first_edge_us = button->first_edge_us;
+            button->edge_pending = false;
+
+            bool pressed = pb_is_button_pressed(button->gpio);
+            if(pressed != button->stable_pressed)
+            {
+                button->stable_pressed = pressed;
+                if(pressed)
+                {
+                    button->press_start_us = first_edge_us;
+                    button->long_sent = false;
+                }
+                pb_emit(button, pressed ? PB_EVENT_PRESS : PB_EVENT_RELEASE, first_edge_us);
+            }
+        }
+
+        if(!button->stable_pressed) continue;
+
+        // Pressionar longo e repetição, medidos a partir da primeira borda
+        if(!button->long_sent)
+        {
+            if(button->timing.long_press_us != 0 &&
+               (now_us - button->press_start_us) >= button->timing.long_press_us)
+            {
+                button->long_sent = true;
+                button->next_repeat_us = now_us + button->timing.repeat_us;
+                pb_emit(button, PB_EVENT_LONG_PRESS, now_us);
+            }
+        }
+        else if(button->timing.repeat_us != 0 && (int32_t) (now_us - button->next_repeat_us) >= 0)
+        {
+            button->next_repeat_us += button->timing.repeat_us;
+            pb_emit(button, PB_EVENT_REPEAT, now_us);
+        }
     }
-    return false;
+}
+
+bool pb_debounce_is_pressed(uint8_t button_pin)
+{
+    pb_button_t *button = pb_find_button(button_pin);
+    return (button != NULL) ? button->stable_pressed : pb_is_button_pressed(button_pin);
 }
@@ -20,15 +20,63 @@
  * @brief Este arquivo contém funções e definições que permitem
  *        operar e gerenciar push buttons, configurando os 
  *        botões conectados ao GPIO e manipulando-os com interrupção
+ *
+ * O debounce é feito por botão: a interrupção de GPIO (nas duas bordas) apenas
+ * registra o instante da borda, e `pb_debounce_poll`, chamada periodicamente,
+ * confirma o novo nível quando o pino fica estável por `debounce_us`. Cada botão
+ * gera eventos de pressionar, soltar, pressionar longo e repetição, marcados
+ * com o instante da primeira borda.
  * 
  * @author Carlos Valadao
  * @date 31/01/2025
  */
 
+#define PB_MAX_BUTTONS 4                 /**< Quantidade máxima de botões com debounce */
+#define PB_DEFAULT_DEBOUNCE_US 5000      /**< Tempo de estabilidade padrão (5 ms) */
+#define PB_DEFAULT_LONG_PRESS_US 800000  /**< Tempo padrão para o pressionar longo (800 ms) */
+#define PB_DEFAULT_REPEAT_US 200000      /**< Intervalo padrão de repetição após o pressionar longo */
+
+/**
+ * @brief Tipos de evento gerados pelo debounce.
+ */
+typedef enum
+{
+    PB_EVENT_PRESS = 1, /**< Botão pressionado (nível estável) */
+    PB_EVENT_RELEASE,   /**< Botão solto (nível estável) */
+    PB_EVENT_LONG_PRESS,/**< Botão mantido pressionado por `long_press_us` */
+    PB_EVENT_REPEAT     /**< Repetição a cada `repeat_us` após o pressionar longo */
+} pb_event_type_t;
+
+/**
+ * @brief Evento de botão já filtrado.
+ */
+typedef struct
+{
+    uint8_t gpio;          /**< Pino do botão */
+    uint8_t type;          /**< Tipo do evento (pb_event_type_t) */
+    uint32_t timestamp_us; /**< Instante da primeira borda (press/release) ou da detecção */
+} pb_event_t;
+
+/**
+ * @brief Tempos de debounce, pressionar longo e repetição de um botão.
+ */
+typedef struct
+{
+    uint32_t debounce_us;   /**< Tempo que o pino deve ficar estável após a última borda */
+    uint32_t long_press_us; /**< Tempo mantido até o evento de pressionar longo (0 desativa) */
+    uint32_t repeat_us;     /**< Intervalo de repetição após o pressionar longo (0 desativa) */
+} pb_timing_t;
+
+/**
+ * @brief Função que recebe os eventos de botão.
+ *
+ * É chamada no contexto de `pb_debounce_poll` e não deve bloquear.
+ */
+typedef void (*pb_event_callback_t)(const pb_event_t *event);
+
 /** Variáveis externas */
 extern volatile bool FIRST_IRQ_USE; /**< Variável de controle para a primeira utilização da interrupção */
 extern volatile gpio_irq_callback_t PB_IRQ_CALLBACK; /**< Função callback para a interrupção do botão */
-extern volatile uint32_t PB_DEBOUNCE_LAST_TIME;
 
 /**
  * @brief Configura o pino do botão para o modo desejado (com ou sem pull-up).
@@ -65,6 +113,42 @@ void pb_enable_irq(uint button_pin);
 
 bool pb_is_button_pressed(uint8_t button_pin);
 
-bool pb_is_debounce_delay_over();
+/**
+ * @brief Registra um botão no debounce e habilita sua interrupção nas duas bordas.
+ * 
+ * O pino deve ter sido configurado com `pb_config`. A interrupção de GPIO passa
+ * a ser tratada por este módulo, que apenas registra o instante das bordas.
+ * 
+ * @param button_pin Pino GPIO do botão (ativo em nível baixo, com pull-up).
+ * @param timing Tempos do botão, ou NULL para os valores padrão.
+ * @return `true` se registrado, `false` se o limite de botões foi atingido.
+ */
+bool pb_debounce_add(uint8_t button_pin, const pb_timing_t *timing);
+
+/**
+ * @brief Define a função que recebe os eventos de botão.
+ * 
+ * @param callback Função chamada a cada evento.
+ */
+void pb_set_event_callback(pb_event_callback_t callback);
+
+/**
+ * @brief Avança as máquinas de estado de todos os botões registrados.
+ * 
+ * Deve ser chamada periodicamente (por exemplo, a cada 1 ms) em um contexto de
+ * mesma prioridade que a interrupção de GPIO. A latência do evento é o tempo
+ * de debounce mais, no máximo, um período de chamada.
+ * 
+ * @param now_us Instante atual, em microssegundos.
+ */
+void pb_debounce_poll(uint32_t now_us);
+
+/**
+ * @brief Retorna o estado filtrado (após o debounce) de um botão registrado.
+ * 
+ * @param button_pin Pino GPIO do botão.
+ * @return `true` se o botão estiver pressionado de forma estável.
+ */
+bool pb_debounce_is_pressed(uint8_t button_pin);
 
 #endif //PUSH_BUTTON_H
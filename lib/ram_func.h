@@ -0,0 +1,58 @@
+#ifndef RAM_FUNC_H
+#define RAM_FUNC_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @file ram_func.h
+ * @brief Marcação das funções do caminho crítico que podem rodar da SRAM.
+ *
+ * Por padrão todo o código executa da flash (XIP), através da cache de 16 KB:
+ * uma falta na cache custa a leitura de uma linha pela QSPI e acontece em
+ * instantes imprevisíveis, conforme o que rodou antes. `RAM_FUNC(nome)` envolve
+ * o nome na definição de uma função do caminho crítico:
+ *
+ *     void RAM_FUNC(ssd1306_pixel)(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value)
+ *
+ * Com `RAM_HOT_PATH_ENABLED=1` (opção JOYTRACKER_RAM_HOT_PATH do CMake), a
+ * função vai para a seção `.time_critical.<nome>`, copiada para a SRAM na
+ * partida (`__not_in_flash_func` do pico-sdk); caso contrário, a macro não
+ * altera nada. Estão marcados as primitivas de desenho (ssd1306.c, oledgfx.c),
+ * o envio do quadro e o registro I2C, a leitura e o filtro do ADC, o
+ * temporizador de amostragem e a interrupção de GPIO dos botões.
+ *
+ * As funções do pico-sdk chamadas por elas (por exemplo `i2c_write_blocking`)
+ * continuam na flash, exceto as `static inline` dos cabeçalhos; para mover o
+ * programa inteiro, use `pico_set_binary_type(JoyTracker copy_to_ram)`.
+ *
+ * A lista das funções movidas e seus tamanhos é impressa ao fim do build por
+ * tools/ram_report.py.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Ram_Func Funções na SRAM
+ * @brief Macro de posicionamento do caminho crítico.
+ * @{
+ */
+
+#ifndef RAM_HOT_PATH_ENABLED
+#define RAM_HOT_PATH_ENABLED 0
+#endif
+
+#if RAM_HOT_PATH_ENABLED
+#define RAM_FUNC(func_name) __not_in_flash_func(func_name)
+#else
+#define RAM_FUNC(func_name) func_name
+#endif
+
+/** @} */ // Fim do grupo "Ram_Func"
+
+#endif // RAM_FUNC_H
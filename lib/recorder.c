@@ -0,0 +1,519 @@
+#include "recorder.h"
+#include "pico/flash.h"
+#include "ram_func.h"
+#include "event_trace.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file recorder.c
+ * @brief Codificador na interrupção, fila de páginas e log de segmentos na flash.
+ *
+ * A interrupção de amostragem (núcleo 0) é a única produtora: abre, preenche e
+ * fecha as páginas e pede início e fim de sessão por flags que ela mesma
+ * atende. O núcleo 1 é o único consumidor: calcula o CRC, grava a página e
+ * apaga segmentos. A fila usa os mesmos índices crescentes de spsc_ring.h, mas
+ * guarda as páginas no lugar, sem cópia.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Tokens do conteúdo (2 bits menores do varint). */
+#define RECORDER_TOKEN_RUN   0u
+#define RECORDER_TOKEN_MOVE  1u
+#define RECORDER_TOKEN_TIME  2u
+#define RECORDER_TOKEN_EVENT 3u
+
+/** @brief Maior varint de 32 bits. */
+#define RECORDER_VARINT_MAX 5u
+
+/** @brief Espaço de uma amostra (TIME e MOVE) e de um evento; sempre sobra lugar para o RUN pendente. */
+#define RECORDER_SAMPLE_MAX (3u * RECORDER_VARINT_MAX)
+#define RECORDER_EVENT_MAX  (2u * RECORDER_VARINT_MAX)
+
+/** @brief Conteúdo máximo de uma página. */
+#define RECORDER_PAYLOAD_SIZE (RECORDER_PAGE_SIZE - RECORDER_HEADER_SIZE)
+
+/** @brief Amostra bruta de referência: dois eixos de 12 bits e instante de 32 bits. */
+#define RECORDER_RAW_SAMPLE_BYTES 7u
+
+/** @brief Espera máxima para pausar o outro núcleo antes de uma operação na flash. */
+#define RECORDER_FLASH_TIMEOUT_MS 10u
+
+#if RECORDER_HEADER_SIZE != 24 || (RECORDER_RAM_PAGES & (RECORDER_RAM_PAGES - 1)) != 0
+#error "cabeçalho de 24 bytes e fila com tamanho potência de dois"
+#endif
+
+_Static_assert(sizeof(recorder_page_header_t) == RECORDER_HEADER_SIZE, "cabeçalho fora do formato");
+
+/**
+ * @brief Operação na flash executada por `flash_safe_execute`.
+ */
+typedef struct
+{
+    uint32_t offset;     /**< Deslocamento na região. */
+    const uint8_t *data; /**< Página a gravar (só na gravação). */
+} recorder_flash_op_t;
+
+/** @brief Fila de páginas: `rec_head` é escrito só pela interrupção, `rec_tail` só pelo núcleo 1. */
+static uint8_t rec_pages[RECORDER_RAM_PAGES][RECORDER_PAGE_SIZE] __attribute__((aligned(4)));
+static uint8_t rec_scratch[RECORDER_PAGE_SIZE] __attribute__((aligned(4)));
+static volatile uint32_t rec_head = 0;
+static volatile uint32_t rec_tail = 0;
+
+/** @brief Estado do codificador (interrupção de amostragem). */
+static uint8_t *rec_page = NULL;       // Página aberta, ou NULL
+static bool rec_page_dropped = false;  // A página aberta é a de rascunho (fila cheia)
+static uint32_t rec_used = 0;          // Bytes de conteúdo da página aberta
+static uint32_t rec_page_open_us = 0;
+static uint32_t rec_prev_t = 0;        // Instante da amostra anterior, na grade do período
+static uint16_t rec_prev_x = 0, rec_prev_y = 0;
+static uint32_t rec_run = 0;           // Amostras repetidas ainda não escritas
+static uint32_t rec_next_seq = 0;
+static uint32_t rec_start_us = 0;
+static uint32_t rec_period_us = 1000;
+
+/** @brief Pedidos do console, atendidos pela interrupção na próxima amostra. */
+static volatile bool rec_start_requested = false;
+static volatile bool rec_stop_requested = false;
+
+/** @brief Estado do log na flash (núcleo 1, após `recorder_init`). */
+static uint32_t rec_write_offset = 0;  // Próxima página a gravar
+static uint32_t rec_erased_ahead = 0;  // Bytes apagados a partir de rec_write_offset
+static bool rec_ready = false;
+
+/** @brief Contadores da sessão (escritos pela interrupção) e da flash (escritos pelo núcleo 1). */
+static recorder_stats_t rec_stats;
+static uint32_t rec_committed_pages = 0;
+static uint32_t rec_erased_segments = 0;
+static uint32_t rec_flash_failures = 0;
+static uint32_t rec_program_us_max = 0;
+static uint32_t rec_erase_us_max = 0;
+
+/**
+ * @brief Conteúdo da região, lido pelo XIP sem passar pela cache.
+ */
+static inline const uint8_t *recorder_region(void)
+{
+    return (const uint8_t *) (XIP_NOCACHE_NOALLOC_BASE + RECORDER_REGION_OFFSET);
+}
+
+/**
+ * @brief Mapeia um inteiro com sinal em um sem sinal de magnitude próxima (0, -1, 1, -2, ...).
+ */
+static inline uint32_t recorder_zigzag(int32_t value)
+{
+    return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+}
+
+/**
+ * @brief Escreve um varint (LEB128) na página aberta.
+ */
+static void RAM_FUNC(recorder_put_varint)(uint32_t value)
+{
+    uint8_t *out = rec_page + RECORDER_HEADER_SIZE;
+    while(value >= 0x80u)
+    {
+        out[rec_used++] = (uint8_t) (value | 0x80u);
+        value >>= 7;
+    }
+    out[rec_used++] = (uint8_t) value;
+}
+
+/**
+ * @brief Escreve as amostras repetidas pendentes.
+ */
+static void RAM_FUNC(recorder_flush_run)(void)
+{
+    if(rec_run == 0) return;
+    recorder_put_varint(rec_run << 2 | RECORDER_TOKEN_RUN);
+    rec_run = 0;
+}
+
+/**
+ * @brief Indica se `len` bytes cabem na página aberta, além do RUN pendente.
+ */
+static inline bool recorder_fits(uint32_t len)
+{
+    return rec_used + len + RECORDER_VARINT_MAX <= RECORDER_PAYLOAD_SIZE;
+}
+
+/**
+ * @brief Abre uma página cuja primeira amostra vai no cabeçalho.
+ *
+ * Com a fila cheia, a página é montada no rascunho e descartada ao fechar.
+ */
+static void RAM_FUNC(recorder_open_page)(uint32_t t_us, uint16_t x, uint16_t y, uint8_t flags)
+{
+    rec_page_dropped = rec_head - rec_tail >= RECORDER_RAM_PAGES;
+    rec_page = rec_page_dropped ? rec_scratch : rec_pages[rec_head & (RECORDER_RAM_PAGES - 1u)];
+
+    recorder_page_header_t header = {
+        .magic = RECORDER_MAGIC,
+        .version = RECORDER_VERSION,
+        .flags = flags,
+        .seq = rec_next_seq++,
+        .session = rec_stats.session,
+        .length = 0,
+        .t0_us = t_us,
+        .x0 = x,
+        .y0 = y,
+        .period_us = (uint16_t) rec_period_us,
+        .crc = 0,
+    };
+    memcpy(rec_page, &header, sizeof(header));
+    rec_used = 0;
+    rec_run = 0;
+    rec_page_open_us = t_us;
+    rec_prev_t = t_us;
+    rec_prev_x = x;
+    rec_prev_y = y;
+}
+
+/**
+ * @brief Fecha a página aberta e a entrega ao núcleo 1 (ou a descarta).
+ */
+static void RAM_FUNC(recorder_close_page)(void)
+{
+    if(rec_page == NULL) return;
+    recorder_flush_run();
+
+    uint16_t length = (uint16_t) rec_used;
+    memcpy(rec_page + offsetof(recorder_page_header_t, length), &length, sizeof(length));
+    memset(rec_page + RECORDER_HEADER_SIZE + rec_used, 0xFF, RECORDER_PAYLOAD_SIZE - rec_used);
+
+    rec_stats.pages++;
+    rec_stats.bytes += RECORDER_HEADER_SIZE + rec_used;
+    if(rec_page_dropped)
+    {
+        rec_stats.dropped_pages++;
+    }
+    else
+    {
+        __sync_synchronize();
+        rec_head = rec_head + 1u;
+    }
+    rec_page = NULL;
+}
+
+void RAM_FUNC(recorder_sample)(uint32_t t_us, uint16_t x, uint16_t y)
+{
+    if(rec_start_requested)
+    {
+        recorder_close_page();
+        uint16_t session = (uint16_t) (rec_stats.session + 1u);
+        memset(&rec_stats, 0, sizeof(rec_stats));
+        rec_stats.session = session;
+
+        rec_start_us = t_us;
+        rec_stats.samples = 1;
+        recorder_open_page(t_us, x, y, RECORDER_FLAG_SESSION_START);
+        rec_stats.recording = true;
+        rec_stop_requested = false;
+        rec_start_requested = false;
+        return;
+    }
+    if(!rec_stats.recording) return;
+    if(rec_stop_requested)
+    {
+        recorder_close_page();
+        rec_stats.recording = false;
+        rec_stop_requested = false;
+        return;
+    }
+
+    rec_stats.samples++;
+    rec_stats.elapsed_us = t_us - rec_start_us;
+    if(rec_page == NULL || t_us - rec_page_open_us >= RECORDER_PAGE_MAX_AGE_US || !recorder_fits(RECORDER_SAMPLE_MAX))
+    {
+        recorder_close_page();
+        recorder_open_page(t_us, x, y, 0);
+        return;
+    }
+
+    // Posição na grade do período; só sai dela após um atraso maior que meio período
+    int32_t periods = ((int32_t) (t_us - rec_prev_t) + (int32_t) (rec_period_us / 2u)) / (int32_t) rec_period_us;
+    if(periods != 1)
+    {
+        recorder_flush_run();
+        recorder_put_varint(recorder_zigzag(periods - 1) << 2 | RECORDER_TOKEN_TIME);
+    }
+    rec_prev_t += (uint32_t) periods * rec_period_us;
+
+    if(x == rec_prev_x && y == rec_prev_y)
+    {
+        rec_run++;
+        return;
+    }
+    recorder_flush_run();
+    recorder_put_varint(recorder_zigzag((int32_t) x - rec_prev_x) << 2 | RECORDER_TOKEN_MOVE);
+    recorder_put_varint(recorder_zigzag((int32_t) y - rec_prev_y));
+    rec_prev_x = x;
+    rec_prev_y = y;
+}
+
+void RAM_FUNC(recorder_event)(uint32_t t_us, uint8_t gpio, uint8_t type)
+{
+    if(!rec_stats.recording || rec_page == NULL || type == 0) return;
+    if(!recorder_fits(RECORDER_EVENT_MAX))
+    {
+        recorder_close_page();
+        recorder_open_page(rec_prev_t, rec_prev_x, rec_prev_y, RECORDER_FLAG_CONTINUED);
+    }
+    recorder_flush_run();
+    recorder_put_varint(((uint32_t) gpio << 2 | (uint32_t) (type - 1u)) << 2 | RECORDER_TOKEN_EVENT);
+    recorder_put_varint(recorder_zigzag((int32_t) (t_us - rec_prev_t)));
+    rec_stats.events++;
+}
+
+void recorder_start(void)
+{
+    if(rec_ready) rec_start_requested = true;
+}
+
+void recorder_stop(void)
+{
+    rec_start_requested = false;
+    if(rec_stats.recording) rec_stop_requested = true;
+}
+
+bool recorder_is_recording(void)
+{
+    return (rec_stats.recording && !rec_stop_requested) || rec_start_requested;
+}
+
+/**
+ * @brief Verifica se um cabeçalho lido da flash pertence a uma página válida.
+ */
+static bool recorder_header_valid(const recorder_page_header_t *header)
+{
+    return header->magic == RECORDER_MAGIC && header->version == RECORDER_VERSION &&
+           header->length <= RECORDER_PAYLOAD_SIZE;
+}
+
+/**
+ * @brief Indica se `len` bytes da região a partir de `offset` estão apagados.
+ */
+static bool recorder_is_blank(uint32_t offset, uint32_t len)
+{
+    const uint8_t *region = recorder_region();
+    for(uint32_t i = 0; i < len; i++)
+    {
+        if(region[offset + i] != 0xFF) return false;
+    }
+    return true;
+}
+
+bool recorder_init(uint32_t period_us)
+{
+#if PICO_ON_DEVICE
+    extern char __flash_binary_end;
+    if((uintptr_t) &__flash_binary_end > XIP_BASE + RECORDER_REGION_OFFSET) return false;
+#endif
+    rec_period_us = period_us;
+
+    const uint8_t *region = recorder_region();
+    bool found = false;
+    uint32_t newest_seq = 0, newest_offset = 0;
+    uint16_t newest_session = 0;
+    for(uint32_t offset = 0; offset < RECORDER_REGION_SIZE; offset += RECORDER_PAGE_SIZE)
+    {
+        recorder_page_header_t header;
+        memcpy(&header, region + offset, sizeof(header));
+        if(!recorder_header_valid(&header)) continue;
+        if(!found || (int32_t) (header.seq - newest_seq) > 0)
+        {
+            found = true;
+            newest_seq = header.seq;
+            newest_offset = offset;
+            newest_session = header.session;
+        }
+    }
+
+    rec_write_offset = found ? (newest_offset + RECORDER_PAGE_SIZE) % RECORDER_REGION_SIZE : 0;
+    rec_next_seq = found ? newest_seq + 1u : 0;
+    rec_stats.session = newest_session;
+
+    // O restante do segmento atual só é aproveitado se estiver de fato apagado
+    uint32_t segment_end = (rec_write_offset / RECORDER_SEGMENT_SIZE + 1u) * RECORDER_SEGMENT_SIZE;
+    rec_erased_ahead = segment_end - rec_write_offset;
+    if(!recorder_is_blank(rec_write_offset, rec_erased_ahead))
+    {
+        rec_write_offset = segment_end % RECORDER_REGION_SIZE;
+        rec_erased_ahead = 0;
+    }
+
+    // Os segmentos seguintes que continuam apagados (a reserva de antes do desligamento) também contam
+    while(rec_erased_ahead < RECORDER_ERASE_RESERVE &&
+          recorder_is_blank((rec_write_offset + rec_erased_ahead) % RECORDER_REGION_SIZE, RECORDER_SEGMENT_SIZE))
+    {
+        rec_erased_ahead += RECORDER_SEGMENT_SIZE;
+    }
+    rec_ready = true;
+    return true;
+}
+
+/**
+ * @brief CRC-16/CCITT (polinômio 0x1021, valor inicial 0xFFFF).
+ */
+static uint16_t recorder_crc16(const uint8_t *data, uint32_t len)
+{
+    uint16_t crc = 0xFFFFu;
+    for(uint32_t i = 0; i < len; i++)
+    {
+        crc ^= (uint16_t) (data[i] << 8);
+        for(uint bit = 0; bit < 8; bit++)
+            crc = (crc & 0x8000u) ? (uint16_t) (crc << 1 ^ 0x1021u) : (uint16_t) (crc << 1);
+    }
+    return crc;
+}
+
+static void recorder_do_erase(void *param)
+{
+    const recorder_flash_op_t *op = (const recorder_flash_op_t *) param;
+    flash_range_erase(RECORDER_REGION_OFFSET + op->offset, RECORDER_SEGMENT_SIZE);
+}
+
+static void recorder_do_program(void *param)
+{
+    const recorder_flash_op_t *op = (const recorder_flash_op_t *) param;
+    flash_range_program(RECORDER_REGION_OFFSET + op->offset, op->data, RECORDER_PAGE_SIZE);
+}
+
+/**
+ * @brief Executa uma operação na flash com o outro núcleo pausado e mede sua duração.
+ *
+ * @return `true` se a operação foi executada.
+ */
+static bool recorder_flash(void (*fn)(void *), recorder_flash_op_t *op, uint32_t *duration_max_us)
+{
+    EVENT_TRACE_SCOPE(EVENT_TRACE_FLASH, op->data == NULL);
+    uint32_t start_us = time_us_32();
+    int result = flash_safe_execute(fn, op, RECORDER_FLASH_TIMEOUT_MS);
+    uint32_t duration_us = time_us_32() - start_us;
+    if(result != PICO_OK)
+    {
+        rec_flash_failures++;
+        return false;
+    }
+    if(duration_us > *duration_max_us) *duration_max_us = duration_us;
+    return true;
+}
+
+/**
+ * @brief Apaga o segmento seguinte à área já apagada.
+ */
+static void recorder_erase_next(void)
+{
+    recorder_flash_op_t op = {(rec_write_offset + rec_erased_ahead) % RECORDER_REGION_SIZE, NULL};
+    if(!recorder_flash(recorder_do_erase, &op, &rec_erase_us_max)) return;
+    rec_erased_ahead += RECORDER_SEGMENT_SIZE;
+    rec_erased_segments++;
+}
+
+void recorder_service(void)
+{
+    if(!rec_ready) return;
+
+    if(rec_tail != rec_head)
+    {
+        if(rec_erased_ahead < RECORDER_PAGE_SIZE)
+        {
+            recorder_erase_next();
+            return;
+        }
+
+        __sync_synchronize();
+        uint8_t *page = rec_pages[rec_tail & (RECORDER_RAM_PAGES - 1u)];
+        uint16_t length;
+        memcpy(&length, page + offsetof(recorder_page_header_t, length), sizeof(length));
+        uint16_t crc = recorder_crc16(page + RECORDER_HEADER_SIZE, length);
+        memcpy(page + offsetof(recorder_page_header_t, crc), &crc, sizeof(crc));
+
+        recorder_flash_op_t op = {rec_write_offset, page};
+        if(!recorder_flash(recorder_do_program, &op, &rec_program_us_max)) return;
+        rec_write_offset = (rec_write_offset + RECORDER_PAGE_SIZE) % RECORDER_REGION_SIZE;
+        rec_erased_ahead -= RECORDER_PAGE_SIZE;
+        rec_committed_pages++;
+        __sync_synchronize();
+        rec_tail = rec_tail + 1u;
+        return;
+    }
+
+    // Sem páginas pendentes e fora da sessão: repõe a reserva, para a próxima sessão não pausar o núcleo 0
+    if(!recorder_is_recording() && rec_erased_ahead < RECORDER_ERASE_RESERVE) recorder_erase_next();
+}
+
+void recorder_get_stats(recorder_stats_t *stats)
+{
+    memcpy(stats, &rec_stats, sizeof(*stats));
+    stats->committed_pages = rec_committed_pages;
+    stats->erased_segments = rec_erased_segments;
+    stats->flash_failures = rec_flash_failures;
+    stats->program_us_max = rec_program_us_max;
+    stats->erase_us_max = rec_erase_us_max;
+    stats->write_offset = rec_write_offset;
+}
+
+void recorder_print_stats(void)
+{
+    recorder_stats_t s;
+    recorder_get_stats(&s);
+
+    printf("rec: %s sessao=%u amostras=%lu eventos=%lu paginas=%lu descartadas=%lu pendentes=%lu\n",
+           s.recording ? "gravando" : "parado", s.session, (unsigned long) s.samples, (unsigned long) s.events,
+           (unsigned long) s.pages, (unsigned long) s.dropped_pages, (unsigned long) (rec_head - rec_tail));
+    if(s.elapsed_us > 0 && s.samples > 0)
+    {
+        uint32_t bytes_per_s = (uint32_t) ((uint64_t) s.bytes * 1000000u / s.elapsed_us);
+        uint32_t raw_per_s = (uint32_t) ((uint64_t) s.samples * RECORDER_RAW_SAMPLE_BYTES * 1000000u / s.elapsed_us);
+        printf("rec: duracao=%lums bytes=%lu bytes/s=%lu (%lu.%02lu B/amostra; bruto %lu bytes/s, %lux menor)\n",
+               (unsigned long) (s.elapsed_us / 1000u), (unsigned long) s.bytes, (unsigned long) bytes_per_s,
+               (unsigned long) (s.bytes / s.samples), (unsigned long) ((uint64_t) s.bytes * 100u / s.samples % 100u),
+               (unsigned long) raw_per_s, (unsigned long) (bytes_per_s ? raw_per_s / bytes_per_s : 0u));
+    }
+    printf("rec: flash paginas=%lu segmentos_apagados=%lu falhas=%lu gravacao_max=%luus apagamento_max=%luus "
+           "posicao=%lu/%lu\n", (unsigned long) s.committed_pages, (unsigned long) s.erased_segments,
+           (unsigned long) s.flash_failures, (unsigned long) s.program_us_max, (unsigned long) s.erase_us_max,
+           (unsigned long) s.write_offset, (unsigned long) RECORDER_REGION_SIZE);
+}
+
+void recorder_dump(void)
+{
+    const uint8_t *region = recorder_region();
+    uint32_t start = rec_write_offset; // Página mais antiga do anel
+    uint32_t pages = 0;
+    for(uint32_t i = 0; i < RECORDER_REGION_SIZE; i += RECORDER_PAGE_SIZE)
+    {
+        recorder_page_header_t header;
+        memcpy(&header, region + (start + i) % RECORDER_REGION_SIZE, sizeof(header));
+        if(recorder_header_valid(&header)) pages++;
+    }
+
+    printf("# recorder offset=%lu pages=%lu\n", (unsigned long) RECORDER_REGION_OFFSET, (unsigned long) pages);
+    for(uint32_t i = 0; i < RECORDER_REGION_SIZE; i += RECORDER_PAGE_SIZE)
+    {
+        const uint8_t *page = region + (start + i) % RECORDER_REGION_SIZE;
+        recorder_page_header_t header;
+        memcpy(&header, page, sizeof(header));
+        if(!recorder_header_valid(&header)) continue;
+
+        static char line[2u + 2u * RECORDER_PAGE_SIZE + 1u]; // Fora da pilha do console
+        static const char hex[] = "0123456789abcdef";
+        line[0] = 'P';
+        line[1] = ' ';
+        for(uint32_t j = 0; j < RECORDER_PAGE_SIZE; j++)
+        {
+            line[2u + 2u * j] = hex[page[j] >> 4];
+            line[3u + 2u * j] = hex[page[j] & 0x0Fu];
+        }
+        line[sizeof(line) - 1u] = '\0';
+        puts(line);
+    }
+    printf("# fim\n");
+}
@@ -0,0 +1,213 @@
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+
+/**
+ * @file recorder.h
+ * @brief Gravador de sessões do joystick em flash, em log circular de segmentos.
+ *
+ * A interrupção de amostragem entrega cada amostra (x, y filtrados) e cada
+ * evento de botão ao codificador, que escreve em páginas de 256 bytes na RAM.
+ * Páginas fechadas entram em uma fila; o núcleo 1, entre quadros, grava uma
+ * página por vez na região reservada no fim da flash. A amostragem nunca
+ * espera pela flash: com a fila cheia, a página é descartada e contabilizada.
+ *
+ * Formato da página (little-endian):
+ *
+ *     0  u16 magic 0x524A    2  u8 versão        3  u8 flags
+ *     4  u32 seq global      8  u16 sessão      10  u16 bytes de conteúdo
+ *    12  u32 t0_us          16  u16 x0          18  u16 y0
+ *    20  u16 período (us)   22  u16 CRC-16/CCITT do conteúdo
+ *    24  conteúdo (até 232 bytes)
+ *
+ * O cabeçalho traz a primeira amostra da página em valor absoluto, de modo que
+ * cada página é decodificada sozinha. O conteúdo é uma sequência de varints
+ * (LEB128); os 2 bits menores de cada um definem o token:
+ *
+ *     RUN   (0): v>>2 amostras iguais à anterior, um período cada
+ *     MOVE  (1): v>>2 = zigzag(dx), seguido de zigzag(dy); um período
+ *     TIME  (2): a próxima amostra vem zigzag⁻¹(v>>2) + 1 períodos depois da anterior
+ *     EVENT (3): v>>2 = gpio << 2 | (tipo - 1), seguido de zigzag(t_evento - t_amostra) em us
+ *
+ * Os instantes das amostras são reconstruídos na grade do período a partir de
+ * t0 (o temporizador de amostragem não acumula deriva); o TIME só aparece
+ * quando uma amostra sai da grade por mais de meio período. Com a flag
+ * RECORDER_FLAG_CONTINUED, a amostra do cabeçalho repete a última da página
+ * anterior e não é uma nova amostra.
+ *
+ * A região é dividida em segmentos do tamanho do bloco de apagamento (4 KB).
+ * A escrita avança em anel, de modo que todos os segmentos são apagados o mesmo
+ * número de vezes; ao dar a volta, as sessões mais antigas são sobrescritas.
+ * Na partida, a região é percorrida para achar a página de maior `seq` e
+ * continuar dali. Fora das sessões, o núcleo 1 mantém uma reserva de
+ * RECORDER_ERASE_RESERVE bytes apagados à frente; durante a sessão, só apaga
+ * quando a reserva acaba, de modo que sessões menores que ela não apagam nada.
+ *
+ * Apagar e gravar a flash desligam o XIP: a operação roda no núcleo 1 por
+ * `flash_safe_execute`, que pausa o núcleo 0 (com as interrupções desligadas)
+ * durante a gravação de uma página (~0,5 ms) ou o apagamento de um segmento
+ * (dezenas de ms). A amostragem não para: o ADC e o DMA continuam capturando
+ * o joystick (joystick_capture_start), e a interrupção seguinte entrega as
+ * amostras do intervalo com os instantes das conversões, sem lacuna no registro.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Recorder Gravador em flash
+ * @brief Codificação delta/varint, log de segmentos e exportação.
+ * @{
+ */
+
+/** @brief Tamanho da região reservada no fim da flash. */
+#define RECORDER_REGION_SIZE (256u * 1024u)
+
+/** @brief Deslocamento da região a partir do início da flash. */
+#define RECORDER_REGION_OFFSET (PICO_FLASH_SIZE_BYTES - RECORDER_REGION_SIZE)
+
+/** @brief Página do log: unidade de gravação da flash. */
+#define RECORDER_PAGE_SIZE FLASH_PAGE_SIZE
+
+/** @brief Segmento do log: unidade de apagamento da flash. */
+#define RECORDER_SEGMENT_SIZE FLASH_SECTOR_SIZE
+
+/** @brief Páginas na fila entre a interrupção e o núcleo 1 (potência de dois). */
+#define RECORDER_RAM_PAGES 8
+
+/** @brief Bytes mantidos apagados à frente da escrita fora das sessões (16 segmentos). */
+#define RECORDER_ERASE_RESERVE (16u * RECORDER_SEGMENT_SIZE)
+
+/** @brief Tamanho do cabeçalho da página. */
+#define RECORDER_HEADER_SIZE 24
+
+/** @brief Identificação e versão do formato. */
+#define RECORDER_MAGIC 0x524Au
+#define RECORDER_VERSION 1u
+
+/** @brief Flags da página. */
+#define RECORDER_FLAG_SESSION_START 0x01u /**< Primeira página da sessão. */
+#define RECORDER_FLAG_CONTINUED     0x02u /**< A amostra do cabeçalho repete a anterior. */
+
+/** @brief Tempo máximo de uma página aberta: limita o que se perde ao desligar parado. */
+#define RECORDER_PAGE_MAX_AGE_US 10000000u
+
+/**
+ * @brief Cabeçalho da página, na ordem em que é gravado.
+ */
+typedef struct
+{
+    uint16_t magic;      /**< RECORDER_MAGIC. */
+    uint8_t version;     /**< RECORDER_VERSION. */
+    uint8_t flags;       /**< RECORDER_FLAG_*. */
+    uint32_t seq;        /**< Sequência global das páginas. */
+    uint16_t session;    /**< Sessão de gravação. */
+    uint16_t length;     /**< Bytes de conteúdo após o cabeçalho. */
+    uint32_t t0_us;      /**< Instante da primeira amostra. */
+    uint16_t x0;         /**< Eixo X da primeira amostra. */
+    uint16_t y0;         /**< Eixo Y da primeira amostra. */
+    uint16_t period_us;  /**< Período nominal de amostragem. */
+    uint16_t crc;        /**< CRC-16/CCITT do conteúdo. */
+} recorder_page_header_t;
+
+/**
+ * @brief Contadores do gravador.
+ */
+typedef struct
+{
+    bool recording;            /**< Sessão em andamento. */
+    uint16_t session;          /**< Sessão atual (ou a última). */
+    uint32_t samples;          /**< Amostras codificadas na sessão. */
+    uint32_t events;           /**< Eventos de botão codificados na sessão. */
+    uint32_t pages;            /**< Páginas fechadas na sessão. */
+    uint32_t bytes;            /**< Bytes fechados na sessão, com cabeçalhos. */
+    uint32_t dropped_pages;    /**< Páginas descartadas por fila cheia. */
+    uint32_t elapsed_us;       /**< Duração da sessão. */
+    uint32_t committed_pages;  /**< Páginas gravadas na flash desde a partida. */
+    uint32_t erased_segments;  /**< Segmentos apagados desde a partida. */
+    uint32_t flash_failures;   /**< Operações recusadas por `flash_safe_execute`. */
+    uint32_t program_us_max;   /**< Maior duração de uma gravação de página. */
+    uint32_t erase_us_max;     /**< Maior duração de um apagamento de segmento. */
+    uint32_t write_offset;     /**< Próxima página da região a ser gravada. */
+} recorder_stats_t;
+
+/**
+ * @brief Localiza o fim do log na flash. Chamar no núcleo 0, antes de iniciar o núcleo 1.
+ *
+ * @param[in] period_us Período nominal de amostragem.
+ * @return `false` se a região se sobrepõe ao programa.
+ */
+bool recorder_init(uint32_t period_us);
+
+/**
+ * @brief Inicia uma sessão; a primeira amostra seguinte abre a primeira página.
+ */
+void recorder_start(void);
+
+/**
+ * @brief Encerra a sessão; a página aberta é fechada pela próxima amostra.
+ */
+void recorder_stop(void);
+
+/**
+ * @brief Indica se há uma sessão em andamento, considerando os pedidos ainda não atendidos.
+ */
+bool recorder_is_recording(void);
+
+/**
+ * @brief Codifica uma amostra. Chamada pela interrupção de amostragem.
+ *
+ * @param[in] t_us Instante da leitura.
+ * @param[in] x Eixo X.
+ * @param[in] y Eixo Y.
+ */
+void recorder_sample(uint32_t t_us, uint16_t x, uint16_t y);
+
+/**
+ * @brief Codifica um evento de botão. Chamada no mesmo contexto de `recorder_sample`.
+ *
+ * @param[in] t_us Instante do evento.
+ * @param[in] gpio Pino.
+ * @param[in] type Tipo (1 a 4, `pb_event_type_t`).
+ */
+void recorder_event(uint32_t t_us, uint8_t gpio, uint8_t type);
+
+/**
+ * @brief Grava uma página pendente ou apaga o próximo segmento (uma operação por chamada).
+ *
+ * Chamada pelo núcleo 1, entre quadros. Durante a sessão, só apaga quando a
+ * reserva apagada acaba; fora dela, repõe a reserva.
+ */
+void recorder_service(void);
+
+/**
+ * @brief Copia os contadores.
+ */
+void recorder_get_stats(recorder_stats_t *stats);
+
+/**
+ * @brief Imprime os contadores, os bytes por segundo e a razão em relação às amostras brutas.
+ */
+void recorder_print_stats(void);
+
+/**
+ * @brief Imprime as páginas válidas da região, da mais antiga para a mais nova, em hexadecimal.
+ *
+ * Formato lido por tools/recorder_decode.py:
+ *
+ *     # recorder offset=<deslocamento> pages=<n>
+ *     P <256 bytes em hexadecimal>
+ *     # fim
+ */
+void recorder_dump(void);
+
+/** @} */ // Fim do grupo "Recorder"
+
+#endif // RECORDER_H
@@ -1,75 +1,212 @@
 #include "rgb.h"
 #include "hardware/pwm.h"
 
-/** 
- * @brief Calcula o valor de intensidade para o LED com base na porcentagem fornecida.
- * 
- * A função converte a intensidade fornecida, que é um valor entre 1 e 100, para um valor correspondente 
- * que será passado para o PWM. A intensidade mínima é 1, para evitar que o valor de intensidade seja zero 
- * (o que poderia desligar o LED).
+/**
+ * @brief Luminância relativa (0 a 1) de um nível perceptual, pela curva CIE L*.
  *
- * @param intensity Intensidade desejada do LED, variando de 1 a 100.
- * @return O valor de intensidade calculado para o LED, adequado para ser usado com PWM.
+ * O nível 0 a 65535 é tratado como a luminosidade L* (0 a 100); a inversa da
+ * curva CIE 1976 fornece a fração do período em que o LED deve ficar aceso.
+ *
+ * @param level Nível perceptual (0 a 65535).
+ * @return Fração do ciclo ativo correspondente.
  */
-static uint16_t calculate_led_intensity_value(uint8_t intensity)
+static float rgb_cie_luminance(uint16_t level)
 {
-    // Evita que a intensidade seja zero, o que desligaria o LED
-    intensity = (intensity == 0) ? 1 : intensity;
-    
-    // Define a intensidade máxima do LED (valor 0xFF00, um valor de 16 bits)
-    uint16_t MAX_LED_INTENSITY = 0xFFFF;
-    
-    // Retorna o valor de intensidade proporcional
-    return (uint16_t) ((MAX_LED_INTENSITY * intensity) / 100u);
+    float lightness = (level * 100.0f) / 65535.0f;
+    if(lightness <= 8.0f) return lightness / 903.3f;
+
+    float f = (lightness + 16.0f) / 116.0f;
+    return f * f * f;
+}
+
+/**
+ * @brief Converte um nível perceptual em nível de PWM para um período de `period` contagens.
+ *
+ * @param level Nível perceptual (0 a 255).
+ * @param period Contagens por período (`wrap + 1`); o nível 255 resulta em LED sempre aceso.
+ * @return Nível de comparação do PWM.
+ */
+static uint16_t rgb_level_for_period(uint8_t level, uint32_t period)
+{
+    uint32_t value = (uint32_t) (rgb_cie_luminance((uint16_t) (level * 257u)) * period + 0.5f);
+    return (uint16_t) ((value > period) ? period : value);
+}
+
+/**
+ * @brief Converte uma intensidade em porcentagem (0 a 100) em nível perceptual (0 a 255).
+ *
+ * @param intensity Intensidade, limitada a 100.
+ * @return Nível perceptual correspondente.
+ */
+static uint8_t rgb_percent_to_level(uint8_t intensity)
+{
+    if(intensity > 100) intensity = 100;
+    return (uint8_t) ((intensity * (RGB_LEVELS - 1) + 50u) / 100u);
 }
 
 /** 
  * @brief Inicializa os pinos GPIO para controlar os LEDs RGB com PWM.
  * 
  * A função configura os pinos GPIO fornecidos para usar a funcionalidade de PWM 
- * (Pulse Width Modulation) para controle da intensidade dos LEDs.
+ * (Pulse Width Modulation), guarda o slice e o canal de cada cor e calcula a
+ * tabela de correção perceptual para o `wrap` configurado.
  * 
  * @param pins Ponteiro para a estrutura contendo os pinos GPIO dos LEDs.
  */
 void rgb_init_all(rgb_t *rgb, uint8_t red, uint8_t green, uint8_t blue, float clkdiv, uint16_t wrap)
 {
-    uint slice_r, slice_g, slice_b;
-    
-    // Configura os pinos dos LEDs como pinos PWM
-    gpio_set_function(red, GPIO_FUNC_PWM);
-    gpio_set_function(green, GPIO_FUNC_PWM);
-    gpio_set_function(blue, GPIO_FUNC_PWM);
-
-    // Obtém o número do "slice" para cada pino
-    slice_r = pwm_gpio_to_slice_num(red);
-    slice_g = pwm_gpio_to_slice_num(green);
-    slice_b = pwm_gpio_to_slice_num(blue);
-
-    pwm_set_clkdiv(slice_r, clkdiv);
-    pwm_set_clkdiv(slice_g, clkdiv);
-    pwm_set_clkdiv(slice_b, clkdiv);
-    
-    pwm_set_wrap(slice_r, wrap);
-    pwm_set_wrap(slice_g, wrap);
-    pwm_set_wrap(slice_b, wrap);
-
-    pwm_set_gpio_level(red, 0);
-    pwm_set_gpio_level(green, 0);
-    pwm_set_gpio_level(blue, 0);
-
-    pwm_set_enabled(slice_r, true);
-    pwm_set_enabled(slice_g, true);
-    pwm_set_enabled(slice_b, true);
+    const uint8_t pins[RGB_CHANNELS] = {red, green, blue};
+
+    for(uint i = 0; i < RGB_CHANNELS; i++)
+    {
+        // Configura o pino como PWM e guarda o slice/canal da cor
+        gpio_set_function(pins[i], GPIO_FUNC_PWM);
+        rgb->slice[i] = (uint8_t) pwm_gpio_to_slice_num(pins[i]);
+        rgb->channel[i] = (uint8_t) pwm_gpio_to_channel(pins[i]);
+
+        pwm_set_clkdiv(rgb->slice[i], clkdiv);
+        pwm_set_wrap(rgb->slice[i], wrap);
+        pwm_set_gpio_level(pins[i], 0);
+    }
+
+    // Habilita depois de configurar todos, pois dois pinos podem compartilhar o slice
+    for(uint i = 0; i < RGB_CHANNELS; i++)
+    {
+        pwm_set_enabled(rgb->slice[i], true);
+    }
 
     rgb->red = red;
     rgb->green = green;
     rgb->blue = blue;
+    rgb->wrap = wrap;
+
+    for(uint i = 0; i < RGB_LEVELS; i++)
+    {
+        rgb->gamma[i] = rgb_level_for_period((uint8_t) i, (uint32_t) wrap + 1u);
+    }
+}
+
+void rgb_color_to_levels(const rgb_t *rgb, rgb_color_t color, uint16_t levels[RGB_CHANNELS])
+{
+    levels[RED] = rgb->gamma[color.red];
+    levels[GREEN] = rgb->gamma[color.green];
+    levels[BLUE] = rgb->gamma[color.blue];
+}
+
+/**
+ * @brief Escreve os níveis dos canais selecionados, agrupados por slice.
+ *
+ * Para cada slice envolvido, os canais A e B são combinados em um único valor
+ * e escritos no registrador CC com uma só escrita (pelo alias atômico do
+ * registrador), preservando o canal que não pertence ao LED. Como o CC é
+ * carregado pelo contador apenas no fim do período, a cor muda por inteiro
+ * no próximo período.
+ *
+ * @param rgb Estrutura do LED RGB.
+ * @param levels Níveis de PWM, na ordem R, G, B.
+ * @param mask Canais a atualizar (bit 0 = vermelho, 1 = verde, 2 = azul).
+ */
+static void rgb_write_levels(const rgb_t *rgb, const uint16_t levels[RGB_CHANNELS], uint8_t mask)
+{
+    for(uint i = 0; i < RGB_CHANNELS; i++)
+    {
+        if(!(mask & (1u << i))) continue;
+
+        uint slice = rgb->slice[i];
+        uint32_t value = 0;
+        uint32_t bits = 0;
+
+        // Reúne todos os canais pendentes que pertencem ao mesmo slice
+        for(uint j = i; j < RGB_CHANNELS; j++)
+        {
+            if(!(mask & (1u << j)) || rgb->slice[j] != slice) continue;
+
+            uint32_t shift = rgb->channel[j] ? PWM_CH0_CC_B_LSB : PWM_CH0_CC_A_LSB;
+            value |= (uint32_t) levels[j] << shift;
+            bits |= 0xFFFFu << shift;
+            mask &= (uint8_t) ~(1u << j);
+        }
+
+        hw_write_masked(&pwm_hw->slice[slice].cc, value, bits);
+    }
+}
+
+void rgb_set_color(const rgb_t *rgb, rgb_color_t color)
+{
+    rgb_set_color_masked(rgb, color, RGB_MASK_ALL);
+}
+
+void rgb_set_color_masked(const rgb_t *rgb, rgb_color_t color, uint8_t mask)
+{
+    uint16_t levels[RGB_CHANNELS];
+    rgb_color_to_levels(rgb, color, levels);
+    rgb_write_levels(rgb, levels, mask & RGB_MASK_ALL);
+}
+
+rgb_color_t rgb_hsv_to_color(uint16_t hue, uint8_t saturation, uint8_t value)
+{
+    rgb_color_t color = {value, value, value};
+    if(saturation == 0) return color;
+
+    hue %= 360;
+    uint32_t sector = hue / 60u;
+    uint32_t fraction = ((hue % 60u) * 255u) / 60u;
+
+    uint8_t p = (uint8_t) ((value * (255u - saturation)) / 255u);
+    uint8_t q = (uint8_t) ((value * (255u - (saturation * fraction) / 255u)) / 255u);
+    uint8_t t = (uint8_t) ((value * (255u - (saturation * (255u - fraction)) / 255u)) / 255u);
+
+    switch(sector)
+    {
+        case 0:  color = (rgb_color_t) {value, t, p}; break;
+        case 1:  color = (rgb_color_t) {q, value, p}; break;
+        case 2:  color = (rgb_color_t) {p, value, t}; break;
+        case 3:  color = (rgb_color_t) {p, q, value}; break;
+        case 4:  color = (rgb_color_t) {t, p, value}; break;
+        default: color = (rgb_color_t) {value, p, q}; break;
+    }
+    return color;
+}
+
+void rgb_set_hsv(const rgb_t *rgb, uint16_t hue, uint8_t saturation, uint8_t value)
+{
+    rgb_set_color(rgb, rgb_hsv_to_color(hue, saturation, value));
+}
+
+/**
+ * @brief Define o nível de um único canal, sem alterar os demais.
+ *
+ * @param rgb Estrutura do LED RGB.
+ * @param color Índice da cor (RED, GREEN ou BLUE).
+ * @param level Nível perceptual (0 a 255).
+ */
+static void rgb_set_channel(const rgb_t *rgb, uint color, uint8_t level)
+{
+    uint16_t levels[RGB_CHANNELS] = {0, 0, 0};
+    levels[color] = rgb->gamma[level];
+    rgb_write_levels(rgb, levels, (uint8_t) (1u << color));
+}
+
+rgb_color_t rgb_color_from16(rgb_color16_t color)
+{
+    return (rgb_color_t) {
+        (uint8_t) ((color.red + 128u) / 257u),
+        (uint8_t) ((color.green + 128u) / 257u),
+        (uint8_t) ((color.blue + 128u) / 257u)
+    };
+}
+
+uint32_t rgb_duty_fixed(uint16_t level, uint32_t period, uint8_t frac_bits)
+{
+    uint32_t full = period << frac_bits;
+    uint32_t value = (uint32_t) (rgb_cie_luminance(level) * (float) full + 0.5f);
+    return (value > full) ? full : value;
 }
 
 /** 
  * @brief Acende o LED vermelho com a intensidade especificada.
  * 
- * A intensidade é convertida para um valor PWM adequado e então o LED vermelho é aceso 
+ * A intensidade é convertida pela tabela de correção e então o LED vermelho é aceso 
  * na intensidade desejada.
  * 
  * @param pins Ponteiro para a estrutura contendo os pinos GPIO dos LEDs.
@@ -77,8 +214,7 @@ void rgb_init_all(rgb_t *rgb, uint8_t red, uint8_t green, uint8_t blue, float cl
  */
 void rgb_turn_on_red(const rgb_t *pins, uint8_t intensity)
 {
-    //uint16_t led_intensity = calculate_led_intensity_value(intensity); // Calcula a intensidade do LED
-    pwm_set_gpio_level(pins->red, intensity); // Acende o LED vermelho com a intensidade calculada
+    rgb_set_channel(pins, RED, rgb_percent_to_level(intensity));
 }
 
 /** 
@@ -90,13 +226,13 @@ void rgb_turn_on_red(const rgb_t *pins, uint8_t intensity)
  */
 void rgb_turn_off_red(const rgb_t *pins)
 {
-    pwm_set_gpio_level(pins->red, 0); // Desliga o LED vermelho
+    rgb_set_channel(pins, RED, 0); // Desliga o LED vermelho
 }
 
 /** 
  * @brief Acende o LED verde com a intensidade especificada.
  * 
- * A intensidade é convertida para um valor PWM adequado e então o LED verde é aceso 
+ * A intensidade é convertida pela tabela de correção e então o LED verde é aceso 
  * na intensidade desejada.
  * 
  * @param pins Ponteiro para a estrutura contendo os pinos GPIO dos LEDs.
@@ -104,8 +240,7 @@ void rgb_turn_off_red(const rgb_t *pins)
  */
 void rgb_turn_on_green(const rgb_t *pins, uint8_t intensity)
 {
-    //uint16_t led_intensity = calculate_led_intensity_value(intensity); // Calcula a intensidade do LED
-    pwm_set_gpio_level(pins->green, intensity); // Acende o LED verde com a intensidade calculada
+    rgb_set_channel(pins, GREEN, rgb_percent_to_level(intensity));
 }
 
 /** 
@@ -117,13 +252,13 @@ void rgb_turn_on_green(const rgb_t *pins, uint8_t intensity)
  */
 void rgb_turn_off_green(const rgb_t *pins)
 {
-    pwm_set_gpio_level(pins->green, 0); // Desliga o LED verde
+    rgb_set_channel(pins, GREEN, 0); // Desliga o LED verde
 }
 
 /** 
  * @brief Acende o LED azul com a intensidade especificada.
  * 
- * A intensidade é convertida para um valor PWM adequado e então o LED azul é aceso 
+ * A intensidade é convertida pela tabela de correção e então o LED azul é aceso 
  * na intensidade desejada.
  * 
  * @param pins Ponteiro para a estrutura contendo os pinos GPIO dos LEDs.
@@ -131,8 +266,7 @@ void rgb_turn_off_green(const rgb_t *pins)
  */
 void rgb_turn_on_blue(const rgb_t *pins, uint8_t intensity)
 {
-    //uint16_t led_intensity = calculate_led_intensity_value(intensity); // Calcula a intensidade do LED
-    pwm_set_gpio_level(pins->blue, intensity); // Acende o LED azul
+    rgb_set_channel(pins, BLUE, rgb_percent_to_level(intensity));
 }
 
 /** 
@@ -144,23 +278,20 @@ void rgb_turn_on_blue(const rgb_t *pins, uint8_t intensity)
  */
 void rgb_turn_off_blue(const rgb_t *pins)
 {
-    pwm_set_gpio_level(pins->blue, 0); // Desliga o LED azul
+    rgb_set_channel(pins, BLUE, 0); // Desliga o LED azul
 }
 
 /** 
  * @brief Acende o LED branco (combinando as 3 cores RGB) com a intensidade especificada.
  * 
- * A intensidade para o LED branco é calculada como a média de 1/3 da intensidade
- * de cada cor (R, G e B). O LED branco é composto por uma combinação igual das 3 cores RGB.
+ * As três cores recebem o mesmo nível perceptual e são atualizadas juntas.
  * 
  * @param pins Ponteiro para a estrutura contendo os pinos GPIO dos LEDs.
  * @param intensity Intensidade do LED branco, variando de 0 a 100.
  */
 void rgb_turn_on_white(const rgb_t *pins, uint8_t intensity) {
-    uint16_t led_intensity = calculate_led_intensity_value(intensity / 3u); // Calcula a intensidade para branco
-    pwm_set_gpio_level(pins->red, led_intensity);   // Acende o LED vermelho para o branco
-    pwm_set_gpio_level(pins->green, led_intensity); // Acende o LED verde para o branco
-    pwm_set_gpio_level(pins->blue, led_intensity);  // Acende o LED azul para o branco
+    uint8_t level = rgb_percent_to_level(intensity);
+    rgb_set_color(pins, (rgb_color_t) {level, level, level});
 }
 
 /** 
@@ -171,9 +302,7 @@ void rgb_turn_on_white(const rgb_t *pins, uint8_t intensity) {
  * @param pins Ponteiro para a estrutura contendo os pinos GPIO dos LEDs.
  */
 void rgb_turn_off_white(const rgb_t *pins) {
-    pwm_set_gpio_level(pins->red, 0);   // Desliga o LED vermelho
-    pwm_set_gpio_level(pins->green, 0); // Desliga o LED verde
-    pwm_set_gpio_level(pins->blue, 0);  // Desliga o LED azul
+    rgb_set_color(pins, (rgb_color_t) {0, 0, 0});
 }
 
 void turn_off_led_by_gpio(uint8_t pin)
@@ -183,6 +312,7 @@ void turn_off_led_by_gpio(uint8_t pin)
 
 void rgb_turn_on_by_gpio(uint8_t pin, uint8_t intensity)
 {
-    uint16_t led_intensity = calculate_led_intensity_value(intensity);
-    pwm_set_gpio_level(pin, led_intensity);
-}
\ No newline at end of file
+    // Sem a estrutura rgb_t, o período é lido do próprio slice
+    uint32_t period = pwm_hw->slice[pwm_gpio_to_slice_num(pin)].top + 1u;
+    pwm_set_gpio_level(pin, rgb_level_for_period(rgb_percent_to_level(intensity), period));
+}
@@ -11,41 +11,168 @@
 
 #include "pico/stdlib.h"
 
-/** 
+/**
  * @file rgb.h
  * @brief Este arquivo contém declarações de funções e definições relacionadas a um
  *        LED RGB conectado aos pinos GPIO.
- * 
- * @note A intensidade dos LEDs é dada em porcentagem, variando de 0 a 100, onde
- *       0 significa que o LED estará apagado, e 100 representa a intensidade máxima.
- *       A função `rgb_turn_on_*` pode ser utilizada para controlar a intensidade 
- *       de cada cor individualmente, enquanto as funções `rgb_turn_off_*` 
- *       desligam as cores correspondentes.
+ *
+ * @note As cores são informadas em uma escala perceptual de 0 a 255 por canal
+ *       (`rgb_set_color`, `rgb_set_hsv`): o valor é convertido para o nível de
+ *       PWM por uma tabela de correção (CIE L*) dimensionada para o `wrap`
+ *       configurado, de modo que passos iguais produzem variações de brilho
+ *       aparentemente iguais. As funções `rgb_turn_on_*` mantêm a intensidade
+ *       em porcentagem (0 a 100), convertida pela mesma tabela.
+ *
+ * @note Canais que compartilham um slice de PWM (no BitDogLab, vermelho no GPIO 13
+ *       e azul no GPIO 12 pertencem ao slice 6) são atualizados com uma única
+ *       escrita no registrador de comparação, para que a cor nunca fique
+ *       dividida entre dois períodos.
  *
  * @author Carlos Valadao
  * @date 17/01/2025
  */
 
+/** @brief Quantidade de entradas da tabela de correção (uma por nível perceptual). */
+#define RGB_LEVELS 256
+
+/** @brief Quantidade de canais (vermelho, verde e azul). */
+#define RGB_CHANNELS 3
+
+/** @brief Máscaras de canais para `rgb_set_color_masked`. */
+#define RGB_MASK_RED   (1u << RED)
+#define RGB_MASK_GREEN (1u << GREEN)
+#define RGB_MASK_BLUE  (1u << BLUE)
+#define RGB_MASK_ALL   (RGB_MASK_RED | RGB_MASK_GREEN | RGB_MASK_BLUE)
+
+/**
+ * @brief Cor em escala perceptual, 0 a 255 por canal.
+ */
+typedef struct
+{
+    uint8_t red;   /**< Vermelho */
+    uint8_t green; /**< Verde */
+    uint8_t blue;  /**< Azul */
+} rgb_color_t;
+
+/**
+ * @brief Cor em escala perceptual de alta resolução, 0 a 65535 por canal.
+ *
+ * Usada pelo modo com dithering (rgb_dither.h), que aproveita a resolução extra.
+ */
+typedef struct
+{
+    uint16_t red;   /**< Vermelho */
+    uint16_t green; /**< Verde */
+    uint16_t blue;  /**< Azul */
+} rgb_color16_t;
 
 typedef struct
 {
     uint red;    /**< Pino do LED vermelho */
     uint green;  /**< Pino do LED verde */
     uint blue;   /**< Pino do LED azul */
+    uint16_t wrap;                  /**< Valor de wrap dos slices de PWM */
+    uint8_t slice[RGB_CHANNELS];    /**< Slice de PWM de cada canal (R, G, B) */
+    uint8_t channel[RGB_CHANNELS];  /**< Canal do slice (0 = A, 1 = B) de cada cor */
+    uint16_t gamma[RGB_LEVELS];     /**< Nível de PWM para cada nível perceptual */
 } rgb_t;
 
 
 /**
  * @brief Inicializa os pinos do LED RGB com base nas configurações passadas.
- * 
- * @param pins Estrutura contendo os pinos dos LEDs RGB.
+ *
+ * Além de configurar os slices de PWM, calcula a tabela de correção perceptual
+ * para o `wrap` informado (o nível 255 corresponde a `wrap + 1`, LED sempre aceso).
+ *
+ * @param rgb Estrutura que receberá os pinos, slices e a tabela de correção.
+ * @param red Pino do LED vermelho.
+ * @param green Pino do LED verde.
+ * @param blue Pino do LED azul.
+ * @param clkdiv Divisor de clock dos slices.
+ * @param wrap Valor máximo do contador do PWM.
  */
 void rgb_init_all(rgb_t *rgb, uint8_t red, uint8_t green, uint8_t blue, float clkdiv, uint16_t wrap);
 
 
+/**
+ * @brief Define a cor do LED, em escala perceptual.
+ *
+ * Cada slice de PWM envolvido é atualizado com uma única escrita.
+ *
+ * @param rgb Estrutura do LED RGB.
+ * @param color Cor desejada (0 a 255 por canal).
+ */
+void rgb_set_color(const rgb_t *rgb, rgb_color_t color);
+
+
+/**
+ * @brief Define a cor apenas dos canais selecionados, sem alterar os demais.
+ *
+ * Útil quando parte dos canais está sob controle de outro módulo (por exemplo,
+ * um sequenciador por DMA, ver led_seq.h).
+ *
+ * @param rgb Estrutura do LED RGB.
+ * @param color Cor desejada (0 a 255 por canal).
+ * @param mask Canais a atualizar (RGB_MASK_*).
+ */
+void rgb_set_color_masked(const rgb_t *rgb, rgb_color_t color, uint8_t mask);
+
+
+/**
+ * @brief Define a cor do LED a partir de matiz, saturação e valor.
+ *
+ * @param rgb Estrutura do LED RGB.
+ * @param hue Matiz, em graus (0 a 359).
+ * @param saturation Saturação (0 a 255).
+ * @param value Valor/brilho perceptual (0 a 255).
+ */
+void rgb_set_hsv(const rgb_t *rgb, uint16_t hue, uint8_t saturation, uint8_t value);
+
+
+/**
+ * @brief Converte matiz, saturação e valor em uma cor RGB perceptual.
+ *
+ * @param hue Matiz, em graus (0 a 359).
+ * @param saturation Saturação (0 a 255).
+ * @param value Valor (0 a 255).
+ * @return Cor correspondente.
+ */
+rgb_color_t rgb_hsv_to_color(uint16_t hue, uint8_t saturation, uint8_t value);
+
+
+/**
+ * @brief Converte uma cor perceptual nos níveis de PWM de cada canal.
+ *
+ * @param rgb Estrutura do LED RGB (tabela de correção).
+ * @param color Cor desejada.
+ * @param levels Níveis de PWM resultantes, na ordem R, G, B.
+ */
+void rgb_color_to_levels(const rgb_t *rgb, rgb_color_t color, uint16_t levels[RGB_CHANNELS]);
+
+
+/**
+ * @brief Reduz uma cor de alta resolução para a escala de 0 a 255.
+ *
+ * @param color Cor de 0 a 65535 por canal.
+ * @return Cor de 0 a 255 por canal (arredondada).
+ */
+rgb_color_t rgb_color_from16(rgb_color16_t color);
+
+
+/**
+ * @brief Calcula o ciclo ativo de um nível perceptual de alta resolução, com bits fracionários.
+ *
+ * @param level Nível perceptual (0 a 65535).
+ * @param period Contagens por período do PWM (`wrap + 1`).
+ * @param frac_bits Bits fracionários do resultado.
+ * @return Contagens de ciclo ativo, em ponto fixo com `frac_bits` bits fracionários.
+ */
+uint32_t rgb_duty_fixed(uint16_t level, uint32_t period, uint8_t frac_bits);
+
+
 /**
  * @brief Acende o LED vermelho com a intensidade especificada.
- * 
+ *
  * @param pins Estrutura contendo os pinos dos LEDs RGB.
  * @param intensity Intensidade do LED vermelho, variando de 0 a 100.
  */
@@ -54,7 +181,7 @@ void rgb_turn_on_red(const rgb_t *pins, uint8_t intensity);
 
 /**
  * @brief Desliga o LED vermelho.
- * 
+ *
  * @param pins Estrutura contendo os pinos dos LEDs RGB.
  */
 void rgb_turn_off_red(const rgb_t *pins);
@@ -62,7 +189,7 @@ void rgb_turn_off_red(const rgb_t *pins);
 
 /**
  * @brief Acende o LED verde com a intensidade especificada.
- * 
+ *
  * @param pins Estrutura contendo os pinos dos LEDs RGB.
  * @param intensity Intensidade do LED verde, variando de 0 a 100.
  */
@@ -71,7 +198,7 @@ void rgb_turn_on_green(const rgb_t *pins, uint8_t intensity);
 
 /**
  * @brief Desliga o LED verde.
- * 
+ *
  * @param pins Estrutura contendo os pinos dos LEDs RGB.
  */
 void rgb_turn_off_green(const rgb_t *pins);
@@ -79,7 +206,7 @@ void rgb_turn_off_green(const rgb_t *pins);
 
 /**
  * @brief Acende o LED azul com a intensidade especificada.
- * 
+ *
  * @param pins Estrutura contendo os pinos dos LEDs RGB.
  * @param intensity Intensidade do LED azul, variando de 0 a 100.
  */
@@ -88,7 +215,7 @@ void rgb_turn_on_blue(const rgb_t *pins, uint8_t intensity);
 
 /**
  * @brief Desliga o LED azul.
- * 
+ *
  * @param pins Estrutura contendo os pinos dos LEDs RGB.
  */
 void rgb_turn_off_blue(const rgb_t *pins);
@@ -96,7 +223,7 @@ void rgb_turn_off_blue(const rgb_t *pins);
 
 /**
  * @brief Acende o LED branco com a intensidade especificada.
- * 
+ *
  * @param pins Estrutura contendo os pinos dos LEDs RGB.
  * @param intensity Intensidade do LED branco, variando de 0 a 100.
  */
@@ -105,13 +232,22 @@ void rgb_turn_on_white(const rgb_t *pins, uint8_t intensity);
 
 /**
  * @brief Desliga o LED branco.
- * 
+ *
  * @param pins Estrutura contendo os pinos dos LEDs RGB.
  */
 void rgb_turn_off_white(const rgb_t *pins);
 
 void turn_off_led_by_gpio(uint8_t pin);
 
+/**
+ * @brief Acende um LED qualquer, pelo pino, com intensidade de 0 a 100.
+ *
+ * A intensidade é convertida com a mesma curva perceptual e escalada para o
+ * `wrap` atual do slice do pino.
+ *
+ * @param pin Pino do LED (já configurado como PWM).
+ * @param intensity Intensidade, variando de 0 a 100.
+ */
 void rgb_turn_on_by_gpio(uint8_t pin, uint8_t intensity);
 
 #endif // RGB_H
@@ -0,0 +1,131 @@
+#include "rgb_dither.h"
+#include <stdio.h>
+#include <math.h>
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+
+/**
+ * @file rgb_dither.c
+ * @brief Implementação do modo com dithering sigma-delta do LED RGB.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+bool rgb_dither_init(rgb_dither_t *dither, const rgb_t *rgb)
+{
+    dither->rgb = rgb;
+    dither->slice_count = 0;
+    dither->updates = 0;
+    dither->update_us_total = 0;
+    dither->update_us_max = 0;
+
+    // Agrupa os canais do LED por slice (vermelho e azul dividem o slice 6 no BitDogLab)
+    for(uint i = 0; i < RGB_CHANNELS; i++)
+    {
+        rgb_dither_slice_t *slice = NULL;
+        for(uint j = 0; j < dither->slice_count; j++)
+        {
+            if(dither->slices[j].seq.slice == rgb->slice[i]) slice = &dither->slices[j];
+        }
+
+        if(slice == NULL)
+        {
+            slice = &dither->slices[dither->slice_count++];
+            slice->mask = 0;
+            slice->current = 0;
+            slice->running = false;
+            led_wave_init(&slice->wave[0], slice->storage[0], RGB_DITHER_PERIODS, rgb->gamma);
+            led_wave_init(&slice->wave[1], slice->storage[1], RGB_DITHER_PERIODS, rgb->gamma);
+
+            // O próprio slice é o marcapasso: uma palavra do padrão por período do PWM
+            if(!led_seq_init(&slice->seq, rgb->slice[i], rgb->slice[i]))
+            {
+                // led_seq_init já devolveu os canais do slice que falhou; os anteriores são devolvidos aqui
+                for(uint j = 0; j + 1u < dither->slice_count; j++)
+                {
+                    dma_channel_unclaim(dither->slices[j].seq.data_chan);
+                    dma_channel_unclaim(dither->slices[j].seq.ctrl_chan);
+                }
+                dither->slice_count = 0;
+                return false;
+            }
+        }
+        slice->mask |= (uint8_t) (1u << i);
+    }
+    return true;
+}
+
+void rgb_dither_apply(rgb_dither_t *dither, rgb_color16_t color, uint8_t mask)
+{
+    const rgb_t *rgb = dither->rgb;
+    const uint16_t levels[RGB_CHANNELS] = {color.red, color.green, color.blue};
+    uint32_t period = (uint32_t) rgb->wrap + 1u;
+    uint32_t start_us = time_us_32();
+
+    for(uint i = 0; i < dither->slice_count; i++)
+    {
+        rgb_dither_slice_t *slice = &dither->slices[i];
+        if(!(slice->mask & mask)) continue;
+
+        uint32_t duty[2] = {0, 0};
+        for(uint c = 0; c < RGB_CHANNELS; c++)
+        {
+            if(slice->mask & (1u << c)) duty[rgb->channel[c]] = rgb_duty_fixed(levels[c], period, RGB_DITHER_BITS);
+        }
+
+        // Escreve no padrão livre e o entrega ao DMA, que o adota no fim do ciclo atual
+        uint8_t next = slice->current ^ 1u;
+        led_wave_clear(&slice->wave[next]);
+        led_wave_dither(&slice->wave[next], duty[0], duty[1], RGB_DITHER_BITS);
+
+        if(slice->running)
+        {
+            led_seq_set_loop(&slice->seq, &slice->wave[next]);
+        }
+        else
+        {
+            led_seq_play(&slice->seq, NULL, &slice->wave[next]);
+            slice->running = true;
+        }
+        slice->current = next;
+    }
+
+    uint32_t elapsed_us = time_us_32() - start_us;
+    dither->updates++;
+    dither->update_us_total += elapsed_us;
+    if(elapsed_us > dither->update_us_max) dither->update_us_max = elapsed_us;
+}
+
+void rgb_dither_release(rgb_dither_t *dither, uint8_t mask)
+{
+    for(uint i = 0; i < dither->slice_count; i++)
+    {
+        rgb_dither_slice_t *slice = &dither->slices[i];
+        if(!(slice->mask & mask) || !slice->running) continue;
+
+        led_seq_stop(&slice->seq);
+        slice->running = false;
+    }
+}
+
+void rgb_dither_print_stats(const rgb_dither_t *dither)
+{
+    uint32_t period = (uint32_t) dither->rgb->wrap + 1u;
+    uint32_t steps = period << RGB_DITHER_BITS;
+
+    // Divisor do PWM em ponto fixo 8.4; uma transferência de DMA por período e por slice
+    uint32_t div = pwm_hw->slice[dither->rgb->slice[RED]].div;
+    uint32_t pwm_hz = (uint32_t) (((uint64_t) clock_get_hz(clk_sys) * 16u) / ((uint64_t) div * period));
+    uint32_t mean_us = dither->updates ? dither->update_us_total / dither->updates : 0;
+
+    printf("dither: %lu x %u niveis (%.1f bits), pwm=%luHz padrao=%luHz dma=%lu palavras/s\n",
+           (unsigned long) period, RGB_DITHER_PERIODS, log2f((float) steps), (unsigned long) pwm_hz,
+           (unsigned long) (pwm_hz / RGB_DITHER_PERIODS), (unsigned long) (pwm_hz * dither->slice_count));
+    printf("dither: recalculos=%lu medio=%luus max=%luus\n", (unsigned long) dither->updates,
+           (unsigned long) mean_us, (unsigned long) dither->update_us_max);
+}
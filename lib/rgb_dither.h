@@ -0,0 +1,117 @@
+#ifndef RGB_DITHER_H
+#define RGB_DITHER_H
+
+#include "pico/stdlib.h"
+#include "rgb.h"
+#include "led_wave.h"
+#include "led_seq.h"
+
+/**
+ * @file rgb_dither.h
+ * @brief Modo opcional de PWM com dithering sigma-delta para o LED RGB.
+ *
+ * Com wrap 2048, cada período do PWM tem 2049 contagens (~11 bits), e os níveis
+ * mais baixos das rampas avançam em degraus visíveis. Neste modo, o valor de
+ * comparação muda a cada período segundo um padrão de RGB_DITHER_PERIODS
+ * períodos, cuja média tem RGB_DITHER_BITS bits fracionários: 2049 × 32
+ * posições, ou seja, 16 bits efetivos, sem reduzir a frequência do PWM (o
+ * padrão se repete a ~1,9 kHz com clkdiv 1,0).
+ *
+ * O padrão de cada slice é copiado para o registrador CC por um sequenciador
+ * por DMA (led_seq.h) marcado pelo wrap do próprio slice: uma palavra por
+ * período, sem interrupções. A CPU só recalcula o padrão (32 palavras) quando
+ * a cor muda; o tempo gasto nisso é medido e informado por
+ * `rgb_dither_print_stats`. Cada slice tem dois padrões: o novo é escrito no
+ * que não está em uso e trocado no fim do ciclo atual.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup RGB_Dither Dithering do LED RGB
+ * @brief Resolução efetiva de 16 bits por modulação do valor de comparação.
+ * @{
+ */
+
+/** @brief Bits fracionários obtidos pelo dithering. */
+#define RGB_DITHER_BITS 5
+
+/** @brief Períodos do PWM em um padrão de dithering. */
+#define RGB_DITHER_PERIODS (1u << RGB_DITHER_BITS)
+
+/**
+ * @brief Dithering de um slice de PWM.
+ */
+typedef struct
+{
+    led_seq_t seq;                                     /**< Sequenciador marcado pelo wrap do slice. */
+    led_wave_t wave[2];                                /**< Padrões (em uso e próximo). */
+    uint32_t storage[2][RGB_DITHER_PERIODS];           /**< Palavras dos padrões. */
+    uint8_t current;                                   /**< Padrão em uso. */
+    uint8_t mask;                                      /**< Canais do LED neste slice (RGB_MASK_*). */
+    bool running;                                      /**< Se o DMA está escrevendo no slice. */
+} rgb_dither_slice_t;
+
+/**
+ * @brief Estado do modo com dithering.
+ */
+typedef struct
+{
+    const rgb_t *rgb;                          /**< LED controlado. */
+    rgb_dither_slice_t slices[RGB_CHANNELS];   /**< Um por slice distinto do LED. */
+    uint8_t slice_count;                       /**< Slices em uso. */
+    uint32_t updates;                          /**< Padrões recalculados. */
+    uint32_t update_us_total;                  /**< Tempo total gasto nos recálculos. */
+    uint32_t update_us_max;                    /**< Maior tempo de um recálculo. */
+} rgb_dither_t;
+
+/**
+ * @brief Prepara o dithering, reservando dois canais de DMA por slice do LED.
+ *
+ * O LED só passa a ser controlado na primeira chamada a `rgb_dither_apply`.
+ *
+ * @param[out] dither Estado do dithering.
+ * @param[in] rgb LED já inicializado com `rgb_init_all`.
+ * @return `true` se todos os canais de DMA foram reservados; senão, nenhum fica reservado.
+ */
+bool rgb_dither_init(rgb_dither_t *dither, const rgb_t *rgb);
+
+/**
+ * @brief Aplica uma cor de alta resolução aos slices dos canais selecionados.
+ *
+ * Um slice é atualizado (e passa a ser controlado pelo dithering) se qualquer
+ * um dos seus canais estiver em `mask`; os demais slices não são alterados.
+ *
+ * @param[in,out] dither Estado do dithering.
+ * @param[in] color Cor perceptual (0 a 65535 por canal).
+ * @param[in] mask Canais a atualizar (RGB_MASK_*).
+ */
+void rgb_dither_apply(rgb_dither_t *dither, rgb_color16_t color, uint8_t mask);
+
+/**
+ * @brief Interrompe o dithering dos slices dos canais selecionados.
+ *
+ * Os slices ficam com o último valor escrito e podem voltar a ser controlados
+ * por `rgb_set_color` ou por outro sequenciador.
+ *
+ * @param[in,out] dither Estado do dithering.
+ * @param[in] mask Canais liberados (RGB_MASK_*).
+ */
+void rgb_dither_release(rgb_dither_t *dither, uint8_t mask);
+
+/**
+ * @brief Imprime, pelo USB stdio, a resolução efetiva e o custo de CPU medido.
+ *
+ * @param[in] dither Estado do dithering.
+ */
+void rgb_dither_print_stats(const rgb_dither_t *dither);
+
+/** @} */ // Fim do grupo "RGB_Dither"
+
+#endif // RGB_DITHER_H
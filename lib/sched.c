@@ -0,0 +1,180 @@
+#include "sched.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file sched.c
+ * @brief Implementação do escalonador cooperativo de taxa fixa.
+ *
+ * Os instantes são de 32 bits em microssegundos e comparados por diferença com
+ * sinal, o que tolera a volta do contador (~71 minutos).
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @brief Zera as estatísticas (apenas no núcleo que executa o escalonador).
+ *
+ * @param sched Escalonador.
+ */
+static void sched_clear_stats(sched_t *sched)
+{
+    for(uint i = 0; i < sched->count; i++)
+    {
+        sched_task_t *task = &sched->tasks[i];
+        task->runs = 0;
+        task->overruns = 0;
+        task->skipped = 0;
+        task->jitter_max_us = 0;
+        task->jitter_sum_us = 0;
+        task->runtime_max_us = 0;
+        task->runtime_sum_us = 0;
+    }
+    sched->idle_us = 0;
+    sched->stats_start_us = time_us_32();
+    sched->reset_requested = false;
+}
+
+void sched_init(sched_t *sched)
+{
+    memset(sched, 0, sizeof(*sched));
+}
+
+sched_task_t *sched_add(sched_t *sched, const char *name, sched_task_fn_t fn, void *ctx,
+                        uint32_t period_us, uint32_t deadline_us, uint32_t offset_us)
+{
+    if(sched->count >= SCHED_MAX_TASKS) return NULL;
+
+    sched_task_t *task = &sched->tasks[sched->count++];
+    memset(task, 0, sizeof(*task));
+    task->name = name;
+    task->fn = fn;
+    task->ctx = ctx;
+    task->period_us = period_us;
+    task->deadline_us = deadline_us ? deadline_us : period_us;
+    task->next_release_us = offset_us; // Relativo ao início, ajustado em sched_run
+    return task;
+}
+
+/**
+ * @brief Executa uma tarefa liberada e atualiza suas estatísticas e a próxima liberação.
+ *
+ * @param task Tarefa.
+ * @param start_us Instante de início.
+ */
+static void sched_execute(sched_task_t *task, uint32_t start_us)
+{
+    uint32_t release_us = task->next_release_us;
+    uint32_t lateness_us = start_us - release_us;
+
+    task->fn(task->ctx, release_us);
+
+    uint32_t end_us = time_us_32();
+    uint32_t runtime_us = end_us - start_us;
+
+    task->runs++;
+    task->jitter_sum_us += lateness_us;
+    if(lateness_us > task->jitter_max_us) task->jitter_max_us = lateness_us;
+    task->runtime_sum_us += runtime_us;
+    if(runtime_us > task->runtime_max_us) task->runtime_max_us = runtime_us;
+    if(end_us - release_us > task->deadline_us) task->overruns++;
+
+    // Liberação seguinte sem deriva; se já passou mais de um período, realinha sem rajada
+    uint32_t next_us = release_us + task->period_us;
+    if((int32_t) (end_us - next_us) >= (int32_t) task->period_us)
+    {
+        uint32_t missed = (end_us - next_us) / task->period_us;
+        task->skipped += missed;
+        next_us += missed * task->period_us;
+    }
+    task->next_release_us = next_us;
+}
+
+bool sched_run_once(sched_t *sched, uint32_t *next_release_us)
+{
+    if(sched->reset_requested) sched_clear_stats(sched);
+
+    uint32_t now_us = time_us_32();
+    sched_task_t *ready = NULL;
+    uint32_t ready_deadline_us = 0;
+    uint32_t next_us = now_us + INT32_MAX;
+
+    for(uint i = 0; i < sched->count; i++)
+    {
+        sched_task_t *task = &sched->tasks[i];
+        if((int32_t) (now_us - task->next_release_us) >= 0)
+        {
+            // Liberada: escolhe o prazo absoluto mais próximo (EDF)
+            uint32_t deadline_us = task->next_release_us + task->deadline_us;
+            if(ready == NULL || (int32_t) (deadline_us - ready_deadline_us) < 0)
+            {
+                ready = task;
+                ready_deadline_us = deadline_us;
+            }
+        }
+        else if((int32_t) (task->next_release_us - next_us) < 0)
+        {
+            next_us = task->next_release_us;
+        }
+    }
+
+    if(ready == NULL)
+    {
+        if(next_release_us != NULL) *next_release_us = next_us;
+        return false;
+    }
+
+    sched_execute(ready, now_us);
+    return true;
+}
+
+void sched_run(sched_t *sched)
+{
+    // Converte os deslocamentos iniciais em instantes absolutos
+    uint32_t start_us = time_us_32();
+    for(uint i = 0; i < sched->count; i++)
+    {
+        sched->tasks[i].next_release_us += start_us;
+    }
+    sched_clear_stats(sched);
+
+    while(true)
+    {
+        uint32_t next_us;
+        if(sched_run_once(sched, &next_us)) continue;
+
+        // Dorme até a próxima liberação; outros eventos (SEV) apenas antecipam a verificação
+        uint32_t idle_start_us = time_us_32();
+        int32_t wait_us = (int32_t) (next_us - idle_start_us);
+        if(wait_us > 0) best_effort_wfe_or_timeout(make_timeout_time_us((uint64_t) wait_us));
+        sched->idle_us += time_us_32() - idle_start_us;
+    }
+}
+
+void sched_request_reset(sched_t *sched)
+{
+    sched->reset_requested = true;
+}
+
+void sched_print_stats(const sched_t *sched, const char *label)
+{
+    uint32_t elapsed_us = time_us_32() - sched->stats_start_us;
+    uint32_t busy_pct = elapsed_us ? (uint32_t) (100u - (sched->idle_us * 100u) / elapsed_us) : 0;
+
+    printf("%s: ocupacao=%lu%% janela=%lums\n", label, (unsigned long) busy_pct,
+           (unsigned long) (elapsed_us / 1000u));
+    for(uint i = 0; i < sched->count; i++)
+    {
+        const sched_task_t *task = &sched->tasks[i];
+        uint32_t runs = task->runs ? task->runs : 1u;
+        printf("  %-8s T=%luus n=%lu jitter(med/max)=%lu/%luus exec(med/max)=%lu/%luus estouros=%lu pulos=%lu\n",
+               task->name, (unsigned long) task->period_us, (unsigned long) task->runs,
+               (unsigned long) (task->jitter_sum_us / runs), (unsigned long) task->jitter_max_us,
+               (unsigned long) (task->runtime_sum_us / runs), (unsigned long) task->runtime_max_us,
+               (unsigned long) task->overruns, (unsigned long) task->skipped);
+    }
+}
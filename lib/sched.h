@@ -0,0 +1,142 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @file sched.h
+ * @brief Escalonador cooperativo de tarefas periódicas, com taxa fixa e sem deriva.
+ *
+ * Cada tarefa declara período e prazo (relativo à liberação). As liberações são
+ * múltiplos exatos do período a partir do início (`next += period`), de modo que
+ * o tempo de execução das tarefas não acumula deriva. Entre as tarefas liberadas,
+ * executa primeiro a de prazo absoluto mais próximo (EDF); as tarefas não são
+ * interrompidas umas pelas outras, apenas pelas interrupções.
+ *
+ * Sem tarefas liberadas, o núcleo dorme (WFE) até a próxima liberação, usando o
+ * alarm pool do SDK como despertador. Cada núcleo executa seu próprio `sched_t`.
+ *
+ * Para cada tarefa são contabilizados: execuções, atraso de início em relação à
+ * liberação (jitter), tempo de execução, estouros de prazo e liberações puladas
+ * (quando o atraso passa de um período, a tarefa é realinhada à próxima
+ * liberação futura em vez de executar em rajada).
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Sched Escalonador
+ * @brief Tarefas periódicas cooperativas com estatísticas de prazo e jitter.
+ * @{
+ */
+
+/** @brief Quantidade máxima de tarefas por escalonador. */
+#define SCHED_MAX_TASKS 8
+
+/**
+ * @brief Função de uma tarefa.
+ *
+ * @param ctx Contexto informado em `sched_add`.
+ * @param release_us Instante de liberação desta execução.
+ */
+typedef void (*sched_task_fn_t)(void *ctx, uint32_t release_us);
+
+/**
+ * @brief Tarefa periódica e suas estatísticas.
+ */
+typedef struct
+{
+    const char *name;          /**< Nome exibido nas estatísticas. */
+    sched_task_fn_t fn;        /**< Função executada a cada liberação. */
+    void *ctx;                 /**< Contexto repassado à função. */
+    uint32_t period_us;        /**< Período. */
+    uint32_t deadline_us;      /**< Prazo relativo à liberação. */
+    uint32_t next_release_us;  /**< Próxima liberação. */
+    uint32_t runs;             /**< Execuções. */
+    uint32_t overruns;         /**< Execuções concluídas depois do prazo. */
+    uint32_t skipped;          /**< Liberações puladas por atraso maior que um período. */
+    uint32_t jitter_max_us;    /**< Maior atraso de início. */
+    uint64_t jitter_sum_us;    /**< Soma dos atrasos de início. */
+    uint32_t runtime_max_us;   /**< Maior tempo de execução. */
+    uint64_t runtime_sum_us;   /**< Soma dos tempos de execução. */
+} sched_task_t;
+
+/**
+ * @brief Escalonador de um núcleo.
+ */
+typedef struct
+{
+    sched_task_t tasks[SCHED_MAX_TASKS]; /**< Tarefas registradas. */
+    uint8_t count;                       /**< Quantidade de tarefas. */
+    uint32_t stats_start_us;             /**< Início da janela das estatísticas. */
+    uint64_t idle_us;                    /**< Tempo dormindo na janela. */
+    volatile bool reset_requested;       /**< Pedido de zerar as estatísticas (qualquer núcleo). */
+} sched_t;
+
+/**
+ * @brief Inicializa um escalonador vazio.
+ *
+ * @param[out] sched Escalonador.
+ */
+void sched_init(sched_t *sched);
+
+/**
+ * @brief Registra uma tarefa periódica.
+ *
+ * A primeira liberação ocorre em `sched_run`, deslocada de `offset_us`, o que
+ * permite espalhar tarefas de mesmo período.
+ *
+ * @param[in,out] sched Escalonador.
+ * @param[in] name Nome da tarefa (literal).
+ * @param[in] fn Função da tarefa.
+ * @param[in] ctx Contexto repassado à função.
+ * @param[in] period_us Período.
+ * @param[in] deadline_us Prazo relativo à liberação (0 = igual ao período).
+ * @param[in] offset_us Deslocamento da primeira liberação.
+ * @return Tarefa registrada, ou `NULL` se o limite foi atingido.
+ */
+sched_task_t *sched_add(sched_t *sched, const char *name, sched_task_fn_t fn, void *ctx,
+                        uint32_t period_us, uint32_t deadline_us, uint32_t offset_us);
+
+/**
+ * @brief Executa a tarefa liberada de prazo mais próximo, se houver.
+ *
+ * @param[in,out] sched Escalonador.
+ * @param[out] next_release_us Se nenhuma tarefa estava liberada, recebe a próxima liberação.
+ * @return `true` se uma tarefa foi executada.
+ */
+bool sched_run_once(sched_t *sched, uint32_t *next_release_us);
+
+/**
+ * @brief Laço do escalonador: executa as tarefas e dorme entre liberações. Não retorna.
+ *
+ * @param[in,out] sched Escalonador.
+ */
+void sched_run(sched_t *sched) __attribute__((noreturn));
+
+/**
+ * @brief Pede que as estatísticas sejam zeradas pelo núcleo que executa o escalonador.
+ *
+ * Pode ser chamada de qualquer núcleo; o pedido é atendido antes da próxima tarefa.
+ *
+ * @param[in,out] sched Escalonador.
+ */
+void sched_request_reset(sched_t *sched);
+
+/**
+ * @brief Imprime, pelo USB stdio, as estatísticas das tarefas e a ocupação do núcleo.
+ *
+ * @param[in] sched Escalonador (pode estar rodando em outro núcleo).
+ * @param[in] label Identificação do escalonador.
+ */
+void sched_print_stats(const sched_t *sched, const char *label);
+
+/** @} */ // Fim do grupo "Sched"
+
+#endif // SCHED_H
@@ -0,0 +1,75 @@
+#include "snapshot.h"
+#include <string.h>
+
+/**
+ * @file snapshot.c
+ * @brief Implementação do mecanismo de quatro posições de Simpson.
+ *
+ * O escritor escolhe o par que o leitor não está usando e, dentro dele, a
+ * posição que não foi publicada por último; assim nunca escreve onde o leitor
+ * pode estar lendo. O leitor anuncia o par antes de escolher a posição, o que
+ * fecha a janela em que o escritor poderia trocar de par durante a leitura.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+void snapshot_init(snapshot_t *snap, void *storage, uint32_t elem_size)
+{
+    snap->storage = (uint8_t *) storage;
+    snap->elem_size = elem_size;
+    snap->slot[0] = 0;
+    snap->slot[1] = 0;
+    snap->latest = 0;
+    snap->reading = 0;
+    snap->published = 0;
+    snap->consumed = 0;
+    snap->write_pair = 0;
+    snap->write_index = 0;
+
+    // Todas as posições começam iguais, para que qualquer leitura inicial seja válida
+    for(uint32_t i = 1; i < SNAPSHOT_SLOTS; i++)
+    {
+        memcpy(&snap->storage[i * elem_size], snap->storage, elem_size);
+    }
+}
+
+void *snapshot_write_begin(snapshot_t *snap)
+{
+    __sync_synchronize();
+    snap->write_pair = (uint8_t) !snap->reading;
+    snap->write_index = (uint8_t) !snap->slot[snap->write_pair];
+    return &snap->storage[(snap->write_pair * 2u + snap->write_index) * snap->elem_size];
+}
+
+void snapshot_write_end(snapshot_t *snap)
+{
+    __sync_synchronize();
+    snap->slot[snap->write_pair] = snap->write_index;
+    __sync_synchronize();
+    snap->latest = snap->write_pair;
+    __sync_synchronize();
+    snap->published = snap->published + 1u;
+}
+
+const void *snapshot_read(snapshot_t *snap, bool *fresh)
+{
+    // A contagem é lida antes do par: uma publicação concorrente, no pior caso,
+    // faz a próxima leitura ser marcada como nova sem necessidade, nunca o contrário
+    uint32_t published = snap->published;
+    __sync_synchronize();
+
+    uint8_t pair = snap->latest;
+    snap->reading = pair;
+    __sync_synchronize();
+
+    uint8_t index = snap->slot[pair];
+    __sync_synchronize();
+
+    if(fresh != NULL) *fresh = (published != snap->consumed);
+    snap->consumed = published;
+    return &snap->storage[(pair * 2u + index) * snap->elem_size];
+}
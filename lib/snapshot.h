@@ -0,0 +1,93 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file snapshot.h
+ * @brief Troca do estado mais recente entre um escritor e um leitor, sem espera.
+ *
+ * Implementa o mecanismo assíncrono de quatro posições de Simpson: o escritor
+ * publica cópias completas de um estado e o leitor sempre obtém a cópia mais
+ * recente, íntegra, sem que nenhum dos dois jamais espere pelo outro. Ao
+ * contrário de um buffer triplo, não é necessária troca atômica de índices (o
+ * Cortex-M0+ não possui LDREX/STREX): cada variável de controle tem um único
+ * escritor e só é lida pelo outro lado, com barreiras entre os passos, o que
+ * funciona também entre os dois núcleos.
+ *
+ * Estados intermediários podem ser pulados pelo leitor; para fluxos em que
+ * nenhum item pode ser perdido, use spsc_ring.h.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Snapshot Estado compartilhado
+ * @brief Publicação do estado mais recente, sem espera, entre dois contextos.
+ * @{
+ */
+
+/** @brief Posições de armazenamento exigidas (dois pares de duas). */
+#define SNAPSHOT_SLOTS 4
+
+/**
+ * @brief Estado compartilhado entre um escritor e um leitor.
+ */
+typedef struct
+{
+    uint8_t *storage;           /**< SNAPSHOT_SLOTS posições de `elem_size` bytes. */
+    uint32_t elem_size;         /**< Tamanho do estado, em bytes. */
+    volatile uint8_t slot[2];   /**< Posição mais recente de cada par (escritor). */
+    volatile uint8_t latest;    /**< Par escrito por último (escritor). */
+    volatile uint8_t reading;   /**< Par em leitura (leitor). */
+    volatile uint32_t published; /**< Publicações concluídas (escritor). */
+    uint32_t consumed;          /**< Última publicação vista pelo leitor. */
+    uint8_t write_pair;         /**< Par da escrita em andamento (escritor). */
+    uint8_t write_index;        /**< Posição da escrita em andamento (escritor). */
+} snapshot_t;
+
+/**
+ * @brief Inicializa o estado compartilhado.
+ *
+ * O conteúdo inicial lido antes da primeira publicação é o de `storage`.
+ *
+ * @param[out] snap Estado compartilhado.
+ * @param[in] storage Área com pelo menos `SNAPSHOT_SLOTS * elem_size` bytes.
+ * @param[in] elem_size Tamanho do estado, em bytes.
+ */
+void snapshot_init(snapshot_t *snap, void *storage, uint32_t elem_size);
+
+/**
+ * @brief Inicia uma escrita (lado do escritor).
+ *
+ * @param[in,out] snap Estado compartilhado.
+ * @return Posição a ser preenchida; o leitor não a acessa até `snapshot_write_end`.
+ */
+void *snapshot_write_begin(snapshot_t *snap);
+
+/**
+ * @brief Publica a posição preenchida desde `snapshot_write_begin` (lado do escritor).
+ *
+ * @param[in,out] snap Estado compartilhado.
+ */
+void snapshot_write_end(snapshot_t *snap);
+
+/**
+ * @brief Obtém o estado publicado mais recente (lado do leitor).
+ *
+ * @param[in,out] snap Estado compartilhado.
+ * @param[out] fresh Se não `NULL`, recebe `true` caso houve publicação desde a leitura anterior.
+ * @return Estado; permanece válido e inalterado até a próxima chamada.
+ */
+const void *snapshot_read(snapshot_t *snap, bool *fresh);
+
+/** @} */ // Fim do grupo "Snapshot"
+
+#endif // SNAPSHOT_H
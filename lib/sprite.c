@@ -0,0 +1,282 @@
+#include <stdio.h>
+#include <string.h>
+#include "sprite.h"
+#include "pixaddr.h"
+#include "ram_func.h"
+
+/**
+ * @file sprite.c
+ * @brief Ordem z, baldes por página e composição dos trechos danificados da camada de sprites.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/** @brief Bits dos sprites criados. */
+#define SPRITE_ALL(count) ((count) >= 32u ? 0xFFFFFFFFu : (1u << (count)) - 1u)
+
+/**
+ * @brief Refaz a ordem z (z crescente, empates pelo identificador) e os baldes das áreas desenhadas.
+ */
+static void sprite_layer_reorder(sprite_layer_t *layer)
+{
+    // Inserção: poucas dezenas de sprites, e a ordem só muda ao criar um sprite ou trocar seu z
+    for(uint8_t i = 0; i < layer->count; i++)
+    {
+        uint8_t id = i;
+        uint8_t pos = i;
+        while(pos > 0 && layer->sprites[layer->by_rank[pos - 1]].z > layer->sprites[id].z)
+        {
+            layer->by_rank[pos] = layer->by_rank[pos - 1];
+            pos--;
+        }
+        layer->by_rank[pos] = id;
+    }
+
+    memset(layer->buckets, 0, sizeof(layer->buckets));
+    for(uint8_t rank = 0; rank < layer->count; rank++)
+    {
+        const sprite_t *s = &layer->sprites[layer->by_rank[rank]];
+        layer->rank[layer->by_rank[rank]] = rank;
+        if(!s->drawn) continue;
+        for(uint8_t page = s->drawn_page0; page <= s->drawn_page1; page++)
+        {
+            layer->buckets[page] |= 1u << rank;
+        }
+    }
+}
+
+void sprite_layer_init(sprite_layer_t *layer)
+{
+    memset(layer, 0, sizeof(*layer));
+}
+
+int sprite_add(sprite_layer_t *layer, const uint8_t *bitmap, uint8_t width, uint8_t pages, int8_t z)
+{
+    if(layer->count >= SPRITE_MAX) return SPRITE_INVALID;
+    sprite_t *s = &layer->sprites[layer->count];
+    memset(s, 0, sizeof(*s));
+    s->bitmap = bitmap;
+    s->width = width;
+    s->pages = pages;
+    s->z = z;
+    layer->count++;
+    sprite_layer_reorder(layer);
+    return layer->count - 1;
+}
+
+void sprite_move(sprite_layer_t *layer, int id, uint8_t x, uint8_t y)
+{
+    sprite_t *s = &layer->sprites[id];
+    if(s->x == x && s->y == y) return;
+    s->x = x;
+    s->y = y;
+    if(s->visible) layer->dirty |= 1u << id;
+}
+
+void sprite_set_visible(sprite_layer_t *layer, int id, bool visible)
+{
+    sprite_t *s = &layer->sprites[id];
+    if(s->visible == visible) return;
+    s->visible = visible;
+    layer->dirty |= 1u << id;
+}
+
+void sprite_set_shape(sprite_layer_t *layer, int id, const uint8_t *bitmap, uint8_t width, uint8_t pages)
+{
+    sprite_t *s = &layer->sprites[id];
+    if(s->bitmap == bitmap && s->width == width && s->pages == pages) return;
+    s->bitmap = bitmap;
+    s->width = width;
+    s->pages = pages;
+    if(s->visible) layer->dirty |= 1u << id;
+}
+
+void sprite_set_z(sprite_layer_t *layer, int id, int8_t z)
+{
+    sprite_t *s = &layer->sprites[id];
+    if(s->z == z) return;
+    s->z = z;
+    sprite_layer_reorder(layer);
+    if(s->visible) layer->dirty |= 1u << id;
+}
+
+void sprite_layer_invalidate(sprite_layer_t *layer)
+{
+    for(uint8_t id = 0; id < layer->count; id++)
+    {
+        layer->sprites[id].drawn = false;
+    }
+    memset(layer->buckets, 0, sizeof(layer->buckets));
+    layer->dirty = SPRITE_ALL(layer->count);
+}
+
+/**
+ * @brief Acrescenta as colunas `x0` - `x1` das páginas `page0` - `page1` aos trechos danificados.
+ */
+static void sprite_damage(uint8_t *span_x0, uint8_t *span_x1, uint8_t *damaged, uint8_t x0, uint8_t x1,
+                          uint8_t page0, uint8_t page1)
+{
+    for(uint8_t page = page0; page <= page1; page++)
+    {
+        if(*damaged & (1u << page))
+        {
+            if(x0 < span_x0[page]) span_x0[page] = x0;
+            if(x1 > span_x1[page]) span_x1[page] = x1;
+        }
+        else
+        {
+            span_x0[page] = x0;
+            span_x1[page] = x1;
+            *damaged |= (uint8_t) (1u << page);
+        }
+    }
+}
+
+/**
+ * @brief Desenha as colunas `x0` - `x1` de um sprite em uma página, um byte por coluna.
+ *
+ * O byte da página reúne a parte de cima de uma página do bitmap, deslocada
+ * para baixo por `y & 7`, e a parte de baixo da página anterior do bitmap.
+ */
+static void RAM_FUNC(sprite_compose)(ssd1306_t *ssd, const sprite_t *s, uint8_t page, uint8_t x0, uint8_t x1)
+{
+    if(s->drawn_x0 > x1 || s->drawn_x1 < x0) return;
+    uint8_t from = s->drawn_x0 > x0 ? s->drawn_x0 : x0;
+    uint8_t to = s->drawn_x1 < x1 ? s->drawn_x1 : x1;
+    int row = (int) page - (s->y >> 3);
+    uint8_t shift = s->y & 7u;
+    const uint8_t *upper = row >= 0 && row < s->pages ? s->bitmap + row * s->width : NULL;
+    const uint8_t *lower = shift != 0 && row >= 1 && row - 1 < s->pages ? s->bitmap + (row - 1) * s->width : NULL;
+
+    pixaddr_t a;
+    pixaddr_begin(&a, ssd->ram_buffer, PIXADDR_PACK(from, page << 3), PIXADDR_USE_INTERP);
+    for(uint8_t x = from; x <= to; x++)
+    {
+        uint8_t col = (uint8_t) (x - s->x);
+        uint8_t byte = 0;
+        if(upper != NULL) byte |= (uint8_t) (upper[col] << shift);
+        if(lower != NULL) byte |= (uint8_t) (lower[col] >> (8u - shift));
+        *pixaddr_byte(&a) |= byte;
+        pixaddr_step(&a, PIXADDR_STEP_X);
+    }
+}
+
+uint8_t RAM_FUNC(sprite_layer_render)(sprite_layer_t *layer, ssd1306_t *ssd, ssd1306_window_t *rects,
+                                      uint8_t max_rects)
+{
+    uint32_t dirty = layer->dirty;
+    if(dirty == 0) return 0;
+    layer->dirty = 0;
+
+    uint8_t span_x0[SPRITE_PAGES], span_x1[SPRITE_PAGES];
+    uint8_t damaged = 0;
+
+    // Só os sprites sujos: a área antiga sai dos baldes e dos pixels, a nova entra
+    while(dirty != 0)
+    {
+        uint8_t id = (uint8_t) __builtin_ctz(dirty);
+        dirty &= dirty - 1u;
+        sprite_t *s = &layer->sprites[id];
+        uint32_t bit = 1u << layer->rank[id];
+
+        if(s->drawn)
+        {
+            for(uint8_t page = s->drawn_page0; page <= s->drawn_page1; page++)
+            {
+                layer->buckets[page] &= ~bit;
+            }
+            sprite_damage(span_x0, span_x1, &damaged, s->drawn_x0, s->drawn_x1, s->drawn_page0, s->drawn_page1);
+            s->drawn = false;
+        }
+        if(s->visible && s->width > 0 && s->pages > 0 && s->x < WIDTH && s->y < HEIGHT)
+        {
+            uint16_t x1 = (uint16_t) s->x + s->width - 1u;
+            uint16_t page1 = (uint16_t) ((s->y + s->pages * 8u - 1u) >> 3);
+            s->drawn_x0 = s->x;
+            s->drawn_x1 = (uint8_t) (x1 < WIDTH ? x1 : WIDTH - 1u);
+            s->drawn_page0 = s->y >> 3;
+            s->drawn_page1 = (uint8_t) (page1 < SPRITE_PAGES ? page1 : SPRITE_PAGES - 1u);
+            s->drawn = true;
+            for(uint8_t page = s->drawn_page0; page <= s->drawn_page1; page++)
+            {
+                layer->buckets[page] |= bit;
+            }
+            sprite_damage(span_x0, span_x1, &damaged, s->drawn_x0, s->drawn_x1, s->drawn_page0, s->drawn_page1);
+        }
+        layer->sprites_moved++;
+    }
+    if(damaged == 0) return 0;
+
+    // Cada página danificada numa passada: apaga o trecho e desenha o balde de trás para a frente
+    uint8_t count = 0;
+    uint32_t bytes = 0;
+    for(uint8_t page = 0; page < SPRITE_PAGES; page++)
+    {
+        if(!(damaged & (1u << page))) continue;
+        uint8_t x0 = span_x0[page], x1 = span_x1[page];
+        for(uint8_t x = x0; x <= x1; x++)
+        {
+            ssd->ram_buffer[1 + x * ssd->pages + page] = 0;
+        }
+        uint32_t bucket = layer->buckets[page];
+        while(bucket != 0)
+        {
+            uint8_t rank = (uint8_t) __builtin_ctz(bucket);
+            bucket &= bucket - 1u;
+            sprite_compose(ssd, &layer->sprites[layer->by_rank[rank]], page, x0, x1);
+        }
+        layer->pages_composed++;
+        bytes += x1 - x0 + 1u;
+
+        // Páginas vizinhas com as mesmas colunas formam uma só área
+        if(count > 0 && count <= max_rects && rects[count - 1].page1 + 1u == page && rects[count - 1].x0 == x0 &&
+           rects[count - 1].x1 == x1)
+        {
+            rects[count - 1].page1 = page;
+        }
+        else
+        {
+            if(count < max_rects)
+            {
+                rects[count].x0 = x0;
+                rects[count].x1 = x1;
+                rects[count].page0 = page;
+                rects[count].page1 = page;
+            }
+            count++;
+        }
+    }
+
+    if(count > max_rects)
+    {
+        // Áreas demais: uma só, que cobre todas as páginas e colunas danificadas
+        ssd1306_window_t all = {WIDTH - 1, 0, SPRITE_PAGES - 1, 0};
+        for(uint8_t page = 0; page < SPRITE_PAGES; page++)
+        {
+            if(!(damaged & (1u << page))) continue;
+            if(span_x0[page] < all.x0) all.x0 = span_x0[page];
+            if(span_x1[page] > all.x1) all.x1 = span_x1[page];
+            if(page < all.page0) all.page0 = page;
+            all.page1 = page;
+        }
+        rects[0] = all;
+        bytes = (uint32_t) (all.x1 - all.x0 + 1u) * (all.page1 - all.page0 + 1u);
+        count = 1;
+    }
+    layer->renders++;
+    layer->dirty_bytes += bytes;
+    return count;
+}
+
+void sprite_layer_print(const sprite_layer_t *layer, const char *label)
+{
+    uint32_t renders = layer->renders;
+    printf("%s: sprites=%u composicoes=%lu sujos=%lu paginas=%lu bytes=%lu (%lu/composicao)\n", label,
+           (unsigned) layer->count, (unsigned long) renders, (unsigned long) layer->sprites_moved,
+           (unsigned long) layer->pages_composed, (unsigned long) layer->dirty_bytes,
+           (unsigned long) (renders != 0 ? layer->dirty_bytes / renders : 0));
+}
@@ -0,0 +1,175 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+
+/**
+ * @file sprite.h
+ * @brief Camada de sprites sobre o framebuffer do SSD1306, composta por página e enviada por área.
+ *
+ * Cada sprite tem posição, ordem de sobreposição (z), forma (um bitmap no
+ * formato de página do framebuffer, como os de `pixaddr_blit`) e visibilidade.
+ * Mudar qualquer um deles só marca o sprite como sujo; `sprite_layer_render`
+ * percorre apenas os sprites sujos, acrescentando aos trechos danificados de
+ * cada página a área que o sprite ocupava na tela e a que passa a ocupar.
+ *
+ * Cada página do display tem um balde com os sprites que a tocam (um bit por
+ * posição na ordem z). Uma página danificada é composta de uma vez: o trecho
+ * é apagado e os sprites do balde que o cruzam são desenhados de trás para a
+ * frente, coluna a coluna, cada byte montado com as duas páginas do bitmap
+ * que caem nele. Nenhum outro pixel da tela é tocado, e o custo acompanha os
+ * sprites que mudaram e os que os cobrem, não a quantidade de sprites.
+ *
+ * Os trechos danificados viram as áreas sujas do quadro, uma janela do
+ * SSD1306 por grupo de páginas vizinhas com as mesmas colunas, para o envio
+ * só do que mudou (`ssd1306_send_window`).
+ *
+ * A camada apaga o que estava sob os sprites: o que mais houver na tela (a
+ * borda, por exemplo) deve ser redesenhado depois da composição.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Sprite Camada de sprites
+ * @brief Sprites com ordem z, baldes por página e áreas sujas para o envio.
+ * @{
+ */
+
+/** @brief Sprites de uma camada (um bit de `uint32_t` por sprite). */
+#define SPRITE_MAX 32
+
+/** @brief Páginas (faixas de 8 linhas) da tela. */
+#define SPRITE_PAGES 8
+
+/** @brief Identificador devolvido quando a camada está cheia. */
+#define SPRITE_INVALID (-1)
+
+/**
+ * @brief Sprite: estado pedido e o último desenhado.
+ */
+typedef struct
+{
+    const uint8_t *bitmap; /**< `pages` faixas de `width` bytes (uma coluna por byte, bit 0 em cima). */
+    uint8_t width;         /**< Largura em pixels. */
+    uint8_t pages;         /**< Altura em páginas de 8 linhas. */
+    uint8_t x, y;          /**< Canto superior esquerdo. */
+    int8_t z;              /**< Ordem: maior, mais à frente (empates pela ordem de criação). */
+    bool visible;          /**< Desenhado na tela. */
+    bool drawn;            /**< Há uma área desenhada (abaixo) a apagar. */
+    uint8_t drawn_x0, drawn_x1, drawn_page0, drawn_page1; /**< Área ocupada no último desenho (inclusiva). */
+} sprite_t;
+
+/**
+ * @brief Camada de sprites.
+ */
+typedef struct
+{
+    sprite_t sprites[SPRITE_MAX];      /**< Sprites, pelo identificador. */
+    uint8_t count;                     /**< Sprites criados. */
+    uint8_t rank[SPRITE_MAX];          /**< Posição de cada sprite na ordem z. */
+    uint8_t by_rank[SPRITE_MAX];       /**< Sprite em cada posição da ordem z. */
+    uint32_t buckets[SPRITE_PAGES];    /**< Sprites desenhados em cada página, um bit por posição na ordem z. */
+    uint32_t dirty;                    /**< Sprites a redesenhar, um bit por identificador. */
+    uint32_t renders;                  /**< Composições com alguma área suja. */
+    uint32_t sprites_moved;            /**< Sprites sujos processados. */
+    uint32_t pages_composed;           /**< Páginas recompostas. */
+    uint32_t dirty_bytes;              /**< Bytes das áreas sujas devolvidas. */
+} sprite_layer_t;
+
+/**
+ * @brief Inicializa uma camada vazia.
+ *
+ * @param[out] layer Camada.
+ */
+void sprite_layer_init(sprite_layer_t *layer);
+
+/**
+ * @brief Cria um sprite, invisível até `sprite_set_visible`.
+ *
+ * @param[in,out] layer Camada.
+ * @param[in] bitmap Forma (no formato de `pixaddr_blit`; deve continuar válida).
+ * @param[in] width Largura em pixels.
+ * @param[in] pages Altura em páginas.
+ * @param[in] z Ordem de sobreposição.
+ * @return Identificador, ou SPRITE_INVALID se a camada estiver cheia.
+ */
+int sprite_add(sprite_layer_t *layer, const uint8_t *bitmap, uint8_t width, uint8_t pages, int8_t z);
+
+/**
+ * @brief Move um sprite (sem efeito se a posição não mudar).
+ *
+ * @param[in,out] layer Camada.
+ * @param[in] id Sprite.
+ * @param[in] x Coluna do canto superior esquerdo.
+ * @param[in] y Linha do canto superior esquerdo.
+ */
+void sprite_move(sprite_layer_t *layer, int id, uint8_t x, uint8_t y);
+
+/**
+ * @brief Mostra ou esconde um sprite.
+ *
+ * @param[in,out] layer Camada.
+ * @param[in] id Sprite.
+ * @param[in] visible Visível.
+ */
+void sprite_set_visible(sprite_layer_t *layer, int id, bool visible);
+
+/**
+ * @brief Troca a forma de um sprite.
+ *
+ * @param[in,out] layer Camada.
+ * @param[in] id Sprite.
+ * @param[in] bitmap Nova forma.
+ * @param[in] width Largura em pixels.
+ * @param[in] pages Altura em páginas.
+ */
+void sprite_set_shape(sprite_layer_t *layer, int id, const uint8_t *bitmap, uint8_t width, uint8_t pages);
+
+/**
+ * @brief Muda a ordem de sobreposição de um sprite (refaz a ordem e os baldes da camada).
+ *
+ * @param[in,out] layer Camada.
+ * @param[in] id Sprite.
+ * @param[in] z Nova ordem.
+ */
+void sprite_set_z(sprite_layer_t *layer, int id, int8_t z);
+
+/**
+ * @brief Descarta o que foi desenhado (após limpar a tela): o próximo `sprite_layer_render` desenha todos os sprites visíveis.
+ *
+ * @param[in,out] layer Camada.
+ */
+void sprite_layer_invalidate(sprite_layer_t *layer);
+
+/**
+ * @brief Recompõe as áreas dos sprites que mudaram e devolve as áreas sujas.
+ *
+ * Se houver mais áreas que `max_rects`, devolve uma só, que cobre todas.
+ *
+ * @param[in,out] layer Camada.
+ * @param[in,out] ssd Display (framebuffer).
+ * @param[out] rects Áreas sujas, de cima para baixo.
+ * @param[in] max_rects Capacidade de `rects` (ao menos 1).
+ * @return Áreas preenchidas (0: nada mudou).
+ */
+uint8_t sprite_layer_render(sprite_layer_t *layer, ssd1306_t *ssd, ssd1306_window_t *rects, uint8_t max_rects);
+
+/**
+ * @brief Imprime os contadores da camada.
+ *
+ * @param[in] layer Camada.
+ * @param[in] label Nome exibido.
+ */
+void sprite_layer_print(const sprite_layer_t *layer, const char *label);
+
+/** @} */ // Fim do grupo "Sprite"
+
+#endif // SPRITE_H
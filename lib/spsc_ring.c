@@ -0,0 +1,56 @@
+#include "spsc_ring.h"
+#include <string.h>
+
+/**
+ * @file spsc_ring.c
+ * @brief Implementação da fila circular de um produtor e um consumidor.
+ *
+ * Os índices crescem livremente e são reduzidos pela máscara apenas no acesso
+ * ao armazenamento; a diferença `head - tail` é a ocupação mesmo após o estouro
+ * dos contadores de 32 bits. As barreiras garantem que o elemento esteja
+ * completamente escrito (ou lido) antes de o índice correspondente avançar,
+ * inclusive quando produtor e consumidor estão em núcleos diferentes.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+void spsc_ring_init(spsc_ring_t *ring, void *storage, uint32_t elem_size, uint32_t capacity)
+{
+    ring->storage = (uint8_t *) storage;
+    ring->elem_size = elem_size;
+    ring->mask = capacity - 1u;
+    ring->head = 0;
+    ring->tail = 0;
+}
+
+bool spsc_ring_push(spsc_ring_t *ring, const void *elem)
+{
+    uint32_t head = ring->head;
+    if(head - ring->tail > ring->mask) return false; // Cheia
+
+    memcpy(&ring->storage[(head & ring->mask) * ring->elem_size], elem, ring->elem_size);
+    __sync_synchronize();
+    ring->head = head + 1u;
+    return true;
+}
+
+bool spsc_ring_pop(spsc_ring_t *ring, void *elem)
+{
+    uint32_t tail = ring->tail;
+    if(ring->head == tail) return false; // Vazia
+
+    __sync_synchronize();
+    memcpy(elem, &ring->storage[(tail & ring->mask) * ring->elem_size], ring->elem_size);
+    __sync_synchronize();
+    ring->tail = tail + 1u;
+    return true;
+}
+
+uint32_t spsc_ring_count(const spsc_ring_t *ring)
+{
+    return ring->head - ring->tail;
+}
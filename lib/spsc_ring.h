@@ -0,0 +1,82 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file spsc_ring.h
+ * @brief Fila circular sem bloqueio para um produtor e um consumidor.
+ *
+ * Os elementos têm tamanho fixo e a capacidade é uma potência de dois. O índice
+ * de escrita só é alterado pelo produtor e o de leitura só pelo consumidor, de
+ * modo que nenhuma operação atômica de leitura-modificação-escrita é necessária
+ * (o Cortex-M0+ não as possui). O produtor nunca espera: se a fila estiver
+ * cheia, `spsc_ring_push` retorna `false` e cabe a ele contabilizar a perda.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup SPSC_Ring Fila SPSC
+ * @brief Fila circular de elementos de tamanho fixo, sem bloqueio.
+ * @{
+ */
+
+/**
+ * @brief Fila circular de um produtor e um consumidor.
+ */
+typedef struct
+{
+    uint8_t *storage;       /**< Área de armazenamento (capacity * elem_size bytes). */
+    uint32_t elem_size;     /**< Tamanho de cada elemento, em bytes. */
+    uint32_t mask;          /**< Capacidade - 1 (capacidade potência de dois). */
+    volatile uint32_t head; /**< Total de elementos escritos; alterado só pelo produtor. */
+    volatile uint32_t tail; /**< Total de elementos lidos; alterado só pelo consumidor. */
+} spsc_ring_t;
+
+/**
+ * @brief Inicializa a fila sobre uma área de armazenamento estática.
+ *
+ * @param[out] ring Fila a ser inicializada.
+ * @param[in] storage Área com pelo menos `capacity * elem_size` bytes.
+ * @param[in] elem_size Tamanho de cada elemento, em bytes.
+ * @param[in] capacity Quantidade de elementos; deve ser potência de dois.
+ */
+void spsc_ring_init(spsc_ring_t *ring, void *storage, uint32_t elem_size, uint32_t capacity);
+
+/**
+ * @brief Insere um elemento na fila (lado do produtor).
+ *
+ * @param[in,out] ring Fila.
+ * @param[in] elem Elemento a ser copiado para a fila.
+ * @return `true` se inserido, `false` se a fila estava cheia.
+ */
+bool spsc_ring_push(spsc_ring_t *ring, const void *elem);
+
+/**
+ * @brief Retira o elemento mais antigo da fila (lado do consumidor).
+ *
+ * @param[in,out] ring Fila.
+ * @param[out] elem Destino da cópia do elemento.
+ * @return `true` se um elemento foi retirado, `false` se a fila estava vazia.
+ */
+bool spsc_ring_pop(spsc_ring_t *ring, void *elem);
+
+/**
+ * @brief Retorna a quantidade de elementos na fila.
+ *
+ * @param[in] ring Fila.
+ * @return Elementos aguardando consumo.
+ */
+uint32_t spsc_ring_count(const spsc_ring_t *ring);
+
+/** @} */ // Fim do grupo "SPSC_Ring"
+
+#endif // SPSC_RING_H
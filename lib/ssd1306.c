@@ -1,4 +1,9 @@
+#include <string.h>
 #include "ssd1306.h"
+#include "profile.h"
+#include "ram_func.h"
+#include "i2c_trace.h"
+#include "pixaddr.h"
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
   ssd->width = width;
@@ -10,6 +15,20 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  ssd->bus = NULL;
+  ssd->bus_device = NULL;
+}
+
+// Com o gerenciador do barramento, as escritas entram na fila de i2c1 e o quadro é dividido em trechos
+void ssd1306_set_bus(ssd1306_t *ssd, i2c_bus_t *bus, i2c_bus_device_t *device) {
+  ssd->bus = device != NULL ? bus : NULL;
+  ssd->bus_device = device;
+}
+
+static int RAM_FUNC(ssd1306_write)(ssd1306_t *ssd, const uint8_t *src, size_t len) {
+  if (ssd->bus_device != NULL)
+    return i2c_bus_transfer(ssd->bus, ssd->bus_device, src, len, NULL, 0);
+  return i2c_trace_write_blocking(ssd->i2c_port, ssd->address, src, len, false);
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
@@ -40,34 +59,45 @@ void ssd1306_config(ssd1306_t *ssd) {
   ssd1306_command(ssd, SET_DISP | 0x01);
 }
 
-void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+void RAM_FUNC(ssd1306_command)(ssd1306_t *ssd, uint8_t command) {
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->port_buffer,
-    2,
-    false
-  );
+  ssd1306_write(ssd, ssd->port_buffer, 2);
 }
 
-void ssd1306_send_data(ssd1306_t *ssd) {
+void RAM_FUNC(ssd1306_send_data)(ssd1306_t *ssd) {
+  PROFILE_SCOPE(PROFILE_SSD1306_SEND);
   ssd1306_command(ssd, SET_COL_ADDR);
   ssd1306_command(ssd, 0);
   ssd1306_command(ssd, ssd->width - 1);
   ssd1306_command(ssd, SET_PAGE_ADDR);
   ssd1306_command(ssd, 0);
   ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+  ssd1306_write(ssd, ssd->ram_buffer, ssd->bufsize);
 }
 
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+// Bytes de uma janela na ordem do endereçamento vertical, precedidos pelo byte de controle
+static uint8_t ssd1306_window_buffer[WIDTH * HEIGHT / 8 + 1];
+
+// Só a janela vai ao barramento: o display grava coluna a coluna, página a página, dentro dela
+void RAM_FUNC(ssd1306_send_window)(ssd1306_t *ssd, const ssd1306_window_t *window) {
+  PROFILE_SCOPE(PROFILE_SSD1306_SEND);
+  uint8_t pages = window->page1 - window->page0 + 1;
+  size_t len = 1;
+  ssd1306_window_buffer[0] = 0x40;
+  for (uint8_t x = window->x0; x <= window->x1; ++x) {
+    memcpy(&ssd1306_window_buffer[len], &ssd->ram_buffer[1 + x * ssd->pages + window->page0], pages);
+    len += pages;
+  }
+  ssd1306_command(ssd, SET_COL_ADDR);
+  ssd1306_command(ssd, window->x0);
+  ssd1306_command(ssd, window->x1);
+  ssd1306_command(ssd, SET_PAGE_ADDR);
+  ssd1306_command(ssd, window->page0);
+  ssd1306_command(ssd, window->page1);
+  ssd1306_write(ssd, ssd1306_window_buffer, len);
+}
+
+void RAM_FUNC(ssd1306_pixel)(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
   uint16_t index = (y >> 3) + (x << 3) + 1;
   uint8_t pixel = (y & 0b111);
   if (value)
@@ -83,7 +113,8 @@ void ssd1306_fill(ssd1306_t *ssd, bool value) {
     ssd->ram_buffer[i] = byte;
 }*/
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
+void RAM_FUNC(ssd1306_fill)(ssd1306_t *ssd, bool value) {
+    PROFILE_SCOPE(PROFILE_SSD1306_FILL);
     // Itera por todas as posições do display
     for (uint8_t y = 0; y < ssd->height; ++y) {
         for (uint8_t x = 0; x < ssd->width; ++x) {
@@ -94,26 +125,22 @@ void ssd1306_fill(ssd1306_t *ssd, bool value) {
 
 
 
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
-  }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
-  }
+// Arestas e interior como spans (pixaddr.h): o endereço avança sem recalcular (y >> 3) + (x << 3)
+void RAM_FUNC(ssd1306_rect)(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  if (width == 0 || height == 0)
+    return;
+  pixaddr_span(ssd->ram_buffer, PIXADDR_PACK(left, top), PIXADDR_STEP_X, width, value, PIXADDR_USE_INTERP);
+  pixaddr_span(ssd->ram_buffer, PIXADDR_PACK(left, top + height - 1), PIXADDR_STEP_X, width, value, PIXADDR_USE_INTERP);
+  pixaddr_span(ssd->ram_buffer, PIXADDR_PACK(left, top), PIXADDR_STEP_Y, height, value, PIXADDR_USE_INTERP);
+  pixaddr_span(ssd->ram_buffer, PIXADDR_PACK(left + width - 1, top), PIXADDR_STEP_Y, height, value, PIXADDR_USE_INTERP);
 
-  if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
-    }
+  if (fill && width > 2 && height > 2) {
+    for (uint8_t x = left + 1; x < left + width - 1; ++x)
+      pixaddr_span(ssd->ram_buffer, PIXADDR_PACK(x, top + 1), PIXADDR_STEP_Y, height - 2, value, PIXADDR_USE_INTERP);
   }
 }
 
-void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
+void RAM_FUNC(ssd1306_line)(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
     int dx = abs(x1 - x0);
     int dy = abs(y1 - y0);
 
@@ -122,34 +149,48 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 
     int err = dx - dy;
 
+    // O endereço acompanha (x0, y0) na coordenada empacotada (pixaddr.h): ±64 por coluna, ±1 por linha
+    pixaddr_t pixel;
+    pixaddr_begin(&pixel, ssd->ram_buffer, PIXADDR_PACK(x0, y0), PIXADDR_USE_INTERP);
+
     while (true) {
-        ssd1306_pixel(ssd, x0, y0, value); // Desenha o pixel atual
+        // Desenha o pixel atual
+        uint8_t *byte = pixaddr_byte(&pixel);
+        if (value)
+            *byte |= pixaddr_mask(&pixel);
+        else
+            *byte &= ~pixaddr_mask(&pixel);
 
         if (x0 == x1 && y0 == y1) break; // Termina quando alcança o ponto final
 
         int e2 = err * 2;
+        int32_t step = 0;
 
         if (e2 > -dy) {
             err -= dy;
             x0 += sx;
+            step += sx * PIXADDR_STEP_X;
         }
 
         if (e2 < dx) {
             err += dx;
             y0 += sy;
+            step += sy * PIXADDR_STEP_Y;
         }
+
+        pixaddr_step(&pixel, step);
     }
 }
 
 
-void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+void RAM_FUNC(ssd1306_hline)(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  if (x0 <= x1)
+    pixaddr_span(ssd->ram_buffer, PIXADDR_PACK(x0, y), PIXADDR_STEP_X, x1 - x0 + 1, value, PIXADDR_USE_INTERP);
 }
 
-void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+void RAM_FUNC(ssd1306_vline)(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  if (y0 <= y1)
+    pixaddr_span(ssd->ram_buffer, PIXADDR_PACK(x, y0), PIXADDR_STEP_Y, y1 - y0 + 1, value, PIXADDR_USE_INTERP);
 }
 
 /*
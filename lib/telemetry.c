@@ -0,0 +1,225 @@
+#include "telemetry.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file telemetry.c
+ * @brief Implementação dos fluxos de telemetria e da codificação COBS.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/// @brief Fluxos registrados, drenados em rodízio.
+static telemetry_stream_t *streams[TELEMETRY_MAX_STREAMS];
+
+/// @brief Quantidade de fluxos registrados.
+static uint8_t stream_count = 0;
+
+/// @brief Próximo fluxo a ser drenado, para que nenhum monopolize o canal.
+static uint8_t next_stream = 0;
+
+/// @brief Sequência dos registros gerados pelo consumidor.
+static uint16_t consumer_sequence = 0;
+
+/**
+ * @brief Escreve um inteiro de 16 bits em little-endian.
+ */
+static void put_u16(uint8_t *dst, uint16_t value)
+{
+    dst[0] = (uint8_t) value;
+    dst[1] = (uint8_t) (value >> 8);
+}
+
+/**
+ * @brief Escreve um inteiro de 32 bits em little-endian.
+ */
+static void put_u32(uint8_t *dst, uint32_t value)
+{
+    dst[0] = (uint8_t) value;
+    dst[1] = (uint8_t) (value >> 8);
+    dst[2] = (uint8_t) (value >> 16);
+    dst[3] = (uint8_t) (value >> 24);
+}
+
+/**
+ * @brief Monta o cabeçalho e o conteúdo de um registro.
+ *
+ * @return Tamanho total do registro.
+ */
+static uint8_t telemetry_build_record(uint8_t *dst, uint8_t type, uint8_t stream_id, uint16_t sequence,
+                                      uint32_t timestamp_us, const void *payload, uint8_t len)
+{
+    dst[0] = type;
+    dst[1] = stream_id;
+    put_u16(&dst[2], sequence);
+    put_u32(&dst[4], timestamp_us);
+    memcpy(&dst[TELEMETRY_HEADER_SIZE], payload, len);
+    return (uint8_t) (TELEMETRY_HEADER_SIZE + len);
+}
+
+bool telemetry_stream_init(telemetry_stream_t *stream, uint8_t id, telemetry_record_t *storage, uint32_t capacity)
+{
+    spsc_ring_init(&stream->ring, storage, sizeof(telemetry_record_t), capacity);
+    stream->id = id;
+    stream->sequence = 0;
+    stream->emitted = 0;
+    stream->dropped = 0;
+    stream->reported_drops = 0;
+
+    if(stream_count >= TELEMETRY_MAX_STREAMS) return false;
+    streams[stream_count] = stream;
+    __sync_synchronize();
+    stream_count++;
+    return true;
+}
+
+bool telemetry_emit(telemetry_stream_t *stream, uint8_t type, uint32_t timestamp_us, const void *payload, uint8_t len)
+{
+    telemetry_record_t record;
+
+    if(len > TELEMETRY_MAX_PAYLOAD) len = TELEMETRY_MAX_PAYLOAD;
+    record.length = telemetry_build_record(record.bytes, type, stream->id, stream->sequence++,
+                                           timestamp_us, payload, len);
+    stream->emitted++;
+
+    // A sequência avança mesmo na perda, para que o host detecte a lacuna
+    if(!spsc_ring_push(&stream->ring, &record))
+    {
+        stream->dropped++;
+        return false;
+    }
+    return true;
+}
+
+bool telemetry_emit_sample(telemetry_stream_t *stream, uint8_t type, uint32_t timestamp_us, uint16_t x, uint16_t y)
+{
+    uint8_t payload[4];
+    put_u16(&payload[0], x);
+    put_u16(&payload[2], y);
+    return telemetry_emit(stream, type, timestamp_us, payload, sizeof(payload));
+}
+
+bool telemetry_emit_button(telemetry_stream_t *stream, uint32_t timestamp_us, uint8_t gpio, uint8_t event)
+{
+    uint8_t payload[2] = { gpio, event };
+    return telemetry_emit(stream, TELEMETRY_BUTTON_EVENT, timestamp_us, payload, sizeof(payload));
+}
+
+bool telemetry_emit_frame(telemetry_stream_t *stream, uint32_t timestamp_us, uint32_t render_us,
+                          uint32_t flush_us, uint32_t latency_us)
+{
+    uint8_t payload[12];
+    put_u32(&payload[0], render_us);
+    put_u32(&payload[4], flush_us);
+    put_u32(&payload[8], latency_us);
+    return telemetry_emit(stream, TELEMETRY_FRAME_TIMING, timestamp_us, payload, sizeof(payload));
+}
+
+uint32_t telemetry_cobs_encode(const uint8_t *src, uint32_t len, uint8_t *dst)
+{
+    uint32_t code_index = 0;
+    uint32_t out = 1;
+    uint8_t code = 1;
+
+    for(uint32_t i = 0; i < len; i++)
+    {
+        if(src[i] == 0)
+        {
+            dst[code_index] = code;
+            code_index = out++;
+            code = 1;
+        }
+        else
+        {
+            dst[out++] = src[i];
+            if(++code == 0xFF)
+            {
+                dst[code_index] = code;
+                code_index = out++;
+                code = 1;
+            }
+        }
+    }
+    dst[code_index] = code;
+    dst[out++] = 0x00; // Delimitador de quadro
+    return out;
+}
+
+/**
+ * @brief Codifica um registro e o entrega ao destino.
+ *
+ * @return Bytes entregues.
+ */
+static uint32_t telemetry_write_record(const uint8_t *record, uint8_t length, telemetry_write_fn_t write)
+{
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    uint32_t frame_len = telemetry_cobs_encode(record, length, frame);
+    if(write != NULL) write(frame, frame_len);
+    return frame_len;
+}
+
+/**
+ * @brief Envia um registro TELEMETRY_STREAM_STATS para cada fluxo com novas perdas.
+ *
+ * @return Bytes entregues, ou 0 se não houver espaço para todos os registros.
+ */
+static uint32_t telemetry_report_drops(uint32_t now_us, uint32_t max_bytes, telemetry_write_fn_t write)
+{
+    uint8_t record[TELEMETRY_MAX_RECORD];
+    uint8_t payload[9];
+    uint32_t written = 0;
+
+    for(uint8_t i = 0; i < stream_count; i++)
+    {
+        telemetry_stream_t *stream = streams[i];
+        uint32_t dropped = stream->dropped;
+        if(dropped == stream->reported_drops) continue;
+        if(written + TELEMETRY_MAX_FRAME > max_bytes) break;
+
+        payload[0] = stream->id;
+        put_u32(&payload[1], stream->emitted);
+        put_u32(&payload[5], dropped);
+        uint8_t length = telemetry_build_record(record, TELEMETRY_STREAM_STATS, TELEMETRY_STREAM_CONSUMER,
+                                                consumer_sequence++, now_us, payload, sizeof(payload));
+        written += telemetry_write_record(record, length, write);
+        stream->reported_drops = dropped;
+    }
+    return written;
+}
+
+uint32_t telemetry_drain(uint32_t now_us, uint32_t max_bytes, telemetry_write_fn_t write)
+{
+    telemetry_record_t record;
+    uint32_t written = telemetry_report_drops(now_us, max_bytes, write);
+    uint8_t idle_streams = 0;
+
+    while(stream_count > 0 && idle_streams < stream_count && written + TELEMETRY_MAX_FRAME <= max_bytes)
+    {
+        telemetry_stream_t *stream = streams[next_stream];
+        next_stream = (uint8_t) ((next_stream + 1u) % stream_count);
+
+        if(!spsc_ring_pop(&stream->ring, &record))
+        {
+            idle_streams++;
+            continue;
+        }
+        idle_streams = 0;
+        written += telemetry_write_record(record.bytes, record.length, write);
+    }
+    return written;
+}
+
+void telemetry_print_stats(void)
+{
+    for(uint8_t i = 0; i < stream_count; i++)
+    {
+        telemetry_stream_t *stream = streams[i];
+        printf("telemetry[%u]: emitted=%lu dropped=%lu queued=%lu\n", stream->id,
+               (unsigned long) stream->emitted, (unsigned long) stream->dropped,
+               (unsigned long) spsc_ring_count(&stream->ring));
+    }
+}
@@ -0,0 +1,196 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "spsc_ring.h"
+
+/**
+ * @file telemetry.h
+ * @brief Protocolo binário de telemetria com enquadramento COBS.
+ *
+ * Cada contexto produtor (interrupção de amostragem, interrupção dos botões,
+ * laço principal) possui seu próprio fluxo, com uma fila SPSC de registros.
+ * Emitir um registro nunca bloqueia: se a fila estiver cheia, o registro é
+ * descartado e o contador de perdas do fluxo é incrementado. O consumidor
+ * drena os fluxos, codifica cada registro em COBS e o termina com um byte 0x00.
+ *
+ * Formato de um registro (little-endian), antes da codificação COBS:
+ *
+ * | Byte | Campo        | Descrição                                        |
+ * |------|--------------|--------------------------------------------------|
+ * | 0    | type         | Tipo do registro (telemetry_type_t)              |
+ * | 1    | stream       | Identificador do fluxo produtor                  |
+ * | 2-3  | sequence     | Sequência do fluxo (lacunas indicam perdas)      |
+ * | 4-7  | timestamp_us | Instante do evento, em us desde o boot           |
+ * | 8-   | payload      | Conteúdo específico do tipo                      |
+ *
+ * O decodificador do host está em tools/telemetry_decode.py.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup Telemetry Telemetria
+ * @brief Registros binários, filas por produtor e codificação COBS.
+ * @{
+ */
+
+/** @brief Tamanho do cabeçalho de um registro. */
+#define TELEMETRY_HEADER_SIZE 8
+
+/** @brief Maior conteúdo suportado por um registro. */
+#define TELEMETRY_MAX_PAYLOAD 16
+
+/** @brief Maior registro, antes da codificação. */
+#define TELEMETRY_MAX_RECORD (TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_PAYLOAD)
+
+/** @brief Maior quadro codificado: registro + sobrecarga COBS + delimitador. */
+#define TELEMETRY_MAX_FRAME (TELEMETRY_MAX_RECORD + TELEMETRY_MAX_RECORD / 254 + 2)
+
+/** @brief Quantidade máxima de fluxos registrados. */
+#define TELEMETRY_MAX_STREAMS 4
+
+/** @brief Identificador reservado aos registros gerados pelo próprio consumidor. */
+#define TELEMETRY_STREAM_CONSUMER 0xFF
+
+/**
+ * @brief Tipos de registro.
+ */
+typedef enum
+{
+    TELEMETRY_RAW_SAMPLE = 1,  /**< x, y (u16): leitura bruta do ADC. */
+    TELEMETRY_FILTERED_SAMPLE, /**< x, y (u16): leitura após a zona morta. */
+    TELEMETRY_BUTTON_EVENT,    /**< gpio (u8), evento (u8). */
+    TELEMETRY_FRAME_TIMING,    /**< render, flush, latência (u32, em us). */
+    TELEMETRY_STREAM_STATS,    /**< fluxo (u8), emitidos (u32), perdidos (u32). */
+    TELEMETRY_FRAMEBUFFER      /**< quadro (u16), deslocamento (u16), flags (u8), delta do framebuffer (fb_mirror.h). */
+} telemetry_type_t;
+
+/**
+ * @brief Posição da fila que guarda um registro ainda não codificado.
+ */
+typedef struct
+{
+    uint8_t length;                      /**< Bytes válidos em `bytes`. */
+    uint8_t bytes[TELEMETRY_MAX_RECORD]; /**< Cabeçalho seguido do conteúdo. */
+} telemetry_record_t;
+
+/**
+ * @brief Fluxo de telemetria de um único contexto produtor.
+ */
+typedef struct
+{
+    spsc_ring_t ring;          /**< Registros aguardando envio. */
+    uint8_t id;                /**< Identificador do fluxo. */
+    uint16_t sequence;         /**< Sequência do próximo registro. */
+    uint32_t emitted;          /**< Registros emitidos (enfileirados ou perdidos). */
+    volatile uint32_t dropped; /**< Registros perdidos por fila cheia. */
+    uint32_t reported_drops;   /**< Perdas já informadas ao host (lado do consumidor). */
+} telemetry_stream_t;
+
+/**
+ * @brief Função que recebe os bytes codificados.
+ *
+ * @param data Bytes a serem transmitidos.
+ * @param len Quantidade de bytes.
+ */
+typedef void (*telemetry_write_fn_t)(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief Inicializa e registra um fluxo de telemetria.
+ *
+ * @param[out] stream Fluxo a ser inicializado.
+ * @param[in] id Identificador do fluxo, repetido em cada registro.
+ * @param[in] storage Posições da fila (estáticas).
+ * @param[in] capacity Quantidade de posições; deve ser potência de dois.
+ * @return `true` se registrado, `false` se o limite de fluxos foi atingido.
+ */
+bool telemetry_stream_init(telemetry_stream_t *stream, uint8_t id, telemetry_record_t *storage, uint32_t capacity);
+
+/**
+ * @brief Emite um registro genérico no fluxo, sem bloquear.
+ *
+ * @param[in,out] stream Fluxo do contexto chamador.
+ * @param[in] type Tipo do registro.
+ * @param[in] timestamp_us Instante do evento.
+ * @param[in] payload Conteúdo já serializado em little-endian.
+ * @param[in] len Tamanho do conteúdo (até TELEMETRY_MAX_PAYLOAD).
+ * @return `true` se enfileirado, `false` se perdido.
+ */
+bool telemetry_emit(telemetry_stream_t *stream, uint8_t type, uint32_t timestamp_us, const void *payload, uint8_t len);
+
+/**
+ * @brief Emite uma amostra dos eixos (bruta ou filtrada).
+ *
+ * @param[in,out] stream Fluxo do contexto chamador.
+ * @param[in] type TELEMETRY_RAW_SAMPLE ou TELEMETRY_FILTERED_SAMPLE.
+ * @param[in] timestamp_us Instante da leitura.
+ * @param[in] x Eixo X.
+ * @param[in] y Eixo Y.
+ * @return `true` se enfileirado, `false` se perdido.
+ */
+bool telemetry_emit_sample(telemetry_stream_t *stream, uint8_t type, uint32_t timestamp_us, uint16_t x, uint16_t y);
+
+/**
+ * @brief Emite um evento de botão.
+ *
+ * @param[in,out] stream Fluxo do contexto chamador.
+ * @param[in] timestamp_us Instante do evento.
+ * @param[in] gpio Pino do botão.
+ * @param[in] event Código do evento.
+ * @return `true` se enfileirado, `false` se perdido.
+ */
+bool telemetry_emit_button(telemetry_stream_t *stream, uint32_t timestamp_us, uint8_t gpio, uint8_t event);
+
+/**
+ * @brief Emite os tempos de um quadro do display.
+ *
+ * @param[in,out] stream Fluxo do contexto chamador.
+ * @param[in] timestamp_us Instante de término do quadro.
+ * @param[in] render_us Tempo de rasterização.
+ * @param[in] flush_us Tempo de envio ao display.
+ * @param[in] latency_us Latência desde a leitura do ADC.
+ * @return `true` se enfileirado, `false` se perdido.
+ */
+bool telemetry_emit_frame(telemetry_stream_t *stream, uint32_t timestamp_us, uint32_t render_us,
+                          uint32_t flush_us, uint32_t latency_us);
+
+/**
+ * @brief Codifica um bloco em COBS e acrescenta o delimitador 0x00.
+ *
+ * @param[in] src Bytes a serem codificados.
+ * @param[in] len Quantidade de bytes.
+ * @param[out] dst Destino, com pelo menos `len + len / 254 + 2` bytes.
+ * @return Bytes escritos em `dst`, incluindo o delimitador.
+ */
+uint32_t telemetry_cobs_encode(const uint8_t *src, uint32_t len, uint8_t *dst);
+
+/**
+ * @brief Drena os fluxos registrados, codificando os registros em quadros COBS.
+ *
+ * Os fluxos são percorridos em rodízio até a fila esvaziar ou até o próximo
+ * quadro não caber em `max_bytes`. Se algum fluxo tiver novas perdas, um
+ * registro TELEMETRY_STREAM_STATS é enviado antes dos demais.
+ *
+ * @param[in] now_us Instante atual, usado nos registros gerados pelo consumidor.
+ * @param[in] max_bytes Espaço disponível no destino.
+ * @param[in] write Destino dos quadros; se `NULL`, os registros são descartados.
+ * @return Bytes entregues a `write`.
+ */
+uint32_t telemetry_drain(uint32_t now_us, uint32_t max_bytes, telemetry_write_fn_t write);
+
+/**
+ * @brief Imprime, pelo USB stdio, a ocupação e as perdas de cada fluxo.
+ */
+void telemetry_print_stats(void);
+
+/** @} */ // Fim do grupo "Telemetry"
+
+#endif // TELEMETRY_H
@@ -0,0 +1,58 @@
+#include "telemetry_usb.h"
+#include "telemetry.h"
+#include "fb_mirror.h"
+#include "usb_device.h"
+#include "tusb.h"
+#include "hardware/timer.h"
+
+/**
+ * @file telemetry_usb.c
+ * @brief Envio dos quadros de telemetria pela interface CDC de telemetria.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @brief Copia um quadro codificado para o buffer de transmissão CDC.
+ *
+ * @param data Quadro codificado.
+ * @param len Tamanho do quadro.
+ */
+static void telemetry_usb_write(const uint8_t *data, uint32_t len)
+{
+    tud_cdc_n_write(USB_CDC_TELEMETRY, data, len);
+}
+
+/**
+ * @brief Tratador de início de quadro USB: drena a telemetria e, no espaço restante, o espelho do framebuffer.
+ *
+ * @param frame_count Número do quadro USB.
+ */
+static void telemetry_usb_frame_handler(uint32_t frame_count)
+{
+    (void) frame_count;
+
+    if(!tud_cdc_n_connected(USB_CDC_TELEMETRY))
+    {
+        telemetry_drain(time_us_32(), UINT32_MAX, NULL);
+        fb_mirror_drain(0, NULL);
+        return;
+    }
+
+    uint32_t available = tud_cdc_n_write_available(USB_CDC_TELEMETRY);
+    uint32_t written = telemetry_drain(time_us_32(), available, telemetry_usb_write);
+    written += fb_mirror_drain(available - written, telemetry_usb_write);
+    if(written > 0)
+    {
+        tud_cdc_n_write_flush(USB_CDC_TELEMETRY);
+    }
+}
+
+void telemetry_usb_init(void)
+{
+    usb_device_add_frame_handler(telemetry_usb_frame_handler);
+}
@@ -0,0 +1,32 @@
+#ifndef TELEMETRY_USB_H
+#define TELEMETRY_USB_H
+
+/**
+ * @file telemetry_usb.h
+ * @brief Transporte da telemetria pela segunda interface CDC do USB.
+ *
+ * A cada quadro USB (1 ms) os fluxos de telemetria são drenados para o buffer
+ * de transmissão da interface CDC de telemetria, até o limite do espaço livre.
+ * Sem um host conectado (DTR desativado), os registros são descartados sem
+ * contar como perda, para que o contador reflita apenas estouros reais.
+ *
+ * O espaço que sobra após a telemetria é usado pelo espelho do framebuffer
+ * (fb_mirror.h), que envia seu quadro pendente em registros próprios.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @brief Registra o envio da telemetria como tratador de início de quadro USB.
+ *
+ * @note `usb_device_init()` deve ter sido chamada antes.
+ */
+void telemetry_usb_init(void);
+
+#endif // TELEMETRY_USB_H
@@ -0,0 +1,50 @@
+#ifndef TUSB_CONFIG_H
+#define TUSB_CONFIG_H
+
+/**
+ * @file tusb_config.h
+ * @brief Configuração do TinyUSB para o dispositivo composto do JoyTracker.
+ *
+ * O dispositivo expõe duas interfaces CDC (USB stdio do pico-sdk e fluxo
+ * binário de telemetria) e uma interface HID (gamepad ou mouse) consultada
+ * pelo host a cada 1 ms.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+#ifndef CFG_TUSB_MCU
+#error CFG_TUSB_MCU must be defined
+#endif
+
+#define CFG_TUSB_RHPORT0_MODE   OPT_MODE_DEVICE
+
+#ifndef CFG_TUSB_OS
+#define CFG_TUSB_OS             OPT_OS_PICO
+#endif
+
+#ifndef CFG_TUSB_MEM_ALIGN
+#define CFG_TUSB_MEM_ALIGN      __attribute__ ((aligned(4)))
+#endif
+
+#define CFG_TUD_ENABLED         1
+#define CFG_TUD_ENDPOINT0_SIZE  64
+
+/// @brief Classes habilitadas: CDC (stdio e telemetria) e HID (gamepad/mouse).
+#define CFG_TUD_CDC             2
+#define CFG_TUD_HID             1
+#define CFG_TUD_MSC             0
+#define CFG_TUD_MIDI            0
+#define CFG_TUD_VENDOR          0
+
+/// @brief Buffers das interfaces CDC; o de transmissão comporta alguns ms de telemetria.
+#define CFG_TUD_CDC_RX_BUFSIZE  256
+#define CFG_TUD_CDC_TX_BUFSIZE  1024
+
+/// @brief Tamanho do endpoint HID: maior relatório (gamepad) mais o identificador.
+#define CFG_TUD_HID_EP_BUFSIZE  16
+
+#endif // TUSB_CONFIG_H
@@ -0,0 +1,157 @@
+#include "tusb.h"
+#include "pico/unique_id.h"
+#include "hid_report.h"
+
+/**
+ * @file usb_descriptors.c
+ * @brief Descritores USB do dispositivo composto (2x CDC + HID).
+ *
+ * A primeira interface CDC mantém o USB stdio do pico-sdk funcionando e a
+ * segunda transporta o fluxo binário de telemetria; a interface HID
+ * declara dois relatórios (gamepad e mouse) em um único endpoint de interrupção
+ * com intervalo de consulta de 1 ms.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/// @brief Identificadores USB. O PID deve ser trocado por um registrado antes de distribuir.
+#define USB_VID 0x2E8A
+#define USB_PID 0x4001
+#define USB_BCD 0x0200
+
+/// @brief Intervalo de consulta do endpoint HID, em milissegundos (full-speed).
+#define HID_POLL_INTERVAL_MS 1
+
+/// @brief Numeração das interfaces.
+enum
+{
+    ITF_NUM_CDC = 0,
+    ITF_NUM_CDC_DATA,
+    ITF_NUM_TELEMETRY,
+    ITF_NUM_TELEMETRY_DATA,
+    ITF_NUM_HID,
+    ITF_NUM_TOTAL
+};
+
+/// @brief Endereços dos endpoints.
+#define EPNUM_CDC_NOTIF 0x81
+#define EPNUM_CDC_OUT   0x02
+#define EPNUM_CDC_IN    0x82
+#define EPNUM_TLM_NOTIF 0x83
+#define EPNUM_TLM_OUT   0x04
+#define EPNUM_TLM_IN    0x84
+#define EPNUM_HID       0x85
+
+/// @brief Índices dos descritores de texto.
+enum
+{
+    STRID_LANGID = 0,
+    STRID_MANUFACTURER,
+    STRID_PRODUCT,
+    STRID_SERIAL,
+    STRID_CDC,
+    STRID_TELEMETRY,
+    STRID_HID
+};
+
+#define CONFIG_TOTAL_LEN (TUD_CONFIG_DESC_LEN + 2 * TUD_CDC_DESC_LEN + TUD_HID_DESC_LEN)
+
+/// @brief Descritor do dispositivo (composto, com Interface Association).
+static const tusb_desc_device_t desc_device =
+{
+    .bLength            = sizeof(tusb_desc_device_t),
+    .bDescriptorType    = TUSB_DESC_DEVICE,
+    .bcdUSB             = USB_BCD,
+    .bDeviceClass       = TUSB_CLASS_MISC,
+    .bDeviceSubClass    = MISC_SUBCLASS_COMMON,
+    .bDeviceProtocol    = MISC_PROTOCOL_IAD,
+    .bMaxPacketSize0    = CFG_TUD_ENDPOINT0_SIZE,
+    .idVendor           = USB_VID,
+    .idProduct          = USB_PID,
+    .bcdDevice          = 0x0100,
+    .iManufacturer      = STRID_MANUFACTURER,
+    .iProduct           = STRID_PRODUCT,
+    .iSerialNumber      = STRID_SERIAL,
+    .bNumConfigurations = 1
+};
+
+/// @brief Descritor de relatório HID: gamepad e mouse, distinguidos pelo identificador.
+static const uint8_t desc_hid_report[] =
+{
+    TUD_HID_REPORT_DESC_GAMEPAD(HID_REPORT_ID(HID_REPORT_ID_GAMEPAD)),
+    TUD_HID_REPORT_DESC_MOUSE(HID_REPORT_ID(HID_REPORT_ID_MOUSE))
+};
+
+/// @brief Descritor de configuração.
+static const uint8_t desc_configuration[] =
+{
+    TUD_CONFIG_DESCRIPTOR(1, ITF_NUM_TOTAL, 0, CONFIG_TOTAL_LEN, 0x00, 100),
+    TUD_CDC_DESCRIPTOR(ITF_NUM_CDC, STRID_CDC, EPNUM_CDC_NOTIF, 8, EPNUM_CDC_OUT, EPNUM_CDC_IN, 64),
+    TUD_CDC_DESCRIPTOR(ITF_NUM_TELEMETRY, STRID_TELEMETRY, EPNUM_TLM_NOTIF, 8, EPNUM_TLM_OUT, EPNUM_TLM_IN, 64),
+    TUD_HID_DESCRIPTOR(ITF_NUM_HID, STRID_HID, HID_ITF_PROTOCOL_NONE, sizeof(desc_hid_report),
+                       EPNUM_HID, CFG_TUD_HID_EP_BUFSIZE, HID_POLL_INTERVAL_MS)
+};
+
+/// @brief Descritores de texto (o número de série é lido da flash).
+static const char *const desc_strings[] =
+{
+    [STRID_MANUFACTURER] = "Carlos Valadao",
+    [STRID_PRODUCT]      = "JoyTracker",
+    [STRID_SERIAL]       = NULL,
+    [STRID_CDC]          = "JoyTracker stdio",
+    [STRID_TELEMETRY]    = "JoyTracker telemetry",
+    [STRID_HID]          = "JoyTracker HID"
+};
+
+uint8_t const *tud_descriptor_device_cb(void)
+{
+    return (uint8_t const *) &desc_device;
+}
+
+uint8_t const *tud_descriptor_configuration_cb(uint8_t index)
+{
+    (void) index;
+    return desc_configuration;
+}
+
+uint8_t const *tud_hid_descriptor_report_cb(uint8_t instance)
+{
+    (void) instance;
+    return desc_hid_report;
+}
+
+uint16_t const *tud_descriptor_string_cb(uint8_t index, uint16_t langid)
+{
+    static uint16_t desc_str[32 + 1];
+    char serial[2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES + 1];
+    const char *str;
+    uint8_t len;
+
+    (void) langid;
+    if(index == STRID_LANGID)
+    {
+        desc_str[1] = 0x0409; // Inglês (EUA)
+        len = 1;
+    }
+    else
+    {
+        if(index >= sizeof(desc_strings) / sizeof(desc_strings[0])) return NULL;
+        if(index == STRID_SERIAL)
+        {
+            pico_get_unique_board_id_string(serial, sizeof(serial));
+            str = serial;
+        }
+        else
+        {
+            str = desc_strings[index];
+        }
+        for(len = 0; len < 32 && str[len]; len++) desc_str[1 + len] = (uint8_t) str[len];
+    }
+
+    desc_str[0] = (uint16_t) ((TUSB_DESC_STRING << 8) | (2 * len + 2));
+    return desc_str;
+}
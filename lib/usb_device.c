@@ -0,0 +1,49 @@
+#include "usb_device.h"
+#include "tusb.h"
+#include "event_trace.h"
+
+/**
+ * @file usb_device.c
+ * @brief Inicialização do TinyUSB e despacho do callback de início de quadro.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/// @brief Tratadores registrados, chamados na ordem de registro.
+static usb_frame_handler_t frame_handlers[USB_DEVICE_MAX_FRAME_HANDLERS];
+
+/// @brief Quantidade de tratadores registrados.
+static volatile uint8_t frame_handler_count = 0;
+
+void usb_device_init(void)
+{
+    tusb_init();
+}
+
+bool usb_device_add_frame_handler(usb_frame_handler_t handler)
+{
+    if(frame_handler_count >= USB_DEVICE_MAX_FRAME_HANDLERS) return false;
+    frame_handlers[frame_handler_count] = handler;
+    __sync_synchronize();
+    frame_handler_count++;
+    tud_sof_cb_enable(true);
+    return true;
+}
+
+/**
+ * @brief Callback de início de quadro USB: chama os tratadores registrados.
+ *
+ * @param frame_count Número do quadro USB.
+ */
+void tud_sof_cb(uint32_t frame_count)
+{
+    EVENT_TRACE_SCOPE(EVENT_TRACE_USB_FRAME, 0);
+    for(uint8_t i = 0; i < frame_handler_count; i++)
+    {
+        frame_handlers[i](frame_count);
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef USB_DEVICE_H
+#define USB_DEVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file usb_device.h
+ * @brief Inicialização do dispositivo USB composto e tarefas por quadro USB.
+ *
+ * Centraliza a inicialização do TinyUSB e distribui o callback de início de
+ * quadro (SOF, 1 kHz em full-speed) entre os módulos que precisam enviar dados
+ * periodicamente (HID, telemetria). Os tratadores rodam no contexto do
+ * TinyUSB, que o USB stdio executa em interrupção de baixa prioridade.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup USB_Device Dispositivo USB
+ * @brief Inicialização do TinyUSB e tratadores de início de quadro.
+ * @{
+ */
+
+/** @brief Quantidade máxima de tratadores de início de quadro. */
+#define USB_DEVICE_MAX_FRAME_HANDLERS 4
+
+/** @brief Interface CDC usada pelo USB stdio. */
+#define USB_CDC_STDIO 0
+
+/** @brief Interface CDC usada pelo fluxo binário de telemetria. */
+#define USB_CDC_TELEMETRY 1
+
+/**
+ * @brief Tratador chamado a cada início de quadro USB.
+ *
+ * @param frame_count Número do quadro USB.
+ */
+typedef void (*usb_frame_handler_t)(uint32_t frame_count);
+
+/**
+ * @brief Inicializa o TinyUSB com os descritores compostos da aplicação.
+ *
+ * @note Deve ser chamada antes de `stdio_init_all()`.
+ */
+void usb_device_init(void);
+
+/**
+ * @brief Registra um tratador de início de quadro.
+ *
+ * @param[in] handler Função chamada a cada 1 ms no contexto do TinyUSB.
+ * @return `true` se registrado, `false` se não houver espaço.
+ */
+bool usb_device_add_frame_handler(usb_frame_handler_t handler);
+
+/** @} */ // Fim do grupo "USB_Device"
+
+#endif // USB_DEVICE_H
@@ -0,0 +1,94 @@
+#include "usb_hid.h"
+#include "usb_device.h"
+#include "tusb.h"
+
+/**
+ * @file usb_hid.c
+ * @brief Integração dos relatórios HID com o TinyUSB.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/// @brief Instância HID única declarada em usb_descriptors.c.
+#define USB_HID_INSTANCE 0
+
+/// @brief Fonte das leituras dos eixos e botões.
+static usb_hid_input_fn_t hid_read_input = NULL;
+
+/// @brief Estado de geração dos relatórios (frações do mouse e zona morta).
+static hid_report_state_t hid_state;
+
+/// @brief Modo de operação selecionado.
+static volatile hid_mode_t hid_mode = HID_MODE_GAMEPAD;
+
+/// @brief Relatórios entregues ao TinyUSB.
+static volatile uint32_t hid_report_count = 0;
+
+static void usb_hid_frame_handler(uint32_t frame_count);
+
+void usb_hid_init(usb_hid_input_fn_t read_input, uint16_t deadzone)
+{
+    hid_read_input = read_input;
+    hid_report_init(&hid_state, deadzone);
+    usb_device_add_frame_handler(usb_hid_frame_handler);
+}
+
+void usb_hid_set_mode(hid_mode_t mode) { hid_mode = mode; }
+
+hid_mode_t usb_hid_get_mode(void) { return hid_mode; }
+
+uint32_t usb_hid_get_report_count(void) { return hid_report_count; }
+
+/**
+ * @brief Tratador de início de quadro USB (1 kHz em full-speed).
+ *
+ * Monta o relatório com uma leitura fresca e o entrega ao endpoint, que será
+ * consultado pelo host ainda neste quadro. Se o relatório anterior ainda não
+ * tiver sido lido, este quadro é pulado.
+ *
+ * @param frame_count Número do quadro USB.
+ */
+static void usb_hid_frame_handler(uint32_t frame_count)
+{
+    (void) frame_count;
+    hid_report_input_t input;
+
+    if(hid_read_input == NULL || !tud_hid_n_ready(USB_HID_INSTANCE)) return;
+    hid_read_input(&input);
+
+    if(hid_mode == HID_MODE_MOUSE)
+    {
+        hid_report_mouse_t report;
+        hid_report_build_mouse(&hid_state, &input, &report);
+        if(tud_hid_n_report(USB_HID_INSTANCE, HID_REPORT_ID_MOUSE, &report, sizeof(report))) hid_report_count++;
+    }
+    else
+    {
+        hid_report_gamepad_t report;
+        hid_report_build_gamepad(&hid_state, &input, &report);
+        if(tud_hid_n_report(USB_HID_INSTANCE, HID_REPORT_ID_GAMEPAD, &report, sizeof(report))) hid_report_count++;
+    }
+}
+
+/**
+ * @brief Requisição GET_REPORT do host: não suportada, o host recebe STALL.
+ */
+uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type,
+                               uint8_t *buffer, uint16_t reqlen)
+{
+    (void) instance; (void) report_id; (void) report_type; (void) buffer; (void) reqlen;
+    return 0;
+}
+
+/**
+ * @brief Requisição SET_REPORT do host: sem relatórios de saída, é ignorada.
+ */
+void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type,
+                           uint8_t const *buffer, uint16_t bufsize)
+{
+    (void) instance; (void) report_id; (void) report_type; (void) buffer; (void) bufsize;
+}
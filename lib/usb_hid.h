@@ -0,0 +1,71 @@
+#ifndef USB_HID_H
+#define USB_HID_H
+
+#include <stdint.h>
+#include "hid_report.h"
+
+/**
+ * @file usb_hid.h
+ * @brief Interface HID (gamepad ou mouse relativo) do JoyTracker sobre o TinyUSB.
+ *
+ * Os relatórios são montados no início de cada quadro USB (SOF, 1 kHz), a partir
+ * de uma leitura fresca fornecida pela aplicação, e enviados pelo contexto do
+ * TinyUSB. Como esse contexto roda em interrupção, o envio não é afetado pelo
+ * envio bloqueante de quadros ao OLED no laço principal.
+ *
+ * @note `usb_device_init()` deve ser chamada antes desta interface.
+ *
+ * @author Carlos Valadão
+ * @date 2026-10-18
+ * @version 1.0
+ * @license GNU General Public License v3.0 (GPLv3)
+ *
+ * @copyright
+ * Copyright (C) 2025 Carlos Valadão
+ */
+
+/**
+ * @defgroup USB_HID Interface USB HID
+ * @brief Envio de relatórios HID a 1 kHz.
+ * @{
+ */
+
+/**
+ * @brief Função que fornece a leitura atual dos eixos e botões.
+ *
+ * É chamada no contexto do TinyUSB uma vez por quadro USB e não deve bloquear.
+ */
+typedef void (*usb_hid_input_fn_t)(hid_report_input_t *input);
+
+/**
+ * @brief Inicializa a interface HID e habilita o callback de início de quadro.
+ *
+ * @param[in] read_input Função que fornece a leitura atual dos eixos e botões.
+ * @param[in] deadzone Zona morta dos eixos, em contagens do ADC.
+ */
+void usb_hid_init(usb_hid_input_fn_t read_input, uint16_t deadzone);
+
+/**
+ * @brief Seleciona o tipo de relatório enviado (gamepad ou mouse).
+ *
+ * @param[in] mode Novo modo de operação.
+ */
+void usb_hid_set_mode(hid_mode_t mode);
+
+/**
+ * @brief Retorna o modo de operação atual.
+ *
+ * @return Modo de operação da interface HID.
+ */
+hid_mode_t usb_hid_get_mode(void);
+
+/**
+ * @brief Retorna quantos relatórios foram entregues ao TinyUSB desde o boot.
+ *
+ * @return Contagem de relatórios enviados.
+ */
+uint32_t usb_hid_get_report_count(void);
+
+/** @} */ // Fim do grupo "USB_HID"
+
+#endif // USB_HID_H
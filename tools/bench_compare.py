@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""Comparação de duas execuções dos micro-benchmarks do JoyTracker.
+
+Lê dois CSVs gerados por ``joytracker_bench`` (ou capturados da CDC do
+``JoyTrackerBench``) e mostra, por caso, o tempo de cada execução e a
+variação. Sai com código 1 se algum caso ficou mais lento que o limite.
+
+Uso:
+    bench_compare.py base.csv atual.csv
+    bench_compare.py base.csv atual.csv --threshold 10
+
+Linhas iniciadas por ``#`` são ignoradas, assim como o eco do terminal.
+"""
+
+import argparse
+import csv
+import sys
+
+COLUMNS = ("benchmark", "platform", "iterations", "ns_per_op", "bytes_per_op")
+
+
+def load(path):
+    """Carrega um CSV de resultados: benchmark -> (plataforma, ns/op, bytes/op)."""
+    results = {}
+    with open(path, newline="", encoding="utf-8", errors="replace") as handle:
+        lines = (line for line in handle if line.strip() and not line.startswith("#"))
+        for row in csv.reader(lines):
+            if len(row) != len(COLUMNS) or row[0] == COLUMNS[0]:
+                continue
+            try:
+                results[row[0]] = (row[1], float(row[3]), int(row[4]))
+            except ValueError:
+                continue
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("base", help="CSV de referência")
+    parser.add_argument("current", help="CSV da execução atual")
+    parser.add_argument("-t", "--threshold", type=float, default=5.0,
+                        help="piora máxima tolerada, em %% (padrão: 5)")
+    args = parser.parse_args()
+
+    base = load(args.base)
+    current = load(args.current)
+    if not base or not current:
+        print("nenhum resultado encontrado", file=sys.stderr)
+        sys.exit(2)
+
+    regressions = 0
+    print(f"{'benchmark':<24} {'base ns/op':>14} {'atual ns/op':>14} {'variação':>10}")
+    for name in list(base) + [name for name in current if name not in base]:
+        if name not in base or name not in current:
+            only = "base" if name in base else "atual"
+            print(f"{name:<24} {'(só em ' + only + ')':>40}")
+            continue
+        platform_base, ns_base, bytes_base = base[name]
+        platform_cur, ns_cur, bytes_cur = current[name]
+        if platform_base != platform_cur:
+            print(f"aviso: {name} medido em {platform_base} e {platform_cur}", file=sys.stderr)
+        if bytes_base != bytes_cur:
+            print(f"aviso: {name} mudou de {bytes_base} para {bytes_cur} bytes/op", file=sys.stderr)
+
+        delta = (ns_cur - ns_base) / ns_base * 100.0 if ns_base > 0 else 0.0
+        mark = ""
+        if delta > args.threshold:
+            mark = "  <- regressão"
+            regressions += 1
+        print(f"{name:<24} {ns_base:>14.1f} {ns_cur:>14.1f} {delta:>+9.1f}%{mark}")
+
+    if regressions:
+        print(f"{regressions} caso(s) acima de {args.threshold:.1f}%", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""Reconstrutor do espelho do framebuffer do JoyTracker.
+
+Lê o fluxo da interface CDC de telemetria (ou um arquivo capturado, como o
+gravado por ``joytracker_sim -T telemetria.bin``), junta os registros
+TELEMETRY_FRAMEBUFFER de cada quadro, aplica os deltas XOR + RLE sobre o
+último quadro reconstruído e grava cada quadro como PBM, além de um índice
+``frames.csv``. Os demais registros de telemetria são ignorados.
+
+Após uma lacuna na sequência dos registros, os deltas são descartados até o
+próximo quadro-chave.
+
+Uso:
+    fb_mirror_view.py /dev/ttyACM1 -o espelho/
+    fb_mirror_view.py telemetria.bin -o espelho/
+
+O formato está documentado em lib/fb_mirror.h.
+"""
+
+import argparse
+import csv
+import os
+import struct
+import sys
+
+from telemetry_decode import HEADER, cobs_decode, open_source, read_frames
+
+TYPE_FRAMEBUFFER = 6
+CHUNK = struct.Struct("<HHB")
+FLAG_KEYFRAME = 0x01
+FLAG_LAST = 0x02
+
+WIDTH, HEIGHT = 128, 64
+FB_SIZE = WIDTH * HEIGHT // 8
+
+
+def apply_delta(framebuffer, encoded):
+    """Aplica um quadro codificado (tokens SKIP/FILL/LITERAL) ao framebuffer."""
+    i = pos = 0
+    while i < len(encoded):
+        token, count = encoded[i] & 0xC0, (encoded[i] & 0x3F) + 1
+        i += 1
+        if pos + count > FB_SIZE:
+            raise ValueError("delta além do framebuffer")
+        if token == 0x40:
+            for k in range(count):
+                framebuffer[pos + k] ^= encoded[i]
+            i += 1
+        elif token == 0x80:
+            for k in range(count):
+                framebuffer[pos + k] ^= encoded[i + k]
+            i += count
+        elif token != 0x00:
+            raise ValueError("token inválido")
+        pos += count
+
+
+def write_pbm(path, framebuffer):
+    """Grava o framebuffer (colunas de 8 pixels, bit 0 no alto) como PBM; 1 é preto."""
+    rows = bytearray()
+    for y in range(HEIGHT):
+        for b in range(WIDTH // 8):
+            bits = 0
+            for k in range(8):
+                x = b * 8 + k
+                if not (framebuffer[x * 8 + (y >> 3)] >> (y & 7)) & 1:
+                    bits |= 0x80 >> k
+            rows.append(bits)
+    with open(path, "wb") as handle:
+        handle.write(b"P4\n%d %d\n" % (WIDTH, HEIGHT) + bytes(rows))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source", help="porta CDC de telemetria, arquivo capturado ou '-'")
+    parser.add_argument("-o", "--output", default="mirror", help="diretório dos quadros PBM")
+    parser.add_argument("-n", "--max-frames", type=int, default=0, help="para após N quadros")
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    framebuffer = bytearray(FB_SIZE)
+    pending, pending_frame = bytearray(), None
+    synced, next_sequence = False, None
+    written = skipped = lost = encoded_total = 0
+
+    index_file = open(os.path.join(args.output, "frames.csv"), "w", newline="")
+    index = csv.writer(index_file)
+    index.writerow(("file", "frame", "timestamp_us", "keyframe", "bytes"))
+    source = open_source(args.source)
+    try:
+        for raw in read_frames(source):
+            try:
+                record = cobs_decode(raw)
+                rtype, _, sequence, timestamp = HEADER.unpack_from(record)
+                if rtype != TYPE_FRAMEBUFFER:
+                    continue
+                frame, offset, flags = CHUNK.unpack_from(record, HEADER.size)
+            except (ValueError, struct.error):
+                continue
+            data = record[HEADER.size + CHUNK.size:]
+
+            # Registro perdido: o quadro em montagem e os deltas seguintes não valem
+            if next_sequence is not None and sequence != next_sequence:
+                lost += (sequence - next_sequence) & 0xFFFF
+                synced, pending_frame = False, None
+            next_sequence = (sequence + 1) & 0xFFFF
+
+            if offset == 0:
+                pending, pending_frame = bytearray(), frame
+            if frame != pending_frame or offset != len(pending):
+                pending_frame = None
+                continue
+            pending += data
+            if not flags & FLAG_LAST:
+                continue
+            pending_frame = None
+
+            if flags & FLAG_KEYFRAME:
+                framebuffer[:] = bytes(FB_SIZE)
+                synced = True
+            if not synced:
+                skipped += 1
+                continue
+            try:
+                apply_delta(framebuffer, pending)
+            except (ValueError, IndexError):
+                synced = False
+                skipped += 1
+                continue
+
+            name = f"frame_{written:05d}.pbm"
+            write_pbm(os.path.join(args.output, name), framebuffer)
+            index.writerow((name, frame, timestamp, int(bool(flags & FLAG_KEYFRAME)), len(pending)))
+            written += 1
+            encoded_total += len(pending)
+            if args.max_frames and written >= args.max_frames:
+                break
+    except KeyboardInterrupt:
+        pass
+    finally:
+        index_file.close()
+
+    mean = encoded_total / written if written else 0.0
+    print(f"quadros: {written}, descartados até o quadro-chave: {skipped}, registros perdidos: {lost}, "
+          f"média {mean:.0f} B/quadro (bruto {FB_SIZE})", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
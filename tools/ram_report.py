@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Relatório das funções do JoyTracker que executam da SRAM.
+
+Lê a tabela de símbolos do ELF (``arm-none-eabi-nm``) e lista as funções com
+endereço na SRAM, com o tamanho de cada uma e o total. As marcadas com
+``RAM_FUNC`` nos fontes (build com JOYTRACKER_RAM_HOT_PATH) aparecem como
+``RAM_FUNC``; as demais foram colocadas na SRAM pelo próprio pico-sdk.
+
+Uso:
+    ram_report.py build/JoyTracker.elf
+    ram_report.py build/JoyTracker.elf --nm arm-none-eabi-nm --sources lib JoyTracker.c
+
+No build com a opção, sai com código 1 se alguma função marcada com
+``RAM_FUNC`` e presente no ELF tiver ficado na flash.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+SRAM_START = 0x20000000
+SRAM_END = 0x20042000
+FLASH_START = 0x10000000
+FLASH_END = 0x11000000
+
+RAM_FUNC_PATTERN = re.compile(r"\bRAM_FUNC\((\w+)\)")
+
+
+def marked_functions(paths):
+    """Nomes envolvidos por RAM_FUNC nos arquivos .c dos caminhos dados."""
+    names = set()
+    for path in paths:
+        files = [path]
+        if os.path.isdir(path):
+            files = [os.path.join(path, name) for name in sorted(os.listdir(path)) if name.endswith(".c")]
+        for file in files:
+            with open(file, encoding="utf-8", errors="replace") as handle:
+                names.update(RAM_FUNC_PATTERN.findall(handle.read()))
+    return names
+
+
+def load_symbols(nm, elf):
+    """Funções definidas no ELF: nome -> (endereço, tamanho)."""
+    output = subprocess.run([nm, "--print-size", "--defined-only", elf],
+                            check=True, capture_output=True, text=True).stdout
+    symbols = {}
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) != 4 or fields[2] not in ("t", "T"):
+            continue
+        address = int(fields[0], 16) & ~1  # Bit 0: modo Thumb
+        symbols[fields[3]] = (address, int(fields[1], 16))
+    return symbols
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="ELF do firmware")
+    parser.add_argument("--nm", default="arm-none-eabi-nm", help="nm da toolchain (padrão: arm-none-eabi-nm)")
+    parser.add_argument("--sources", nargs="*", default=[],
+                        help="arquivos ou diretórios onde procurar RAM_FUNC")
+    args = parser.parse_args()
+
+    symbols = load_symbols(args.nm, args.elf)
+    marked = marked_functions(args.sources)
+
+    in_ram = sorted(((name, size) for name, (address, size) in symbols.items()
+                     if SRAM_START <= address < SRAM_END), key=lambda item: (-item[1], item[0]))
+    in_flash = sorted(name for name in marked if name in symbols
+                      and FLASH_START <= symbols[name][0] < FLASH_END)
+
+    total_marked = sum(size for name, size in in_ram if name in marked)
+    total_sdk = sum(size for name, size in in_ram if name not in marked)
+    print(f"{'função':<36} {'bytes':>7}  origem")
+    for name, size in in_ram:
+        print(f"{name:<36} {size:>7}  {'RAM_FUNC' if name in marked else 'pico-sdk'}")
+    print(f"{'total RAM_FUNC':<36} {total_marked:>7}")
+    print(f"{'total pico-sdk':<36} {total_sdk:>7}")
+
+    if total_marked == 0:
+        print("nenhuma função RAM_FUNC na SRAM (build sem JOYTRACKER_RAM_HOT_PATH?)", file=sys.stderr)
+        sys.exit(0)
+    for name in in_flash:
+        print(f"aviso: {name} está marcada com RAM_FUNC, mas ficou na flash", file=sys.stderr)
+    sys.exit(1 if in_flash else 0)
+
+
+if __name__ == "__main__":
+    main()
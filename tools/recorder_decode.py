@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""Decodificador das sessões gravadas na flash pelo JoyTracker.
+
+Lê o despejo do comando ``u`` do console (linhas ``P <hex>``, podendo estar
+misturadas a outras saídas) ou uma imagem binária da flash (por exemplo, a
+gravada por ``joytracker_sim -F flash.bin`` ou lida com ``picotool save``), e
+grava ``samples.csv`` e ``events.csv``. Páginas com CRC inválido são ignoradas;
+lacunas na sequência das páginas são contabilizadas como perdas.
+
+Uso:
+    recorder_decode.py console.txt -o saida/
+    recorder_decode.py flash.bin -o saida/
+    recorder_decode.py regiao.bin --offset 0 -o saida/
+
+O formato das páginas está documentado em lib/recorder.h.
+"""
+
+import argparse
+import csv
+import os
+import struct
+import sys
+
+HEADER = struct.Struct("<HBBIHHIHHHH")
+PAGE_SIZE = 256
+REGION_SIZE = 256 * 1024
+MAGIC = 0x524A
+VERSION = 1
+FLAG_SESSION_START = 0x01
+FLAG_CONTINUED = 0x02
+
+TOKEN_RUN, TOKEN_MOVE, TOKEN_TIME, TOKEN_EVENT = range(4)
+EVENT_NAMES = ("press", "release", "long_press", "repeat")
+
+
+def crc16(data):
+    """CRC-16/CCITT (polinômio 0x1021, valor inicial 0xFFFF)."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def varints(data):
+    """Gera os varints LEB128 do conteúdo de uma página."""
+    value, shift = 0, 0
+    for byte in data:
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            yield value
+            value, shift = 0, 0
+    if shift:
+        raise ValueError("varint truncado")
+
+
+def read_pages(path, offset):
+    """Páginas de 256 bytes do despejo de texto ou da imagem binária."""
+    with open(path, "rb") as handle:
+        data = handle.read()
+    if b"# recorder" in data or data.startswith(b"P "):
+        pages = []
+        for line in data.decode("ascii", errors="replace").splitlines():
+            line = line.strip()
+            if line.startswith("P ") and len(line) == 2 + 2 * PAGE_SIZE:
+                pages.append(bytes.fromhex(line[2:]))
+        return pages
+    if offset is None:
+        offset = max(0, len(data) - REGION_SIZE)  # Região no fim da flash
+    region = data[offset:offset + REGION_SIZE]
+    return [region[i:i + PAGE_SIZE] for i in range(0, len(region) - PAGE_SIZE + 1, PAGE_SIZE)]
+
+
+def parse_page(page):
+    """Cabeçalho e conteúdo de uma página válida, ou None."""
+    magic, version, flags, seq, session, length, t0, x0, y0, period, crc = HEADER.unpack_from(page)
+    if magic != MAGIC or version != VERSION or length > PAGE_SIZE - HEADER.size:
+        return None
+    payload = page[HEADER.size:HEADER.size + length]
+    if crc16(payload) != crc:
+        return None
+    return dict(flags=flags, seq=seq, session=session, t0=t0, x0=x0, y0=y0, period=period,
+                payload=payload, bytes=HEADER.size + length)
+
+
+def decode_page(page, samples, events):
+    """Acrescenta as amostras (t, x, y) e os eventos (t, gpio, tipo) de uma página."""
+    t, x, y, period = page["t0"], page["x0"], page["y0"], page["period"]
+    if not page["flags"] & FLAG_CONTINUED:
+        samples.append((t, x, y))
+    gap = 1  # Períodos até a próxima amostra
+    tokens = varints(page["payload"])
+    for value in tokens:
+        token, arg = value & 3, value >> 2
+        if token == TOKEN_RUN:
+            for _ in range(arg):
+                t += gap * period
+                gap = 1
+                samples.append((t, x, y))
+        elif token == TOKEN_MOVE:
+            t += gap * period
+            gap = 1
+            x += unzigzag(arg)
+            y += unzigzag(next(tokens))
+            samples.append((t, x, y))
+        elif token == TOKEN_TIME:
+            gap = unzigzag(arg) + 1
+        else:
+            gpio, kind = arg >> 2, (arg & 3) + 1
+            events.append((t + unzigzag(next(tokens)), gpio, kind))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source", help="despejo do comando 'u' ou imagem binária da flash")
+    parser.add_argument("-o", "--output", default="recorder", help="diretório dos CSVs")
+    parser.add_argument("--offset", type=lambda text: int(text, 0), default=None,
+                        help="início da região na imagem binária (padrão: últimos 256 KB)")
+    args = parser.parse_args()
+
+    raw_pages = read_pages(args.source, args.offset)
+    pages = [page for page in map(parse_page, raw_pages) if page is not None]
+    blank = sum(1 for page in raw_pages if page == b"\xff" * PAGE_SIZE)
+    invalid = len(raw_pages) - len(pages) - blank
+    if not pages:
+        print(f"nenhuma página válida ({invalid} inválidas)", file=sys.stderr)
+        sys.exit(1)
+
+    # Ordem de gravação: a sequência continua entre sessões e entre partidas
+    pages.sort(key=lambda page: page["seq"])
+    lost = sum(b["seq"] - a["seq"] - 1 for a, b in zip(pages, pages[1:]))
+
+    os.makedirs(args.output, exist_ok=True)
+    sessions = {}
+    with open(os.path.join(args.output, "samples.csv"), "w", newline="") as samples_file, \
+            open(os.path.join(args.output, "events.csv"), "w", newline="") as events_file:
+        samples_csv, events_csv = csv.writer(samples_file), csv.writer(events_file)
+        samples_csv.writerow(("session", "t_us", "x", "y"))
+        events_csv.writerow(("session", "t_us", "gpio", "event"))
+        for page in pages:
+            samples, events = [], []
+            try:
+                decode_page(page, samples, events)
+            except (ValueError, StopIteration):
+                invalid += 1
+                continue
+            summary = sessions.setdefault(page["session"], dict(pages=0, bytes=0, samples=0, events=0,
+                                                                first=None, last=None))
+            summary["pages"] += 1
+            summary["bytes"] += page["bytes"]
+            summary["samples"] += len(samples)
+            summary["events"] += len(events)
+            if samples:
+                summary["first"] = samples[0][0] if summary["first"] is None else summary["first"]
+                summary["last"] = samples[-1][0]
+            samples_csv.writerows((page["session"], t & 0xFFFFFFFF, x, y) for t, x, y in samples)
+            events_csv.writerows((page["session"], t & 0xFFFFFFFF, gpio, EVENT_NAMES[kind - 1])
+                                 for t, gpio, kind in events)
+
+    print(f"páginas válidas: {len(pages)}, inválidas: {invalid}, perdidas: {lost}", file=sys.stderr)
+    for session, summary in sorted(sessions.items()):
+        duration_us = ((summary["last"] - summary["first"]) & 0xFFFFFFFF) if summary["first"] is not None else 0
+        rate = summary["bytes"] * 1e6 / duration_us if duration_us else 0.0
+        print(f"sessão {session}: {duration_us / 1e6:.2f} s, {summary['samples']} amostras, "
+              f"{summary['events']} eventos, {summary['pages']} páginas, {rate:.1f} B/s", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
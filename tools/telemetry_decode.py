@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""Decodificador da telemetria binária do JoyTracker.
+
+Lê o fluxo COBS da interface CDC de telemetria (ou de um arquivo gravado com,
+por exemplo, ``cat /dev/ttyACM1 > captura.bin``) e grava um CSV por tipo de
+registro. Lacunas na sequência de cada fluxo são contabilizadas como perdas.
+
+Uso:
+    telemetry_decode.py /dev/ttyACM1 -o saida/
+    telemetry_decode.py captura.bin -o saida/
+
+O formato dos registros está documentado em lib/telemetry.h.
+"""
+
+import argparse
+import csv
+import os
+import struct
+import sys
+
+HEADER = struct.Struct("<BBHI")
+
+# Tipo -> (nome do arquivo, formato do conteúdo, colunas)
+RECORD_TYPES = {
+    1: ("raw_sample", struct.Struct("<HH"), ("x", "y")),
+    2: ("filtered_sample", struct.Struct("<HH"), ("x", "y")),
+    3: ("button_event", struct.Struct("<BB"), ("gpio", "event")),
+    4: ("frame_timing", struct.Struct("<III"), ("render_us", "flush_us", "latency_us")),
+    5: ("stream_stats", struct.Struct("<BII"), ("stream_id", "emitted", "dropped")),
+    # Delta do framebuffer: só o cabeçalho do trecho (os quadros são reconstruídos por fb_mirror_view.py)
+    6: ("framebuffer_chunk", struct.Struct("<HHB"), ("frame", "offset", "flags")),
+}
+
+
+def cobs_decode(frame):
+    """Decodifica um quadro COBS (sem o delimitador 0x00)."""
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame) + 1:
+            raise ValueError("quadro COBS inválido")
+        out += frame[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def read_frames(stream):
+    """Gera os quadros delimitados por 0x00 lidos de um arquivo binário."""
+    pending = bytearray()
+    while True:
+        chunk = stream.read(4096)
+        if not chunk:
+            break
+        pending += chunk
+        while True:
+            end = pending.find(b"\x00")
+            if end < 0:
+                break
+            frame = bytes(pending[:end])
+            del pending[:end + 1]
+            if frame:
+                yield frame
+
+
+def open_source(path):
+    """Abre um arquivo ou porta serial; usa pyserial se estiver disponível."""
+    if path == "-":
+        return sys.stdin.buffer
+    if path.startswith("/dev/"):
+        try:
+            import serial  # type: ignore
+            return serial.Serial(path, timeout=1)
+        except ImportError:
+            pass
+    return open(path, "rb", buffering=0)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source", help="porta CDC de telemetria, arquivo capturado ou '-'")
+    parser.add_argument("-o", "--output", default="telemetry", help="diretório dos CSVs")
+    parser.add_argument("-n", "--max-records", type=int, default=0, help="para após N registros")
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    writers, files = {}, []
+    next_sequence, lost, invalid, decoded = {}, {}, 0, 0
+
+    source = open_source(args.source)
+    try:
+        for frame in read_frames(source):
+            try:
+                record = cobs_decode(frame)
+                rtype, stream_id, sequence, timestamp = HEADER.unpack_from(record)
+            except (ValueError, struct.error):
+                invalid += 1
+                continue
+            if rtype not in RECORD_TYPES:
+                invalid += 1
+                continue
+
+            # Perdas: diferença entre a sequência esperada e a recebida (módulo 2^16)
+            expected = next_sequence.get(stream_id)
+            if expected is not None and sequence != expected:
+                lost[stream_id] = lost.get(stream_id, 0) + ((sequence - expected) & 0xFFFF)
+            next_sequence[stream_id] = (sequence + 1) & 0xFFFF
+
+            name, payload, columns = RECORD_TYPES[rtype]
+            if rtype not in writers:
+                handle = open(os.path.join(args.output, name + ".csv"), "w", newline="")
+                files.append(handle)
+                writers[rtype] = csv.writer(handle)
+                writers[rtype].writerow(("stream", "sequence", "timestamp_us") + columns)
+            try:
+                values = payload.unpack_from(record, HEADER.size)
+            except struct.error:
+                invalid += 1
+                continue
+            writers[rtype].writerow((stream_id, sequence, timestamp) + values)
+
+            decoded += 1
+            if args.max_records and decoded >= args.max_records:
+                break
+    except KeyboardInterrupt:
+        pass
+    finally:
+        for handle in files:
+            handle.close()
+
+    print(f"registros decodificados: {decoded}, quadros inválidos: {invalid}", file=sys.stderr)
+    for stream_id, count in sorted(lost.items()):
+        print(f"fluxo {stream_id}: {count} registros perdidos", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""Conversor da linha do tempo de eventos do JoyTracker para o trace do Chrome.
+
+Lê o despejo do comando ``j`` do console (linhas ``N``, ``C`` e ``E``, podendo
+estar misturadas a outras saídas) e grava o JSON do formato de trace do
+Chrome, aberto por ``chrome://tracing`` ou pelo Perfetto (ui.perfetto.dev).
+Cada núcleo vira uma linha (``core0``, ``core1``); os instantes são relativos
+ao primeiro evento e corrigidos na volta do contador de 32 bits.
+
+Fins sem início (o início foi sobrescrito no buffer) são descartados; inícios
+sem fim (a janela acabou no meio do intervalo) são fechados no último evento.
+
+Uso:
+    trace_to_chrome.py console.txt -o trace.json
+
+O formato do despejo está documentado em lib/event_trace.h.
+"""
+
+import argparse
+import json
+import sys
+
+PHASES = {"B": "B", "E": "E", "I": "i"}
+
+
+def load(path):
+    """Carrega o despejo: (nomes por id, eventos por núcleo, sobrescritos por núcleo)."""
+    names, events, overwritten = {}, {}, {}
+    with open(path, encoding="utf-8", errors="replace") as handle:
+        for line in handle:
+            fields = line.split()
+            try:
+                if len(fields) == 3 and fields[0] == "N":
+                    names[int(fields[1])] = fields[2]
+                elif len(fields) == 4 and fields[0] == "C":
+                    core = int(fields[1])
+                    events[core] = []
+                    overwritten[core] = int(fields[3].split("=")[1])
+                elif len(fields) == 6 and fields[0] == "E" and fields[3] in PHASES:
+                    core = int(fields[1])
+                    events.setdefault(core, []).append(
+                        (int(fields[2]), fields[3], int(fields[4]), int(fields[5])))
+            except (ValueError, IndexError):
+                continue
+    return names, events, overwritten
+
+
+def unwrap(events):
+    """Converte os instantes de 32 bits em uma escala contínua (us)."""
+    result, last, offset = [], None, 0
+    for timestamp, phase, ident, arg in events:
+        if last is not None and timestamp < last and last - timestamp > 1 << 31:
+            offset += 1 << 32
+        last = timestamp
+        result.append((timestamp + offset, phase, ident, arg))
+    return result
+
+
+def convert(names, events):
+    """Gera a lista traceEvents, com os intervalos de cada núcleo balanceados."""
+    per_core = {core: unwrap(core_events) for core, core_events in events.items()}
+    starts = [core_events[0][0] for core_events in per_core.values() if core_events]
+    origin = min(starts) if starts else 0
+    trace, dropped = [], 0
+
+    for core in sorted(per_core):
+        trace.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": core,
+                      "args": {"name": f"core{core}"}})
+        open_ids = []
+        last_ts = origin
+        for timestamp, phase, ident, arg in per_core[core]:
+            last_ts = timestamp
+            entry = {"name": names.get(ident, f"evento_{ident}"), "ph": PHASES[phase],
+                     "pid": 1, "tid": core, "ts": timestamp - origin}
+            if phase == "B":
+                open_ids.append(ident)
+                entry["args"] = {"arg": arg}
+            elif phase == "E":
+                if ident not in open_ids:
+                    dropped += 1
+                    continue
+                # Fecha também os intervalos internos que perderam o fim
+                while open_ids:
+                    inner = open_ids.pop()
+                    if inner == ident:
+                        break
+                    trace.append({"name": names.get(inner, f"evento_{inner}"), "ph": "E",
+                                  "pid": 1, "tid": core, "ts": timestamp - origin})
+            else:
+                entry["s"] = "t"
+                entry["args"] = {"arg": arg}
+            trace.append(entry)
+        while open_ids:
+            ident = open_ids.pop()
+            trace.append({"name": names.get(ident, f"evento_{ident}"), "ph": "E",
+                          "pid": 1, "tid": core, "ts": last_ts - origin})
+    return trace, dropped
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("dump", help="saída do console com o despejo do comando 'j'")
+    parser.add_argument("-o", "--output", default="trace.json", help="arquivo JSON gerado")
+    args = parser.parse_args()
+
+    names, events, overwritten = load(args.dump)
+    if not events:
+        print("nenhum despejo de event_trace encontrado", file=sys.stderr)
+        return 1
+    trace, dropped = convert(names, events)
+    with open(args.output, "w", encoding="utf-8") as handle:
+        json.dump({"traceEvents": trace, "displayTimeUnit": "ns"}, handle)
+
+    for core in sorted(events):
+        print(f"core{core}: {len(events[core])} eventos, {overwritten.get(core, 0)} sobrescritos",
+              file=sys.stderr)
+    print(f"{len(trace)} entradas em {args.output} ({dropped} fins sem início descartados)",
+          file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())